@@ -93,8 +93,10 @@ float4 GetDiffuseColor(Material material, float4 transformUV, MSOutput input) {
 float3 GetNormalMap(Material material, float4 transformUV, MSOutput input) {
 	
 	// normalMap
-	float3 localNormal = gTextures[material.normalMapTextureIndex].Sample(gSampler, transformUV.xy).xyz;
-	localNormal = (localNormal - 0.5f) * 2.0f;
+	// BC5で圧縮したものはxyのみ持つのでzを復元する
+	float2 localNormalXY = gTextures[material.normalMapTextureIndex].Sample(gSampler, transformUV.xy).xy;
+	localNormalXY = (localNormalXY - 0.5f) * 2.0f;
+	float3 localNormal = float3(localNormalXY, sqrt(saturate(1.0f - dot(localNormalXY, localNormalXY))));
 	float3 normal = input.tangent * localNormal.x + input.biNormal * localNormal.y + input.normal * localNormal.z;
 	
 	return normal;
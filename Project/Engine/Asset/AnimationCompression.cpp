@@ -0,0 +1,605 @@
+#include "AnimationCompression.h"
+
+//============================================================================
+//	include
+//============================================================================
+
+// c++
+#include <cmath>
+#include <fstream>
+#include <algorithm>
+
+//============================================================================
+//	AnimationCompression Methods
+//============================================================================
+
+namespace {
+
+	// ファイル識別子とバージョン
+	constexpr uint32_t kCookedMagic = 0x4D4E4143; // "CANM"
+	constexpr uint32_t kCookedVersion = 2;
+
+	// smallest-threeで残す3成分の範囲は[-1/√2, 1/√2]
+	constexpr float kRotationRange = 0.70710678f;
+	constexpr float kRotationScale = 32767.0f;
+	constexpr float kVector3Scale = 65535.0f;
+
+	//--------- quantize -----------------------------------------------------
+
+	uint16_t QuantizeUnit(float value, float scale) {
+
+		return static_cast<uint16_t>(std::lround(std::clamp(value, 0.0f, 1.0f) * scale));
+	}
+
+	void QuantizeVector3(const CompressedTrack& track, const Vector3& value, uint16_t out[3]) {
+
+		const float v[3] = { value.x, value.y, value.z };
+		for (int i = 0; i < 3; ++i) {
+
+			const float extent = track.rangeExtent[i];
+			out[i] = extent <= 0.0f ? 0 : QuantizeUnit((v[i] - track.rangeMin[i]) / extent, kVector3Scale);
+		}
+	}
+
+	Vector3 DequantizeVector3(const CompressedTrack& track, const uint16_t in[3]) {
+
+		return Vector3(
+			track.rangeMin[0] + track.rangeExtent[0] * (in[0] / kVector3Scale),
+			track.rangeMin[1] + track.rangeExtent[1] * (in[1] / kVector3Scale),
+			track.rangeMin[2] + track.rangeExtent[2] * (in[2] / kVector3Scale));
+	}
+
+	//--------- error --------------------------------------------------------
+
+	float Error(const Vector3& a, const Vector3& b) {
+
+		return (std::max)({ std::abs(a.x - b.x), std::abs(a.y - b.y), std::abs(a.z - b.z) });
+	}
+
+	float Error(const Quaternion& a, const Quaternion& b) {
+
+		// 2つの回転のなす角。acosは1付近で精度が出ないので弦の長さから求める
+		const float sign = Quaternion::Dot(a, b) < 0.0f ? -1.0f : 1.0f;
+		const float dx = a.x - b.x * sign;
+		const float dy = a.y - b.y * sign;
+		const float dz = a.z - b.z * sign;
+		const float dw = a.w - b.w * sign;
+		const float chord = std::sqrt(dx * dx + dy * dy + dz * dz + dw * dw);
+		return 4.0f * std::asin((std::min)(chord * 0.5f, 1.0f));
+	}
+
+	Vector3 Interpolate(const Vector3& a, const Vector3& b, float t) { return Vector3::Lerp(a, b, t); }
+	Quaternion Interpolate(const Quaternion& a, const Quaternion& b, float t) { return Quaternion::Slerp(a, b, t); }
+
+	//--------- track --------------------------------------------------------
+
+	// 一定間隔で再サンプリングする
+	template <typename tValue>
+	std::vector<tValue> Resample(const AnimationCurve<tValue>& curve,
+		uint32_t frameCount, float sampleRate, float duration) {
+
+		std::vector<tValue> samples(frameCount);
+		KeyframeCursor cursor{};
+		for (uint32_t frame = 0; frame < frameCount; ++frame) {
+
+			const float time = (std::min)(static_cast<float>(frame) / sampleRate, duration);
+			samples[frame] = AnimationSampler::Sample(curve, time, cursor);
+		}
+		return samples;
+	}
+
+	// 再サンプリング済みの値からトラックを作成する
+	template <typename tValue>
+	CompressedTrack BuildTrack(const std::vector<tValue>& samples, float tolerance) {
+
+		CompressedTrack track{};
+		const uint32_t frameCount = static_cast<uint32_t>(samples.size());
+
+		// 全フレームが許容誤差内なら定数トラックにする
+		const bool isConstant = std::all_of(samples.begin(), samples.end(),
+			[&](const tValue& value) { return Error(value, samples.front()) <= tolerance; });
+		if (isConstant) {
+
+			track.isConstant = true;
+			if constexpr (std::is_same_v<tValue, Quaternion>) {
+
+				const Quaternion& q = samples.front();
+				track.constant = { q.x, q.y, q.z, q.w };
+			} else {
+
+				const Vector3& v = samples.front();
+				track.constant = { v.x, v.y, v.z, 0.0f };
+			}
+			return track;
+		}
+		track.isConstant = false;
+
+		// 量子化範囲
+		if constexpr (!std::is_same_v<tValue, Quaternion>) {
+
+			Vector3 minValue = samples.front();
+			Vector3 maxValue = samples.front();
+			for (const Vector3& v : samples) {
+
+				minValue = Vector3((std::min)(minValue.x, v.x), (std::min)(minValue.y, v.y), (std::min)(minValue.z, v.z));
+				maxValue = Vector3((std::max)(maxValue.x, v.x), (std::max)(maxValue.y, v.y), (std::max)(maxValue.z, v.z));
+			}
+			track.rangeMin = { minValue.x, minValue.y, minValue.z };
+			track.rangeExtent = { maxValue.x - minValue.x, maxValue.y - minValue.y, maxValue.z - minValue.z };
+		}
+
+		// 全フレームを量子化し、展開後の値でキー削減の誤差を測る
+		std::vector<std::array<uint16_t, 3>> quantized(frameCount);
+		std::vector<tValue> decoded(frameCount);
+		for (uint32_t frame = 0; frame < frameCount; ++frame) {
+
+			if constexpr (std::is_same_v<tValue, Quaternion>) {
+
+				AnimationCompression::QuantizeRotation(samples[frame], quantized[frame].data());
+				decoded[frame] = AnimationCompression::DequantizeRotation(quantized[frame].data());
+			} else {
+
+				QuantizeVector3(track, samples[frame], quantized[frame].data());
+				decoded[frame] = DequantizeVector3(track, quantized[frame].data());
+			}
+		}
+
+		// 区間[begin, end]の補間で間のフレームを再現できるか
+		auto canSkip = [&](uint32_t begin, uint32_t end) {
+			for (uint32_t frame = begin + 1; frame < end; ++frame) {
+
+				const float t = static_cast<float>(frame - begin) / static_cast<float>(end - begin);
+				if (tolerance < Error(Interpolate(decoded[begin], decoded[end], t), samples[frame])) {
+					return false;
+				}
+			}
+			return true;
+			};
+
+		// 先頭から貪欲に区間を伸ばし、再現できないところでキーを残す
+		std::vector<uint32_t> keptFrames = { 0 };
+		uint32_t begin = 0;
+		while (begin < frameCount - 1) {
+
+			uint32_t end = begin + 1;
+			while (end + 1 < frameCount && canSkip(begin, end + 1)) {
+				++end;
+			}
+			keptFrames.emplace_back(end);
+			begin = end;
+		}
+
+		track.frames.reserve(keptFrames.size());
+		track.values.reserve(keptFrames.size() * 3);
+		for (uint32_t frame : keptFrames) {
+
+			track.frames.emplace_back(static_cast<uint16_t>(frame));
+			track.values.insert(track.values.end(), quantized[frame].begin(), quantized[frame].end());
+		}
+		return track;
+	}
+
+	// カーブからトラックを作成する。キーの無いカーブは展開時に値を変更しないトラックにする
+	template <typename tValue>
+	CompressedTrack BuildTrack(const AnimationCurve<tValue>& curve,
+		uint32_t frameCount, float sampleRate, float duration, float tolerance) {
+
+		if (curve.Empty()) {
+
+			CompressedTrack track{};
+			track.hasKeys = false;
+			return track;
+		}
+		return BuildTrack(Resample(curve, frameCount, sampleRate, duration), tolerance);
+	}
+
+	// 全カーブで最も短いキー間隔を求める。キーが無ければ0
+	float FindMinKeyInterval(const AnimationData& animation) {
+
+		float minInterval = 0.0f;
+		auto check = [&](const std::vector<float>& times) {
+			for (size_t i = 1; i < times.size(); ++i) {
+
+				const float interval = times[i] - times[i - 1];
+				if (1e-4f < interval && (minInterval == 0.0f || interval < minInterval)) {
+
+					minInterval = interval;
+				}
+			}
+			};
+		for (const auto& [name, node] : animation.nodeAnimations) {
+
+			check(node.translate.times);
+			check(node.rotate.times);
+			check(node.scale.times);
+		}
+		return minInterval;
+	}
+
+	// 残したキーの区間を求める。frames[index] <= frame < frames[index + 1]
+	float FindSegment(const CompressedTrack& track, float frame, KeyframeCursor& cursor, uint32_t& outIndex) {
+
+		const std::vector<uint16_t>& frames = track.frames;
+		const uint32_t last = static_cast<uint32_t>(frames.size() - 1);
+		if (frame <= frames.front()) {
+
+			cursor.index = 0;
+			outIndex = 0;
+			return 0.0f;
+		}
+		if (frames.back() <= frame) {
+
+			cursor.index = last;
+			outIndex = last;
+			return 0.0f;
+		}
+
+		// 前回の区間、次の区間の順で確認し、外れたら二分探索する
+		auto contains = [&](uint32_t index) {
+			return index < last && frames[index] <= frame && frame < frames[index + 1]; };
+		uint32_t index = cursor.index;
+		if (!contains(index)) {
+			if (contains(index + 1)) {
+
+				++index;
+			} else {
+
+				auto it = std::upper_bound(frames.begin(), frames.end(), frame,
+					[](float value, uint16_t key) { return value < static_cast<float>(key); });
+				index = static_cast<uint32_t>(std::distance(frames.begin(), it)) - 1;
+			}
+		}
+		cursor.index = index;
+		outIndex = index;
+		return (frame - frames[index]) / static_cast<float>(frames[index + 1] - frames[index]);
+	}
+
+	Vector3 SampleVector3(const CompressedTrack& track, float frame, KeyframeCursor& cursor) {
+
+		if (track.isConstant) {
+			return Vector3(track.constant[0], track.constant[1], track.constant[2]);
+		}
+
+		uint32_t index = 0;
+		const float t = FindSegment(track, frame, cursor, index);
+		const Vector3 v0 = DequantizeVector3(track, &track.values[index * 3]);
+		if (t <= 0.0f) {
+			return v0;
+		}
+		return Vector3::Lerp(v0, DequantizeVector3(track, &track.values[(index + 1) * 3]), t);
+	}
+
+	Quaternion SampleRotation(const CompressedTrack& track, float frame, KeyframeCursor& cursor) {
+
+		if (track.isConstant) {
+			return Quaternion{ track.constant[0], track.constant[1], track.constant[2], track.constant[3] };
+		}
+
+		uint32_t index = 0;
+		const float t = FindSegment(track, frame, cursor, index);
+		const Quaternion q0 = AnimationCompression::DequantizeRotation(&track.values[index * 3]);
+		if (t <= 0.0f) {
+			return q0;
+		}
+		return Quaternion::Slerp(q0, AnimationCompression::DequantizeRotation(&track.values[(index + 1) * 3]), t);
+	}
+
+	//--------- file ---------------------------------------------------------
+
+	template <typename T>
+	void WriteValue(std::ofstream& file, const T& value) {
+
+		file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+	template <typename T>
+	bool ReadValue(std::ifstream& file, T& value) {
+
+		return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(T)));
+	}
+
+	template <typename T>
+	void WriteArray(std::ofstream& file, const std::vector<T>& values) {
+
+		WriteValue(file, static_cast<uint32_t>(values.size()));
+		file.write(reinterpret_cast<const char*>(values.data()), sizeof(T) * values.size());
+	}
+	template <typename T>
+	bool ReadArray(std::ifstream& file, std::vector<T>& values) {
+
+		uint32_t count = 0;
+		if (!ReadValue(file, count)) {
+			return false;
+		}
+		values.resize(count);
+		return static_cast<bool>(file.read(reinterpret_cast<char*>(values.data()), sizeof(T) * count));
+	}
+
+	void WriteString(std::ofstream& file, const std::string& value) {
+
+		WriteValue(file, static_cast<uint32_t>(value.size()));
+		file.write(value.data(), value.size());
+	}
+	bool ReadString(std::ifstream& file, std::string& value) {
+
+		uint32_t size = 0;
+		if (!ReadValue(file, size)) {
+			return false;
+		}
+		value.resize(size);
+		return static_cast<bool>(file.read(value.data(), size));
+	}
+
+	void WriteTrack(std::ofstream& file, const CompressedTrack& track) {
+
+		WriteValue(file, static_cast<uint8_t>(track.hasKeys));
+		WriteValue(file, static_cast<uint8_t>(track.isConstant));
+		WriteValue(file, track.constant);
+		WriteValue(file, track.rangeMin);
+		WriteValue(file, track.rangeExtent);
+		WriteArray(file, track.frames);
+		WriteArray(file, track.values);
+	}
+	bool ReadTrack(std::ifstream& file, CompressedTrack& track) {
+
+		uint8_t hasKeys = 0;
+		uint8_t isConstant = 0;
+		if (!ReadValue(file, hasKeys) || !ReadValue(file, isConstant) || !ReadValue(file, track.constant) ||
+			!ReadValue(file, track.rangeMin) || !ReadValue(file, track.rangeExtent) ||
+			!ReadArray(file, track.frames) || !ReadArray(file, track.values)) {
+			return false;
+		}
+		track.hasKeys = hasKeys != 0;
+		track.isConstant = isConstant != 0;
+
+		// 壊れたデータを弾く
+		if (track.hasKeys && !track.isConstant && (track.frames.empty() || track.values.size() != track.frames.size() * 3)) {
+			return false;
+		}
+		return true;
+	}
+}
+
+void AnimationCompression::QuantizeRotation(const Quaternion& rotation, uint16_t out[3]) {
+
+	Quaternion q = Quaternion::Normalize(rotation);
+	float components[4] = { q.x, q.y, q.z, q.w };
+
+	// 絶対値が最大の成分を落とし、正になるよう符号をそろえる
+	uint32_t largest = 0;
+	for (uint32_t i = 1; i < 4; ++i) {
+		if (std::abs(components[largest]) < std::abs(components[i])) {
+
+			largest = i;
+		}
+	}
+	const float sign = components[largest] < 0.0f ? -1.0f : 1.0f;
+
+	uint32_t outIndex = 0;
+	for (uint32_t i = 0; i < 4; ++i) {
+		if (i == largest) {
+			continue;
+		}
+
+		const float unit = (components[i] * sign / kRotationRange + 1.0f) * 0.5f;
+		out[outIndex] = QuantizeUnit(unit, kRotationScale);
+		++outIndex;
+	}
+
+	// 最大成分のIndexを上位bitに入れる
+	out[0] |= static_cast<uint16_t>((largest & 1) << 15);
+	out[1] |= static_cast<uint16_t>(((largest >> 1) & 1) << 15);
+}
+
+Quaternion AnimationCompression::DequantizeRotation(const uint16_t in[3]) {
+
+	const uint32_t largest = ((in[0] >> 15) & 1) | (((in[1] >> 15) & 1) << 1);
+
+	float components[4]{};
+	float sum = 0.0f;
+	uint32_t inIndex = 0;
+	for (uint32_t i = 0; i < 4; ++i) {
+		if (i == largest) {
+			continue;
+		}
+
+		const float unit = static_cast<float>(in[inIndex] & 0x7fff) / kRotationScale;
+		components[i] = (unit * 2.0f - 1.0f) * kRotationRange;
+		sum += components[i] * components[i];
+		++inIndex;
+	}
+	components[largest] = std::sqrt((std::max)(0.0f, 1.0f - sum));
+	return Quaternion{ components[0], components[1], components[2], components[3] };
+}
+
+AnimationCompression::CookedClip AnimationCompression::Compress(const std::string& name,
+	const AnimationData& animation, const Settings& settings) {
+
+	CookedClip clip{};
+	clip.name = name;
+	clip.duration = animation.duration;
+
+	// 元のキー間隔に合わせたレートで再サンプリングし、キー位置をずらさないようにする
+	float sampleRate = settings.sampleRate;
+	const float minInterval = FindMinKeyInterval(animation);
+	if (0.0f < minInterval) {
+
+		sampleRate = std::clamp(1.0f / minInterval, 1.0f, settings.maxSampleRate);
+	}
+
+	// 尺が整数フレームになるようレートを補正する
+	uint32_t frameCount = 1;
+	clip.sampleRate = sampleRate;
+	if (0.0f < animation.duration) {
+
+		const uint32_t intervals = (std::max)(1u,
+			static_cast<uint32_t>(std::ceil(animation.duration * sampleRate - 1e-3f)));
+		frameCount = (std::min)(intervals + 1, 65536u);
+		clip.sampleRate = static_cast<float>(frameCount - 1) / animation.duration;
+	}
+
+	clip.nodes.reserve(animation.nodeAnimations.size());
+	for (const auto& [nodeName, node] : animation.nodeAnimations) {
+
+		CompressedNodeAnimation compressed{};
+		compressed.translate = BuildTrack(node.translate,
+			frameCount, clip.sampleRate, clip.duration, settings.translateTolerance);
+		compressed.rotate = BuildTrack(node.rotate,
+			frameCount, clip.sampleRate, clip.duration, settings.rotateTolerance);
+		compressed.scale = BuildTrack(node.scale,
+			frameCount, clip.sampleRate, clip.duration, settings.scaleTolerance);
+		clip.nodes.emplace_back(nodeName, std::move(compressed));
+	}
+	return clip;
+}
+
+void AnimationCompression::SampleNode(const CompressedNodeAnimation& node, float sampleRate, float time,
+	NodeAnimationCursor& cursor, Vector3& outTranslation, Quaternion& outRotation, Vector3& outScale) {
+
+	// 一定間隔なので時刻から直接フレーム位置が求まる
+	// 非圧縮のカーブと同じく、キーの無いトラックは値を変更しない
+	const float frame = (std::max)(0.0f, time * sampleRate);
+	if (node.translate.hasKeys) {
+
+		outTranslation = SampleVector3(node.translate, frame, cursor.translate);
+	}
+	if (node.rotate.hasKeys) {
+
+		outRotation = SampleRotation(node.rotate, frame, cursor.rotate);
+	}
+	if (node.scale.hasKeys) {
+
+		outScale = SampleVector3(node.scale, frame, cursor.scale);
+	}
+}
+
+AnimationCompression::ErrorReport AnimationCompression::MeasureError(const CookedClip& clip,
+	const AnimationData& source, uint32_t subSteps) {
+
+	ErrorReport report{};
+	const uint32_t sampleCount = (std::max)(1u, static_cast<uint32_t>(
+		std::ceil(clip.duration * clip.sampleRate)) * (std::max)(1u, subSteps));
+	for (const auto& [nodeName, node] : clip.nodes) {
+
+		auto it = source.nodeAnimations.find(nodeName);
+		if (it == source.nodeAnimations.end()) {
+			continue;
+		}
+		const NodeAnimation& sourceNode = it->second;
+
+		// キー位置の間も含めて測る
+		NodeAnimationCursor cursor{};
+		NodeAnimationCursor sourceCursor{};
+		for (uint32_t sample = 0; sample <= sampleCount; ++sample) {
+
+			const float time = clip.duration * static_cast<float>(sample) / static_cast<float>(sampleCount);
+			Vector3 translation{};
+			Quaternion rotation = Quaternion::Identity();
+			Vector3 scale{};
+			SampleNode(node, clip.sampleRate, time, cursor, translation, rotation, scale);
+
+			if (!sourceNode.translate.Empty()) {
+
+				report.translate = (std::max)(report.translate, Error(translation,
+					AnimationSampler::Sample(sourceNode.translate, time, sourceCursor.translate)));
+			}
+			if (!sourceNode.rotate.Empty()) {
+
+				report.rotate = (std::max)(report.rotate, Error(rotation,
+					AnimationSampler::Sample(sourceNode.rotate, time, sourceCursor.rotate)));
+			}
+			if (!sourceNode.scale.Empty()) {
+
+				report.scale = (std::max)(report.scale, Error(scale,
+					AnimationSampler::Sample(sourceNode.scale, time, sourceCursor.scale)));
+			}
+		}
+	}
+	return report;
+}
+
+bool AnimationCompression::IsWithinTolerance(const ErrorReport& error, const Settings& settings) {
+
+	return error.translate <= settings.translateTolerance &&
+		error.rotate <= settings.rotateTolerance &&
+		error.scale <= settings.scaleTolerance;
+}
+
+bool AnimationCompression::WriteCooked(const std::filesystem::path& path, uint64_t sourceHash,
+	const std::vector<CookedClip>& clips) {
+
+	std::error_code error;
+	std::filesystem::create_directories(path.parent_path(), error);
+
+	// 書き込み途中のファイルを読まないように別名で書いてから置き換える
+	std::filesystem::path tempPath = path;
+	tempPath += ".tmp";
+	{
+		std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+		if (!file) {
+			return false;
+		}
+
+		WriteValue(file, kCookedMagic);
+		WriteValue(file, kCookedVersion);
+		WriteValue(file, sourceHash);
+		WriteValue(file, static_cast<uint32_t>(clips.size()));
+		for (const CookedClip& clip : clips) {
+
+			WriteString(file, clip.name);
+			WriteValue(file, clip.duration);
+			WriteValue(file, clip.sampleRate);
+			WriteValue(file, static_cast<uint32_t>(clip.nodes.size()));
+			for (const auto& [nodeName, node] : clip.nodes) {
+
+				WriteString(file, nodeName);
+				WriteTrack(file, node.scale);
+				WriteTrack(file, node.rotate);
+				WriteTrack(file, node.translate);
+			}
+		}
+		if (!file) {
+			return false;
+		}
+	}
+	std::filesystem::rename(tempPath, path, error);
+	return !error;
+}
+
+bool AnimationCompression::ReadCooked(const std::filesystem::path& path, uint64_t sourceHash,
+	std::vector<CookedClip>& outClips) {
+
+	std::ifstream file(path, std::ios::binary);
+	if (!file) {
+		return false;
+	}
+
+	uint32_t magic = 0;
+	uint32_t version = 0;
+	uint64_t cookedHash = 0;
+	uint32_t clipCount = 0;
+	if (!ReadValue(file, magic) || !ReadValue(file, version) || !ReadValue(file, cookedHash) ||
+		!ReadValue(file, clipCount) ||
+		magic != kCookedMagic || version != kCookedVersion || cookedHash != sourceHash) {
+		return false;
+	}
+
+	outClips.clear();
+	outClips.resize(clipCount);
+	for (CookedClip& clip : outClips) {
+
+		uint32_t nodeCount = 0;
+		if (!ReadString(file, clip.name) || !ReadValue(file, clip.duration) ||
+			!ReadValue(file, clip.sampleRate) || !ReadValue(file, nodeCount)) {
+			return false;
+		}
+
+		clip.nodes.resize(nodeCount);
+		for (auto& [nodeName, node] : clip.nodes) {
+			if (!ReadString(file, nodeName) || !ReadTrack(file, node.scale) ||
+				!ReadTrack(file, node.rotate) || !ReadTrack(file, node.translate)) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
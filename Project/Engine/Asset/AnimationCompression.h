@@ -0,0 +1,72 @@
+#pragma once
+
+//============================================================================
+//	include
+//============================================================================
+#include <Engine/Asset/AssetStructure.h>
+#include <Engine/Asset/AnimationSampler.h>
+
+// c++
+#include <string>
+#include <vector>
+#include <utility>
+#include <filesystem>
+
+//============================================================================
+//	AnimationCompression namespace
+//	アニメーションクリップの圧縮/展開と、圧縮済みクリップのファイル入出力を行う。
+//	圧縮は一定間隔での再サンプリング -> 定数トラックの除去 -> 量子化 -> 許容誤差内のキー削減の順に行う
+//============================================================================
+namespace AnimationCompression {
+
+	//--------- structure ----------------------------------------------------
+
+	// 圧縮設定
+	struct Settings {
+
+		float sampleRate = 30.0f;           // キー間隔が取れない場合のレート(1秒あたりのフレーム数)
+		float maxSampleRate = 120.0f;       // キー間隔から求めたレートの上限
+		float translateTolerance = 0.0005f; // 許容誤差(各成分の差)
+		float scaleTolerance = 0.0005f;
+		float rotateTolerance = 0.0005f;    // 許容誤差(ラジアン)
+	};
+
+	// ファイルに書き出す1クリップ分のデータ。ノード名で持ち、読み込み時に骨のIndexへ解決する
+	struct CookedClip {
+
+		std::string name;
+		float duration = 0.0f;
+		float sampleRate = 0.0f;
+		std::vector<std::pair<std::string, CompressedNodeAnimation>> nodes;
+	};
+
+	// 展開結果と元のカーブとの最大誤差
+	struct ErrorReport {
+
+		float translate = 0.0f;
+		float rotate = 0.0f; // ラジアン
+		float scale = 0.0f;
+	};
+
+	//--------- functions ----------------------------------------------------
+
+	// 1クリップ分を圧縮する。sampleRateは尺が整数フレームになるよう補正される
+	CookedClip Compress(const std::string& name, const AnimationData& animation, const Settings& settings);
+
+	// 元のクリップに対する誤差を、1フレームをsubSteps分割した時刻で測る
+	ErrorReport MeasureError(const CookedClip& clip, const AnimationData& source, uint32_t subSteps = 4);
+	// 誤差が設定の許容誤差内か
+	bool IsWithinTolerance(const ErrorReport& error, const Settings& settings);
+
+	// 圧縮済みノードから指定時刻のSRTを求める。キーの無いトラックの値は変更しない
+	void SampleNode(const CompressedNodeAnimation& node, float sampleRate, float time,
+		NodeAnimationCursor& cursor, Vector3& outTranslation, Quaternion& outRotation, Vector3& outScale);
+
+	// 圧縮済みクリップのファイル入出力、元ファイルのハッシュが一致する時のみ読み込む
+	bool WriteCooked(const std::filesystem::path& path, uint64_t sourceHash, const std::vector<CookedClip>& clips);
+	bool ReadCooked(const std::filesystem::path& path, uint64_t sourceHash, std::vector<CookedClip>& outClips);
+
+	// 回転の量子化(smallest-three)
+	void QuantizeRotation(const Quaternion& rotation, uint16_t out[3]);
+	Quaternion DequantizeRotation(const uint16_t in[3]);
+}
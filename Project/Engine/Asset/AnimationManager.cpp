@@ -8,7 +8,8 @@
 #include <Engine/Core/Graphics/Descriptors/SRVDescriptor.h>
 #include <Engine/Core/Graphics/DxLib/DxUtils.h>
 #include <Engine/Asset/ModelLoader.h>
-#include <Engine/Asset/Filesystem.h>
+#include <Engine/Asset/AnimationCompression.h>
+#include <Engine/Asset/ModelCache.h>
 #include <Engine/Utility/Helper/Algorithm.h>
 
 //============================================================================
@@ -16,7 +17,8 @@
 //============================================================================
 
 void AnimationManager::Init(ID3D12Device* device,
-	SRVDescriptor* srvDescriptor, ModelLoader* modelLoader) {
+	SRVDescriptor* srvDescriptor, ModelLoader* modelLoader, AssetLoadScheduler* loadScheduler,
+	AssetRegistry* assetRegistry) {
 
 	device_ = nullptr;
 	device_ = device;
@@ -27,71 +29,122 @@ void AnimationManager::Init(ID3D12Device* device,
 	modelLoader_ = nullptr;
 	modelLoader_ = modelLoader;
 
-	baseDirectoryPath_ = "./Assets/Models/";
+	loadScheduler_ = nullptr;
+	loadScheduler_ = loadScheduler;
+
+	assetRegistry_ = nullptr;
+	assetRegistry_ = assetRegistry;
 
-	// ワーカースレッド起動
-	loadWorker_.Start([this](AnimationAsyncKey&& key) {
-		this->LoadAsync(std::move(key)); });
+	baseDirectoryPath_ = "./Assets/Models/";
+	// モデルと同じディレクトリなので登録済みなら走査されない
+	assetRegistry_->AddRoot(baseDirectoryPath_);
+	cookedDirectoryPath_ = "./Assets/Cooked/Animations/";
 }
 
-void AnimationManager::Load(const std::string& animationName, const std::string& modelName) {
+void AnimationManager::Load(const std::string& animationName, const std::string& modelName, bool useCompressed) {
 
-	RequestLoadAsync(animationName, modelName);
-	// モデルとアニメが来るまで待つ
-	for (;;) {
-		{
-			std::scoped_lock lk(animMutex_);
-			if (animations_.find(modelName) != animations_.end()) break;
-		}
-		std::this_thread::sleep_for(std::chrono::milliseconds(1));
-	}
+	// モデルとアニメの完了通知が来るまで待つ
+	RequestLoadAsync(animationName, modelName, AssetLoadPriority::Current, useCompressed).Wait();
 }
 
-void AnimationManager::RequestLoadAsync(const std::string& animationName, const std::string& modelName) {
+AssetLoadHandle AnimationManager::RequestLoadAsync(const std::string& animationName,
+	const std::string& modelName, AssetLoadPriority priority, bool useCompressed) {
 
-	auto& queue = loadWorker_.RefAsyncQueue();
+	// 骨を作るのにモデルが必要なので、モデルの読み込みが終わってから実行させる
+	return modelLoader_->RequestLoadAsync(modelName, priority).Then(
+		MakeJobKey(animationName, modelName), priority,
+		[this, key = AnimationAsyncKey{ animationName, modelName, useCompressed }]() { this->LoadAsync(key); });
+}
 
-	// 処理中のキューにあるなら処理させない
-	if (queue.IsClearCondition([&](const AnimationAsyncKey& j) {
-		return j.animName == animationName && j.modelName == modelName;
-		})) {
-		return;
-	}
-	// 重複チェック後にキューを追加
-	queue.AddQueue(AnimationAsyncKey{ animationName, modelName });
-	SpdLogger::Log("[Animation][Enqueue] anim:" + animationName + " model:" + modelName);
+AssetJobKey AnimationManager::MakeJobKey(const std::string& animationName, const std::string& modelName) {
+
+	return AssetJobKey{ AssetJobType::Animation, animationName + "/" + modelName };
 }
 
 void AnimationManager::WaitAll() {
 
-	for (;;) {
-		if (loadWorker_.GetAsyncQueue().IsEmpty()) {
-
-			break;
-		}
-		std::this_thread::sleep_for(std::chrono::milliseconds(1));
-	}
+	loadScheduler_->WaitIdle(AssetJobType::Animation);
 }
 
-void AnimationManager::LoadAsync(AnimationAsyncKey key) {
+void AnimationManager::LoadAsync(const AnimationAsyncKey& key) {
 
-	// 必要なモデルがまだ読み込みされていなければ処理しない
+	// モデルの読み込みが終わった後に呼ばれる、見つからなかった場合は処理しない
 	if (!modelLoader_->Search(key.modelName)) {
 
-		SpdLogger::Log("[Animation][WaitModel] anim:" + key.animName + " model:" + key.modelName);
-		std::this_thread::sleep_for(std::chrono::milliseconds(2));
-		loadWorker_.RefAsyncQueue().AddQueue(std::move(key));
+		SpdLogger::Log("[Animation][MissingModel] anim:" + key.animName + " model:" + key.modelName);
 		return;
 	}
 
+	// 読み込み開始
+	SpdLogger::Log("[Animation][Begin] anim:" + key.animName + " model:" + key.modelName);
+
 	std::filesystem::path filePath;
 	// 見つからなければ処理しない
-	if (!Filesystem::FindByStem(baseDirectoryPath_, key.animName, { ".gltf" }, filePath)) {
+	if (!assetRegistry_->FindByStem(baseDirectoryPath_, key.animName, { ".gltf" }, filePath)) {
 
 		SpdLogger::Log("[Animation][Missing] anim:" + key.animName);
 		return;
 	}
 
+	// 圧縮済みクリップが最新ならAssimpを通さずに読み込む
+	std::vector<AnimationCompression::CookedClip> cookedClips{};
+	std::unordered_map<std::string, AnimationData> localAnimations{};
+	const std::filesystem::path cookedPath = MakeCookedPath(key);
+	const uint64_t sourceHash = key.useCompressed ? ModelCache::HashSource(filePath, *assetRegistry_) : 0;
+	const bool isCooked = key.useCompressed &&
+		AnimationCompression::ReadCooked(cookedPath, sourceHash, cookedClips);
+	bool useCompressed = isCooked;
+	if (!isCooked) {
+
+		if (!ImportAnimations(filePath, key, localAnimations)) {
+			return;
+		}
+
+		// 圧縮して書き出し、次回以降はそちらを使う
+		if (key.useCompressed) {
+
+			useCompressed = CookClips(key, cookedPath, sourceHash, localAnimations, cookedClips);
+		}
+	}
+
+	// 読み込み完了
+	SpdLogger::Log("[Animation][Loaded] anim=" + key.animName + (isCooked ? " (cooked)" : ""));
+	{
+		std::scoped_lock lk(animMutex_);
+
+		// クラスター、骨データ作成
+		if (!skeletons_.contains(key.modelName)) {
+
+			skeletons_[key.modelName] = std::make_shared<const Skeleton>(
+				CreateSkeleton(modelLoader_->GetModelData(key.modelName).rootNode));
+		}
+		const Skeleton& skeleton = *skeletons_[key.modelName];
+		if (!skinClusters_.contains(key.modelName)) {
+
+			skinClusters_[key.modelName] = std::make_shared<const SkinCluster>(
+				CreateSkinCluster(key.modelName, skeleton));
+		}
+
+		// 骨のIndexで解決したクリップとして1つだけ保持する
+		if (useCompressed) {
+			for (auto& cookedClip : cookedClips) {
+
+				clips_[cookedClip.name] = std::make_shared<const AnimationClip>(CreateClip(std::move(cookedClip), skeleton));
+			}
+		} else {
+			for (auto& [name, animation] : localAnimations) {
+
+				clips_[name] = std::make_shared<const AnimationClip>(CreateClip(std::move(animation), skeleton));
+			}
+		}
+	}
+	SpdLogger::Log("[Animation][Registered] model:" + key.modelName + "animations:" +
+		std::to_string(useCompressed ? cookedClips.size() : localAnimations.size()));
+}
+
+bool AnimationManager::ImportAnimations(const std::filesystem::path& filePath,
+	const AnimationAsyncKey& key, std::unordered_map<std::string, AnimationData>& outAnimations) {
+
 	// アニメーションが存在していない場合はエラーにする
 	Assimp::Importer importer;
 	const aiScene* scene = importer.ReadFile(filePath.string(), 0);
@@ -99,11 +152,10 @@ void AnimationManager::LoadAsync(AnimationAsyncKey key) {
 
 		SpdLogger::Log("[Animation][NoClips] anim:" + key.animName);
 		ASSERT(FALSE, "[Animation][NoClips] anim:" + key.animName);
-		return;
+		return false;
 	}
 
 	// アニメーション解析処理
-	std::unordered_map<std::string, AnimationData> localAnimations{};
 	for (uint32_t i = 0; i < scene->mNumAnimations; ++i) {
 
 		aiAnimation* animAssimp = scene->mAnimations[i];
@@ -122,50 +174,61 @@ void AnimationManager::LoadAsync(AnimationAsyncKey key) {
 			for (uint32_t k = 0; k < nodeAnim->mNumPositionKeys; ++k) {
 
 				aiVectorKey& kv = nodeAnim->mPositionKeys[k];
-				KeyframeVector3 f; f.time = float(kv.mTime / animAssimp->mTicksPerSecond);
-				f.value = { -kv.mValue.x, kv.mValue.y, kv.mValue.z };
-				node.translate.keyframes.push_back(f);
+				node.translate.AddKey(float(kv.mTime / animAssimp->mTicksPerSecond),
+					Vector3(-kv.mValue.x, kv.mValue.y, kv.mValue.z));
 			}
 			// R
 			for (uint32_t k = 0; k < nodeAnim->mNumRotationKeys; ++k) {
 
 				aiQuatKey& kv = nodeAnim->mRotationKeys[k];
-				KeyframeQuaternion f; f.time = float(kv.mTime / animAssimp->mTicksPerSecond);
-				f.value = { kv.mValue.x, -kv.mValue.y, -kv.mValue.z, kv.mValue.w };
-				node.rotate.keyframes.push_back(f);
+				node.rotate.AddKey(float(kv.mTime / animAssimp->mTicksPerSecond),
+					Quaternion{ kv.mValue.x, -kv.mValue.y, -kv.mValue.z, kv.mValue.w });
 			}
 			// S
 			for (uint32_t k = 0; k < nodeAnim->mNumScalingKeys; ++k) {
 
 				aiVectorKey& kv = nodeAnim->mScalingKeys[k];
-				KeyframeVector3 f; f.time = float(kv.mTime / animAssimp->mTicksPerSecond);
-				f.value = { kv.mValue.x, kv.mValue.y, kv.mValue.z };
-				node.scale.keyframes.push_back(f);
+				node.scale.AddKey(float(kv.mTime / animAssimp->mTicksPerSecond),
+					Vector3(kv.mValue.x, kv.mValue.y, kv.mValue.z));
 			}
 		}
-		localAnimations.emplace(newName, std::move(anim));
+		outAnimations.emplace(newName, std::move(anim));
 	}
+	return true;
+}
 
-	// 読み込み完了
-	SpdLogger::Log("[Animation][Loaded] anim=" + key.animName);
-	{
-		std::scoped_lock lk(animMutex_);
-		for (auto& [name, animation] : localAnimations) {
+std::filesystem::path AnimationManager::MakeCookedPath(const AnimationAsyncKey& key) const {
 
-			animations_[name] = std::move(animation);
-		}
+	return std::filesystem::path(cookedDirectoryPath_) / key.modelName / (key.animName + ".canim");
+}
 
-		// クラスター、骨データ作成
-		if (!skeletons_.contains(key.modelName)) {
+bool AnimationManager::CookClips(const AnimationAsyncKey& key, const std::filesystem::path& cookedPath,
+	uint64_t sourceHash, const std::unordered_map<std::string, AnimationData>& animations,
+	std::vector<AnimationCompression::CookedClip>& outClips) {
 
-			skeletons_[key.modelName] = CreateSkeleton(modelLoader_->GetModelData(key.modelName).rootNode);
-		}
-		if (!skinClusters_.contains(key.modelName)) {
+	outClips.clear();
+	for (const auto& [name, animation] : animations) {
 
-			skinClusters_[key.modelName] = CreateSkinCluster(key.modelName, key.modelName);
+		AnimationCompression::CookedClip& clip = outClips.emplace_back(
+			AnimationCompression::Compress(name, animation, compressionSettings_));
+
+		// キー間も含めて元のカーブとの誤差を測り、許容誤差を超えたら圧縮しない
+		const AnimationCompression::ErrorReport error = AnimationCompression::MeasureError(clip, animation);
+		if (!AnimationCompression::IsWithinTolerance(error, compressionSettings_)) {
+
+			SpdLogger::Log("[Animation][CompressionError] anim:" + key.animName + " clip:" + name +
+				" T:" + std::to_string(error.translate) + " R:" + std::to_string(error.rotate) +
+				" S:" + std::to_string(error.scale));
+			outClips.clear();
+			return false;
 		}
 	}
-	SpdLogger::Log("[Animation][Registered] model:" + key.modelName + "animations:" + std::to_string(localAnimations.size()));
+
+	if (!AnimationCompression::WriteCooked(cookedPath, sourceHash, outClips)) {
+
+		SpdLogger::Log("[Animation][CookFailed] anim:" + key.animName);
+	}
+	return true;
 }
 
 Skeleton AnimationManager::CreateSkeleton(const Node& rootNode) {
@@ -206,15 +269,12 @@ int32_t AnimationManager::CreateJoint(const Node& node, const std::optional<int3
 	return joint.index;
 }
 
-SkinCluster AnimationManager::CreateSkinCluster(const std::string& modelName, const std::string& animationName) {
+SkinCluster AnimationManager::CreateSkinCluster(const std::string& modelName, const Skeleton& skeleton) {
 
 	SkinCluster skinCluster;
 
-	// size確保
-	skinCluster.mappedPalette.resize(skeletons_[animationName].joints.size());
-
 	// inverseBindPoseMatrixを格納する場所を作成して単位行列で埋める
-	skinCluster.inverseBindPoseMatrices.resize(skeletons_[animationName].joints.size());
+	skinCluster.inverseBindPoseMatrices.resize(skeleton.joints.size());
 	std::generate(skinCluster.inverseBindPoseMatrices.begin(), skinCluster.inverseBindPoseMatrices.end(),
 		[]() { return Matrix4x4::MakeIdentity4x4(); });
 
@@ -222,9 +282,9 @@ SkinCluster AnimationManager::CreateSkinCluster(const std::string& modelName, co
 	for (const auto& jointWeight : modelLoader_->GetModelData(modelName).skinClusterData) {
 
 		// jointWeight.firstはjoint名なので、skeletonに対象となるjointが含まれているか判断
-		auto it = skeletons_[animationName].jointMap.find(jointWeight.first);
+		auto it = skeleton.jointMap.find(jointWeight.first);
 		// 存在しないjoint名だったら次に進める
-		if (it == skeletons_[animationName].jointMap.end()) {
+		if (it == skeleton.jointMap.end()) {
 			continue;
 		}
 
@@ -235,19 +295,62 @@ SkinCluster AnimationManager::CreateSkinCluster(const std::string& modelName, co
 	return skinCluster;
 }
 
-const AnimationData& AnimationManager::GetAnimationData(const std::string& animationName) const {
+AnimationClip AnimationManager::CreateClip(AnimationData&& animation, const Skeleton& skeleton) {
+
+	AnimationClip clip{};
+	clip.duration = animation.duration;
+	clip.jointChannels.assign(skeleton.joints.size(), -1);
+	clip.channels.reserve(skeleton.joints.size());
+
+	// 骨に対応するノードのカーブのみ移す
+	for (const Joint& joint : skeleton.joints) {
+
+		auto it = animation.nodeAnimations.find(joint.name);
+		if (it == animation.nodeAnimations.end()) {
+			continue;
+		}
+		clip.jointChannels[joint.index] = static_cast<int32_t>(clip.channels.size());
+		clip.channels.emplace_back(std::move(it->second));
+	}
+	clip.channels.shrink_to_fit();
+	return clip;
+}
+
+AnimationClip AnimationManager::CreateClip(AnimationCompression::CookedClip&& cookedClip, const Skeleton& skeleton) {
+
+	AnimationClip clip{};
+	clip.duration = cookedClip.duration;
+	clip.sampleRate = cookedClip.sampleRate;
+	clip.jointChannels.assign(skeleton.joints.size(), -1);
+	clip.compressedChannels.reserve(skeleton.joints.size());
+
+	// 骨に対応するノードのトラックのみ移す
+	for (auto& [nodeName, node] : cookedClip.nodes) {
+
+		auto it = skeleton.jointMap.find(nodeName);
+		if (it == skeleton.jointMap.end()) {
+			continue;
+		}
+		clip.jointChannels[it->second] = static_cast<int32_t>(clip.compressedChannels.size());
+		clip.compressedChannels.emplace_back(std::move(node));
+	}
+	clip.compressedChannels.shrink_to_fit();
+	return clip;
+}
+
+std::shared_ptr<const AnimationClip> AnimationManager::GetAnimationClip(const std::string& animationName) const {
 
 	std::scoped_lock lk(animMutex_);
-	bool find = animations_.find(animationName) != animations_.end();
+	bool find = clips_.find(animationName) != clips_.end();
 	if (!find) {
 
 		LOG_WARN("not found animation", animationName);
 		ASSERT(find, "not found animation" + animationName);
 	}
-	return animations_.at(animationName);
+	return clips_.at(animationName);
 }
 
-const Skeleton& AnimationManager::GetSkeletonData(const std::string& animationName) const {
+std::shared_ptr<const Skeleton> AnimationManager::GetSkeletonData(const std::string& animationName) const {
 
 	std::scoped_lock lk(animMutex_);
 	bool find = skeletons_.find(animationName) != skeletons_.end();
@@ -259,7 +362,7 @@ const Skeleton& AnimationManager::GetSkeletonData(const std::string& animationNa
 	return skeletons_.at(animationName);
 }
 
-const SkinCluster& AnimationManager::GetSkinClusterData(const std::string& animationName) const {
+std::shared_ptr<const SkinCluster> AnimationManager::GetSkinClusterData(const std::string& animationName) const {
 
 	std::scoped_lock lk(animMutex_);
 	bool find = skinClusters_.find(animationName) != skinClusters_.end();
@@ -4,13 +4,16 @@
 //	include
 //============================================================================
 #include <Engine/Asset/AssetStructure.h>
-#include <Engine/Asset/Async/AssetLoadWorker.h>
+#include <Engine/Asset/Async/AssetLoadScheduler.h>
+#include <Engine/Asset/AssetRegistry.h>
+#include <Engine/Asset/AnimationCompression.h>
 
 // assimp
 #include <Externals/assimp/include/assimp/Importer.hpp>
 #include <Externals/assimp/include/assimp/postprocess.h>
 #include <Externals/assimp/include/assimp/scene.h>
 // c++
+#include <memory>
 #include <unordered_map>
 #include <unordered_set>
 // front
@@ -31,23 +34,30 @@ public:
 	~AnimationManager() = default;
 
 	// 初期化
-	void Init(ID3D12Device* device, SRVDescriptor* srvDescriptor, ModelLoader* modelLoader);
+	void Init(ID3D12Device* device, SRVDescriptor* srvDescriptor, ModelLoader* modelLoader,
+		AssetLoadScheduler* loadScheduler, AssetRegistry* assetRegistry);
 
 	// 読み込み処理
-	void Load(const std::string& animationName, const std::string& modelName);
-
-	// 非同期処理
-	void RequestLoadAsync(const std::string& animationName, const std::string& modelName);
+	// useCompressedがtrueなら圧縮済みクリップ(.canim)を使う、誤差を確認したクリップのみ有効にする
+	void Load(const std::string& animationName, const std::string& modelName, bool useCompressed = false);
+
+	// 非同期処理、モデルの読み込みも要求し、完了してから読み込む
+	// モデルのハンドルに後続ジョブとしてつなげ、アニメーションのハンドルを返す
+	// 同じアニメーションとモデルの組は最初の要求の設定で1度だけ読み込まれる
+	AssetLoadHandle RequestLoadAsync(const std::string& animationName, const std::string& modelName,
+		AssetLoadPriority priority = AssetLoadPriority::Current, bool useCompressed = false);
+	// スケジューラ上でのジョブの識別子
+	static AssetJobKey MakeJobKey(const std::string& animationName, const std::string& modelName);
 	// 起動中のスレッド待機
 	void WaitAll();
 
 	//--------- accessor -----------------------------------------------------
 
-	// 再生に必要なデータの取得
+	// 再生に必要なデータの取得。全インスタンスで共有される不変データ
 	// マップのキーから引数の値が見つからない場合ASSERT(LOG出力あり)
-	const AnimationData& GetAnimationData(const std::string& animationName) const;
-	const Skeleton& GetSkeletonData(const std::string& animationName) const;
-	const SkinCluster& GetSkinClusterData(const std::string& animationName) const;
+	std::shared_ptr<const AnimationClip> GetAnimationClip(const std::string& animationName) const;
+	std::shared_ptr<const Skeleton> GetSkeletonData(const std::string& animationName) const;
+	std::shared_ptr<const SkinCluster> GetSkinClusterData(const std::string& animationName) const;
 private:
 	//========================================================================
 	//	private Methods
@@ -60,6 +70,8 @@ private:
 
 		std::string animName;
 		std::string modelName;
+		// 圧縮済みクリップを使用するか、falseならAssimpのキーをそのまま使う
+		bool useCompressed = false;
 	};
 
 	//--------- variables ----------------------------------------------------
@@ -69,13 +81,19 @@ private:
 	ModelLoader* modelLoader_;
 
 	std::string baseDirectoryPath_;
+	// 圧縮済みクリップの出力先
+	std::string cookedDirectoryPath_;
+
+	// 圧縮の許容誤差、非可逆なのでシーンのjsonで指定されたクリップのみ圧縮する
+	AnimationCompression::Settings compressionSettings_{};
 
-	std::unordered_map<std::string, AnimationData> animations_;
-	std::unordered_map<std::string, Skeleton> skeletons_;
-	std::unordered_map<std::string, SkinCluster> skinClusters_;
+	std::unordered_map<std::string, std::shared_ptr<const AnimationClip>> clips_;
+	std::unordered_map<std::string, std::shared_ptr<const Skeleton>> skeletons_;
+	std::unordered_map<std::string, std::shared_ptr<const SkinCluster>> skinClusters_;
 
 	// 非同期処理
-	AssetLoadWorker<AnimationAsyncKey> loadWorker_;
+	AssetLoadScheduler* loadScheduler_;
+	AssetRegistry* assetRegistry_;
 	mutable std::mutex animMutex_;
 
 	//--------- functions ----------------------------------------------------
@@ -85,8 +103,21 @@ private:
 	// 再帰的にノードからジョイントを作成
 	int32_t CreateJoint(const Node& node, const std::optional<int32_t> parent, std::vector<Joint>& joints);
 	// スキンクラスターの作成
-	SkinCluster CreateSkinCluster(const std::string& modelName, const std::string& animationName);
+	SkinCluster CreateSkinCluster(const std::string& modelName, const Skeleton& skeleton);
+	// ノード名のカーブをjointIndexで引けるクリップに変換する
+	AnimationClip CreateClip(AnimationData&& animation, const Skeleton& skeleton);
+	AnimationClip CreateClip(AnimationCompression::CookedClip&& cookedClip, const Skeleton& skeleton);
+
+	// Assimpでアニメーションを読み込む
+	bool ImportAnimations(const std::filesystem::path& filePath,
+		const AnimationAsyncKey& key, std::unordered_map<std::string, AnimationData>& outAnimations);
+	// 圧縮済みクリップの出力先、クリップ名はモデル名を含むのでモデルごとに分ける
+	std::filesystem::path MakeCookedPath(const AnimationAsyncKey& key) const;
+	// 圧縮して許容誤差内なら書き出す。誤差を超えるクリップがあればfalse
+	bool CookClips(const AnimationAsyncKey& key, const std::filesystem::path& cookedPath, uint64_t sourceHash,
+		const std::unordered_map<std::string, AnimationData>& animations,
+		std::vector<AnimationCompression::CookedClip>& outClips);
 
 	// 非同期読み込み処理
-	void LoadAsync(AnimationAsyncKey key);
+	void LoadAsync(const AnimationAsyncKey& key);
 };
\ No newline at end of file
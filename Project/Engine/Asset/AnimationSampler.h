@@ -0,0 +1,115 @@
+#pragma once
+
+//============================================================================
+//	include
+//============================================================================
+#include <Engine/Asset/AssetStructure.h>
+
+// c++
+#include <algorithm>
+#include <type_traits>
+
+//============================================================================
+//	KeyframeCursor structure
+//	前回サンプリングした区間の先頭キーを覚えておく。
+//	再生時刻は連続して進むので、大半は同じ区間か次の区間で見つかる
+//============================================================================
+struct KeyframeCursor {
+
+	uint32_t index = 0;
+};
+
+//============================================================================
+//	NodeAnimationCursor structure
+//	1ノード分のSRTチャンネルのカーソル
+//============================================================================
+struct NodeAnimationCursor {
+
+	KeyframeCursor scale;
+	KeyframeCursor rotate;
+	KeyframeCursor translate;
+};
+
+//============================================================================
+//	AnimationSampler namespace
+//	AnimationCurveから指定時刻の値を求める。
+//	区間は「times[i] < time <= times[i + 1]」となる最初のiで、線形探索していた頃と同じ結果を返す
+//============================================================================
+namespace AnimationSampler {
+
+	// カーソルを使ってサンプリングする。外れた場合は二分探索で区間を求め直す
+	template <typename tValue>
+	tValue Sample(const AnimationCurve<tValue>& curve, float time, KeyframeCursor& cursor);
+
+	// カーソルを持たない呼び出し用(毎回二分探索)
+	template <typename tValue>
+	tValue Sample(const AnimationCurve<tValue>& curve, float time);
+
+	// 区間[index, index + 1]がtimeを含む最初の区間か
+	bool IsSegment(const std::vector<float>& times, uint32_t index, float time);
+}
+
+//============================================================================
+//	AnimationSampler templateMethods
+//============================================================================
+
+inline bool AnimationSampler::IsSegment(const std::vector<float>& times, uint32_t index, float time) {
+
+	if (times.size() <= static_cast<size_t>(index) + 1) {
+		return false;
+	}
+	// 先頭区間はtimes[0] < timeが呼び出し側で保証されている
+	return (index == 0 || times[index] < time) && time <= times[index + 1];
+}
+
+template <typename tValue>
+inline tValue AnimationSampler::Sample(const AnimationCurve<tValue>& curve, float time, KeyframeCursor& cursor) {
+
+	const std::vector<float>& times = curve.times;
+
+	// キーが1つか、時刻がキーフレーム前なら最初の値とする
+	if (times.size() == 1 || time <= times.front()) {
+
+		cursor.index = 0;
+		return curve.values.front();
+	}
+	// 1番後の時刻よりも後ろなので最後の値を返す
+	if (times.back() < time) {
+
+		cursor.index = static_cast<uint32_t>(times.size() - 1);
+		return curve.values.back();
+	}
+
+	// 前回の区間、次の区間の順で確認し、外れたら二分探索する
+	uint32_t index = cursor.index;
+	if (!IsSegment(times, index, time)) {
+		if (IsSegment(times, index + 1, time)) {
+
+			++index;
+		} else {
+
+			// time以上となる最初のキーの1つ前が区間の先頭
+			auto it = std::lower_bound(times.begin() + 1, times.end(), time);
+			index = static_cast<uint32_t>(std::distance(times.begin(), it)) - 1;
+		}
+	}
+	cursor.index = index;
+
+	// 範囲内を補完する
+	const uint32_t nextIndex = index + 1;
+	float t = (time - times[index]) / (times[nextIndex] - times[index]);
+	if constexpr (std::is_same_v<tValue, Quaternion>) {
+
+		return Quaternion::Slerp(curve.values[index], curve.values[nextIndex], t);
+	} else {
+
+		return tValue::Lerp(curve.values[index], curve.values[nextIndex], t);
+	}
+}
+
+template <typename tValue>
+inline tValue AnimationSampler::Sample(const AnimationCurve<tValue>& curve, float time) {
+
+	KeyframeCursor cursor{};
+	return Sample(curve, time, cursor);
+}
@@ -14,14 +14,25 @@
 
 void Asset::Init(ID3D12Device* device, DxCommand* dxCommand, SRVDescriptor* srvDescriptor) {
 
+	// 前回の索引を読み込み、各マネージャの初期化時に変わったところのみ走査させる
+	assetRegistry_ = std::make_unique<AssetRegistry>();
+	assetRegistry_->Init("./Assets/Cooked/AssetIndex.bin");
+
+	// 全ての読み込みで共有するワーカー
+	loadScheduler_ = std::make_unique<AssetLoadScheduler>();
+	loadScheduler_->Init();
+
 	textureManager_ = std::make_unique<TextureManager>();
-	textureManager_->Init(device, dxCommand, srvDescriptor);
+	textureManager_->Init(device, dxCommand, srvDescriptor, loadScheduler_.get(), assetRegistry_.get());
 
 	modelLoader_ = std::make_unique<ModelLoader>();
-	modelLoader_->Init(textureManager_.get());
+	modelLoader_->Init(textureManager_.get(), loadScheduler_.get(), assetRegistry_.get());
 
 	animationManager_ = std::make_unique<AnimationManager>();
-	animationManager_->Init(device, srvDescriptor, modelLoader_.get());
+	animationManager_->Init(device, srvDescriptor, modelLoader_.get(), loadScheduler_.get(), assetRegistry_.get());
+
+	// 次回の起動で使う
+	assetRegistry_->Save();
 }
 
 void Asset::ReportUsage(bool listAll) const {
@@ -33,8 +44,8 @@ void Asset::ReportUsage(bool listAll) const {
 
 void Asset::PumpAsyncLoads() {
 
-	// 最大数分の件数を毎フレーム実行
-	size_t executed = 0;
+	// 上限の時間まで毎フレーム実行、重い処理はワーカー側で行うので投入のみ
+	const auto begin = std::chrono::steady_clock::now();
 	for (;;) {
 
 		std::function<void()> task;
@@ -47,11 +58,60 @@ void Asset::PumpAsyncLoads() {
 			pendingLoads_.pop_front();
 		}
 		task();
-		executed++;
-		if (maxCountPerFrame_ <= executed) {
+
+		const float elapsed = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - begin).count();
+		if (maxMillisecondsPerFrame_ <= elapsed) {
 			break;
 		}
 	}
+
+	// 読み込みが終わったシーンの時間を出力する
+	for (auto& [scene, preload] : preload_) {
+		if (!preload.isTimeReported && IsScenePreloadFinished(scene)) {
+
+			ReportPreloadTime(preload);
+		}
+	}
+}
+
+void Asset::PrioritizeScene(Scene scene) {
+
+	// これから投入するものは高い優先度で投入される
+	prioritizedScene_ = scene;
+
+	// 投入済みのものは列を移す
+	auto it = preload_.find(scene);
+	if (it == preload_.end()) {
+		return;
+	}
+	const auto& load = it->second;
+	for (const auto& texture : load.textures) {
+
+		loadScheduler_->Promote({ AssetJobType::Texture, texture }, AssetLoadPriority::Current);
+	}
+	for (const auto& model : load.models) {
+
+		loadScheduler_->Promote({ AssetJobType::Model, model }, AssetLoadPriority::Current);
+	}
+	for (const auto& [animation, model] : load.animations) {
+
+		loadScheduler_->Promote(AnimationManager::MakeJobKey(animation, model), AssetLoadPriority::Current);
+	}
+}
+
+AssetLoadPriority Asset::GetPriority(Scene scene) const {
+
+	return prioritizedScene_ == scene ? AssetLoadPriority::Current : AssetLoadPriority::Next;
+}
+
+void Asset::ReportPreloadTime(ScenePreload& preload) {
+
+	preload.isTimeReported = true;
+	const float milliseconds = std::chrono::duration<float, std::milli>(
+		std::chrono::steady_clock::now() - preload.beginTime).count();
+	LOG_ASSET_INFO("[Asset][Preload] {}: {} assets, {:.2f}ms (workers: {})",
+		EnumAdapter<Scene>::ToString(preload.scene), preload.total, milliseconds,
+		loadScheduler_->GetWorkerCount());
 }
 
 bool Asset::IsScenePreloadFinished(Scene scene) const {
@@ -71,26 +131,26 @@ float Asset::GetScenePreloadProgress(Scene scene) const {
 	if (load.total == 0) {
 		return 1.0f;
 	}
-	// 読み込み済み
+	// 読み込み済み、見つからなかったものも終わったものとして数える
 	uint32_t ready = 0;
 
 	// テクスチャ
 	for (const auto& t : load.textures) {
-		if (textureManager_->Search(t)) {
+		if (loadScheduler_->IsCompleted({ AssetJobType::Texture, t })) {
 
 			++ready;
 		}
 	}
 	// モデル
 	for (const auto& m : load.models) {
-		if (modelLoader_->Search(m)) {
+		if (loadScheduler_->IsCompleted({ AssetJobType::Model, m })) {
 
 			++ready;
 		}
 	}
 
 	for (const auto& [anim, model] : load.animations) {
-		if (modelLoader_->Search(model)) {
+		if (loadScheduler_->IsCompleted(AnimationManager::MakeJobKey(anim, model))) {
 
 			++ready;
 		}
@@ -99,7 +159,7 @@ float Asset::GetScenePreloadProgress(Scene scene) const {
 	return std::clamp(progress, 0.0f, 1.0f);
 }
 
-std::vector<std::function<void()>> Asset::SetTask(const Json& data, AssetLoadType loadType) {
+std::vector<std::function<void()>> Asset::SetTask(const Json& data, Scene scene) {
 
 	std::vector<std::function<void()>> tasks{};
 	// texture
@@ -108,13 +168,8 @@ std::vector<std::function<void()>> Asset::SetTask(const Json& data, AssetLoadTyp
 			for (auto& name : data["Textures"]) {
 
 				std::string texture = name.get<std::string>();
-				if (loadType == AssetLoadType::Synch) {
-
-					tasks.emplace_back([this, texture]() { this->textureManager_->LoadSynch(texture); });
-				} else if (loadType == AssetLoadType::Async) {
-
-					tasks.emplace_back([this, texture]() { this->textureManager_->RequestLoadAsync(texture); });
-				}
+				tasks.emplace_back([this, scene, texture]() {
+					this->textureManager_->RequestLoadAsync(texture, GetPriority(scene)); });
 			}
 		}
 	}
@@ -124,13 +179,8 @@ std::vector<std::function<void()>> Asset::SetTask(const Json& data, AssetLoadTyp
 			for (auto& name : data["Models"]) {
 
 				std::string model = name.get<std::string>();
-				if (loadType == AssetLoadType::Synch) {
-
-					tasks.emplace_back([this, model]() { this->modelLoader_->LoadSynch(model); });
-				} else if (loadType == AssetLoadType::Async) {
-
-					tasks.emplace_back([this, model]() { this->modelLoader_->RequestLoadAsync(model); });
-				}
+				tasks.emplace_back([this, scene, model]() {
+					this->modelLoader_->RequestLoadAsync(model, GetPriority(scene)); });
 			}
 		}
 	}
@@ -141,7 +191,10 @@ std::vector<std::function<void()>> Asset::SetTask(const Json& data, AssetLoadTyp
 
 				std::string model = a["model"].get<std::string>();
 				std::string animation = a["animation"].get<std::string>();
-				tasks.emplace_back([this, animation, model]() { this->animationManager_->RequestLoadAsync(animation, model); });
+				// 誤差を確認したクリップのみ圧縮済みのデータを使う
+				bool compressed = a.value("compressed", false);
+				tasks.emplace_back([this, scene, animation, model, compressed]() {
+					this->animationManager_->RequestLoadAsync(animation, model, GetPriority(scene), compressed); });
 			}
 		}
 	}
@@ -164,12 +217,23 @@ void Asset::LoadSceneAsync(Scene scene, AssetLoadType loadType) {
 		ASSERT(FALSE, "sceneFile not found: " + fileName);
 	}
 
+	// 前回のシーン読み込みから追加/削除されたファイルを索引に反映する
+	assetRegistry_->Refresh();
+
+	// 同期読み込みは今のシーンとして優先する
+	if (loadType == AssetLoadType::Synch) {
+
+		prioritizedScene_ = scene;
+	}
+
 	//	タスク処理設定
-	std::vector<std::function<void()>> tasks = SetTask(data, loadType);
+	std::vector<std::function<void()>> tasks = SetTask(data, scene);
 
 	// 同期、非同期読み込み処理振り分け
 	auto& info = preload_[scene];
 	info.scene = scene;
+	info.beginTime = std::chrono::steady_clock::now();
+	info.isTimeReported = false;
 
 	// 必要なデータの名前を取得
 	if (data.contains("Textures") && data["Textures"].is_array()) {
@@ -191,15 +255,36 @@ void Asset::LoadSceneAsync(Scene scene, AssetLoadType loadType) {
 				animation["model"].get<std::string>());
 		}
 	}
+	if (data.contains("Particles") && data["Particles"].is_array()) {
+		for (const auto& particle : data["Particles"]) {
+
+			info.particles.emplace_back(particle["path"].get<std::string>(),
+				particle.value("count", 1u));
+		}
+	}
 	// リソース合計数
 	info.total = static_cast<uint32_t>(info.textures.size() + info.models.size() + info.animations.size());
 
-	// 同期読み込み処理
+	// 同期読み込み処理、全て投入してワーカーで並列に読み込ませ、終わるまで待つ
 	if (loadType == AssetLoadType::Synch) {
 		for (auto& task : tasks) {
 
 			task();
 		}
+		// 各ジョブの完了通知を待つ、待っている間はこのスレッドも読み込みを処理する
+		for (const auto& texture : info.textures) {
+
+			loadScheduler_->Wait({ AssetJobType::Texture, texture });
+		}
+		for (const auto& model : info.models) {
+
+			loadScheduler_->Wait({ AssetJobType::Model, model });
+		}
+		for (const auto& [animation, model] : info.animations) {
+
+			loadScheduler_->Wait(AnimationManager::MakeJobKey(animation, model));
+		}
+		ReportPreloadTime(info);
 		return;
 	}
 	{
@@ -207,7 +292,7 @@ void Asset::LoadSceneAsync(Scene scene, AssetLoadType loadType) {
 		std::scoped_lock lock(asyncMutex_);
 		for (auto& task : tasks) {
 
-			pendingLoads_.emplace_back([this, scene, task]() {task(); });
+			pendingLoads_.emplace_back(std::move(task));
 		}
 	}
 }
@@ -234,6 +319,11 @@ void Asset::LoadModel(const std::string& modelName, AssetLoadType loadType) {
 	}
 }
 
+AssetLoadHandle Asset::RequestModelAsync(const std::string& modelName, AssetLoadPriority priority) {
+
+	return modelLoader_->RequestLoadAsync(modelName, priority);
+}
+
 void Asset::LoadAnimation(const std::string& animationName, const std::string& modelName) {
 	animationManager_->Load(animationName, modelName);
 }
@@ -284,14 +374,24 @@ const std::vector<std::string>& Asset::GetPreloadModels(Scene scene) const {
 	return it->second.models;
 }
 
-const AnimationData& Asset::GetAnimationData(const std::string& animationName) const {
-	return animationManager_->GetAnimationData(animationName);
+const std::vector<std::pair<std::string, uint32_t>>& Asset::GetPreloadParticles(Scene scene) const {
+
+	static const std::vector<std::pair<std::string, uint32_t>> kEmpty;
+	auto it = preload_.find(scene);
+	if (it == preload_.end()) {
+		return kEmpty;
+	}
+	return it->second.particles;
+}
+
+std::shared_ptr<const AnimationClip> Asset::GetAnimationClip(const std::string& animationName) const {
+	return animationManager_->GetAnimationClip(animationName);
 }
 
-const Skeleton& Asset::GetSkeletonData(const std::string& animationName) const {
+std::shared_ptr<const Skeleton> Asset::GetSkeletonData(const std::string& animationName) const {
 	return animationManager_->GetSkeletonData(animationName);
 }
 
-const SkinCluster& Asset::GetSkinClusterData(const std::string& animationName) const {
+std::shared_ptr<const SkinCluster> Asset::GetSkinClusterData(const std::string& animationName) const {
 	return animationManager_->GetSkinClusterData(animationName);
 }
\ No newline at end of file
@@ -7,6 +7,8 @@
 #include <Engine/Asset/ModelLoader.h>
 #include <Engine/Asset/AnimationManager.h>
 #include <Engine/Asset/AssetLoadType.h>
+#include <Engine/Asset/Async/AssetLoadScheduler.h>
+#include <Engine/Asset/AssetRegistry.h>
 #include <Engine/Scene/Methods/IScene.h>
 
 // c++
@@ -15,6 +17,7 @@
 #include <functional>
 #include <deque>
 #include <cctype>
+#include <chrono>
 
 //============================================================================
 //	Asset class
@@ -38,18 +41,26 @@ public:
 	//--------- loading ------------------------------------------------------
 
 	// シーンに紐づくアセット定義(json)を読み取り、同期または非同期でロードする
+	// 同期の場合も並列に読み込み、全て終わるまで待機する。非同期の場合は先読みとして低い優先度で読み込む
 	void LoadSceneAsync(Scene scene, AssetLoadType loadType);
-	//  キューされた非同期タスクを1フレームあたりの上限数まで実行する
+	// キューされた非同期タスクを1フレームあたりの時間の上限まで実行し、終わったシーンの読み込み時間を出力する
 	void PumpAsyncLoads();
+	// 次に使うシーンの読み込みを先読みより優先させる
+	void PrioritizeScene(Scene scene);
 
 	// 個別資産のロード要求(同期/非同期)
 	void LoadTexture(const std::string& textureName, AssetLoadType loadType);
 	void LoadModel(const std::string& modelName, AssetLoadType loadType);
+	// モデルの非同期読み込みを投入し、完了待ちや後続ジョブの接続に使うハンドルを返す
+	AssetLoadHandle RequestModelAsync(const std::string& modelName, AssetLoadPriority priority);
 	// アニメーションをモデルに対して読み込む(同期)
 	void LoadAnimation(const std::string& animationName, const std::string& modelName);
 	
 	//--------- accessor -----------------------------------------------------
 
+	// 共有の読み込みスケジューラ
+	AssetLoadScheduler* GetLoadScheduler() const { return loadScheduler_.get(); }
+
 	//  シーンのプリロードが完了しているかを返す
 	bool IsScenePreloadFinished(Scene scene) const;
 	// シーンのプリロード進捗を0.0f〜1.0fで返す
@@ -74,15 +85,17 @@ public:
 	const std::vector<std::string>& GetModelKeys() const;
 	// プリロード対象モデル名リストを取得する
 	const std::vector<std::string>& GetPreloadModels(Scene scene) const;
+	// シーンで事前に作成しておくパーティクルのファイルと数を取得する
+	const std::vector<std::pair<std::string, uint32_t>>& GetPreloadParticles(Scene scene) const;
 	// モデルが読み込み済みかを確認する
 	bool SearchModel(const std::string& modelName);
 
 	//--------- animation ----------------------------------------------------
 
 	// 描画に必要なアニメーション/スケルトン/スキンクラスタ情報を取得する
-	const AnimationData& GetAnimationData(const std::string& animationName) const;
-	const Skeleton& GetSkeletonData(const std::string& animationName) const;
-	const SkinCluster& GetSkinClusterData(const std::string& animationName) const;
+	std::shared_ptr<const AnimationClip> GetAnimationClip(const std::string& animationName) const;
+	std::shared_ptr<const Skeleton> GetSkeletonData(const std::string& animationName) const;
+	std::shared_ptr<const SkinCluster> GetSkinClusterData(const std::string& animationName) const;
 private:
 	//========================================================================
 	//	private Methods
@@ -99,17 +112,30 @@ private:
 		std::vector<std::string> textures;
 		std::vector<std::string> models;
 		std::vector<std::pair<std::string, std::string>> animations;
+		// ParticleManagerのプールに作成しておくファイルと数、読み込み数には含めない
+		std::vector<std::pair<std::string, uint32_t>> particles;
+
+		// 読み込みにかかった時間の計測
+		std::chrono::steady_clock::time_point beginTime;
+		bool isTimeReported = false;
 	};
 
 	//--------- variables ----------------------------------------------------
 
+	// 名前からファイルを引く索引、各マネージャから参照されるので最後に破棄されるよう最初に置く
+	std::unique_ptr<AssetRegistry> assetRegistry_;
+
 	// assetを管理する
 	std::unique_ptr<TextureManager> textureManager_;
 	std::unique_ptr<ModelLoader> modelLoader_;
 	std::unique_ptr<AnimationManager> animationManager_;
+	// 各マネージャの読み込みジョブを参照するので最初に破棄されるよう最後に置く
+	std::unique_ptr<AssetLoadScheduler> loadScheduler_;
 
-	// 1フレームで処理される読み込みスレッド数
-	const uint32_t maxCountPerFrame_ = 1;
+	// 1フレームで読み込み要求の投入にかける時間(ms)
+	const float maxMillisecondsPerFrame_ = 2.0f;
+	// 優先して読み込むシーン
+	std::optional<Scene> prioritizedScene_;
 
 	std::mutex asyncMutex_;
 	std::deque<std::function<void()>> pendingLoads_;  // 実行待ちタスク
@@ -118,6 +144,10 @@ private:
 	//--------- functions ----------------------------------------------------
 
 	// helper
-	// jsonからロードタスク群を構築し、同期/非同期方針に合わせた関数オブジェクトを返す
-	std::vector<std::function<void()>> SetTask(const Json& data, AssetLoadType loadType);
+	// jsonからロードタスク群を構築する。投入時のシーンの優先度で読み込みを要求する関数オブジェクトを返す
+	std::vector<std::function<void()>> SetTask(const Json& data, Scene scene);
+	// シーンの優先度
+	AssetLoadPriority GetPriority(Scene scene) const;
+	// 読み込みが終わったシーンの経過時間を出力する
+	void ReportPreloadTime(ScenePreload& preload);
 };
\ No newline at end of file
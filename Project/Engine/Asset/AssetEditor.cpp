@@ -53,8 +53,8 @@ void AssetEditor::BuildDirectoryTree(bool runTime) {
 			const auto& p = entry.path();
 			const std::string filename = p.filename().string();
 
-			// Engineフォルダは完全に無視
-			if (entry.is_directory() && filename == "Engine") {
+			// Engineフォルダと、読み込み時に生成されるCookedフォルダは完全に無視
+			if (entry.is_directory() && (filename == "Engine" || filename == "Cooked")) {
 				continue;
 			}
 
@@ -0,0 +1,543 @@
+#include "AssetRegistry.h"
+
+//============================================================================
+//	include
+//============================================================================
+#include <Engine/Core/Debug/SpdLogger.h>
+
+// c++
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <unordered_set>
+
+//============================================================================
+//	AssetRegistry classMethods
+//============================================================================
+
+namespace {
+
+	// ファイル識別子とバージョン
+	constexpr uint32_t kIndexMagic = 0x58444941; // "AIDX"
+	constexpr uint32_t kIndexVersion = 1;
+
+	// FNV-1a 64bit
+	constexpr uint64_t kHashOffset = 14695981039346656037ull;
+	constexpr uint64_t kHashPrime = 1099511628211ull;
+
+	// 比較に使うため、区切り文字と末尾をそろえた文字列にする
+	std::string MakeKey(const std::filesystem::path& path) {
+
+		std::string key = path.lexically_normal().generic_string();
+		if (1 < key.size() && key.back() == '/') {
+
+			key.pop_back();
+		}
+		return key;
+	}
+
+	int64_t ToTicks(std::filesystem::file_time_type time) {
+
+		return static_cast<int64_t>(time.time_since_epoch().count());
+	}
+
+	// 取得できなければ0
+	int64_t GetWriteTime(const std::filesystem::path& path) {
+
+		std::error_code error;
+		const auto time = std::filesystem::last_write_time(path, error);
+		return error ? 0 : ToTicks(time);
+	}
+
+	uint64_t HashFile(const std::filesystem::path& path) {
+
+		std::ifstream file(path, std::ios::binary);
+		if (!file) {
+			return 0;
+		}
+
+		uint64_t hash = kHashOffset;
+		std::vector<char> buffer(1 << 16);
+		while (file) {
+
+			file.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+			const std::streamsize count = file.gcount();
+			for (std::streamsize i = 0; i < count; ++i) {
+
+				hash ^= static_cast<uint8_t>(buffer[i]);
+				hash *= kHashPrime;
+			}
+		}
+		// 0は未計算に使うので避ける
+		return hash == 0 ? 1 : hash;
+	}
+
+	//--------- serialize ----------------------------------------------------
+
+	template <typename T>
+	void WriteValue(std::ofstream& file, const T& value) {
+
+		file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+	void WriteString(std::ofstream& file, const std::string& value) {
+
+		WriteValue(file, static_cast<uint32_t>(value.size()));
+		file.write(value.data(), static_cast<std::streamsize>(value.size()));
+	}
+
+	// 範囲を確認しながら読む
+	struct Reader {
+
+		const std::vector<char>& data;
+		size_t offset = 0;
+
+		template <typename T>
+		bool Read(T& value) {
+
+			if (data.size() < offset + sizeof(T)) {
+				return false;
+			}
+			std::memcpy(&value, data.data() + offset, sizeof(T));
+			offset += sizeof(T);
+			return true;
+		}
+		bool ReadString(std::string& value) {
+
+			uint32_t size = 0;
+			if (!Read(size) || data.size() < offset + size) {
+				return false;
+			}
+			value.assign(data.data() + offset, size);
+			offset += size;
+			return true;
+		}
+	};
+}
+
+AssetRegistry::~AssetRegistry() {
+
+	Save();
+}
+
+void AssetRegistry::Init(const std::filesystem::path& indexPath) {
+
+	std::scoped_lock lock(mutex_);
+
+	indexPath_ = indexPath;
+	roots_.clear();
+	files_.clear();
+	isDirty_ = false;
+
+	// 壊れている、古い場合は全て走査し直す
+	if (!ReadIndexLocked()) {
+
+		roots_.clear();
+		files_.clear();
+	}
+}
+
+void AssetRegistry::AddRoot(const std::filesystem::path& root) {
+
+	std::scoped_lock lock(mutex_);
+	AddRootLocked(root);
+}
+
+void AssetRegistry::Refresh() {
+
+	std::scoped_lock lock(mutex_);
+	for (auto& [key, root] : roots_) {
+		if (root.isValidated) {
+
+			RefreshRootLocked(root);
+		}
+	}
+}
+
+void AssetRegistry::Save() {
+
+	std::scoped_lock lock(mutex_);
+	if (!isDirty_ || indexPath_.empty()) {
+		return;
+	}
+	if (WriteIndexLocked()) {
+
+		isDirty_ = false;
+	}
+}
+
+bool AssetRegistry::FindByStem(const std::filesystem::path& root, const std::string& stem,
+	const std::vector<std::string>& extensions, std::filesystem::path& outPath) {
+
+	std::scoped_lock lock(mutex_);
+
+	Root& rootIndex = AddRootLocked(root);
+	if (const AssetFileEntry* file = FindLocked(rootIndex, stem, extensions)) {
+
+		std::error_code error;
+		if (std::filesystem::is_regular_file(file->path, error)) {
+
+			outPath = file->path;
+			return true;
+		}
+	}
+
+	// 見つからない、または消えていた場合は追加/削除があったディレクトリを走査し直して引き直す
+	RefreshRootLocked(rootIndex);
+	if (const AssetFileEntry* file = FindLocked(rootIndex, stem, extensions)) {
+
+		outPath = file->path;
+		return true;
+	}
+	return false;
+}
+
+uint64_t AssetRegistry::GetContentHash(const std::filesystem::path& path) {
+
+	std::error_code error;
+	const uint64_t size = std::filesystem::file_size(path, error);
+	if (error) {
+		return 0;
+	}
+	const int64_t writeTime = GetWriteTime(path);
+	const std::string key = MakeKey(path);
+	{
+		std::scoped_lock lock(mutex_);
+		auto it = files_.find(key);
+		if (it != files_.end() && it->second.contentHash != 0 &&
+			it->second.size == size && it->second.writeTime == writeTime) {
+
+			return it->second.contentHash;
+		}
+	}
+
+	// 読み込みは並列に行えるようにロックの外で行う
+	const uint64_t hash = HashFile(path);
+	if (hash == 0) {
+		return 0;
+	}
+
+	std::scoped_lock lock(mutex_);
+	AssetFileEntry& file = files_[key];
+	if (file.path.empty()) {
+
+		file.path = path.lexically_normal();
+		file.extension = file.path.extension().string();
+	}
+	file.size = size;
+	file.writeTime = writeTime;
+	file.contentHash = hash;
+	isDirty_ = true;
+	return hash;
+}
+
+std::vector<std::string> AssetRegistry::CollectStems(const std::filesystem::path& root,
+	const std::vector<std::string>& extensions) const {
+
+	std::scoped_lock lock(mutex_);
+
+	std::vector<std::string> stems;
+	auto it = roots_.find(MakeKey(root));
+	if (it == roots_.end()) {
+		return stems;
+	}
+	for (const auto& [stem, keys] : it->second.stems) {
+		if (FindLocked(it->second, stem, extensions)) {
+
+			stems.emplace_back(stem);
+		}
+	}
+	return stems;
+}
+
+std::vector<std::filesystem::path> AssetRegistry::CollectFiles(const std::filesystem::path& root,
+	const std::vector<std::string>& extensions) const {
+
+	std::scoped_lock lock(mutex_);
+
+	std::vector<std::filesystem::path> paths;
+	auto it = roots_.find(MakeKey(root));
+	if (it == roots_.end()) {
+		return paths;
+	}
+	for (const auto& [stem, keys] : it->second.stems) {
+		for (const auto& key : keys) {
+
+			auto file = files_.find(key);
+			if (file != files_.end() && std::find(extensions.begin(), extensions.end(),
+				file->second.extension) != extensions.end()) {
+
+				paths.emplace_back(file->second.path);
+			}
+		}
+	}
+	return paths;
+}
+
+void AssetRegistry::ScanDirectoryLocked(Root& root, const std::filesystem::path& directory,
+	std::unordered_map<std::string, AssetFileEntry>& previous) {
+
+	std::error_code error;
+	for (std::filesystem::directory_iterator it(directory, error), end; !error && it != end; it.increment(error)) {
+
+		const auto& entry = *it;
+		std::error_code entryError;
+		if (entry.is_directory(entryError)) {
+
+			// 登録済みのサブディレクトリは別に検証される
+			if (!root.directories.contains(MakeKey(entry.path()))) {
+
+				ScanDirectoryLocked(root, entry.path(), previous);
+			}
+			continue;
+		}
+		if (!entry.is_regular_file(entryError)) {
+			continue;
+		}
+
+		// 走査で得られる情報のみ使い、ファイルは開かない
+		AssetFileEntry file{};
+		file.path = entry.path().lexically_normal();
+		file.extension = file.path.extension().string();
+		file.size = entry.file_size(entryError);
+		file.writeTime = ToTicks(entry.last_write_time(entryError));
+
+		// 内容が変わっていなければハッシュを引き継ぐ
+		const std::string key = MakeKey(file.path);
+		auto keep = [&](const AssetFileEntry& old) {
+			if (old.size == file.size && old.writeTime == file.writeTime) {
+
+				file.contentHash = old.contentHash;
+			}
+			};
+		if (auto old = previous.find(key); old != previous.end()) {
+
+			keep(old->second);
+		} else if (auto existing = files_.find(key); existing != files_.end()) {
+
+			keep(existing->second);
+		}
+
+		root.stems[file.path.stem().string()].emplace_back(key);
+		files_[key] = std::move(file);
+	}
+	root.directories[MakeKey(directory)] = GetWriteTime(directory);
+	isDirty_ = true;
+}
+
+AssetRegistry::Root& AssetRegistry::AddRootLocked(const std::filesystem::path& rootPath) {
+
+	const std::string key = MakeKey(rootPath);
+	Root& root = roots_[key];
+	if (root.isValidated) {
+		return root;
+	}
+
+	const auto begin = std::chrono::steady_clock::now();
+	// 保存済みなら変わったところのみ、無ければ全て走査する
+	const bool isWarm = !root.directories.empty();
+	if (isWarm) {
+
+		RefreshRootLocked(root);
+	} else {
+
+		std::unordered_map<std::string, AssetFileEntry> previous;
+		ScanDirectoryLocked(root, rootPath, previous);
+	}
+	root.isValidated = true;
+
+	size_t fileCount = 0;
+	for (const auto& [stem, keys] : root.stems) {
+
+		fileCount += keys.size();
+	}
+	const float milliseconds = std::chrono::duration<float, std::milli>(
+		std::chrono::steady_clock::now() - begin).count();
+	LOG_INFO("assetRegistry: {}: {} files, {} directories, {:.2f}ms ({})",
+		key, fileCount, root.directories.size(), milliseconds, isWarm ? "warm" : "cold");
+	return root;
+}
+
+void AssetRegistry::RefreshRootLocked(Root& root) {
+
+	// ファイルの追加/削除/名前変更でディレクトリの更新時刻が変わる
+	std::unordered_set<std::string> changed;
+	for (const auto& [key, writeTime] : root.directories) {
+		if (GetWriteTime(key) != writeTime || writeTime == 0) {
+
+			changed.emplace(key);
+		}
+	}
+	if (changed.empty()) {
+		return;
+	}
+
+	// 変わったディレクトリ直下のファイルを一度外す、内容が同じものは走査後にハッシュを引き継ぐ
+	std::unordered_map<std::string, AssetFileEntry> previous;
+	for (auto& [stem, keys] : root.stems) {
+
+		std::erase_if(keys, [&](const std::string& key) {
+			auto it = files_.find(key);
+			if (it == files_.end()) {
+				return true;
+			}
+			if (!changed.contains(MakeKey(it->second.path.parent_path()))) {
+				return false;
+			}
+			previous.emplace(key, std::move(it->second));
+			files_.erase(it);
+			return true;
+			});
+	}
+	std::erase_if(root.stems, [](const auto& pair) { return pair.second.empty(); });
+
+	for (const auto& key : changed) {
+
+		root.directories.erase(key);
+	}
+	for (const auto& key : changed) {
+
+		// 消えたディレクトリは外したまま、残っているものは直下を走査し直す
+		std::error_code error;
+		if (std::filesystem::is_directory(key, error) && !root.directories.contains(key)) {
+
+			ScanDirectoryLocked(root, key, previous);
+		}
+	}
+	isDirty_ = true;
+}
+
+const AssetFileEntry* AssetRegistry::FindLocked(const Root& root, const std::string& stem,
+	const std::vector<std::string>& extensions) const {
+
+	auto it = root.stems.find(stem);
+	if (it == root.stems.end()) {
+		return nullptr;
+	}
+	for (const auto& extension : extensions) {
+		for (const auto& key : it->second) {
+
+			auto file = files_.find(key);
+			if (file != files_.end() && file->second.extension == extension) {
+
+				return &file->second;
+			}
+		}
+	}
+	return nullptr;
+}
+
+bool AssetRegistry::ReadIndexLocked() {
+
+	std::ifstream file(indexPath_, std::ios::binary | std::ios::ate);
+	if (!file) {
+		return false;
+	}
+	std::vector<char> data(static_cast<size_t>(file.tellg()));
+	file.seekg(0);
+	file.read(data.data(), static_cast<std::streamsize>(data.size()));
+
+	Reader reader{ data };
+	uint32_t magic = 0;
+	uint32_t version = 0;
+	if (!reader.Read(magic) || !reader.Read(version) ||
+		magic != kIndexMagic || version != kIndexVersion) {
+		return false;
+	}
+
+	// ディレクトリ
+	std::unordered_map<std::string, Root*> owners;
+	uint32_t rootCount = 0;
+	if (!reader.Read(rootCount)) {
+		return false;
+	}
+	for (uint32_t i = 0; i < rootCount; ++i) {
+
+		std::string rootKey;
+		uint32_t directoryCount = 0;
+		if (!reader.ReadString(rootKey) || !reader.Read(directoryCount)) {
+			return false;
+		}
+		Root& root = roots_[rootKey];
+		for (uint32_t j = 0; j < directoryCount; ++j) {
+
+			std::string key;
+			int64_t writeTime = 0;
+			if (!reader.ReadString(key) || !reader.Read(writeTime)) {
+				return false;
+			}
+			root.directories[key] = writeTime;
+			owners[key] = &root;
+		}
+	}
+
+	// ファイル、置かれているディレクトリからstemの索引を作り直す
+	uint32_t fileCount = 0;
+	if (!reader.Read(fileCount)) {
+		return false;
+	}
+	for (uint32_t i = 0; i < fileCount; ++i) {
+
+		std::string key;
+		AssetFileEntry entry{};
+		if (!reader.ReadString(key) || !reader.ReadString(entry.extension) ||
+			!reader.Read(entry.size) || !reader.Read(entry.writeTime) || !reader.Read(entry.contentHash)) {
+			return false;
+		}
+		entry.path = std::filesystem::path(key);
+
+		auto owner = owners.find(MakeKey(entry.path.parent_path()));
+		if (owner != owners.end()) {
+
+			owner->second->stems[entry.path.stem().string()].emplace_back(key);
+		}
+		files_[key] = std::move(entry);
+	}
+	return true;
+}
+
+bool AssetRegistry::WriteIndexLocked() const {
+
+	std::error_code error;
+	std::filesystem::create_directories(indexPath_.parent_path(), error);
+
+	// 書き込み途中のファイルを読まないように別名で書いてから置き換える
+	std::filesystem::path tempPath = indexPath_;
+	tempPath += ".tmp";
+	{
+		std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+		if (!file) {
+			return false;
+		}
+
+		WriteValue(file, kIndexMagic);
+		WriteValue(file, kIndexVersion);
+
+		WriteValue(file, static_cast<uint32_t>(roots_.size()));
+		for (const auto& [rootKey, root] : roots_) {
+
+			WriteString(file, rootKey);
+			WriteValue(file, static_cast<uint32_t>(root.directories.size()));
+			for (const auto& [key, writeTime] : root.directories) {
+
+				WriteString(file, key);
+				WriteValue(file, writeTime);
+			}
+		}
+
+		WriteValue(file, static_cast<uint32_t>(files_.size()));
+		for (const auto& [key, entry] : files_) {
+
+			WriteString(file, key);
+			WriteString(file, entry.extension);
+			WriteValue(file, entry.size);
+			WriteValue(file, entry.writeTime);
+			WriteValue(file, entry.contentHash);
+		}
+		if (!file) {
+			return false;
+		}
+	}
+	std::filesystem::rename(tempPath, indexPath_, error);
+	return !error;
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+//============================================================================
+//	include
+//============================================================================
+
+// c++
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <filesystem>
+#include <unordered_map>
+
+//============================================================================
+//	AssetFileEntry structure
+//	索引に登録したファイル1つ分の情報
+//============================================================================
+struct AssetFileEntry {
+
+	std::filesystem::path path;
+	std::string extension;
+
+	uint64_t size = 0;
+	int64_t writeTime = 0;    // 最終更新時刻
+	uint64_t contentHash = 0; // 0なら未計算
+};
+
+//============================================================================
+//	AssetRegistry class
+//	アセットのディレクトリを一度だけ走査し、名前(stem)からファイルを引ける索引を持つ。
+//	索引はファイルに保存し、次回起動時は更新時刻が変わったディレクトリのみ走査し直す。
+//	ファイルの追加/削除はディレクトリの更新時刻で、内容の変更はサイズと更新時刻で検出する
+//============================================================================
+class AssetRegistry {
+public:
+	//========================================================================
+	//	public Methods
+	//========================================================================
+
+	AssetRegistry() = default;
+	// 変更があれば保存する
+	~AssetRegistry();
+
+	// 保存済みの索引を読み込む
+	void Init(const std::filesystem::path& indexPath);
+
+	// 索引に含めるディレクトリを登録する。保存済みなら変更のあったディレクトリのみ走査し直す
+	void AddRoot(const std::filesystem::path& root);
+	// 登録済みの全ディレクトリから、変更のあったものを走査し直す
+	void Refresh();
+	// 変更があれば索引を書き出す
+	void Save();
+
+	// rootに登録されたファイルからstemと拡張子が一致するものを探す
+	// 複数あればextensionsの順で先のものを返す
+	bool FindByStem(const std::filesystem::path& root, const std::string& stem,
+		const std::vector<std::string>& extensions, std::filesystem::path& outPath);
+
+	// ファイル内容のハッシュ、サイズと更新時刻が変わっていなければ保存済みの値を返す
+	// 存在しないファイルは0
+	uint64_t GetContentHash(const std::filesystem::path& path);
+
+	//--------- accessor -----------------------------------------------------
+
+	// rootに登録された、指定拡張子のファイルのstem一覧
+	std::vector<std::string> CollectStems(const std::filesystem::path& root,
+		const std::vector<std::string>& extensions) const;
+	// rootに登録された、指定拡張子のファイルのパス一覧
+	std::vector<std::filesystem::path> CollectFiles(const std::filesystem::path& root,
+		const std::vector<std::string>& extensions) const;
+private:
+	//========================================================================
+	//	private Methods
+	//========================================================================
+
+	//--------- structure ----------------------------------------------------
+
+	// 登録したディレクトリ1つ分の索引
+	struct Root {
+
+		// 配下の全ディレクトリと、その更新時刻
+		std::unordered_map<std::string, int64_t> directories;
+		// stem -> files_のキー
+		std::unordered_map<std::string, std::vector<std::string>> stems;
+
+		// 今回の起動で検証済みか
+		bool isValidated = false;
+	};
+
+	//--------- variables ----------------------------------------------------
+
+	std::filesystem::path indexPath_;
+
+	mutable std::mutex mutex_;
+
+	std::unordered_map<std::string, Root> roots_;
+	// 正規化したパス -> ファイル情報
+	std::unordered_map<std::string, AssetFileEntry> files_;
+
+	bool isDirty_ = false;
+
+	//--------- functions ----------------------------------------------------
+
+	// 以下はmutex_を取った状態で呼ぶ
+	// ディレクトリ直下を走査して登録する。未登録のサブディレクトリはたどって登録する
+	void ScanDirectoryLocked(Root& root, const std::filesystem::path& directory,
+		std::unordered_map<std::string, AssetFileEntry>& previous);
+	// 登録済みでなければ走査して登録する
+	Root& AddRootLocked(const std::filesystem::path& rootPath);
+	// 更新時刻が変わったディレクトリを走査し直す
+	void RefreshRootLocked(Root& root);
+	// stemを引く
+	const AssetFileEntry* FindLocked(const Root& root, const std::string& stem,
+		const std::vector<std::string>& extensions) const;
+
+	// 索引ファイルの入出力
+	bool ReadIndexLocked();
+	bool WriteIndexLocked() const;
+};
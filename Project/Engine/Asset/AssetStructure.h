@@ -65,27 +65,25 @@ struct Node {
 	std::vector<Node> children;
 };
 
-//----------------------------------------------------------------------------
-//	Keyframe<tValue>
-//	アニメーションの離散キー。時刻と値のペアを表す。
-//----------------------------------------------------------------------------
-template <typename tValue>
-struct Keyframe {
-
-	float time;
-	tValue value;
-};
-using KeyframeVector3 = Keyframe<Vector3>;
-using KeyframeQuaternion = Keyframe<Quaternion>;
-
 //----------------------------------------------------------------------------
 //	AnimationCurve<tValue>
 //	単一チャンネルのカーブ(キー列)を表すテンプレート。
+//	時刻と値を別配列(SoA)で持ち、時刻のみを連続して探索できるようにする。
 //----------------------------------------------------------------------------
 template <typename tValue>
 struct AnimationCurve {
 
-	std::vector<Keyframe<tValue>> keyframes;
+	std::vector<float> times;   // 昇順のキー時刻
+	std::vector<tValue> values; // timesと同じ並びの値
+
+	// キーを末尾に追加する
+	void AddKey(float time, const tValue& value) {
+
+		times.emplace_back(time);
+		values.emplace_back(value);
+	}
+	bool Empty() const { return times.empty(); }
+	uint32_t GetKeyCount() const { return static_cast<uint32_t>(times.size()); }
 };
 
 //----------------------------------------------------------------------------
@@ -158,6 +156,9 @@ struct ModelData {
 	Node rootNode;
 
 	std::string fullPath;
+	// 読み込み結果のキャッシュ(.cmdl)と、作成時の元ファイルのハッシュ
+	std::string cookedPath;
+	uint64_t sourceHash = 0;
 
 	// 使用されたかどうか
 	mutable bool isUse = false;
@@ -165,13 +166,76 @@ struct ModelData {
 
 //----------------------------------------------------------------------------
 //	AnimationData
-//	アニメーション全体の尺と、各ノードのアニメーションカーブ集合を持つ。
+//	読み込み時の中間データ。アニメーション全体の尺と、各ノードのアニメーションカーブ集合を持つ。
 //----------------------------------------------------------------------------
 struct AnimationData {
 
 	float duration;                                      // アニメーション全体の尺
 	std::map<std::string, NodeAnimation> nodeAnimations; // NodeAnimationの集合、Node名で引けるようにしておく
 };
+
+//----------------------------------------------------------------------------
+//	CompressedTrack
+//	一定間隔で再サンプリングし、量子化/キー削減したSRTの1成分。
+//	Vector3は範囲内を16bit、回転はsmallest-three(15bit x3 + 最大成分Index)で持つ。
+//----------------------------------------------------------------------------
+struct CompressedTrack {
+
+	bool hasKeys = true;                   // 元のカーブにキーがあるか、無ければ展開時に値を変更しない
+	bool isConstant = true;                // 全フレームで値が変わらない
+	std::array<float, 4> constant{};       // 定数トラックの値(Vector3はxyzのみ)
+	std::array<float, 3> rangeMin{};       // Vector3の量子化範囲
+	std::array<float, 3> rangeExtent{};
+	std::vector<uint16_t> frames;          // 残したフレーム番号(昇順、先頭と末尾を含む)
+	std::vector<uint16_t> values;          // 1キー3要素の量子化値
+};
+
+//----------------------------------------------------------------------------
+//	CompressedNodeAnimation
+//	1ノード分の圧縮済みSRTトラック。
+//----------------------------------------------------------------------------
+struct CompressedNodeAnimation {
+
+	CompressedTrack scale;
+	CompressedTrack rotate;
+	CompressedTrack translate;
+};
+
+//----------------------------------------------------------------------------
+//	AnimationClip
+//	読み込み後に骨のIndexで引けるよう解決した、共有される不変のアニメーション。
+//	AnimationManagerが1つだけ所有し、各インスタンスはshared_ptrで参照する。
+//	圧縮済み(sampleRate > 0)の場合はcompressedChannelsのみを持つ。
+//----------------------------------------------------------------------------
+struct AnimationClip {
+
+	float duration;                     // アニメーション全体の尺
+	std::vector<int32_t> jointChannels; // jointIndex -> channelsのIndex、無ければ-1
+	std::vector<NodeAnimation> channels;
+
+	// 圧縮済みデータ
+	float sampleRate = 0.0f; // 1秒あたりのフレーム数、0なら非圧縮
+	std::vector<CompressedNodeAnimation> compressedChannels;
+
+	// 圧縮済みか
+	bool IsCompressed() const { return 0.0f < sampleRate; }
+
+	// jointのチャンネルを取得する。無ければnullptr
+	const NodeAnimation* FindChannel(size_t jointIndex) const {
+
+		if (IsCompressed() || jointChannels.size() <= jointIndex || jointChannels[jointIndex] < 0) {
+			return nullptr;
+		}
+		return &channels[jointChannels[jointIndex]];
+	}
+	const CompressedNodeAnimation* FindCompressedChannel(size_t jointIndex) const {
+
+		if (!IsCompressed() || jointChannels.size() <= jointIndex || jointChannels[jointIndex] < 0) {
+			return nullptr;
+		}
+		return &compressedChannels[jointChannels[jointIndex]];
+	}
+};
 //----------------------------------------------------------------------------
 //	Joint
 //	スケルトンの1関節を表す。局所/スケルトンスペース行列や親子関係を持つ。
@@ -239,8 +303,6 @@ struct SkinningInformation {
 struct SkinCluster {
 
 	std::vector<Matrix4x4> inverseBindPoseMatrices;
-	// インスタンシングに送るデータ
-	std::vector<WellForGPU> mappedPalette;
 };
 
 //----------------------------------------------------------------------------
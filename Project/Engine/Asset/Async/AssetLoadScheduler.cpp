@@ -0,0 +1,412 @@
+#include "AssetLoadScheduler.h"
+
+//============================================================================
+//	include
+//============================================================================
+#include <Engine/Core/Debug/SpdLogger.h>
+
+// c++
+#include <algorithm>
+
+//============================================================================
+//	AssetLoadScheduler classMethods
+//============================================================================
+
+namespace {
+
+	// 種類と名前から一意なIDを作る
+	std::string MakeJobId(const AssetJobKey& key) {
+
+		return std::to_string(static_cast<uint32_t>(key.type)) + ":" + key.name;
+	}
+}
+
+AssetLoadScheduler::~AssetLoadScheduler() {
+
+	// 全ワーカーを起床させて終了を待つ、未実行のジョブは破棄する
+	{
+		std::scoped_lock lock(jobMutex_);
+		stop_ = true;
+	}
+	jobCondition_.notify_all();
+	completeCondition_.notify_all();
+	for (auto& worker : workers_) {
+		if (worker.joinable()) {
+
+			worker.join();
+		}
+	}
+	workers_.clear();
+}
+
+void AssetLoadScheduler::Init(uint32_t workerCount) {
+
+	// 起動済みなら何もしない
+	if (!workers_.empty()) {
+		return;
+	}
+
+	if (workerCount == 0) {
+
+		// ファイル待ちの時間が長いので、フレームのジョブと取り合わない程度の数にする
+		const uint32_t hardware = (std::max)(std::thread::hardware_concurrency(), 2u);
+		workerCount = std::clamp(hardware / 2, 2u, 4u);
+	}
+
+	stop_ = false;
+	workers_.reserve(workerCount);
+	for (uint32_t i = 0; i < workerCount; ++i) {
+
+		workers_.emplace_back([this]() { WorkerLoop(); });
+	}
+	LOG_INFO("assetLoadScheduler: workerCount: {}", workerCount);
+}
+
+bool AssetLoadScheduler::Submit(const AssetJobKey& key, AssetLoadPriority priority,
+	const std::vector<AssetJobKey>& dependencies, std::function<void()> task) {
+
+	const std::string id = MakeJobId(key);
+	{
+		std::scoped_lock lock(jobMutex_);
+
+		// 投入も完了通知もされていない依存先は完了することがないので受け付けない
+		for (const auto& dependency : dependencies) {
+
+			const std::string dependencyId = MakeJobId(dependency);
+			if (!jobs_.contains(dependencyId)) {
+
+				LOG_ERROR("assetLoadScheduler: {} depends on unknown job {}", id, dependencyId);
+				return false;
+			}
+		}
+
+		Job& job = jobs_[id];
+		job.type = key.type;
+		// 投入済みなら優先度の更新のみ行う
+		if (job.state != State::Unscheduled) {
+
+			PromoteLocked(id, priority);
+			return false;
+		}
+
+		// 依存先として先に上げられていればそちらを優先する
+		job.priority = (std::min)(job.priority, priority);
+		job.task = std::move(task);
+		++activeCounts_[static_cast<size_t>(key.type)];
+
+		// 未完了の依存先に自身を登録する
+		for (const auto& dependency : dependencies) {
+
+			const std::string dependencyId = MakeJobId(dependency);
+			Job& dependencyJob = jobs_.at(dependencyId);
+			job.dependencies.emplace_back(dependencyId);
+			if (dependencyJob.state == State::Completed) {
+				continue;
+			}
+			dependencyJob.dependents.emplace_back(id);
+			++job.remainingDependencies;
+
+			// 依存先も同じ優先度で処理させる
+			PromoteLocked(dependencyId, priority);
+		}
+
+		if (0 < job.remainingDependencies) {
+
+			job.state = State::Waiting;
+			return true;
+		}
+		Enqueue(id, job);
+	}
+	// 1スレッド起床させる
+	jobCondition_.notify_one();
+	return true;
+}
+
+void AssetLoadScheduler::Promote(const AssetJobKey& key, AssetLoadPriority priority) {
+
+	std::scoped_lock lock(jobMutex_);
+	PromoteLocked(MakeJobId(key), priority);
+}
+
+void AssetLoadScheduler::MarkCompleted(const AssetJobKey& key) {
+
+	{
+		std::scoped_lock lock(jobMutex_);
+
+		const std::string id = MakeJobId(key);
+		Job& job = jobs_[id];
+		job.type = key.type;
+		if (job.state == State::Completed) {
+			return;
+		}
+
+		// 実行待ちに残っていれば取り除く
+		if (job.state == State::Queued) {
+
+			auto& lane = lanes_[static_cast<size_t>(job.priority)];
+			lane.erase(std::remove(lane.begin(), lane.end(), id), lane.end());
+		}
+		// 実行中のものはワーカー側で完了させる
+		if (job.state == State::Running) {
+			return;
+		}
+		if (job.state != State::Unscheduled) {
+
+			--activeCounts_[static_cast<size_t>(job.type)];
+		}
+		Complete(job);
+	}
+	jobCondition_.notify_all();
+	completeCondition_.notify_all();
+}
+
+void AssetLoadScheduler::CancelPending(AssetJobType type) {
+
+	std::unique_lock lock(jobMutex_);
+
+	// 未実行のものは依存先を待たずに捨てる、後から同じジョブを投入できるように登録ごと消す
+	for (auto& lane : lanes_) {
+
+		std::erase_if(lane, [&](const std::string& id) { return jobs_.at(id).type == type; });
+	}
+	std::erase_if(jobs_, [&](const auto& pair) {
+		const Job& job = pair.second;
+		if (job.type != type || (job.state != State::Waiting && job.state != State::Queued)) {
+			return false;
+		}
+		--activeCounts_[static_cast<size_t>(type)];
+		return true;
+		});
+	for (auto& [id, job] : jobs_) {
+
+		std::erase_if(job.dependents, [&](const std::string& dependent) { return !jobs_.contains(dependent); });
+	}
+
+	// 破棄したジョブを待っているものを起こす
+	completeCondition_.notify_all();
+	completeCondition_.wait(lock, [&] { return runningCounts_[static_cast<size_t>(type)] == 0; });
+}
+
+void AssetLoadScheduler::Wait(const AssetJobKey& key) {
+
+	const std::string id = MakeJobId(key);
+	WaitUntil([&]() {
+		auto it = jobs_.find(id);
+		// 破棄された、名前だけ登録されたものは完了しないので待たない
+		return it == jobs_.end() || it->second.state == State::Completed ||
+			it->second.state == State::Unscheduled; });
+}
+
+void AssetLoadScheduler::WaitIdle(AssetJobType type) {
+
+	WaitUntil([&]() { return activeCounts_[static_cast<size_t>(type)] == 0; });
+}
+
+AssetLoadHandle AssetLoadScheduler::GetHandle(const AssetJobKey& key) {
+
+	return AssetLoadHandle(this, key);
+}
+
+bool AssetLoadScheduler::IsCompleted(const AssetJobKey& key) const {
+
+	std::scoped_lock lock(jobMutex_);
+	auto it = jobs_.find(MakeJobId(key));
+	return it != jobs_.end() && it->second.state == State::Completed;
+}
+
+bool AssetLoadScheduler::IsSubmitted(const AssetJobKey& key) const {
+
+	std::scoped_lock lock(jobMutex_);
+	auto it = jobs_.find(MakeJobId(key));
+	return it != jobs_.end() && it->second.state != State::Unscheduled;
+}
+
+bool AssetLoadScheduler::IsIdle(AssetJobType type) const {
+
+	std::scoped_lock lock(jobMutex_);
+	return activeCounts_[static_cast<size_t>(type)] == 0;
+}
+
+void AssetLoadScheduler::WorkerLoop() {
+
+	while (true) {
+
+		RunningJob runningJob{};
+		{
+			std::unique_lock lock(jobMutex_);
+			jobCondition_.wait(lock, [&] { return stop_ || HasQueuedLocked(); });
+
+			if (stop_) {
+				return;
+			}
+			PopLocked(runningJob);
+		}
+		Execute(runningJob);
+	}
+}
+
+void AssetLoadScheduler::Execute(RunningJob& runningJob) {
+
+	runningJob.task();
+
+	bool hasReady = false;
+	{
+		std::scoped_lock lock(jobMutex_);
+
+		Job& job = jobs_[runningJob.id];
+		--runningCounts_[static_cast<size_t>(runningJob.type)];
+		--activeCounts_[static_cast<size_t>(runningJob.type)];
+		Complete(job);
+		hasReady = HasQueuedLocked();
+	}
+	completeCondition_.notify_all();
+	if (hasReady) {
+
+		jobCondition_.notify_all();
+	}
+}
+
+void AssetLoadScheduler::WaitUntil(const std::function<bool()>& isFinished) {
+
+	std::unique_lock lock(jobMutex_);
+	while (!stop_ && !isFinished()) {
+
+		// 待っている間も実行待ちのジョブを処理する、ワーカーから呼ばれても止まらない
+		RunningJob runningJob{};
+		if (PopLocked(runningJob)) {
+
+			lock.unlock();
+			Execute(runningJob);
+			lock.lock();
+			continue;
+		}
+		// 何かが完了するまで眠る
+		completeCondition_.wait(lock);
+	}
+}
+
+void AssetLoadScheduler::Enqueue(const std::string& id, Job& job) {
+
+	job.state = State::Queued;
+	lanes_[static_cast<size_t>(job.priority)].emplace_back(id);
+}
+
+bool AssetLoadScheduler::PopLocked(RunningJob& outJob) {
+
+	// 優先度の高い列から取り出す
+	auto lane = std::find_if(lanes_.begin(), lanes_.end(),
+		[](const auto& queue) { return !queue.empty(); });
+	if (lane == lanes_.end()) {
+		return false;
+	}
+	outJob.id = std::move(lane->front());
+	lane->pop_front();
+
+	Job& job = jobs_[outJob.id];
+	job.state = State::Running;
+	outJob.task = std::move(job.task);
+	outJob.type = job.type;
+	++runningCounts_[static_cast<size_t>(outJob.type)];
+	return true;
+}
+
+bool AssetLoadScheduler::HasQueuedLocked() const {
+
+	return std::any_of(lanes_.begin(), lanes_.end(),
+		[](const auto& queue) { return !queue.empty(); });
+}
+
+void AssetLoadScheduler::Complete(Job& job) {
+
+	job.state = State::Completed;
+	job.task = nullptr;
+	job.dependencies.clear();
+
+	// 全ての依存先が揃ったものを実行待ちにする
+	std::vector<std::string> dependents = std::move(job.dependents);
+	for (const auto& dependentId : dependents) {
+
+		auto it = jobs_.find(dependentId);
+		if (it == jobs_.end()) {
+			continue;
+		}
+		Job& dependent = it->second;
+		if (dependent.state == State::Waiting && --dependent.remainingDependencies == 0) {
+
+			Enqueue(dependentId, dependent);
+		}
+	}
+}
+
+void AssetLoadScheduler::PromoteLocked(const std::string& id, AssetLoadPriority priority) {
+
+	auto it = jobs_.find(id);
+	if (it == jobs_.end()) {
+		return;
+	}
+	Job& job = it->second;
+	if (job.priority <= priority) {
+		return;
+	}
+
+	if (job.state == State::Queued) {
+
+		// 列を移し替える
+		auto& lane = lanes_[static_cast<size_t>(job.priority)];
+		lane.erase(std::remove(lane.begin(), lane.end(), id), lane.end());
+		lanes_[static_cast<size_t>(priority)].emplace_back(id);
+	}
+	job.priority = priority;
+
+	// 依存先が遅れていると結局待つことになるので合わせて上げる
+	for (const auto& dependencyId : job.dependencies) {
+
+		PromoteLocked(dependencyId, priority);
+	}
+}
+
+//============================================================================
+//	AssetLoadHandle classMethods
+//============================================================================
+
+AssetLoadHandle::AssetLoadHandle(AssetLoadScheduler* scheduler, const AssetJobKey& key) {
+
+	scheduler_ = nullptr;
+	scheduler_ = scheduler;
+
+	key_ = key;
+}
+
+void AssetLoadHandle::Wait() const {
+
+	if (!scheduler_) {
+		return;
+	}
+	scheduler_->Wait(key_);
+}
+
+AssetLoadHandle AssetLoadHandle::Then(const AssetJobKey& key, AssetLoadPriority priority,
+	std::function<void()> task) const {
+
+	// 待つ相手がいないので、完了済みとしてその場で実行する
+	if (!scheduler_) {
+
+		task();
+		return AssetLoadHandle();
+	}
+
+	// 自身を依存先にして投入する、投入済みなら優先度のみ更新される
+	if (!scheduler_->Submit(key, priority, { key_ }, std::move(task)) &&
+		!scheduler_->IsSubmitted(key)) {
+
+		// 依存先が未知で受け付けられなかった、待っても完了しないハンドルは返さない
+		LOG_ERROR("assetLoadHandle: {} was not submitted", MakeJobId(key));
+		return AssetLoadHandle();
+	}
+	return AssetLoadHandle(scheduler_, key);
+}
+
+bool AssetLoadHandle::IsReady() const {
+
+	return !scheduler_ || scheduler_->IsCompleted(key_);
+}
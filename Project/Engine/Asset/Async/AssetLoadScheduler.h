@@ -0,0 +1,220 @@
+#pragma once
+
+//============================================================================
+//	include
+//============================================================================
+
+// c++
+#include <cstdint>
+#include <array>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <functional>
+#include <unordered_map>
+#include <condition_variable>
+
+//============================================================================
+//	AssetLoadScheduler enum class
+//============================================================================
+
+// 読み込みジョブの種類
+enum class AssetJobType {
+
+	Texture,
+	Model,
+	Animation,
+	Mesh,
+
+	Count
+};
+
+// 読み込みの優先度、値が小さいほど先に処理する
+enum class AssetLoadPriority {
+
+	Current, // 今のシーンで必要なもの
+	Next,    // 先読み
+
+	Count
+};
+
+//============================================================================
+//	AssetJobKey structure
+//	種類と名前でジョブを識別する
+//============================================================================
+struct AssetJobKey {
+
+	AssetJobType type;
+	std::string name;
+};
+
+class AssetLoadHandle;
+
+//============================================================================
+//	AssetLoadScheduler class
+//	テクスチャ/モデル/アニメーション/メッシュ構築の読み込みジョブを共有のワーカー群で並列に処理する。
+//	優先度ごとの列を持ち、今のシーンの列から先に取り出す。
+//	依存するジョブ(アニメーション -> モデルなど)が完了するまで実行を保留し、同じジョブの重複投入は優先度の更新のみ行う。
+//	待機は完了通知を受けるまで眠り、実行待ちのジョブがあれば待っている間に処理する
+//============================================================================
+class AssetLoadScheduler {
+public:
+	//========================================================================
+	//	public Methods
+	//========================================================================
+
+	AssetLoadScheduler() = default;
+	~AssetLoadScheduler();
+
+	// ワーカースレッドを起動する(0ならハードウェアスレッド数から決める)
+	void Init(uint32_t workerCount = 0);
+
+	// ジョブを投入する。投入済み、完了済みなら優先度を上げるのみでfalseを返す
+	// 依存先は先に投入するかMarkCompletedで通知しておくこと、未知の依存先があれば投入せずfalseを返す
+	bool Submit(const AssetJobKey& key, AssetLoadPriority priority,
+		const std::vector<AssetJobKey>& dependencies, std::function<void()> task);
+	// 投入済みのジョブと、その依存先の優先度を上げる
+	void Promote(const AssetJobKey& key, AssetLoadPriority priority);
+
+	// 同期読み込みなど、スケジューラを通さずに完了したものを通知して依存先を進める
+	void MarkCompleted(const AssetJobKey& key);
+	// 指定種類の未実行のジョブを破棄し、実行中のものの終了を待つ
+	// 破棄したジョブを待っているものは進まなくなるので、他から依存されない種類に使う
+	void CancelPending(AssetJobType type);
+
+	// 指定ジョブが完了するまで待つ、投入されていないものは待たない
+	void Wait(const AssetJobKey& key);
+	// 指定種類の未完了のジョブがなくなるまで待つ
+	void WaitIdle(AssetJobType type);
+
+	//--------- accessor -----------------------------------------------------
+
+	// 指定ジョブが完了しているか
+	bool IsCompleted(const AssetJobKey& key) const;
+	// 指定ジョブが投入済み、または完了通知済みか
+	bool IsSubmitted(const AssetJobKey& key) const;
+	// 指定種類の未完了のジョブがないか
+	bool IsIdle(AssetJobType type) const;
+
+	// 指定ジョブの完了待ちや後続ジョブの接続に使うハンドル
+	AssetLoadHandle GetHandle(const AssetJobKey& key);
+
+	uint32_t GetWorkerCount() const { return static_cast<uint32_t>(workers_.size()); }
+private:
+	//========================================================================
+	//	private Methods
+	//========================================================================
+
+	//--------- structure ----------------------------------------------------
+
+	// ジョブの状態
+	enum class State {
+
+		Unscheduled, // 名前だけ登録された(投入前)
+		Waiting,     // 依存先の完了待ち
+		Queued,      // 実行待ち
+		Running,
+		Completed,
+	};
+
+	// 1ジョブ分の情報
+	struct Job {
+
+		AssetJobType type;
+		State state = State::Unscheduled;
+		AssetLoadPriority priority = AssetLoadPriority::Next;
+		uint32_t remainingDependencies = 0;
+		std::vector<std::string> dependencies; // 依存先
+		std::vector<std::string> dependents;   // 自身の完了を待っているもの
+		std::function<void()> task;
+	};
+
+	// 実行のために列から取り出したジョブ
+	struct RunningJob {
+
+		std::string id;
+		AssetJobType type;
+		std::function<void()> task;
+	};
+
+	//--------- variables ----------------------------------------------------
+
+	std::vector<std::thread> workers_;
+
+	mutable std::mutex jobMutex_;
+	std::condition_variable jobCondition_;
+	// ジョブの終了通知
+	std::condition_variable completeCondition_;
+
+	std::unordered_map<std::string, Job> jobs_;
+	// 優先度ごとの実行待ち
+	std::array<std::deque<std::string>, static_cast<size_t>(AssetLoadPriority::Count)> lanes_;
+	// 種類ごとの未完了数
+	std::array<uint32_t, static_cast<size_t>(AssetJobType::Count)> activeCounts_{};
+	// 種類ごとの実行中の数
+	std::array<uint32_t, static_cast<size_t>(AssetJobType::Count)> runningCounts_{};
+
+	bool stop_ = false;
+
+	//--------- functions ----------------------------------------------------
+
+	// ワーカースレッドの処理ループ
+	void WorkerLoop();
+	// ジョブを実行して完了させる
+	void Execute(RunningJob& runningJob);
+	// 条件を満たすまで、実行待ちのジョブを処理しながら待つ
+	void WaitUntil(const std::function<bool()>& isFinished);
+
+	// 以下はjobMutex_を取った状態で呼ぶ
+	// 実行待ちの列に積む
+	void Enqueue(const std::string& id, Job& job);
+	// 優先度の高い列から1つ取り出す(無ければfalse)
+	bool PopLocked(RunningJob& outJob);
+	bool HasQueuedLocked() const;
+	// 完了にして、待っているジョブを進める
+	void Complete(Job& job);
+	// 優先度を上げる、依存先もたどる
+	void PromoteLocked(const std::string& id, AssetLoadPriority priority);
+};
+
+//============================================================================
+//	AssetLoadHandle class
+//	読み込み要求の完了待ちと、完了後に実行するジョブの接続を行う
+//============================================================================
+class AssetLoadHandle {
+public:
+	//========================================================================
+	//	public Methods
+	//========================================================================
+
+	AssetLoadHandle() = default;
+	AssetLoadHandle(AssetLoadScheduler* scheduler, const AssetJobKey& key);
+	~AssetLoadHandle() = default;
+
+	// 完了するまで待つ
+	void Wait() const;
+
+	// 完了後に実行するジョブを投入し、そのハンドルを返す
+	// 無効なハンドルは完了済みとして扱うので、その場で実行して無効なハンドルを返す
+	// 自身が未知のジョブで投入できなかった場合はエラーを出し、taskを実行せずに無効なハンドルを返す
+	AssetLoadHandle Then(const AssetJobKey& key, AssetLoadPriority priority,
+		std::function<void()> task) const;
+
+	//--------- accessor -----------------------------------------------------
+
+	bool IsValid() const { return scheduler_ != nullptr; }
+	bool IsReady() const;
+
+	const AssetJobKey& GetKey() const { return key_; }
+private:
+	//========================================================================
+	//	private Methods
+	//========================================================================
+
+	//--------- variables ----------------------------------------------------
+
+	AssetLoadScheduler* scheduler_ = nullptr;
+	AssetJobKey key_{};
+};
@@ -19,9 +19,4 @@ namespace Filesystem {
 	// basePath配下を再帰探索し、完全一致するファイル名を見つけてfullPathへ返す
 	bool Found(const std::filesystem::path& basePath, const std::string& fileName,
 		std::filesystem::path& fullPath);
-
-	// 指定stemと拡張子群に合致する最初のファイルを探し、パスを返す
-	bool FindByStem(const std::filesystem::path& basePath,
-		const std::string& stem, const std::vector<std::string>& extensions,
-		std::filesystem::path& outPath);
 };
\ No newline at end of file
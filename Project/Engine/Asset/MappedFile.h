@@ -0,0 +1,67 @@
+#pragma once
+
+//============================================================================
+//	include
+//============================================================================
+
+// windows
+#include <Windows.h>
+// c++
+#include <cstdint>
+#include <filesystem>
+
+//============================================================================
+//	MappedFile class
+//	読み取り専用でファイルをマップする。開けなかった場合はGetData()がnullptrになる
+//============================================================================
+class MappedFile {
+public:
+
+	explicit MappedFile(const std::filesystem::path& path) {
+
+		file_ = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+			OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+		if (file_ == INVALID_HANDLE_VALUE) {
+			return;
+		}
+		LARGE_INTEGER size{};
+		if (!GetFileSizeEx(file_, &size) || size.QuadPart == 0) {
+			return;
+		}
+		mapping_ = CreateFileMappingW(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!mapping_) {
+			return;
+		}
+		data_ = static_cast<const uint8_t*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+		if (data_) {
+
+			size_ = static_cast<size_t>(size.QuadPart);
+		}
+	}
+	~MappedFile() {
+
+		if (data_) {
+
+			UnmapViewOfFile(data_);
+		}
+		if (mapping_) {
+
+			CloseHandle(mapping_);
+		}
+		if (file_ != INVALID_HANDLE_VALUE) {
+
+			CloseHandle(file_);
+		}
+	}
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	const uint8_t* GetData() const { return data_; }
+	size_t GetSize() const { return size_; }
+private:
+
+	HANDLE file_ = INVALID_HANDLE_VALUE;
+	HANDLE mapping_ = nullptr;
+	const uint8_t* data_ = nullptr;
+	size_t size_ = 0;
+};
@@ -0,0 +1,376 @@
+#include "ModelCache.h"
+
+//============================================================================
+//	include
+//============================================================================
+#include <Engine/Asset/AssetRegistry.h>
+#include <Engine/Asset/MappedFile.h>
+
+// c++
+#include <cstring>
+#include <fstream>
+#include <optional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+//============================================================================
+//	ModelCache Methods
+//============================================================================
+
+namespace {
+
+	// ファイル識別子とバージョン
+	constexpr uint32_t kCookedMagic = 0x4C444D43; // "CMDL"
+	constexpr uint32_t kCookedVersion = 1;
+
+	// ファイル先頭
+	struct Header {
+
+		uint32_t magic;
+		uint32_t version;
+		uint32_t builderVersion;
+		uint32_t vertexStride;      // MeshVertexの構造が変わったものを弾く
+		uint64_t sourceHash;
+		uint64_t meshSectionOffset; // ResourceMeshの開始位置
+	};
+
+	// マップした領域を先頭から読む、範囲外を読もうとしたら失敗を返す
+	struct Reader {
+
+		const uint8_t* data;
+		size_t size;
+		size_t offset;
+
+		bool Read(void* destination, size_t byteSize) {
+
+			if (size - offset < byteSize) {
+				return false;
+			}
+			std::memcpy(destination, data + offset, byteSize);
+			offset += byteSize;
+			return true;
+		}
+	};
+
+	//--------- hash ---------------------------------------------------------
+
+	// FNV-1a
+	constexpr uint64_t kHashOffset = 14695981039346656037ull;
+	constexpr uint64_t kHashPrime = 1099511628211ull;
+
+	uint64_t HashBytes(uint64_t hash, const uint8_t* data, size_t size) {
+
+		for (size_t i = 0; i < size; ++i) {
+
+			hash ^= data[i];
+			hash *= kHashPrime;
+		}
+		return hash;
+	}
+
+	//--------- file ---------------------------------------------------------
+
+	template <typename T>
+	void WriteValue(std::ofstream& file, const T& value) {
+
+		file.write(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+	template <typename T>
+	bool ReadValue(Reader& reader, T& value) {
+
+		return reader.Read(&value, sizeof(T));
+	}
+
+	template <typename T>
+	void WriteArray(std::ofstream& file, const std::vector<T>& values) {
+
+		WriteValue(file, static_cast<uint32_t>(values.size()));
+		file.write(reinterpret_cast<const char*>(values.data()), sizeof(T) * values.size());
+	}
+	template <typename T>
+	bool ReadArray(Reader& reader, std::vector<T>& values) {
+
+		uint32_t count = 0;
+		if (!ReadValue(reader, count) || (reader.size - reader.offset) / sizeof(T) < count) {
+			return false;
+		}
+		values.resize(count);
+		return reader.Read(values.data(), sizeof(T) * count);
+	}
+
+	void WriteString(std::ofstream& file, const std::string& value) {
+
+		WriteValue(file, static_cast<uint32_t>(value.size()));
+		file.write(value.data(), value.size());
+	}
+	bool ReadString(Reader& reader, std::string& value) {
+
+		uint32_t size = 0;
+		if (!ReadValue(reader, size) || reader.size - reader.offset < size) {
+			return false;
+		}
+		value.resize(size);
+		return reader.Read(value.data(), size);
+	}
+
+	template <typename T>
+	void WriteOptional(std::ofstream& file, const std::optional<T>& value) {
+
+		WriteValue(file, static_cast<uint8_t>(value.has_value()));
+		if (value.has_value()) {
+			if constexpr (std::is_same_v<T, std::string>) {
+
+				WriteString(file, *value);
+			} else {
+
+				WriteValue(file, *value);
+			}
+		}
+	}
+	template <typename T>
+	bool ReadOptional(Reader& reader, std::optional<T>& value) {
+
+		uint8_t hasValue = 0;
+		if (!ReadValue(reader, hasValue)) {
+			return false;
+		}
+		if (hasValue == 0) {
+
+			value.reset();
+			return true;
+		}
+		T result{};
+		bool isRead = false;
+		if constexpr (std::is_same_v<T, std::string>) {
+
+			isRead = ReadString(reader, result);
+		} else {
+
+			isRead = ReadValue(reader, result);
+		}
+		value = std::move(result);
+		return isRead;
+	}
+
+	void WriteNode(std::ofstream& file, const Node& node) {
+
+		WriteValue(file, node.transform.scale);
+		WriteValue(file, node.transform.rotation);
+		WriteValue(file, node.transform.translation);
+		WriteValue(file, node.localMatrix);
+		WriteString(file, node.name);
+		WriteValue(file, static_cast<uint32_t>(node.children.size()));
+		for (const auto& child : node.children) {
+
+			WriteNode(file, child);
+		}
+	}
+	bool ReadNode(Reader& reader, Node& node) {
+
+		uint32_t childCount = 0;
+		if (!ReadValue(reader, node.transform.scale) || !ReadValue(reader, node.transform.rotation) ||
+			!ReadValue(reader, node.transform.translation) || !ReadValue(reader, node.localMatrix) ||
+			!ReadString(reader, node.name) || !ReadValue(reader, childCount)) {
+			return false;
+		}
+		node.children.resize(childCount);
+		for (auto& child : node.children) {
+			if (!ReadNode(reader, child)) {
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// 先頭を確認し、一致していれば読み取り位置をヘッダの後ろにする
+	bool ReadHeader(Reader& reader, uint64_t sourceHash, Header& header) {
+
+		return ReadValue(reader, header) &&
+			header.magic == kCookedMagic &&
+			header.version == kCookedVersion &&
+			header.builderVersion == ModelCache::kBuilderVersion &&
+			header.vertexStride == sizeof(MeshVertex) &&
+			header.sourceHash == sourceHash &&
+			header.meshSectionOffset <= reader.size;
+	}
+}
+
+std::filesystem::path ModelCache::MakeCookedPath(const std::filesystem::path& sourceDirectory,
+	const std::filesystem::path& cookedDirectory, const std::filesystem::path& sourcePath) {
+
+	// 別の階層にある同じ名前のものと重ならないようにする
+	std::filesystem::path relative = sourcePath.lexically_normal().lexically_relative(
+		sourceDirectory.lexically_normal());
+	relative.replace_extension(".cmdl");
+	return cookedDirectory / relative;
+}
+
+uint64_t ModelCache::HashSource(const std::filesystem::path& sourcePath, AssetRegistry& registry) {
+
+	uint64_t hash = kHashOffset;
+
+	// 頂点を別ファイルに持つ形式があるので同じ名前のものも含める
+	std::filesystem::path paths[] = {
+		sourcePath,
+		std::filesystem::path(sourcePath).replace_extension(".bin"),
+		std::filesystem::path(sourcePath).replace_extension(".mtl"),
+	};
+	for (const auto& path : paths) {
+
+		// 存在しないものは0
+		const uint64_t fileHash = registry.GetContentHash(path);
+		hash = HashBytes(hash, reinterpret_cast<const uint8_t*>(&fileHash), sizeof(fileHash));
+	}
+	return hash;
+}
+
+bool ModelCache::Write(const std::filesystem::path& path, uint64_t sourceHash,
+	const ModelData& modelData, const ResourceMesh<MeshVertex>& resourceMesh) {
+
+	std::error_code error;
+	std::filesystem::create_directories(path.parent_path(), error);
+
+	// 書き込み途中のファイルを読まないように別名で書いてから置き換える
+	std::filesystem::path tempPath = path;
+	tempPath += ".tmp";
+	{
+		std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+		if (!file) {
+			return false;
+		}
+
+		Header header{};
+		header.magic = kCookedMagic;
+		header.version = kCookedVersion;
+		header.builderVersion = kBuilderVersion;
+		header.vertexStride = sizeof(MeshVertex);
+		header.sourceHash = sourceHash;
+		WriteValue(file, header);
+
+		// ModelData
+		WriteValue(file, static_cast<uint32_t>(modelData.meshes.size()));
+		for (const auto& mesh : modelData.meshes) {
+
+			WriteArray(file, mesh.vertices);
+			WriteArray(file, mesh.indices);
+			WriteOptional(file, mesh.textureName);
+			WriteOptional(file, mesh.normalMapTexture);
+			WriteOptional(file, mesh.baseColor);
+		}
+		WriteValue(file, static_cast<uint32_t>(modelData.skinClusterData.size()));
+		for (const auto& [name, joint] : modelData.skinClusterData) {
+
+			WriteString(file, name);
+			WriteValue(file, joint.inverseBindPoseMatrix);
+			WriteArray(file, joint.vertexWeights);
+		}
+		WriteNode(file, modelData.rootNode);
+
+		// ResourceMesh
+		header.meshSectionOffset = static_cast<uint64_t>(file.tellp());
+		WriteValue(file, static_cast<uint8_t>(resourceMesh.isSkinned));
+		WriteValue(file, static_cast<uint32_t>(resourceMesh.meshCount_));
+		for (size_t meshIndex = 0; meshIndex < resourceMesh.meshCount_; ++meshIndex) {
+
+			WriteArray(file, resourceMesh.vertices[meshIndex]);
+			WriteArray(file, resourceMesh.indices[meshIndex]);
+			WriteArray(file, resourceMesh.meshlets[meshIndex]);
+			WriteArray(file, resourceMesh.uniqueVertexIndices[meshIndex]);
+			WriteArray(file, resourceMesh.primitiveIndices[meshIndex]);
+		}
+
+		// 位置が決まったのでヘッダを書き直す
+		file.seekp(0);
+		WriteValue(file, header);
+		if (!file) {
+			return false;
+		}
+	}
+
+	std::filesystem::rename(tempPath, path, error);
+	return !error;
+}
+
+bool ModelCache::ReadModel(const std::filesystem::path& path, uint64_t sourceHash, ModelData& outModelData) {
+
+	MappedFile file(path);
+	Reader reader{ file.GetData(), file.GetSize(), 0 };
+	Header header{};
+	if (!file.GetData() || !ReadHeader(reader, sourceHash, header)) {
+		return false;
+	}
+
+	ModelData modelData{};
+	uint32_t meshCount = 0;
+	if (!ReadValue(reader, meshCount)) {
+		return false;
+	}
+	modelData.meshes.resize(meshCount);
+	for (auto& mesh : modelData.meshes) {
+		if (!ReadArray(reader, mesh.vertices) || !ReadArray(reader, mesh.indices) ||
+			!ReadOptional(reader, mesh.textureName) || !ReadOptional(reader, mesh.normalMapTexture) ||
+			!ReadOptional(reader, mesh.baseColor)) {
+			return false;
+		}
+	}
+
+	uint32_t jointCount = 0;
+	if (!ReadValue(reader, jointCount)) {
+		return false;
+	}
+	for (uint32_t i = 0; i < jointCount; ++i) {
+
+		std::string name;
+		JointWeightData joint{};
+		if (!ReadString(reader, name) || !ReadValue(reader, joint.inverseBindPoseMatrix) ||
+			!ReadArray(reader, joint.vertexWeights)) {
+			return false;
+		}
+		modelData.skinClusterData.emplace(std::move(name), std::move(joint));
+	}
+	if (!ReadNode(reader, modelData.rootNode)) {
+		return false;
+	}
+
+	outModelData = std::move(modelData);
+	return true;
+}
+
+bool ModelCache::ReadMesh(const std::filesystem::path& path, uint64_t sourceHash, ResourceMesh<MeshVertex>& outResourceMesh) {
+
+	MappedFile file(path);
+	Reader reader{ file.GetData(), file.GetSize(), 0 };
+	Header header{};
+	if (!file.GetData() || !ReadHeader(reader, sourceHash, header)) {
+		return false;
+	}
+	// ModelDataは読まずに飛ばす
+	reader.offset = static_cast<size_t>(header.meshSectionOffset);
+
+	uint8_t isSkinned = 0;
+	uint32_t meshCount = 0;
+	if (!ReadValue(reader, isSkinned) || !ReadValue(reader, meshCount)) {
+		return false;
+	}
+
+	// 一時バッファを挟まず、マップした領域から出力先へ直接コピーする。失敗時の内容は使わない
+	ResourceMesh<MeshVertex>& resourceMesh = outResourceMesh;
+	resourceMesh.isSkinned = isSkinned != 0;
+	resourceMesh.meshCount_ = meshCount;
+	resourceMesh.vertices.resize(meshCount);
+	resourceMesh.indices.resize(meshCount);
+	resourceMesh.meshlets.resize(meshCount);
+	resourceMesh.uniqueVertexIndices.resize(meshCount);
+	resourceMesh.primitiveIndices.resize(meshCount);
+	for (uint32_t meshIndex = 0; meshIndex < meshCount; ++meshIndex) {
+		if (!ReadArray(reader, resourceMesh.vertices[meshIndex]) ||
+			!ReadArray(reader, resourceMesh.indices[meshIndex]) ||
+			!ReadArray(reader, resourceMesh.meshlets[meshIndex]) ||
+			!ReadArray(reader, resourceMesh.uniqueVertexIndices[meshIndex]) ||
+			!ReadArray(reader, resourceMesh.primitiveIndices[meshIndex])) {
+			return false;
+		}
+	}
+	return true;
+}
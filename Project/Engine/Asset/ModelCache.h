@@ -0,0 +1,46 @@
+#pragma once
+
+//============================================================================
+//	include
+//============================================================================
+#include <Engine/Asset/AssetStructure.h>
+#include <Engine/Core/Graphics/Mesh/MeshletStructures.h>
+
+class AssetRegistry;
+
+// c++
+#include <cstdint>
+#include <filesystem>
+
+//============================================================================
+//	ModelCache namespace
+//	Assimp読み込みとmeshlet生成の結果をまとめたファイル(.cmdl)の入出力を行う。
+//	前半にModelData(メッシュ/スキン/階層)、後半にResourceMesh(最適化済み頂点/meshlet)を持ち、
+//	元ファイルのハッシュと生成処理のバージョンが一致する時のみ使用する。
+//	読み込みはファイルをマップし、各配列を一度だけ呼び出し側のvectorへコピーする
+//============================================================================
+namespace ModelCache {
+
+	//--------- variables ----------------------------------------------------
+
+	// 読み込みフラグやMeshletBuilderの処理を変えた時に上げる、古いファイルは作り直される
+	constexpr uint32_t kBuilderVersion = 1;
+
+	//--------- functions ----------------------------------------------------
+
+	// 元ファイルの階層を保ったまま、cookedDirectory以下の.cmdlのパスにする
+	std::filesystem::path MakeCookedPath(const std::filesystem::path& sourceDirectory,
+		const std::filesystem::path& cookedDirectory, const std::filesystem::path& sourcePath);
+
+	// 元ファイルと同じ名前の.bin/.mtlを含めたハッシュ
+	// ファイルごとのハッシュは索引に保存されたものを使い、変わっていなければ読み込まない
+	uint64_t HashSource(const std::filesystem::path& sourcePath, AssetRegistry& registry);
+
+	// ModelDataとResourceMeshを書き出す
+	bool Write(const std::filesystem::path& path, uint64_t sourceHash,
+		const ModelData& modelData, const ResourceMesh<MeshVertex>& resourceMesh);
+
+	// ハッシュが一致する時のみ読み込む。fullPath、cookedPath、sourceHashは呼び出し側で設定する
+	bool ReadModel(const std::filesystem::path& path, uint64_t sourceHash, ModelData& outModelData);
+	bool ReadMesh(const std::filesystem::path& path, uint64_t sourceHash, ResourceMesh<MeshVertex>& outResourceMesh);
+}
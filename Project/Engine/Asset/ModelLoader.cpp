@@ -6,24 +6,36 @@
 #include <Engine/Core/Debug/Assert.h>
 #include <Engine/Core/Debug/SpdLogger.h>
 #include <Engine/Asset/TextureManager.h>
-#include <Engine/Asset/Filesystem.h>
+#include <Engine/Asset/ModelCache.h>
+#include <Engine/Core/Graphics/Mesh/MeshletBuilder.h>
 #include <Engine/Utility/Helper/Algorithm.h>
 
+// c++
+#include <algorithm>
+#include <chrono>
+
 //============================================================================
 //	ModelLoader classMethods
 //============================================================================
 
-void ModelLoader::Init(TextureManager* textureManager) {
+void ModelLoader::Init(TextureManager* textureManager, AssetLoadScheduler* loadScheduler,
+	AssetRegistry* assetRegistry) {
 
 	textureManager_ = nullptr;
 	textureManager_ = textureManager;
 
+	loadScheduler_ = nullptr;
+	loadScheduler_ = loadScheduler;
+
+	assetRegistry_ = nullptr;
+	assetRegistry_ = assetRegistry;
+
 	baseDirectoryPath_ = "./Assets/Models/";
+	// 名前からファイルを引けるように索引に登録する
+	assetRegistry_->AddRoot(baseDirectoryPath_);
+	cookedDirectoryPath_ = "./Assets/Cooked/Models/";
 	isCacheValid_ = false;
-
-	// ワーカースレッド起動
-	loadWorker_.Start([this](std::string&& name) {
-		this->LoadAsync(std::move(name)); });
+	loadStats_ = LoadStats{};
 }
 
 void ModelLoader::LoadSynch(const std::string& modelName) {
@@ -41,65 +53,62 @@ void ModelLoader::LoadSynch(const std::string& modelName) {
 
 	std::filesystem::path path;
 	// 見つからなければ処理しない
-	if (!Filesystem::FindByStem(baseDirectoryPath_, modelName, { ".obj", ".gltf" }, path)) {
+	if (!assetRegistry_->FindByStem(baseDirectoryPath_, modelName, { ".obj", ".gltf" }, path)) {
 		SpdLogger::Log("[Model][Missing] " + modelName);
+		loadScheduler_->MarkCompleted({ AssetJobType::Model, modelName });
 		return;
 	}
 
 	// モデル読み込み処理
-	ModelData modelData = LoadModelFile(path.string());
-	SpdLogger::Log("[Model][Loaded] " + modelName);
+	const auto begin = std::chrono::steady_clock::now();
+	bool isCooked = false;
+	ModelData modelData = LoadModelFile(path.string(), AssetLoadPriority::Current, isCooked);
+	const float milliseconds = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - begin).count();
+	SpdLogger::Log("[Model][Loaded] " + modelName + (isCooked ? " (cooked) " : " ") +
+		std::to_string(milliseconds) + "ms");
 
 	// 読み込みデータを設定
 	{
 		std::scoped_lock lk(modelMutex_);
 		models_[modelName] = std::move(modelData);
 		isCacheValid_ = false;
+		AddLoadStats(isCooked, milliseconds);
 	}
+	// 待っている読み込みを進める
+	loadScheduler_->MarkCompleted({ AssetJobType::Model, modelName });
 }
 
 void ModelLoader::Load(const std::string& modelName) {
 
-	RequestLoadAsync(modelName);
-	for (;;) {
-		{
-			std::scoped_lock lk(modelMutex_);
-			if (models_.contains(modelName)) break;
-		}
-		std::this_thread::sleep_for(std::chrono::milliseconds(1));
-	}
+	// 完了通知が来るまで待つ
+	RequestLoadAsync(modelName).Wait();
 }
 
-void ModelLoader::RequestLoadAsync(const std::string& modelName) {
+AssetLoadHandle ModelLoader::RequestLoadAsync(const std::string& modelName, AssetLoadPriority priority) {
 
+	const AssetJobKey key{ AssetJobType::Model, modelName };
 	// 既にロード済みなら何もしない
 	{
 		std::scoped_lock lk(modelMutex_);
 		if (models_.contains(modelName)) {
-			return;
+			return loadScheduler_->GetHandle(key);
 		}
 	}
-	// 重複チェック後にキューを追加
-	auto& queue = loadWorker_.RefAsyncQueue();
-	if (queue.IsClearCondition([&](const std::string& j) { return j == modelName; })) {
-		return;
+	// 投入済みなら優先度のみ更新される
+	if (loadScheduler_->Submit(key, priority, {},
+		[this, modelName, priority]() { this->LoadAsync(modelName, priority); })) {
+
+		SpdLogger::Log("[Model][Enqueue] " + modelName);
 	}
-	queue.AddQueue(modelName);
-	SpdLogger::Log("[Model][Enqueue] " + modelName);
+	return loadScheduler_->GetHandle(key);
 }
 
 void ModelLoader::WaitAll() {
 
-	for (;;) {
-		if (loadWorker_.GetAsyncQueue().IsEmpty()) {
-
-			break;
-		}
-		std::this_thread::sleep_for(std::chrono::milliseconds(1));
-	}
+	loadScheduler_->WaitIdle(AssetJobType::Model);
 }
 
-void ModelLoader::LoadAsync(std::string modelName) {
+void ModelLoader::LoadAsync(const std::string& modelName, AssetLoadPriority priority) {
 
 	// 重複読み込みを行わないようにチェック
 	{
@@ -114,47 +123,85 @@ void ModelLoader::LoadAsync(std::string modelName) {
 
 	std::filesystem::path path;
 	// 見つからなければ処理しない
-	if (!Filesystem::FindByStem(baseDirectoryPath_, modelName, { ".obj", ".gltf" }, path)) {
+	if (!assetRegistry_->FindByStem(baseDirectoryPath_, modelName, { ".obj", ".gltf" }, path)) {
 		SpdLogger::Log("[Model][Missing] " + modelName);
 		return;
 	}
 
 	// モデル読み込み処理
-	ModelData modelData = LoadModelFile(path.string());
-	SpdLogger::Log("[Model][Loaded] " + modelName);
+	const auto begin = std::chrono::steady_clock::now();
+	bool isCooked = false;
+	ModelData modelData = LoadModelFile(path.string(), priority, isCooked);
+	const float milliseconds = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - begin).count();
+	SpdLogger::Log("[Model][Loaded] " + modelName + (isCooked ? " (cooked) " : " ") +
+		std::to_string(milliseconds) + "ms");
 
 	// 読み込みデータを設定
 	{
 		std::scoped_lock lk(modelMutex_);
 		models_[modelName] = std::move(modelData);
 		isCacheValid_ = false;
+		AddLoadStats(isCooked, milliseconds);
 	}
 }
 
-ModelData ModelLoader::LoadModelFile(const std::string& filePath) {
-
-	ModelData modelData;            // 構築するModelData
-	std::vector<Vector4> positions; // 位置
-	std::vector<Vector3> normals;   // 法線
-	std::vector<Vector2> texcoords; // テクスチャ座標
-	std::string line;               // ファイルから読んだ1行を格納するもの
+ModelData ModelLoader::LoadModelFile(const std::string& filePath, AssetLoadPriority priority, bool& isCooked) {
+
+	ModelData modelData; // 構築するModelData
+
+	// 元ファイルが変わっていなければ解析済みのものを使う
+	const uint64_t sourceHash = ModelCache::HashSource(filePath, *assetRegistry_);
+	const std::filesystem::path cookedPath = ModelCache::MakeCookedPath(
+		baseDirectoryPath_, cookedDirectoryPath_, filePath);
+	isCooked = ModelCache::ReadModel(cookedPath, sourceHash, modelData);
+	if (!isCooked) {
+
+		Assimp::Importer importer;
+		const aiScene* scene = importer.ReadFile(filePath.c_str(),
+			aiProcess_FlipWindingOrder |
+			aiProcess_FlipUVs |
+			aiProcess_Triangulate |
+			aiProcess_GenSmoothNormals |
+			aiProcess_CalcTangentSpace |
+			aiProcess_JoinIdenticalVertices |
+			aiProcess_ImproveCacheLocality |
+			aiProcess_RemoveRedundantMaterials |
+			aiProcess_SortByPType);
+
+		// メッシュがないのには対応しない
+		assert(scene->HasMeshes());
+
+		ReadScene(scene, modelData);
+
+		// meshletも同じシーンから作って書き出し、MeshRegistryで読み直さないようにする
+		MeshletBuilder meshletBuilder{};
+		const ResourceMesh<MeshVertex> resourceMesh =
+			meshletBuilder.ParseMesh(scene, !modelData.skinClusterData.empty());
+		if (!ModelCache::Write(cookedPath, sourceHash, modelData, resourceMesh)) {
+
+			SpdLogger::Log("[Model][CookFailed] " + filePath);
+		}
+	}
 
 	modelData.fullPath = filePath; // フルパスを格納
+	modelData.cookedPath = cookedPath.string();
+	modelData.sourceHash = sourceHash;
 
-	Assimp::Importer importer;
-	const aiScene* scene = importer.ReadFile(filePath.c_str(),
-		aiProcess_FlipWindingOrder |
-		aiProcess_FlipUVs |
-		aiProcess_Triangulate |
-		aiProcess_GenSmoothNormals |
-		aiProcess_CalcTangentSpace |
-		aiProcess_JoinIdenticalVertices |
-		aiProcess_ImproveCacheLocality |
-		aiProcess_RemoveRedundantMaterials |
-		aiProcess_SortByPType);
-
-	// メッシュがないのには対応しない
-	assert(scene->HasMeshes());
+	// 使用するテクスチャの読み込み要求
+	for (const auto& mesh : modelData.meshes) {
+		if (mesh.textureName.has_value()) {
+
+			textureManager_->RequestLoadAsync(mesh.textureName.value(), priority);
+		}
+		if (mesh.normalMapTexture.has_value()) {
+
+			textureManager_->RequestLoadAsync(mesh.normalMapTexture.value(), priority);
+		}
+	}
+	return modelData;
+}
+
+void ModelLoader::ReadScene(const aiScene* scene, ModelData& modelData) {
 
 	// メッシュ解析
 	for (uint32_t meshIndex = 0; meshIndex < scene->mNumMeshes; ++meshIndex) {
@@ -236,8 +283,6 @@ ModelData ModelLoader::LoadModelFile(const std::string& filePath) {
 			std::filesystem::path name(meshModelData.textureName.value());
 			std::string identifier = name.stem().string();
 			meshModelData.textureName = identifier;
-
-			textureManager_->RequestLoadAsync(meshModelData.textureName.value());
 		}
 		// NORMALS
 		if (material->GetTextureCount(aiTextureType_NORMALS) > 0 ||
@@ -255,8 +300,6 @@ ModelData ModelLoader::LoadModelFile(const std::string& filePath) {
 			std::filesystem::path normalNamePath(meshModelData.normalMapTexture.value());
 			std::string normalIdentifier = normalNamePath.stem().string();
 			meshModelData.normalMapTexture = normalIdentifier;
-
-			textureManager_->RequestLoadAsync(meshModelData.normalMapTexture.value());
 		}
 		// BaseColor
 		aiColor4D baseColor;
@@ -270,8 +313,6 @@ ModelData ModelLoader::LoadModelFile(const std::string& filePath) {
 
 	// 階層構造の作成
 	modelData.rootNode = ReadNode(scene->mRootNode);
-
-	return modelData;
 }
 
 Node ModelLoader::ReadNode(aiNode* node) {
@@ -347,8 +388,31 @@ const std::vector<std::string>& ModelLoader::GetModelKeys() const {
 	return modelKeysCache_;
 }
 
+void ModelLoader::AddLoadStats(bool isCooked, float milliseconds) {
+
+	LoadStat& stat = isCooked ? loadStats_.cooked : loadStats_.imported;
+	++stat.count;
+	stat.totalMilliseconds += milliseconds;
+	stat.maxMilliseconds = (std::max)(stat.maxMilliseconds, milliseconds);
+}
+
 void ModelLoader::ReportUsage(bool listAll) const {
 
+	// 読み込み時間、キャッシュから読んだものと解析したもので分ける
+	{
+		std::scoped_lock lock(modelMutex_);
+		auto report = [](const char* label, const LoadStat& stat) {
+			if (stat.count == 0) {
+				return;
+			}
+			LOG_ASSET_INFO("[Model] LoadTime {}: {} models, total {:.2f}ms, avg {:.2f}ms, max {:.2f}ms",
+				label, stat.count, stat.totalMilliseconds,
+				stat.totalMilliseconds / static_cast<float>(stat.count), stat.maxMilliseconds);
+			};
+		report("cooked", loadStats_.cooked);
+		report("imported", loadStats_.imported);
+	}
+
 	// ロード済みだが未使用の場合のログ出力
 	std::vector<std::string> unused;
 	unused.reserve(models_.size());
@@ -374,17 +438,8 @@ void ModelLoader::ReportUsage(bool listAll) const {
 	}
 
 	// フォルダ内にあるにも関わらず未使用
-	std::unordered_set<std::string> onDisk;
-	for (const auto& entry : std::filesystem::recursive_directory_iterator(baseDirectoryPath_)) {
-		if (!entry.is_regular_file()) {
-			continue;
-		}
-		const auto ext = entry.path().extension().string();
-		if (ext == ".obj" || ext == ".gltf") {
-
-			onDisk.insert(entry.path().stem().string());
-		}
-	}
+	const std::vector<std::string> onDisk = assetRegistry_->CollectStems(
+		baseDirectoryPath_, { ".obj", ".gltf" });
 
 	std::unordered_set<std::string> loaded;
 	loaded.reserve(models_.size());
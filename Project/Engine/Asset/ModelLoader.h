@@ -4,7 +4,8 @@
 //	include
 //============================================================================
 #include <Engine/Asset/AssetStructure.h>
-#include <Engine/Asset/Async/AssetLoadWorker.h>
+#include <Engine/Asset/Async/AssetLoadScheduler.h>
+#include <Engine/Asset/AssetRegistry.h>
 
 // c++
 #include <unordered_map>
@@ -28,21 +29,23 @@ public:
 	ModelLoader() = default;
 	~ModelLoader() = default;
 
-	// 依存するTextureManagerを受け取り、基準パス設定とワーカー起動を行う
-	void Init(TextureManager* textureManager);
+	// 依存するTextureManagerと共有の読み込みスケジューラを受け取り、基準パス設定を行う
+	void Init(TextureManager* textureManager, AssetLoadScheduler* loadScheduler,
+		AssetRegistry* assetRegistry);
 
 	// 同期ロード：指定モデルを即時読み込みし、内部キャッシュへ登録
 	void LoadSynch(const std::string& modelName);
 	// 非同期ロードを要求し、完了までブロックして待機
 	void Load(const std::string& modelName);
-	// 非同期ロードをキューに積む(既存/重複を抑止)
-	void RequestLoadAsync(const std::string& modelName);
+	// 非同期ロードをスケジューラに積む(既存/重複を抑止)、完了待ちのハンドルを返す
+	AssetLoadHandle RequestLoadAsync(const std::string& modelName,
+		AssetLoadPriority priority = AssetLoadPriority::Current);
 
 	// 指定モデルが既にロード済みかを確認
 	bool Search(const std::string& modelName);
-	// 全非同期ジョブの完了を待機
+	// 投入済みの読み込みが全て終わるまで待機
 	void WaitAll();
-	// 未使用/未ロード(ディスクのみ)を集計しログ出力listAllで一覧
+	// 読み込み時間と未使用/未ロード(ディスクのみ)を集計しログ出力listAllで一覧
 	void ReportUsage(bool listAll) const;
 
 	//--------- accessor -----------------------------------------------------
@@ -56,11 +59,27 @@ private:
 	//	private Methods
 	//========================================================================
 
+	//--------- structure ----------------------------------------------------
+
+	// 読み込み時間の集計
+	struct LoadStat {
+
+		uint32_t count = 0;
+		float totalMilliseconds = 0.0f;
+		float maxMilliseconds = 0.0f;
+	};
+	struct LoadStats {
+
+		LoadStat cooked;   // キャッシュから読んだ
+		LoadStat imported; // Assimpで解析した
+	};
+
 	//--------- variables ----------------------------------------------------
 
 	TextureManager* textureManager_;
 
 	std::string baseDirectoryPath_;
+	std::string cookedDirectoryPath_;
 
 	std::unordered_map<std::string, ModelData> models_;
 
@@ -68,16 +87,24 @@ private:
 	mutable bool isCacheValid_;
 
 	// 非同期処理
-	AssetLoadWorker<std::string> loadWorker_;
+	AssetLoadScheduler* loadScheduler_;
+	AssetRegistry* assetRegistry_;
 	mutable std::mutex modelMutex_;
+	LoadStats loadStats_;
 
 	//--------- functions ----------------------------------------------------
 
 	// 読み込み、頂点/ボーン/マテリアルを解析してModelDataを生成
-	ModelData LoadModelFile(const std::string& filePath);
+	// 解析済みのキャッシュがあればそちらを使い、なければ解析結果とmeshletを書き出す
+	// 使用するテクスチャはpriorityで読み込みを要求する
+	ModelData LoadModelFile(const std::string& filePath, AssetLoadPriority priority, bool& isCooked);
+	// Assimpのシーンからメッシュ/ボーン/マテリアル/階層を読み取る
+	void ReadScene(const aiScene* scene, ModelData& modelData);
 	// AssimpノードからSRTと階層を再帰的に読み取り、Nodeを構築
 	Node ReadNode(aiNode* node);
 
 	// 非同期ジョブ本体：重複を避けつつ指定モデルをロードして登録
-	void LoadAsync(std::string modelName);
+	void LoadAsync(const std::string& modelName, AssetLoadPriority priority);
+	// 読み込み時間を集計する、modelMutex_を取った状態で呼ぶ
+	void AddLoadStats(bool isCooked, float milliseconds);
 };
\ No newline at end of file
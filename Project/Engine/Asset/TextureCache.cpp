@@ -0,0 +1,186 @@
+#include "TextureCache.h"
+
+//============================================================================
+//	include
+//============================================================================
+#include <Engine/Asset/MappedFile.h>
+#include <Engine/Utility/Helper/Algorithm.h>
+
+// c++
+#include <cstring>
+#include <fstream>
+#include <string>
+
+//============================================================================
+//	TextureCache Methods
+//============================================================================
+
+namespace {
+
+	// ファイル識別子とバージョン
+	constexpr uint32_t kCookedMagic = 0x58455443; // "CTEX"
+	constexpr uint32_t kCookedVersion = 1;
+
+	// 生成するミップの段数
+	constexpr size_t kMipLevels = 4;
+
+	// ファイル先頭、直後にDDSが続く
+	struct Header {
+
+		uint32_t magic;
+		uint32_t version;
+		uint32_t encoderVersion;
+		uint32_t reserved;
+		uint64_t sourceHash;
+		uint64_t ddsSize;
+	};
+}
+
+bool TextureCache::IsNormalMap(const std::filesystem::path& sourcePath) {
+
+	const std::wstring stemLower = Algorithm::ToLowerW(sourcePath.stem().wstring());
+	return (stemLower.find(L"normal") != std::wstring::npos) ||
+		Algorithm::EndsWithW(stemLower, L"_n") ||
+		(stemLower.find(L"_nrm") != std::wstring::npos);
+}
+
+std::filesystem::path TextureCache::MakeCookedPath(const std::filesystem::path& sourceDirectory,
+	const std::filesystem::path& cookedDirectory, const std::filesystem::path& sourcePath) {
+
+	// 別の階層にある同じ名前のものと重ならないようにする
+	std::filesystem::path relative = sourcePath.lexically_normal().lexically_relative(
+		sourceDirectory.lexically_normal());
+	relative.replace_extension(".ctex");
+	return cookedDirectory / relative;
+}
+
+HRESULT TextureCache::LoadSource(const std::filesystem::path& sourcePath, DirectX::ScratchImage& outImage) {
+
+	DirectX::ScratchImage image{};
+	const bool isNormal = IsNormalMap(sourcePath);
+
+	HRESULT hr = S_OK;
+	// dds拡張子かどうかで分岐させる
+	if (sourcePath.extension() == ".dds") {
+
+		hr = DirectX::LoadFromDDSFile(sourcePath.c_str(), DirectX::DDS_FLAGS_NONE, nullptr, image);
+	} else {
+
+		// 法線テクスチャかどうかでLinearかSRGBか変える
+		const DirectX::WIC_FLAGS wicFlags = isNormal ? static_cast<DirectX::WIC_FLAGS>(
+			DirectX::WIC_FLAGS_IGNORE_SRGB | DirectX::WIC_FLAGS_DEFAULT_SRGB) :
+			static_cast<DirectX::WIC_FLAGS>(DirectX::WIC_FLAGS_FORCE_SRGB | DirectX::WIC_FLAGS_DEFAULT_SRGB);
+		hr = DirectX::LoadFromWICFile(sourcePath.c_str(), wicFlags, nullptr, image);
+	}
+	if (FAILED(hr)) {
+		return hr;
+	}
+
+	// 圧縮フォーマットだったらそのまま使用する
+	if (DirectX::IsCompressed(image.GetMetadata().format)) {
+
+		outImage = std::move(image);
+		return S_OK;
+	}
+
+	// ミップマップの作成 → 元画像よりも小さなテクスチャ群
+	const auto mipFilter = isNormal ? DirectX::TEX_FILTER_DEFAULT : DirectX::TEX_FILTER_SRGB;
+	return DirectX::GenerateMipMaps(image.GetImages(), image.GetImageCount(), image.GetMetadata(),
+		mipFilter, kMipLevels, outImage);
+}
+
+bool TextureCache::Cook(const std::filesystem::path& sourcePath, const std::filesystem::path& cookedPath,
+	uint64_t sourceHash) {
+
+	DirectX::ScratchImage mipImages{};
+	if (FAILED(LoadSource(sourcePath, mipImages))) {
+		return false;
+	}
+
+	// ブロック圧縮、最上位が4の倍数でないとBCのリソースを作れないのでその場合は非圧縮のまま保存する
+	DirectX::ScratchImage compressed{};
+	const DirectX::ScratchImage* output = &mipImages;
+	const DirectX::TexMetadata& meta = mipImages.GetMetadata();
+	if (!DirectX::IsCompressed(meta.format) && meta.width % 4 == 0 && meta.height % 4 == 0) {
+
+		// 法線はxyのみ保存し、zはシェーダーで復元する
+		const DXGI_FORMAT format = IsNormalMap(sourcePath) ?
+			DXGI_FORMAT_BC5_UNORM : DXGI_FORMAT_BC7_UNORM_SRGB;
+		const HRESULT hr = DirectX::Compress(mipImages.GetImages(), mipImages.GetImageCount(), meta,
+			format, DirectX::TEX_COMPRESS_PARALLEL, DirectX::TEX_THRESHOLD_DEFAULT, compressed);
+		if (FAILED(hr)) {
+			return false;
+		}
+		output = &compressed;
+	}
+
+	DirectX::Blob dds{};
+	if (FAILED(DirectX::SaveToDDSMemory(output->GetImages(), output->GetImageCount(),
+		output->GetMetadata(), DirectX::DDS_FLAGS_NONE, dds))) {
+		return false;
+	}
+
+	std::error_code error;
+	std::filesystem::create_directories(cookedPath.parent_path(), error);
+
+	// 書き込み途中のファイルを読まないように別名で書いてから置き換える
+	std::filesystem::path tempPath = cookedPath;
+	tempPath += ".tmp";
+	{
+		std::ofstream file(tempPath, std::ios::binary | std::ios::trunc);
+		if (!file) {
+			return false;
+		}
+
+		Header header{};
+		header.magic = kCookedMagic;
+		header.version = kCookedVersion;
+		header.encoderVersion = kEncoderVersion;
+		header.sourceHash = sourceHash;
+		header.ddsSize = dds.GetBufferSize();
+		file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+		file.write(static_cast<const char*>(dds.GetBufferPointer()),
+			static_cast<std::streamsize>(dds.GetBufferSize()));
+		if (!file) {
+			return false;
+		}
+	}
+	std::filesystem::rename(tempPath, cookedPath, error);
+	return !error;
+}
+
+bool TextureCache::IsValid(const std::filesystem::path& cookedPath, uint64_t sourceHash) {
+
+	std::ifstream file(cookedPath, std::ios::binary);
+	Header header{};
+	if (!file || !file.read(reinterpret_cast<char*>(&header), sizeof(Header))) {
+		return false;
+	}
+	return header.magic == kCookedMagic &&
+		header.version == kCookedVersion &&
+		header.encoderVersion == kEncoderVersion &&
+		header.sourceHash == sourceHash;
+}
+
+bool TextureCache::Read(const std::filesystem::path& cookedPath, uint64_t sourceHash,
+	DirectX::ScratchImage& outImage) {
+
+	MappedFile file(cookedPath);
+	if (!file.GetData() || file.GetSize() < sizeof(Header)) {
+		return false;
+	}
+
+	Header header{};
+	std::memcpy(&header, file.GetData(), sizeof(Header));
+	if (header.magic != kCookedMagic ||
+		header.version != kCookedVersion ||
+		header.encoderVersion != kEncoderVersion ||
+		header.sourceHash != sourceHash ||
+		file.GetSize() - sizeof(Header) < header.ddsSize) {
+		return false;
+	}
+
+	// ミップと圧縮は済んでいるので展開のみ行う
+	return SUCCEEDED(DirectX::LoadFromDDSMemory(file.GetData() + sizeof(Header),
+		static_cast<size_t>(header.ddsSize), DirectX::DDS_FLAGS_NONE, nullptr, outImage));
+}
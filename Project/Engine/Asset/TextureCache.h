@@ -0,0 +1,45 @@
+#pragma once
+
+//============================================================================
+//	include
+//============================================================================
+#include <Externals/DirectXTex/DirectXTex.h>
+
+// c++
+#include <cstdint>
+#include <filesystem>
+
+//============================================================================
+//	TextureCache namespace
+//	ミップ生成とブロック圧縮を済ませたテクスチャ(.ctex)の作成と読み込みを行う。
+//	カラーはBC7(sRGB)、法線はBC5で圧縮し、DDSとしてそのまま転送できる形で保存する。
+//	元ファイルのハッシュと変換処理のバージョンが一致する時のみ使用する
+//============================================================================
+namespace TextureCache {
+
+	//--------- variables ----------------------------------------------------
+
+	// 圧縮設定やミップの作り方を変えた時に上げる、古いファイルは作り直される
+	constexpr uint32_t kEncoderVersion = 1;
+
+	//--------- functions ----------------------------------------------------
+
+	// 名前から法線テクスチャかどうかを判定する、法線はLinearで扱う
+	bool IsNormalMap(const std::filesystem::path& sourcePath);
+
+	// 元ファイルの階層を保ったまま、cookedDirectory以下の.ctexのパスにする
+	std::filesystem::path MakeCookedPath(const std::filesystem::path& sourceDirectory,
+		const std::filesystem::path& cookedDirectory, const std::filesystem::path& sourcePath);
+
+	// 元ファイルを読み込み、ミップを生成する。ddsは圧縮済みならそのまま返す
+	HRESULT LoadSource(const std::filesystem::path& sourcePath, DirectX::ScratchImage& outImage);
+
+	// ミップ生成と圧縮を行って書き出す
+	bool Cook(const std::filesystem::path& sourcePath, const std::filesystem::path& cookedPath,
+		uint64_t sourceHash);
+
+	// 先頭のみ読み、作り直しが不要か確認する
+	bool IsValid(const std::filesystem::path& cookedPath, uint64_t sourceHash);
+	// ハッシュが一致する時のみ読み込む。ファイルをマップしてDDSとして展開する
+	bool Read(const std::filesystem::path& cookedPath, uint64_t sourceHash, DirectX::ScratchImage& outImage);
+}
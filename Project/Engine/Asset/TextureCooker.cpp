@@ -0,0 +1,88 @@
+#include "TextureCooker.h"
+
+//============================================================================
+//	include
+//============================================================================
+#include <Engine/Asset/AssetRegistry.h>
+#include <Engine/Asset/TextureCache.h>
+#include <Engine/Core/Thread/JobSystem.h>
+#include <Engine/Core/Debug/SpdLogger.h>
+
+// windows
+#include <Windows.h>
+// c++
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+//============================================================================
+//	TextureCooker Methods
+//============================================================================
+
+TextureCooker::Result TextureCooker::CookAll(AssetRegistry& registry,
+	const std::filesystem::path& sourceDirectory, const std::filesystem::path& cookedDirectory) {
+
+	const auto begin = std::chrono::steady_clock::now();
+
+	// ddsは作成時に圧縮、ミップ生成されているので対象外
+	registry.AddRoot(sourceDirectory);
+	const std::vector<std::filesystem::path> sources = registry.CollectFiles(sourceDirectory, { ".png", ".jpg" });
+
+	// 1枚ずつ並列に変換する
+	std::atomic_uint32_t cooked = 0;
+	std::atomic_uint32_t upToDate = 0;
+	std::atomic_uint32_t failed = 0;
+	JobSystem::GetInstance()->ParallelFor(static_cast<uint32_t>(sources.size()), 1,
+		[&](uint32_t first, uint32_t last) {
+			for (uint32_t i = first; i < last; ++i) {
+
+				const std::filesystem::path& source = sources[i];
+				const uint64_t sourceHash = registry.GetContentHash(source);
+				const std::filesystem::path cookedPath = TextureCache::MakeCookedPath(
+					sourceDirectory, cookedDirectory, source);
+				if (TextureCache::IsValid(cookedPath, sourceHash)) {
+
+					++upToDate;
+					continue;
+				}
+				if (TextureCache::Cook(source, cookedPath, sourceHash)) {
+
+					++cooked;
+					LOG_INFO("[TextureCooker][Cooked] {}", source.generic_string());
+				} else {
+
+					++failed;
+					LOG_WARN("[TextureCooker][Failed] {}", source.generic_string());
+				}
+			}
+		});
+
+	Result result{};
+	result.cooked = cooked;
+	result.upToDate = upToDate;
+	result.failed = failed;
+	result.milliseconds = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - begin).count();
+	return result;
+}
+
+int TextureCooker::RunHeadless() {
+
+	// WICで読み込むため
+	CoInitializeEx(nullptr, COINIT_MULTITHREADED);
+
+	SpdLogger::Init("textureCooker.log");
+	JobSystem::GetInstance()->Init();
+
+	Result result{};
+	{
+		AssetRegistry registry{};
+		registry.Init("./Assets/Cooked/AssetIndex.bin");
+		result = CookAll(registry, "./Assets/Textures/", "./Assets/Cooked/Textures/");
+	}
+	LOG_INFO("[TextureCooker] cooked: {}, upToDate: {}, failed: {}, {:.2f}ms",
+		result.cooked, result.upToDate, result.failed, result.milliseconds);
+
+	JobSystem::Finalize();
+	CoUninitialize();
+	return result.failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+//============================================================================
+//	include
+//============================================================================
+
+// c++
+#include <cstdint>
+#include <filesystem>
+
+// front
+class AssetRegistry;
+
+//============================================================================
+//	TextureCooker namespace
+//	テクスチャのディレクトリ以下のpng/jpgを、ミップ生成と圧縮を済ませた.ctexに変換する。
+//	元ファイルのハッシュが変わっていないものは飛ばすので、ビルドのたびに実行できる
+//============================================================================
+namespace TextureCooker {
+
+	//--------- structure ----------------------------------------------------
+
+	// 変換結果
+	struct Result {
+
+		uint32_t cooked = 0;   // 変換した
+		uint32_t upToDate = 0; // 変換済みだった
+		uint32_t failed = 0;
+		float milliseconds = 0.0f;
+	};
+
+	//--------- functions ----------------------------------------------------
+
+	// sourceDirectory以下を変換してcookedDirectoryに書き出す
+	Result CookAll(AssetRegistry& registry, const std::filesystem::path& sourceDirectory,
+		const std::filesystem::path& cookedDirectory);
+
+	// ウィンドウとデバイスを作らずに変換のみ行う。失敗があれば0以外を返す
+	int RunHeadless();
+}
@@ -7,15 +7,18 @@
 #include <Engine/Core/Debug/SpdLogger.h>
 #include <Engine/Core/Graphics/DxObject/DxCommand.h>
 #include <Engine/Core/Graphics/Descriptors/SRVDescriptor.h>
-#include <Engine/Asset/Filesystem.h>
+#include <Engine/Asset/TextureCache.h>
 #include <Engine/Utility/Helper/Algorithm.h>
 
+// c++
+#include <chrono>
+
 //============================================================================
 //	TextureManager classMethods
 //============================================================================
 
 void TextureManager::Init(ID3D12Device* device, DxCommand* dxCommand,
-	SRVDescriptor* srvDescriptor) {
+	SRVDescriptor* srvDescriptor, AssetLoadScheduler* loadScheduler, AssetRegistry* assetRegistry) {
 
 	device_ = nullptr;
 	device_ = device;
@@ -26,16 +29,22 @@ void TextureManager::Init(ID3D12Device* device, DxCommand* dxCommand,
 	srvDescriptor_ = nullptr;
 	srvDescriptor_ = srvDescriptor;
 
+	loadScheduler_ = nullptr;
+	loadScheduler_ = loadScheduler;
+
+	assetRegistry_ = nullptr;
+	assetRegistry_ = assetRegistry;
+
 	baseDirectoryPath_ = "./Assets/Textures/";
+	cookedDirectoryPath_ = "./Assets/Cooked/Textures/";
+	loadStats_ = LoadStats{};
+	// 名前からファイルを引けるように索引に登録する
+	assetRegistry_->AddRoot(baseDirectoryPath_);
 	isCacheValid_ = false;
 
 	// 転送用
 	dxUploadCommand_ = std::make_unique<DxUploadCommand>();
 	dxUploadCommand_->Create(device_);
-
-	// ワーカースレッド起動
-	loadWorker_.Start([this](std::string&& name) {
-		this->LoadAsync(std::move(name)); });
 }
 
 void TextureManager::LoadSynch(const std::string& textureName) {
@@ -53,72 +62,57 @@ void TextureManager::LoadSynch(const std::string& textureName) {
 
 	std::filesystem::path path;
 	// 見つからなければ処理しない
-	if (!Filesystem::FindByStem(baseDirectoryPath_, textureName, { ".png",".jpg",".dds" }, path)) {
+	if (!assetRegistry_->FindByStem(baseDirectoryPath_, textureName, { ".png",".jpg",".dds" }, path)) {
 		SpdLogger::Log("[Texture][Missing] " + textureName);
+		loadScheduler_->MarkCompleted({ AssetJobType::Texture, textureName });
 		return;
 	}
 	// 識別名取得
 	const std::string identifier = path.stem().string();
 
 	// ミップマップの作成
+	const auto begin = std::chrono::steady_clock::now();
 	DirectX::TexMetadata meta{};
-	auto mip = GenerateMipMaps(path, meta);
+	bool isCooked = false;
+	auto mip = GenerateMipMaps(path, meta, isCooked);
 	// リソース作成してGPUに転送
-	CreateAndUpload(identifier, mip, meta);
-
-	// 階層を設定
-	{
-		std::scoped_lock lock(gpuMutex_);
-
-		std::filesystem::path relative = std::filesystem::relative(path, baseDirectoryPath_);
-		relative.replace_extension();
-		textures_[identifier].hierarchy = relative.generic_string();
-	}
+	CreateAndUpload(identifier, path, mip, meta);
+	AddLoadStats(identifier, isCooked,
+		std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - begin).count());
+	// 待っている読み込みを進める
+	loadScheduler_->MarkCompleted({ AssetJobType::Texture, textureName });
 
 	SpdLogger::Log("[Texture][SyncLoad][End] " + identifier);
 }
 
 void TextureManager::Load(const std::string& textureName) {
 
-	RequestLoadAsync(textureName);
-	for (;;) {
-		{
-			std::scoped_lock lk(gpuMutex_);
-			if (textures_.contains(textureName)) {
-				break;
-			}
-		}
-		std::this_thread::sleep_for(std::chrono::milliseconds(1));
-	}
+	// 完了通知が来るまで待つ
+	RequestLoadAsync(textureName).Wait();
 }
 
-void TextureManager::RequestLoadAsync(const std::string& textureName) {
+AssetLoadHandle TextureManager::RequestLoadAsync(const std::string& textureName, AssetLoadPriority priority) {
 
+	const AssetJobKey key{ AssetJobType::Texture, textureName };
 	// 既にロード済みなら何もしない
 	{
 		std::scoped_lock lk(gpuMutex_);
 		if (textures_.contains(textureName)) {
-			return;
+			return loadScheduler_->GetHandle(key);
 		}
 	}
-	// 重複チェック後にキューを追加
-	auto& queue = loadWorker_.RefAsyncQueue();
-	if (queue.IsClearCondition([&](const std::string& j) { return j == textureName; })) {
-		return;
+	// 投入済みなら優先度のみ更新される
+	if (loadScheduler_->Submit(key, priority, {},
+		[this, textureName]() { this->LoadAsync(textureName); })) {
+
+		SpdLogger::Log("[Texture][Enqueue] " + textureName);
 	}
-	queue.AddQueue(textureName);
-	SpdLogger::Log("[Texture][Enqueue] " + textureName);
+	return loadScheduler_->GetHandle(key);
 }
 
 void TextureManager::WaitAll() {
 
-	for (;;) {
-		if (loadWorker_.GetAsyncQueue().IsEmpty()) {
-
-			break;
-		}
-		std::this_thread::sleep_for(std::chrono::milliseconds(1));
-	}
+	loadScheduler_->WaitIdle(AssetJobType::Texture);
 }
 
 void TextureManager::LoadAsync(std::string name) {
@@ -136,7 +130,7 @@ void TextureManager::LoadAsync(std::string name) {
 
 	std::filesystem::path path;
 	// 見つからなければ処理しない
-	if (!Filesystem::FindByStem(baseDirectoryPath_, name, { ".png",".jpg",".dds" }, path)) {
+	if (!assetRegistry_->FindByStem(baseDirectoryPath_, name, { ".png",".jpg",".dds" }, path)) {
 		SpdLogger::Log("[Texture][Missing] " + name);
 		return;
 	}
@@ -144,62 +138,34 @@ void TextureManager::LoadAsync(std::string name) {
 	const std::string identifier = path.stem().string();
 
 	// ミップマップの作成
+	const auto begin = std::chrono::steady_clock::now();
 	DirectX::TexMetadata meta{};
-	auto mip = GenerateMipMaps(path, meta);
+	bool isCooked = false;
+	auto mip = GenerateMipMaps(path, meta, isCooked);
 	// リソース作成してGPUに転送
-	CreateAndUpload(identifier, mip, meta);
-
-	// 階層を設定
-	{
-		std::scoped_lock lock(gpuMutex_);
-
-		std::filesystem::path relative = std::filesystem::relative(path, baseDirectoryPath_);
-		relative.replace_extension();
-		textures_[identifier].hierarchy = relative.generic_string();
-	}
+	CreateAndUpload(identifier, path, mip, meta);
+	AddLoadStats(identifier, isCooked,
+		std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - begin).count());
 }
 
-DirectX::ScratchImage TextureManager::GenerateMipMaps(const std::filesystem::path& filePath, DirectX::TexMetadata& outMeta) {
-
-	// テクスチャファイルを呼んでプログラムを扱えるようにする
-	DirectX::ScratchImage image{};
-	std::wstring filePathW = Algorithm::ConvertString(filePath.string());
+DirectX::ScratchImage TextureManager::GenerateMipMaps(const std::filesystem::path& filePath,
+	DirectX::TexMetadata& outMeta, bool& isCooked) {
 
-	// 法線テクスチャかどうか
-	const std::wstring stemLower = Algorithm::ToLowerW(filePath.stem().wstring());
-	bool isNormal =
-		(stemLower.find(L"normal") != std::wstring::npos) ||
-		Algorithm::EndsWithW(stemLower, L"_n") ||
-		(stemLower.find(L"_nrm") != std::wstring::npos);
-	// 法線テクスチャかどうかでLinearかSRGBか変える
-	DirectX::WIC_FLAGS wicFlags = isNormal ? static_cast<DirectX::WIC_FLAGS>(
-		DirectX::WIC_FLAGS_IGNORE_SRGB | DirectX::WIC_FLAGS_DEFAULT_SRGB) :
-		static_cast<DirectX::WIC_FLAGS>(DirectX::WIC_FLAGS_FORCE_SRGB | DirectX::WIC_FLAGS_DEFAULT_SRGB);
-
-	HRESULT hr = DirectX::LoadFromWICFile(filePathW.c_str(), wicFlags, nullptr, image);
-	// dds拡張子かどうかで分岐させる
-	if (filePathW.ends_with(L".dds")) {
+	DirectX::ScratchImage mipImages{};
 
-		hr = DirectX::LoadFromDDSFile(filePathW.c_str(), DirectX::DDS_FLAGS_NONE, nullptr, image);
-	} else {
+	// 変換済みのものがあれば、ミップ生成と圧縮が済んだものをそのまま使う
+	isCooked = false;
+	if (filePath.extension() != ".dds") {
 
-		hr = DirectX::LoadFromWICFile(filePathW.c_str(),
-			DirectX::WIC_FLAGS_FORCE_SRGB | DirectX::WIC_FLAGS_DEFAULT_SRGB, nullptr, image);
+		const uint64_t sourceHash = assetRegistry_->GetContentHash(filePath);
+		const std::filesystem::path cookedPath = TextureCache::MakeCookedPath(
+			baseDirectoryPath_, cookedDirectoryPath_, filePath);
+		isCooked = TextureCache::Read(cookedPath, sourceHash, mipImages);
 	}
-	assert(SUCCEEDED(hr));
-
-	DirectX::ScratchImage mipImages{};
-	// 圧縮フォーマットかどうかチェックして分岐させる
-	if (DirectX::IsCompressed(image.GetMetadata().format)) {
-
-		// 圧縮フォーマットだったらそのまま使用する
-		mipImages = std::move(image);
-	} else {
+	if (!isCooked) {
 
-		// ミップマップの作成 → 元画像よりも小さなテクスチャ群
-		auto mipFilter = isNormal ? DirectX::TEX_FILTER_DEFAULT : DirectX::TEX_FILTER_SRGB;
-		hr = DirectX::GenerateMipMaps(image.GetImages(), image.GetImageCount(), image.GetMetadata(),
-			mipFilter, 4, mipImages);
+		// 未変換のものはデコードしてミップを生成する
+		HRESULT hr = TextureCache::LoadSource(filePath, mipImages);
 		assert(SUCCEEDED(hr));
 	}
 	// メタデータ取得
@@ -209,13 +175,19 @@ DirectX::ScratchImage TextureManager::GenerateMipMaps(const std::filesystem::pat
 	return mipImages;
 }
 
-void TextureManager::CreateAndUpload(const std::string& identifier,
+void TextureManager::CreateAndUpload(const std::string& identifier, const std::filesystem::path& path,
 	const DirectX::ScratchImage& mipImages, const DirectX::TexMetadata& meta) {
 
-	TextureData& texture = textures_[identifier];
+	// 登録は最後に行い、作成中のものを他のスレッドから見えないようにする
+	TextureData texture{};
 	texture.metadata = meta;
 	texture.isUse = false;
 
+	// 階層を設定
+	std::filesystem::path relative = std::filesystem::relative(path, baseDirectoryPath_);
+	relative.replace_extension();
+	texture.hierarchy = relative.generic_string();
+
 	// GPUリソース作成
 	{
 		D3D12_RESOURCE_DESC desc{};
@@ -258,6 +230,9 @@ void TextureManager::CreateAndUpload(const std::string& identifier,
 		assert(SUCCEEDED(hr));
 	}
 
+	// 転送用コマンドは共有なので1つずつ積んで実行する
+	std::unique_lock uploadLock(uploadMutex_);
+
 	ID3D12GraphicsCommandList* commandList = dxUploadCommand_->GetCommandList();
 	UpdateSubresources(commandList, texture.resource.Get(), uploadBuffer.Get(),
 		0, 0, static_cast<UINT>(subResources.size()), subResources.data());
@@ -273,10 +248,16 @@ void TextureManager::CreateAndUpload(const std::string& identifier,
 
 	// GPUに転送する
 	dxUploadCommand_->ExecuteCommands();
+	uploadLock.unlock();
 	SpdLogger::Log(std::string("[Texture][Upload->GPU][End]") + identifier);
 
 	std::scoped_lock lk(gpuMutex_);
 
+	// 同期読み込みと重なった場合は先に登録された方を使う
+	if (textures_.contains(identifier)) {
+		return;
+	}
+
 	// SRV作成
 	D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc{};
 	srvDesc.Format = meta.format;
@@ -300,11 +281,13 @@ void TextureManager::CreateAndUpload(const std::string& identifier,
 	// debug用にGPUResourceにtextureの名前を設定する
 	texture.resource->SetName(resourceName.c_str());
 
+	textures_.emplace(identifier, std::move(texture));
 	isCacheValid_ = false;
 }
 
 bool TextureManager::Search(const std::string& textureName) {
 
+	std::scoped_lock lock(gpuMutex_);
 	return Algorithm::Find(textures_, textureName);
 }
 
@@ -375,8 +358,35 @@ const std::vector<std::string>& TextureManager::GetTextureKeys() const {
 	return textureKeysCache_;
 }
 
+void TextureManager::AddLoadStats(const std::string& identifier, bool isCooked, float milliseconds) {
+
+	SpdLogger::Log("[Texture][Loaded] " + identifier + (isCooked ? " (cooked) " : " ") +
+		std::to_string(milliseconds) + "ms");
+
+	std::scoped_lock lock(gpuMutex_);
+	LoadStat& stat = isCooked ? loadStats_.cooked : loadStats_.decoded;
+	++stat.count;
+	stat.totalMilliseconds += milliseconds;
+	stat.maxMilliseconds = (std::max)(stat.maxMilliseconds, milliseconds);
+}
+
 void TextureManager::ReportUsage(bool listAll) const {
 
+	// 読み込み時間、変換済みのものと実行時にデコードしたもので分ける
+	{
+		std::scoped_lock lock(gpuMutex_);
+		auto report = [](const char* label, const LoadStat& stat) {
+			if (stat.count == 0) {
+				return;
+			}
+			LOG_ASSET_INFO("[Texture] LoadTime {}: {} textures, total {:.2f}ms, avg {:.2f}ms, max {:.2f}ms",
+				label, stat.count, stat.totalMilliseconds,
+				stat.totalMilliseconds / static_cast<float>(stat.count), stat.maxMilliseconds);
+			};
+		report("cooked", loadStats_.cooked);
+		report("decoded", loadStats_.decoded);
+	}
+
 	// ロード済みだが未使用の場合のログ出力
 	std::vector<std::string> unused;
 	unused.reserve(textures_.size());
@@ -402,17 +412,8 @@ void TextureManager::ReportUsage(bool listAll) const {
 	}
 
 	// フォルダ内にあるにも関わらず未使用
-	std::unordered_set<std::string> onDisk;
-	for (const auto& entry : std::filesystem::recursive_directory_iterator(baseDirectoryPath_)) {
-		if (!entry.is_regular_file()) {
-			continue;
-		}
-		const auto ext = entry.path().extension().string();
-		if (ext == ".png" || ext == ".jpg" || ext == ".dds" || ext == ".cube") {
-
-			onDisk.insert(entry.path().stem().string());
-		}
-	}
+	const std::vector<std::string> onDisk = assetRegistry_->CollectStems(
+		baseDirectoryPath_, { ".png", ".jpg", ".dds", ".cube" });
 
 	std::unordered_set<std::string> loaded;
 	loaded.reserve(textures_.size());
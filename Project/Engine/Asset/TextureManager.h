@@ -4,7 +4,8 @@
 //	include
 //============================================================================
 #include <Engine/Core/Graphics/DxObject/DxUploadCommand.h>
-#include <Engine/Asset/Async/AssetLoadWorker.h>
+#include <Engine/Asset/Async/AssetLoadScheduler.h>
+#include <Engine/Asset/AssetRegistry.h>
 
 // directX
 #include <Externals/DirectXTex/DirectXTex.h>
@@ -36,19 +37,21 @@ public:
 	TextureManager() = default;
 	~TextureManager() = default;
 
-	// 必要なデバイス/コマンド/ディスクリプタを受け取り、ワーカーとアップロード系を初期化
-	void Init(ID3D12Device* device, DxCommand* dxCommand, SRVDescriptor* srvDescriptor);
+	// 必要なデバイス/コマンド/ディスクリプタと共有の読み込みスケジューラを受け取り、アップロード系を初期化
+	void Init(ID3D12Device* device, DxCommand* dxCommand, SRVDescriptor* srvDescriptor,
+		AssetLoadScheduler* loadScheduler, AssetRegistry* assetRegistry);
 
 	// 同期ロード：即時読み込み→ミップ生成→GPU転送→SRV作成まで実行
 	void LoadSynch(const std::string& textureName);
 	// 非同期ロードを要求し、完了までブロックして待機
 	void Load(const std::string& textureName);
-	// 非同期ロードをキューに積む(重複/既存チェックあり)
-	void RequestLoadAsync(const std::string& textureName);
+	// 非同期ロードをスケジューラに積む(重複/既存チェックあり)、完了待ちのハンドルを返す
+	AssetLoadHandle RequestLoadAsync(const std::string& textureName,
+		AssetLoadPriority priority = AssetLoadPriority::Current);
 
 	// ロード済みかの有無を確認
 	bool Search(const std::string& textureName);
-	// キューが空になるまで待機
+	// 投入済みの読み込みが全て終わるまで待機
 	void WaitAll();
 	// 未使用/未ロード(ディスクのみ)を集計しログ出力listAllで一覧
 	void ReportUsage(bool listAll) const;
@@ -86,6 +89,19 @@ private:
 		mutable bool isUse = false;
 	};
 
+	// 読み込み時間の集計
+	struct LoadStat {
+
+		uint32_t count = 0;
+		float totalMilliseconds = 0.0f;
+		float maxMilliseconds = 0.0f;
+	};
+	struct LoadStats {
+
+		LoadStat cooked;  // 変換済みのものを読んだ
+		LoadStat decoded; // 実行時にデコード、ミップ生成した
+	};
+
 	//--------- variables ----------------------------------------------------
 
 	ID3D12Device* device_;
@@ -93,26 +109,37 @@ private:
 	SRVDescriptor* srvDescriptor_;
 
 	std::string baseDirectoryPath_;
+	// 変換済みテクスチャの出力先
+	std::string cookedDirectoryPath_;
 
 	std::unordered_map<std::string, TextureData> textures_;
+	// 読み込み時間の集計
+	LoadStats loadStats_;
 
 	mutable std::vector<std::string> textureKeysCache_;
 	mutable bool isCacheValid_;
 
 	// 非同期処理
+	AssetLoadScheduler* loadScheduler_;
+	AssetRegistry* assetRegistry_;
 	std::unique_ptr<DxUploadCommand> dxUploadCommand_;
 
-	AssetLoadWorker<std::string> loadWorker_;
-	std::mutex gpuMutex_;
+	// 登録済みテクスチャとSRVの保護
+	mutable std::mutex gpuMutex_;
+	// 転送用コマンドは1つなので、デコードは並列に行い転送のみ順番に行う
+	std::mutex uploadMutex_;
 
 	//--------- functions ----------------------------------------------------
 
-	// 拡張子や法線判定に応じて読み込み、適切なミップを生成して返す
-	DirectX::ScratchImage GenerateMipMaps(const std::filesystem::path& filePath, DirectX::TexMetadata& outMeta);
+	// 変換済みのものがあればそれを、無ければ拡張子や法線判定に応じて読み込み、適切なミップを生成して返す
+	DirectX::ScratchImage GenerateMipMaps(const std::filesystem::path& filePath,
+		DirectX::TexMetadata& outMeta, bool& isCooked);
+	// 読み込み時間を集計してログに出す
+	void AddLoadStats(const std::string& identifier, bool isCooked, float milliseconds);
 
 	// 非同期ジョブ本体：指定テクスチャを読み込み→GPUへアップロード→登録
 	void LoadAsync(std::string name);
-	// リソース作成・UploadCmdでの転送・SRV生成までをまとめて行う
-	void CreateAndUpload(const std::string& identifier,
+	// リソース作成・UploadCmdでの転送・SRV生成・登録までをまとめて行う
+	void CreateAndUpload(const std::string& identifier, const std::filesystem::path& path,
 		const DirectX::ScratchImage& mipImages, const DirectX::TexMetadata& meta);
 };
\ No newline at end of file
@@ -86,9 +86,12 @@ public:
 
 	void SetType(ColliderType type) { type_ = type; }
 	void SetTargetType(ColliderType target) { targetType_ = target; }
+	// 登録順の番号、CollisionManagerが設定する
+	void SetId(uint32_t id) { id_ = id; }
 
 	ColliderType GetType() const { return type_; }
 	ColliderType GetTargetType() const { return targetType_; }
+	uint32_t GetId() const { return id_; }
 
 	const CollisionShape::Shapes& GetShape() const { return shape_; }
 private:
@@ -112,4 +115,6 @@ private:
 	ColliderType targetType_; // 衝突相手のタイプ
 
 	CollisionShape::Shapes shape_; // 衝突判定を行う形状
+
+	uint32_t id_ = 0; // 登録順の番号、ペアとコールバックの順序に使う
 };
\ No newline at end of file
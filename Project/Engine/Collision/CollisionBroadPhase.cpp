@@ -0,0 +1,179 @@
+#include "CollisionBroadPhase.h"
+
+//============================================================================
+//	include
+//============================================================================
+#include <Engine/Collision/CollisionBody.h>
+
+// c++
+#include <cmath>
+#include <algorithm>
+
+//============================================================================
+//	CollisionPair Methods
+//============================================================================
+
+bool CollisionPairLess(const CollisionPair& pairA, const CollisionPair& pairB) {
+
+	if (pairA.first->GetId() != pairB.first->GetId()) {
+		return pairA.first->GetId() < pairB.first->GetId();
+	}
+	return pairA.second->GetId() < pairB.second->GetId();
+}
+
+//============================================================================
+//	SweepAndPruneBroadPhase classMethods
+//============================================================================
+
+void SweepAndPruneBroadPhase::AddBody(CollisionBody* body) {
+
+	proxies_.push_back(Proxy{ Vector3::AnyInit(0.0f), Vector3::AnyInit(0.0f), 0.0f, 0.0f, body });
+}
+
+void SweepAndPruneBroadPhase::RemoveBody(CollisionBody* body) {
+
+	// 並びを崩さないようにeraseする
+	auto it = std::find_if(proxies_.begin(), proxies_.end(),
+		[body](const Proxy& proxy) { return proxy.body == body; });
+	if (it != proxies_.end()) {
+
+		proxies_.erase(it);
+	}
+}
+
+void SweepAndPruneBroadPhase::Clear() {
+
+	proxies_.clear();
+}
+
+void SweepAndPruneBroadPhase::CollectPairs(std::vector<CollisionPair>& out) {
+
+	if (proxies_.empty()) {
+		return;
+	}
+
+	// 境界ボックスを更新
+	Vector3 sum = Vector3::AnyInit(0.0f);
+	Vector3 sumSq = Vector3::AnyInit(0.0f);
+	for (auto& proxy : proxies_) {
+
+		CollisionBounds::Compute(proxy.body->GetShape(), proxy.min, proxy.max);
+
+		const Vector3 center = (proxy.min + proxy.max) * 0.5f;
+		sum = sum + center;
+		sumSq = sumSq + center * center;
+	}
+
+	// 中心の分散が最も大きい軸で走査する、1軸に並んだ配置でも区間の重なりが少なくなる
+	const float count = static_cast<float>(proxies_.size());
+	const Vector3 variance = sumSq / count - (sum / count) * (sum / count);
+	sweepAxis_ = 0;
+	if (variance.x < variance.y) {
+		sweepAxis_ = 1;
+	}
+	if ((sweepAxis_ == 0 ? variance.x : variance.y) < variance.z) {
+		sweepAxis_ = 2;
+	}
+	for (auto& proxy : proxies_) {
+
+		proxy.sweepMin = GetAxisValue(proxy.min, sweepAxis_);
+		proxy.sweepMax = GetAxisValue(proxy.max, sweepAxis_);
+	}
+
+	// 前フレームの並びからの挿入ソート
+	// 並びが大きく崩れた場合は移動回数が上限を超えた時点でstd::sortに切り替える
+	const size_t maxShiftCount = proxies_.size() * kMaxShiftPerProxy;
+	size_t shiftCount = 0;
+	for (size_t i = 1; i < proxies_.size() && shiftCount <= maxShiftCount; ++i) {
+
+		Proxy proxy = proxies_[i];
+		size_t j = i;
+		while (0 < j && proxy.sweepMin < proxies_[j - 1].sweepMin) {
+
+			proxies_[j] = proxies_[j - 1];
+			--j;
+		}
+		proxies_[j] = proxy;
+		shiftCount += i - j;
+	}
+	if (maxShiftCount < shiftCount) {
+
+		std::sort(proxies_.begin(), proxies_.end(),
+			[](const Proxy& proxyA, const Proxy& proxyB) { return proxyA.sweepMin < proxyB.sweepMin; });
+	}
+
+	// 走査軸の区間が重なる間だけ走査し、3軸で絞り込む
+	for (size_t i = 0; i < proxies_.size(); ++i) {
+
+		const Proxy& proxyA = proxies_[i];
+		for (size_t j = i + 1; j < proxies_.size(); ++j) {
+
+			const Proxy& proxyB = proxies_[j];
+			if (proxyA.sweepMax < proxyB.sweepMin) {
+				break;
+			}
+			if (proxyA.max.x < proxyB.min.x || proxyB.max.x < proxyA.min.x ||
+				proxyA.max.y < proxyB.min.y || proxyB.max.y < proxyA.min.y ||
+				proxyA.max.z < proxyB.min.z || proxyB.max.z < proxyA.min.z) {
+				continue;
+			}
+
+			// ペアは登録番号順にそろえる
+			if (proxyA.body->GetId() < proxyB.body->GetId()) {
+
+				out.emplace_back(proxyA.body, proxyB.body);
+			} else {
+
+				out.emplace_back(proxyB.body, proxyA.body);
+			}
+		}
+	}
+}
+
+float SweepAndPruneBroadPhase::GetAxisValue(const Vector3& value, int axis) {
+
+	switch (axis) {
+	case 1:
+		return value.y;
+	case 2:
+		return value.z;
+	default:
+		return value.x;
+	}
+}
+
+//============================================================================
+//	CollisionBounds Methods
+//============================================================================
+
+void CollisionBounds::Compute(const CollisionShape::Shapes& shape, Vector3& outMin, Vector3& outMax) {
+
+	std::visit([&](const auto& shapeData) {
+		using ShapeType = std::decay_t<decltype(shapeData)>;
+
+		if constexpr (std::is_same_v<ShapeType, CollisionShape::Sphere>) {
+
+			const Vector3 extent = Vector3::AnyInit(shapeData.radius);
+			outMin = shapeData.center - extent;
+			outMax = shapeData.center + extent;
+		} else if constexpr (std::is_same_v<ShapeType, CollisionShape::AABB>) {
+
+			outMin = shapeData.GetMin();
+			outMax = shapeData.GetMax();
+		} else if constexpr (std::is_same_v<ShapeType, CollisionShape::OBB>) {
+
+			// 各軸の半径をワールド軸へ投影した和が範囲になる
+			Matrix4x4 rotateMatrix = Quaternion::MakeRotateMatrix(shapeData.rotate);
+			const float size[3] = { shapeData.size.x, shapeData.size.y, shapeData.size.z };
+			Vector3 extent = Vector3::AnyInit(0.0f);
+			for (int i = 0; i < 3; ++i) {
+
+				extent.x += std::abs(rotateMatrix.m[i][0]) * size[i];
+				extent.y += std::abs(rotateMatrix.m[i][1]) * size[i];
+				extent.z += std::abs(rotateMatrix.m[i][2]) * size[i];
+			}
+			outMin = shapeData.center - extent;
+			outMax = shapeData.center + extent;
+		}
+		}, shape);
+}
@@ -0,0 +1,102 @@
+#pragma once
+
+//============================================================================
+//	include
+//============================================================================
+#include <Engine/Collision/CollisionGeometry.h>
+
+// c++
+#include <vector>
+#include <utility>
+// front
+class CollisionBody;
+
+// 衝突候補のペア(firstの方が登録番号が小さい)
+using CollisionPair = std::pair<CollisionBody*, CollisionBody*>;
+// ペアを登録番号順に比較する、アドレス順だと実行ごとにコールバックの順序が変わるため
+bool CollisionPairLess(const CollisionPair& pairA, const CollisionPair& pairB);
+
+//============================================================================
+//	IBroadPhase class
+//	全ボディから、境界ボックスが重なる衝突候補ペアのみを抽出するIF
+//============================================================================
+class IBroadPhase {
+public:
+	//========================================================================
+	//	public Methods
+	//========================================================================
+
+	IBroadPhase() = default;
+	virtual ~IBroadPhase() = default;
+
+	// ボディの登録/解除
+	virtual void AddBody(CollisionBody* body) = 0;
+	virtual void RemoveBody(CollisionBody* body) = 0;
+	virtual void Clear() = 0;
+
+	// 候補ペアをoutに追加する。タイプの組み合わせ判定は呼び出し側で行う
+	virtual void CollectPairs(std::vector<CollisionPair>& out) = 0;
+};
+
+//============================================================================
+//	SweepAndPruneBroadPhase class
+//	中心の分散が最も大きい軸で区間をソートし、重なる区間のみ3軸で絞り込む。
+//	前フレームの並びを保持して挿入ソートするので、動きが小さければほぼ線形で済む
+//============================================================================
+class SweepAndPruneBroadPhase :
+	public IBroadPhase {
+public:
+	//========================================================================
+	//	public Methods
+	//========================================================================
+
+	SweepAndPruneBroadPhase() = default;
+	~SweepAndPruneBroadPhase() = default;
+
+	void AddBody(CollisionBody* body) override;
+	void RemoveBody(CollisionBody* body) override;
+	void Clear() override;
+
+	void CollectPairs(std::vector<CollisionPair>& out) override;
+private:
+	//========================================================================
+	//	private Methods
+	//========================================================================
+
+	//--------- structure ----------------------------------------------------
+
+	// 1ボディ分の境界ボックス
+	struct Proxy {
+
+		Vector3 min;
+		Vector3 max;
+		// 走査軸の区間
+		float sweepMin;
+		float sweepMax;
+		CollisionBody* body;
+	};
+
+	//--------- variables ----------------------------------------------------
+
+	// 挿入ソートで許す1ボディあたりの平均移動回数、超えたらstd::sortに切り替える
+	static constexpr size_t kMaxShiftPerProxy = 8;
+
+	// sweepMin順に並んだ境界ボックス
+	std::vector<Proxy> proxies_;
+	// 走査軸(0:x 1:y 2:z)
+	int sweepAxis_ = 0;
+
+	//--------- functions ----------------------------------------------------
+
+	static float GetAxisValue(const Vector3& value, int axis);
+};
+
+//============================================================================
+//	CollisionBounds namespace
+//	形状ごとのワールド境界ボックスを求める
+//============================================================================
+namespace CollisionBounds {
+
+	// 形状を包むAABBのmin/maxを求める
+	void Compute(const CollisionShape::Shapes& shape, Vector3& outMin, Vector3& outMax);
+}
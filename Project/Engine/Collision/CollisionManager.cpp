@@ -6,6 +6,9 @@
 #include <Engine/Core/Debug/Assert.h>
 #include <Engine/Core/Graphics/Renderer/LineRenderer.h>
 
+// c++
+#include <algorithm>
+
 //============================================================================
 //	CollisionManager classMethods
 //============================================================================
@@ -79,32 +82,59 @@ CollisionBody* CollisionManager::AddCollisionBody(const CollisionShape::Shapes&
 
 	CollisionBody* collider = new CollisionBody();
 	collider->SetShape(shape);
+	collider->SetId(nextBodyId_++);
 	colliders_.emplace_back(collider);
+	broadPhase_->AddBody(collider);
 
 	return collider;
 }
 
 void CollisionManager::RemoveCollisionBody(CollisionBody* collider) {
 
+	// コールバック中はペア配列を走査しているので、更新後にまとめて除去する
+	if (isUpdating_) {
+
+		removedBodies_.emplace_back(collider);
+		return;
+	}
+	EraseBody(collider);
+}
+
+void CollisionManager::EraseBody(CollisionBody* collider) {
+
 	auto itA = std::find(colliders_.begin(), colliders_.end(), collider);
 	if (itA != colliders_.end()) {
+
 		colliders_.erase(itA);
+		broadPhase_->RemoveBody(collider);
 	}
 
-	for (auto itB = preCollisions_.begin(); itB != preCollisions_.end();) {
-		if (itB->first == collider || itB->second == collider) {
-
-			itB = preCollisions_.erase(itB);
-		} else {
-			++itB;
-		}
-	}
+	// ソート順を保ったまま関連ペアを破棄
+	std::erase_if(preCollisions_, [collider](const CollisionPair& pair) {
+		return pair.first == collider || pair.second == collider; });
 }
 
 void CollisionManager::ClearAllCollision() {
 
 	colliders_.clear();
+	broadPhase_->Clear();
 	preCollisions_.clear();
+	currentCollisions_.clear();
+	removedBodies_.clear();
+	collidingBodies_.clear();
+}
+
+void CollisionManager::SetBroadPhase(std::unique_ptr<IBroadPhase> broadPhase) {
+
+	if (!broadPhase) {
+		return;
+	}
+
+	broadPhase_ = std::move(broadPhase);
+	for (CollisionBody* collider : colliders_) {
+
+		broadPhase_->AddBody(collider);
+	}
 }
 
 void CollisionManager::Update() {
@@ -113,54 +143,105 @@ void CollisionManager::Update() {
 		return;
 	}
 
-	std::unordered_set<std::pair<CollisionBody*, CollisionBody*>, pair_hash> currentCollisions;
+	// 境界ボックスが重なる候補ペアのみ取得
+	currentCollisions_.clear();
+	broadPhase_->CollectPairs(currentCollisions_);
+
+	auto hasPair = [](ColliderType a, ColliderType b) {
+		using T = std::underlying_type_t<ColliderType>;
+		return (static_cast<T>(a) & static_cast<T>(b)) != 0; };
+
+	// タイプの組み合わせと形状で絞り込む
+	std::erase_if(currentCollisions_, [&](const CollisionPair& pair) {
 
-	for (auto itA = colliders_.begin(); itA != colliders_.end(); ++itA) {
+		CollisionBody* colliderA = pair.first;
+		CollisionBody* colliderB = pair.second;
+		if (!hasPair(colliderA->GetTargetType(), colliderB->GetType()) &&
+			!hasPair(colliderB->GetTargetType(), colliderA->GetType())) {
+			return true;
+		}
+		return !IsColliding(colliderA, colliderB);
+		});
+	std::sort(currentCollisions_.begin(), currentCollisions_.end(), CollisionPairLess);
+
+	// Enter/Stay/Exitを発火
+	isUpdating_ = true;
+	DispatchEvents();
+	isUpdating_ = false;
 
-		auto itB = itA;
-		++itB;
+	std::swap(preCollisions_, currentCollisions_);
 
-		for (; itB != colliders_.end(); ++itB) {
+	// コールバック中に除去されたボディを反映
+	if (!removedBodies_.empty()) {
 
-			CollisionBody* colliderA = *itA;
-			CollisionBody* colliderB = *itB;
+		std::vector<CollisionBody*> removedBodies = std::move(removedBodies_);
+		removedBodies_.clear();
+		for (CollisionBody* collider : removedBodies) {
 
-			auto hasPair = [](ColliderType a, ColliderType b) {
-				using T = std::underlying_type_t<ColliderType>;
-				return (static_cast<T>(a) & static_cast<T>(b)) != 0; };
-			if (!hasPair(colliderA->GetTargetType(), colliderB->GetType()) &&
-				!hasPair(colliderB->GetTargetType(), colliderA->GetType())) {
-				continue;
+			EraseBody(collider);
+		}
+	}
+
+	// colliderの描画
+	DrawCollider();
+}
+
+void CollisionManager::DispatchEvents() {
+
+	// どちらもソート済みなのでマージしながら差分を取る
+	size_t preIndex = 0;
+	size_t currentIndex = 0;
+	while (preIndex < preCollisions_.size() || currentIndex < currentCollisions_.size()) {
+
+		const bool hasPre = preIndex < preCollisions_.size();
+		const bool hasCurrent = currentIndex < currentCollisions_.size();
+
+		if (hasCurrent && (!hasPre || CollisionPairLess(currentCollisions_[currentIndex], preCollisions_[preIndex]))) {
+
+			// 今フレームのみ: Enter
+			const CollisionPair& pair = currentCollisions_[currentIndex];
+			if (!IsRemoved(pair)) {
+
+				pair.first->TriggerOnCollisionEnter(pair.second);
+				pair.second->TriggerOnCollisionEnter(pair.first);
 			}
+			++currentIndex;
+		} else if (hasPre && (!hasCurrent || CollisionPairLess(preCollisions_[preIndex], currentCollisions_[currentIndex]))) {
 
-			if (IsColliding(colliderA, colliderB)) {
-				currentCollisions.insert({ colliderA, colliderB });
+			// 前フレームのみ: Exit
+			const CollisionPair& pair = preCollisions_[preIndex];
+			if (!IsRemoved(pair)) {
 
-				if (preCollisions_.find({ colliderA, colliderB }) == preCollisions_.end()) {
+				pair.first->TriggerOnCollisionExit(pair.second);
+				pair.second->TriggerOnCollisionExit(pair.first);
+			}
+			++preIndex;
+		} else {
 
-					colliderA->TriggerOnCollisionEnter(colliderB);
-					colliderB->TriggerOnCollisionEnter(colliderA);
-				} else {
+			// 両方: Stay
+			const CollisionPair& pair = currentCollisions_[currentIndex];
+			if (!IsRemoved(pair)) {
 
-					colliderA->TriggerOnCollisionStay(colliderB);
-					colliderB->TriggerOnCollisionStay(colliderA);
-				}
+				pair.first->TriggerOnCollisionStay(pair.second);
+				pair.second->TriggerOnCollisionStay(pair.first);
 			}
+			++preIndex;
+			++currentIndex;
 		}
 	}
+}
 
-	for (auto& collision : preCollisions_) {
-		if (currentCollisions.find(collision) == currentCollisions.end()) {
+bool CollisionManager::IsRemoved(const CollisionPair& pair) const {
 
-			collision.first->TriggerOnCollisionExit(collision.second);
-			collision.second->TriggerOnCollisionExit(collision.first);
+	if (removedBodies_.empty()) {
+		return false;
+	}
+	for (CollisionBody* removed : removedBodies_) {
+		if (pair.first == removed || pair.second == removed) {
+			return true;
 		}
 	}
-
-	preCollisions_ = currentCollisions;
-
-	// colliderの描画
-	DrawCollider();
+	return false;
 }
 
 bool CollisionManager::IsColliding(CollisionBody* colliderA, CollisionBody* colliderB) {
@@ -180,6 +261,15 @@ void CollisionManager::DrawCollider() {
 	LineRenderer* lineRenderer = LineRenderer::GetInstance();
 	if (!lineRenderer) return;
 
+	// 衝突中のボディを二分探索できるようにまとめる
+	collidingBodies_.clear();
+	for (const auto& collisionPair : preCollisions_) {
+
+		collidingBodies_.emplace_back(collisionPair.first);
+		collidingBodies_.emplace_back(collisionPair.second);
+	}
+	std::sort(collidingBodies_.begin(), collidingBodies_.end());
+
 	for (auto& collider : colliders_) {
 
 		const auto& shape = collider->GetShape();
@@ -196,13 +286,8 @@ void CollisionManager::DrawCollider() {
 		}
 
 		// コライダーが衝突しているかどうかを判定
-		bool isColliding = false;
-		for (const auto& collisionPair : preCollisions_) {
-			if (collisionPair.first == collider || collisionPair.second == collider) {
-				isColliding = true;
-				break;
-			}
-		}
+		const bool isColliding = std::binary_search(
+			collidingBodies_.begin(), collidingBodies_.end(), collider);
 
 		// 衝突状態に応じた色を設定
 		Color color = isColliding ? Color::Red() : Color::Convert(0x00ffffff);
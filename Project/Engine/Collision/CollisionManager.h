@@ -5,11 +5,12 @@
 //============================================================================
 #include <Engine/Collision/CollisionBody.h>
 #include <Engine/Collision/CollisionGeometry.h>
+#include <Engine/Collision/CollisionBroadPhase.h>
 
 // c++
-#include <list>
+#include <memory>
+#include <vector>
 #include <utility>
-#include <unordered_set>
 
 //============================================================================
 //	CollisionManager class
@@ -30,9 +31,12 @@ public:
 	// 全ての衝突情報をクリアする(ボディ/ペア)
 	void ClearAllCollision();
 
-	// 全ボディの組合せを走査し、衝突状態に応じてEnter/Stay/Exitを発火する
+	// ブロードフェーズで候補を絞り込み、衝突状態に応じてEnter/Stay/Exitを発火する
 	void Update();
 
+	// ブロードフェーズを差し替える(登録済みボディは引き継ぐ)
+	void SetBroadPhase(std::unique_ptr<IBroadPhase> broadPhase);
+
 	//--------- accessor -----------------------------------------------------
 
 	// シングルトン取得/破棄
@@ -42,26 +46,37 @@ private:
 	//========================================================================
 	//	private Methods
 	//========================================================================
-	
-	// ハッシュセット用のペアハッシュ
-	struct pair_hash {
-		template <class T1, class T2>
-		std::size_t operator () (const std::pair<T1, T2>& pair) const {
-			return std::hash<T1>()(pair.first) ^ std::hash<T2>()(pair.second);
-		}
-	};
 
 	//--------- variables ----------------------------------------------------
 
 	static CollisionManager* instance_;
 
-	std::list<CollisionBody*> colliders_;
-	std::unordered_set<std::pair<CollisionBody*, CollisionBody*>, pair_hash> preCollisions_;
+	std::vector<CollisionBody*> colliders_;
+	// 次に登録するボディの番号
+	uint32_t nextBodyId_ = 0;
+	std::unique_ptr<IBroadPhase> broadPhase_ = std::make_unique<SweepAndPruneBroadPhase>();
+
+	// 登録番号順にソート済みの衝突ペア(前フレーム/今フレーム)
+	std::vector<CollisionPair> preCollisions_;
+	std::vector<CollisionPair> currentCollisions_;
+
+	// 更新中に除去されたボディ(コールバック内での除去に対応する)
+	bool isUpdating_ = false;
+	std::vector<CollisionBody*> removedBodies_;
+
+	// 描画用、衝突中のボディ(ソート済み)
+	std::vector<CollisionBody*> collidingBodies_;
 
 	//--------- functions ----------------------------------------------------
 
 	// 2つのボディ形状に応じたディスパッチテーブルで交差を判定する
 	bool IsColliding(CollisionBody* colliderA, CollisionBody* colliderB);
+	// 前フレームとの差分からEnter/Stay/Exitを発火する
+	void DispatchEvents();
+	// ボディと関連するペアを除去する
+	void EraseBody(CollisionBody* collider);
+	// 更新中に除去されたボディか
+	bool IsRemoved(const CollisionPair& pair) const;
 
 	// デバッグ用に各コライダー形状を描画する
 	void DrawCollider();
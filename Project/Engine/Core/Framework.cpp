@@ -4,6 +4,7 @@
 //	include
 //============================================================================
 #include <Engine/Core/Debug/SpdLogger.h>
+#include <Engine/Core/Thread/JobSystem.h>
 #include <Engine/Input/Input.h>
 #include <Engine/Asset/AssetEditor.h>
 #include <Engine/Object/Core/ObjectManager.h>
@@ -65,6 +66,9 @@ Framework::Framework() {
 
 	fullscreenEnable_ = Config::kFullscreenEnable;
 
+	// job実行スレッド起動
+	JobSystem::GetInstance()->Init();
+
 	// window作成
 	winApp_ = std::make_unique<WinApp>();
 	winApp_->Create();
@@ -313,6 +317,7 @@ void Framework::Finalize() {
 	ObjectManager::GetInstance()->Finalize();
 	ParticleManager::GetInstance()->Finalize();
 	PostProcessSystem::GetInstance()->Finalize();
+	JobSystem::GetInstance()->Finalize();
 
 	winApp_.reset();
 	asset_.reset();
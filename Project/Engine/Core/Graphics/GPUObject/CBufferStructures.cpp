@@ -74,7 +74,7 @@ void TransformationMatrix::Update(const BaseTransform* parent, const Vector3& sc
 		}
 		world = world * parentMatrix;
 	}
-	worldInverseTranspose = Matrix4x4::Transpose(Matrix4x4::Inverse(world));
+	worldInverseTranspose = Matrix4x4::InverseTranspose3x3(world);
 }
 
 void SpriteMaterialForGPU::Init() {
@@ -70,8 +70,7 @@ void InstancedMeshBuffer::CreateSkinnedMeshBuffers(const std::string& name) {
 	meshGroup.wellUploadData.resize(meshNum);
 
 	//　bone、骨の数
-	const Skeleton skeleton = asset_->GetSkeletonData(name);
-	const uint32_t boneSize = static_cast<uint32_t>(skeleton.joints.size());
+	const uint32_t boneSize = static_cast<uint32_t>(asset_->GetSkeletonData(name)->joints.size());
 	meshGroup.boneSize = boneSize;
 
 	for (uint32_t meshIndex = 0; meshIndex < meshNum; ++meshIndex) {
@@ -4,6 +4,7 @@
 //	include
 //============================================================================
 #include <Engine/Asset/Asset.h>
+#include <Engine/Asset/ModelCache.h>
 #include <Engine/Core/Graphics/Mesh/MeshletBuilder.h>
 #include <Engine/Utility/Helper/Algorithm.h>
 
@@ -24,31 +25,64 @@ void MeshRegistry::RegisterMesh(const std::string& modelName,
 	bool isSkinned, uint32_t numInstance) {
 
 	// 作成済みの場合生成しない
-	if (Algorithm::Find(meshes_, modelName)) {
+	if (Contains(modelName)) {
 		return;
 	}
+	AddMesh(modelName, CreateMesh(modelName, isSkinned, numInstance));
+}
+
+std::unique_ptr<IMesh> MeshRegistry::CreateMesh(const std::string& modelName,
+	bool isSkinned, uint32_t numInstance) {
 
 	// 頂点、meshlet生成
 	const ResourceMesh<MeshVertex> resourceMesh = CreateMeshlet(modelName);
 
 	// meshの生成
+	std::unique_ptr<IMesh> mesh{};
 	if (isSkinned) {
 
-		meshes_[modelName] = std::make_unique<SkinnedMesh>();
+		mesh = std::make_unique<SkinnedMesh>();
 	} else {
 
-		meshes_[modelName] = std::make_unique<StaticMesh>();
+		mesh = std::make_unique<StaticMesh>();
 	}
-	meshes_[modelName]->Init(device_, resourceMesh,
+	mesh->Init(device_, resourceMesh,
 		isSkinned, numInstance);
+	return mesh;
+}
+
+void MeshRegistry::AddMesh(const std::string& modelName, std::unique_ptr<IMesh> mesh) {
+
+	std::scoped_lock lock(meshMutex_);
+	meshes_.emplace(modelName, std::move(mesh));
+}
+
+IMesh* MeshRegistry::GetMesh(const std::string& name) const {
+
+	std::scoped_lock lock(meshMutex_);
+	return meshes_.at(name).get();
+}
+
+bool MeshRegistry::Contains(const std::string& name) const {
+
+	std::scoped_lock lock(meshMutex_);
+	return meshes_.contains(name);
 }
 
 ResourceMesh<MeshVertex> MeshRegistry::CreateMeshlet(const std::string& modelName) {
 
+	const ModelData& modelData = asset_->GetModelData(modelName);
+
+	// 読み込み時に書き出したものを使う
+	ResourceMesh<MeshVertex> resourceMesh{};
+	if (ModelCache::ReadMesh(modelData.cookedPath, modelData.sourceHash, resourceMesh)) {
+		return resourceMesh;
+	}
+
+	// 書き出しに失敗していた場合は解析し直す
 	MeshletBuilder meshletBuilder{};
 
 	Assimp::Importer importer;
-	ModelData modelData = asset_->GetModelData(modelName);
 	const aiScene* scene = importer.ReadFile(modelData.fullPath,
 		aiProcess_FlipWindingOrder |
 		aiProcess_FlipUVs |
@@ -61,7 +95,6 @@ ResourceMesh<MeshVertex> MeshRegistry::CreateMeshlet(const std::string& modelNam
 		aiProcess_SortByPType);
 
 	// 頂点、meshlet生成
-	ResourceMesh<MeshVertex> resourceMesh{};
 	resourceMesh = meshletBuilder.ParseMesh(scene, !modelData.skinClusterData.empty());
 
 	return resourceMesh;
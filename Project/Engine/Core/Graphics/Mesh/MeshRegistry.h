@@ -6,6 +6,7 @@
 #include <Engine/Core/Graphics/Mesh/Mesh.h>
 
 // c++
+#include <mutex>
 #include <string>
 #include <unordered_map>
 // front
@@ -31,10 +32,19 @@ public:
 	void RegisterMesh(const std::string& modelName,
 		bool isSkinned, uint32_t numInstance);
 
+	// 登録せずにメッシュを作成する、ワーカースレッドから呼び出せる
+	std::unique_ptr<IMesh> CreateMesh(const std::string& modelName,
+		bool isSkinned, uint32_t numInstance);
+	// 作成済みのメッシュを登録する、登録済みなら破棄する
+	void AddMesh(const std::string& modelName, std::unique_ptr<IMesh> mesh);
+
 	//--------- accessor -----------------------------------------------------
 
 	// meshの取得
-	IMesh* GetMesh(const std::string& name) const { return meshes_.at(name).get(); }
+	IMesh* GetMesh(const std::string& name) const;
+	// 登録済みかどうか
+	bool Contains(const std::string& name) const;
+	// マップを直接参照する。登録と同じスレッドからのみ使用すること
 	const std::unordered_map<std::string, std::unique_ptr<IMesh>>& GetMeshes() const { return meshes_; }
 private:
 	//========================================================================
@@ -47,6 +57,7 @@ private:
 	Asset* asset_;
 
 	std::unordered_map<std::string, std::unique_ptr<IMesh>> meshes_;
+	mutable std::mutex meshMutex_;
 
 	//--------- functions ----------------------------------------------------
 
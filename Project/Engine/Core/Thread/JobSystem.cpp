@@ -0,0 +1,151 @@
+#include "JobSystem.h"
+
+//============================================================================
+//	include
+//============================================================================
+#include <Engine/Core/Debug/SpdLogger.h>
+
+// c++
+#include <algorithm>
+
+//============================================================================
+//	JobSystem classMethods
+//============================================================================
+
+JobSystem* JobSystem::instance_ = nullptr;
+
+JobSystem* JobSystem::GetInstance() {
+
+	if (instance_ == nullptr) {
+		instance_ = new JobSystem();
+	}
+	return instance_;
+}
+
+void JobSystem::Finalize() {
+
+	if (instance_ != nullptr) {
+
+		delete instance_;
+		instance_ = nullptr;
+	}
+}
+
+JobSystem::~JobSystem() {
+
+	// 全ワーカーを起床させて終了を待つ
+	{
+		std::scoped_lock lock(jobMutex_);
+		stop_ = true;
+	}
+	jobCondition_.notify_all();
+	for (auto& worker : workers_) {
+		if (worker.joinable()) {
+
+			worker.join();
+		}
+	}
+	workers_.clear();
+}
+
+void JobSystem::Init(uint32_t workerCount) {
+
+	// 起動済みなら何もしない
+	if (!workers_.empty()) {
+		return;
+	}
+
+	if (workerCount == 0) {
+
+		// メインスレッド分を除く
+		const uint32_t hardware = (std::max)(std::thread::hardware_concurrency(), 2u);
+		workerCount = hardware - 1;
+	}
+
+	stop_ = false;
+	workers_.reserve(workerCount);
+	for (uint32_t i = 0; i < workerCount; ++i) {
+
+		workers_.emplace_back([this]() { WorkerLoop(); });
+	}
+	LOG_INFO("jobSystem: workerCount: {}", workerCount);
+}
+
+void JobSystem::Submit(std::function<void()> job, JobCounter* counter) {
+
+	if (counter) {
+
+		counter->count.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	// ワーカーがいなければその場で実行する
+	if (workers_.empty()) {
+
+		Job inlineJob{ std::move(job), counter };
+		Execute(inlineJob);
+		return;
+	}
+
+	{
+		std::scoped_lock lock(jobMutex_);
+		jobs_.push_back(Job{ std::move(job), counter });
+	}
+	// 1スレッド起床させる
+	jobCondition_.notify_one();
+}
+
+void JobSystem::Wait(const JobCounter& counter) {
+
+	while (!counter.IsDone()) {
+
+		// 待っている間も他のジョブを処理する
+		if (!TryExecuteOne()) {
+
+			std::this_thread::yield();
+		}
+	}
+}
+
+void JobSystem::WorkerLoop() {
+
+	while (true) {
+
+		Job job{};
+		{
+			std::unique_lock lock(jobMutex_);
+			jobCondition_.wait(lock, [&] { return stop_ || !jobs_.empty(); });
+
+			if (stop_ && jobs_.empty()) {
+				return;
+			}
+
+			job = std::move(jobs_.front());
+			jobs_.pop_front();
+		}
+		Execute(job);
+	}
+}
+
+bool JobSystem::TryExecuteOne() {
+
+	Job job{};
+	{
+		std::scoped_lock lock(jobMutex_);
+		if (jobs_.empty()) {
+			return false;
+		}
+		job = std::move(jobs_.front());
+		jobs_.pop_front();
+	}
+	Execute(job);
+	return true;
+}
+
+void JobSystem::Execute(Job& job) {
+
+	job.task();
+	if (job.counter) {
+
+		job.counter->count.fetch_sub(1, std::memory_order_release);
+	}
+}
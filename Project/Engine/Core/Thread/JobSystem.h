@@ -0,0 +1,133 @@
+#pragma once
+
+//============================================================================
+//	include
+//============================================================================
+
+// c++
+#include <cstdint>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <condition_variable>
+
+//============================================================================
+//	JobCounter structure
+//	投入したジョブの残り数を保持する。0になれば全て完了
+//============================================================================
+struct JobCounter {
+
+	std::atomic_uint32_t count = 0;
+
+	// 全てのジョブが完了しているか
+	bool IsDone() const { return count.load(std::memory_order_acquire) == 0; }
+};
+
+//============================================================================
+//	JobSystem class
+//	ワーカースレッド群でジョブを並列実行する。
+//	待機中の呼び出し側スレッドもジョブを処理するため、入れ子の投入でも停止しない
+//============================================================================
+class JobSystem {
+public:
+	//========================================================================
+	//	public Methods
+	//========================================================================
+
+	JobSystem() = default;
+	~JobSystem();
+
+	// ワーカースレッドを起動する(0ならハードウェアスレッド数-1)
+	void Init(uint32_t workerCount = 0);
+
+	// ジョブを投入する。counterがあれば投入時に加算、完了時に減算される
+	void Submit(std::function<void()> job, JobCounter* counter = nullptr);
+
+	// counterが0になるまで、ジョブを処理しながら待機する
+	void Wait(const JobCounter& counter);
+
+	// [0, count)をchunkSize単位に分割して並列実行し、完了まで待機する
+	// func(begin, end)
+	template<class Func>
+	void ParallelFor(uint32_t count, uint32_t chunkSize, Func&& func);
+
+	//--------- accessor -----------------------------------------------------
+
+	// ワーカースレッド数を取得
+	uint32_t GetWorkerCount() const { return static_cast<uint32_t>(workers_.size()); }
+
+	// singleton
+	static JobSystem* GetInstance();
+	static void Finalize();
+private:
+	//========================================================================
+	//	private Methods
+	//========================================================================
+
+	//--------- structure ----------------------------------------------------
+
+	// 1ジョブ分の情報
+	struct Job {
+
+		std::function<void()> task;
+		JobCounter* counter = nullptr;
+	};
+
+	//--------- variables ----------------------------------------------------
+
+	static JobSystem* instance_;
+
+	std::vector<std::thread> workers_;
+
+	std::mutex jobMutex_;
+	std::condition_variable jobCondition_;
+	std::deque<Job> jobs_;
+
+	bool stop_ = false;
+
+	//--------- functions ----------------------------------------------------
+
+	// ワーカースレッドの処理ループ
+	void WorkerLoop();
+	// キューからジョブを1つ取り出して実行する(無ければfalse)
+	bool TryExecuteOne();
+	// ジョブを実行しcounterを減算する
+	void Execute(Job& job);
+};
+
+//============================================================================
+//	JobSystem templateMethods
+//============================================================================
+
+template<class Func>
+inline void JobSystem::ParallelFor(uint32_t count, uint32_t chunkSize, Func&& func) {
+
+	if (count == 0) {
+		return;
+	}
+	if (chunkSize == 0) {
+		chunkSize = 1;
+	}
+
+	// ワーカーがいない、または1チャンクに収まる場合はその場で処理する
+	if (workers_.empty() || count <= chunkSize) {
+
+		func(0u, count);
+		return;
+	}
+
+	// 先頭のチャンクは呼び出し側で処理し、残りを投入する
+	JobCounter counter{};
+	for (uint32_t begin = chunkSize; begin < count; begin += chunkSize) {
+
+		const uint32_t end = (std::min)(begin + chunkSize, count);
+		Submit([&func, begin, end]() { func(begin, end); }, &counter);
+	}
+	func(0u, chunkSize);
+
+	Wait(counter);
+}
@@ -266,6 +266,7 @@ void ImGuiEditor::Console() {
 		if (ImGui::BeginTabItem("GameObject")) {
 
 			GameTimer::ImGui();
+			ObjectManager::GetInstance()->GetSystemManager()->ImGui();
 			ImGui::EndTabItem();
 		}
 		if (ImGui::BeginTabItem("ResourceView")) {
@@ -0,0 +1,267 @@
+#include "ParticleBudget.h"
+
+//============================================================================
+//	include
+//============================================================================
+#include <Engine/Effect/Particle/System/ParticleSystem.h>
+#include <Engine/Effect/Particle/ParticleConfig.h>
+#include <Engine/Scene/Camera/BaseCamera.h>
+
+// imgui
+#include <imgui.h>
+// c++
+#include <algorithm>
+#include <cfloat>
+#include <cmath>
+#include <string>
+
+//============================================================================
+//	ParticleBudget classMethods
+//============================================================================
+
+void ParticleBudget::Init() {
+
+	// 初期化値
+	maxParticleCount_ = kMaxCPUParticles * 16;
+	cpuBudgetMilliseconds_ = 2.0f;
+
+	// 遠いほど発生を減らし、更新を間引く
+	tiers_[0] = { 20.0f, 1, 1.0f };
+	tiers_[1] = { 40.0f, 1, 0.75f };
+	tiers_[2] = { 80.0f, 2, 0.5f };
+	tiers_[3] = { FLT_MAX, 4, 0.25f };
+	// 画面外でも寿命は進める
+	culledSetting_ = { 0.0f, 4, 0.25f };
+
+	pressure_ = 0;
+	pressureFrames_ = 0;
+	smoothedMilliseconds_ = 0.0f;
+}
+
+void ParticleBudget::Evaluate(const std::vector<std::unique_ptr<ParticleSystem>>& systems,
+	const BaseCamera* camera) {
+
+	stats_ = Stats{};
+	stats_.systemCount = static_cast<uint32_t>(systems.size());
+
+	if (camera) {
+
+		BuildFrustum(camera->GetViewProjectionMatrix());
+	}
+	const Vector3 cameraTranslation = camera ? camera->GetTransform().translation : Vector3();
+
+	// 候補を集める
+	candidates_.clear();
+	for (const auto& system : systems) {
+		for (auto& group : system->GetCPUGroup()) {
+
+			Candidate& candidate = candidates_.emplace_back();
+			candidate.group = &group.group;
+			candidate.priority = system->GetPriority();
+			candidate.particleCount = group.group.GetNumInstance();
+			candidate.distance = 0.0f;
+
+			// 無効時、カメラがない時、粒がまだない時は最も詳細な段階にする
+			const CPUParticle::BoundingSphere& bounds = group.group.GetBounds();
+			if (!isEnabled_ || !camera || !bounds.isValid) {
+				continue;
+			}
+
+			// 球の表面までの距離
+			candidate.distance = (std::max)(0.0f,
+				(bounds.center - cameraTranslation).Length() - bounds.radius);
+			if (!IsVisible(bounds)) {
+
+				// 画面外は描画せず、寿命を進める程度に更新する
+				candidate.lod.tier = kTierCount - 1;
+				candidate.lod.updateInterval = culledSetting_.updateInterval;
+				candidate.lod.emitRateScale = culledSetting_.emitRateScale;
+				candidate.lod.isCulled = true;
+				continue;
+			}
+
+			// 時間の予算を超えている分だけ段階を下げる
+			const uint32_t tier = (std::min)(SelectTier(candidate.distance) + pressure_, kTierCount - 1);
+			candidate.lod.tier = tier;
+			candidate.lod.updateInterval = tiers_[tier].updateInterval;
+			candidate.lod.emitRateScale = tiers_[tier].emitRateScale;
+		}
+	}
+
+	// 優先度が高く、近い順に粒数の予算を割り当てる
+	if (isEnabled_) {
+
+		std::sort(candidates_.begin(), candidates_.end(),
+			[](const Candidate& a, const Candidate& b) {
+				if (a.priority != b.priority) {
+					return a.priority > b.priority;
+				}
+				return a.distance < b.distance;
+			});
+
+		uint32_t usedCount = 0;
+		const uint32_t maxCount = static_cast<uint32_t>((std::max)(maxParticleCount_, 0));
+		for (auto& candidate : candidates_) {
+
+			usedCount += candidate.particleCount;
+			if (maxCount < usedCount) {
+
+				// 生存中の粒はそのまま更新し、新しい発生のみ止める
+				candidate.lod.emitRateScale = 0.0f;
+				++stats_.starvedGroupCount;
+			}
+		}
+	}
+
+	// 設定、統計
+	for (const auto& candidate : candidates_) {
+
+		candidate.group->SetLOD(candidate.lod);
+
+		++stats_.groupCount;
+		stats_.particleCount += candidate.particleCount;
+		if (candidate.lod.isCulled) {
+
+			++stats_.culledGroupCount;
+		} else {
+
+			++stats_.tierGroupCount[candidate.lod.tier];
+		}
+	}
+}
+
+void ParticleBudget::EndFrame(const std::vector<std::unique_ptr<ParticleSystem>>& systems,
+	float updateMilliseconds) {
+
+	for (const auto& system : systems) {
+		for (const auto& group : system->GetCPUGroup()) {
+			if (group.group.IsUpdateSkipped()) {
+
+				++stats_.skippedUpdateCount;
+			}
+		}
+	}
+
+	// 1フレームの揺れで段階が変わらないように平均をとる
+	stats_.updateMilliseconds = updateMilliseconds;
+	smoothedMilliseconds_ = std::lerp(smoothedMilliseconds_, updateMilliseconds, 0.1f);
+	UpdatePressure();
+}
+
+void ParticleBudget::UpdatePressure() {
+
+	if (!isEnabled_) {
+
+		pressure_ = 0;
+		return;
+	}
+
+	// 段階を変えた直後は結果が出るまで待つ
+	if (++pressureFrames_ < kPressureSettleFrames) {
+		return;
+	}
+
+	if (cpuBudgetMilliseconds_ < smoothedMilliseconds_ && pressure_ < kTierCount - 1) {
+
+		++pressure_;
+		pressureFrames_ = 0;
+	} else if (smoothedMilliseconds_ < cpuBudgetMilliseconds_ * 0.5f && 0 < pressure_) {
+
+		// 戻してすぐに超えないように余裕がある時のみ戻す
+		--pressure_;
+		pressureFrames_ = 0;
+	}
+}
+
+uint32_t ParticleBudget::SelectTier(float distance) const {
+
+	for (uint32_t tier = 0; tier < kTierCount; ++tier) {
+		if (distance < tiers_[tier].distance) {
+
+			return tier;
+		}
+	}
+	return kTierCount - 1;
+}
+
+void ParticleBudget::BuildFrustum(const Matrix4x4& viewProjection) {
+
+	// 行ベクトルなのでclip = p * viewProjection、列から平面を取り出す
+	const auto& m = viewProjection.m;
+	auto column = [&](int c) {
+		return std::array<float, 4>{ m[0][c], m[1][c], m[2][c], m[3][c] }; };
+	const std::array<float, 4> x = column(0), y = column(1), z = column(2), w = column(3);
+
+	// left, right, bottom, top, near(z >= 0), far
+	const std::array<std::array<float, 4>, 6> planes = { {
+		{ w[0] + x[0], w[1] + x[1], w[2] + x[2], w[3] + x[3] },
+		{ w[0] - x[0], w[1] - x[1], w[2] - x[2], w[3] - x[3] },
+		{ w[0] + y[0], w[1] + y[1], w[2] + y[2], w[3] + y[3] },
+		{ w[0] - y[0], w[1] - y[1], w[2] - y[2], w[3] - y[3] },
+		{ z[0], z[1], z[2], z[3] },
+		{ w[0] - z[0], w[1] - z[1], w[2] - z[2], w[3] - z[3] },
+	} };
+	for (uint32_t i = 0; i < planes.size(); ++i) {
+
+		// 球との判定に使うので法線を正規化する
+		const Vector3 normal(planes[i][0], planes[i][1], planes[i][2]);
+		const float length = normal.Length();
+		const float inverse = length != 0.0f ? 1.0f / length : 0.0f;
+		frustum_[i].normal = normal * inverse;
+		frustum_[i].distance = planes[i][3] * inverse;
+	}
+}
+
+bool ParticleBudget::IsVisible(const CPUParticle::BoundingSphere& bounds) const {
+
+	for (const auto& plane : frustum_) {
+		if (Vector3::Dot(plane.normal, bounds.center) + plane.distance < -bounds.radius) {
+
+			return false;
+		}
+	}
+	return true;
+}
+
+void ParticleBudget::ImGui() {
+
+	ImGui::Checkbox("enable", &isEnabled_);
+	ImGui::DragInt("maxParticleCount", &maxParticleCount_, 16.0f, 0, kMaxCPUParticles * 256);
+	ImGui::DragFloat("cpuBudget(ms)", &cpuBudgetMilliseconds_, 0.01f, 0.1f, 16.0f);
+
+	if (ImGui::TreeNode("Tiers")) {
+		for (uint32_t tier = 0; tier < kTierCount; ++tier) {
+
+			ImGui::PushID(static_cast<int>(tier));
+			ImGui::SeparatorText(("tier" + std::to_string(tier)).c_str());
+			if (tier + 1 < kTierCount) {
+
+				ImGui::DragFloat("distance", &tiers_[tier].distance, 0.1f, 0.0f, 10000.0f);
+			}
+			ImGui::DragScalar("updateInterval", ImGuiDataType_U32, &tiers_[tier].updateInterval, 0.05f);
+			tiers_[tier].updateInterval = (std::max)(tiers_[tier].updateInterval, 1u);
+			ImGui::DragFloat("emitRateScale", &tiers_[tier].emitRateScale, 0.01f, 0.0f, 1.0f);
+			ImGui::PopID();
+		}
+
+		ImGui::SeparatorText("culled");
+		ImGui::DragScalar("updateInterval##culled", ImGuiDataType_U32, &culledSetting_.updateInterval, 0.05f);
+		culledSetting_.updateInterval = (std::max)(culledSetting_.updateInterval, 1u);
+		ImGui::DragFloat("emitRateScale##culled", &culledSetting_.emitRateScale, 0.01f, 0.0f, 1.0f);
+		ImGui::TreePop();
+	}
+
+	ImGui::SeparatorText("Stats");
+
+	ImGui::Text("systems: %u  groups: %u", stats_.systemCount, stats_.groupCount);
+	ImGui::Text("particles: %u / %d", stats_.particleCount, maxParticleCount_);
+	ImGui::Text("update: %.3f ms (avg %.3f) / %.3f ms",
+		stats_.updateMilliseconds, smoothedMilliseconds_, cpuBudgetMilliseconds_);
+	ImGui::Text("pressure: %u", pressure_);
+	for (uint32_t tier = 0; tier < kTierCount; ++tier) {
+
+		ImGui::Text("tier%u: %u", tier, stats_.tierGroupCount[tier]);
+	}
+	ImGui::Text("culled: %u  starved: %u  skipped: %u",
+		stats_.culledGroupCount, stats_.starvedGroupCount, stats_.skippedUpdateCount);
+}
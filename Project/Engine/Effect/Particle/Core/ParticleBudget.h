@@ -0,0 +1,119 @@
+#pragma once
+
+//============================================================================
+//	include
+//============================================================================
+#include <Engine/Effect/Particle/Structures/ParticleStructures.h>
+
+// c++
+#include <array>
+#include <memory>
+#include <vector>
+// front
+class ParticleSystem;
+class CPUParticleGroup;
+class BaseCamera;
+
+//============================================================================
+//	ParticleBudget class
+//	CPUパーティクルの処理量を全体の予算内に収める
+//	カメラからの距離でグループごとにLOD段階を決め、発生の速さと更新の間引きを変える
+//	画面外のグループは描画せず、粒数の予算を超えた分は優先度の低いシステムから発生を止める
+//	CPU更新にかかった時間が予算を超えている間は全体の段階を1つずつ下げる
+//============================================================================
+class ParticleBudget {
+public:
+	//========================================================================
+	//	public Methods
+	//========================================================================
+
+	ParticleBudget() = default;
+	~ParticleBudget() = default;
+
+	void Init();
+
+	// 全てのCPUグループの間引き設定を決める、更新ジョブを積む前に呼ぶ
+	void Evaluate(const std::vector<std::unique_ptr<ParticleSystem>>& systems, const BaseCamera* camera);
+	// CPU更新にかかった時間を渡す、更新ジョブが終わった後に呼ぶ
+	void EndFrame(const std::vector<std::unique_ptr<ParticleSystem>>& systems, float updateMilliseconds);
+
+	// editor
+	void ImGui();
+private:
+	//========================================================================
+	//	private Methods
+	//========================================================================
+
+	//--------- structure ----------------------------------------------------
+
+	// LOD段階の数
+	static constexpr uint32_t kTierCount = 4;
+
+	// LOD段階ごとの設定
+	struct TierSetting {
+
+		float distance;          // この距離未満ならこの段階
+		uint32_t updateInterval; // 何フレームに1回更新するか
+		float emitRateScale;     // 発生の進む速さ
+	};
+
+	// 予算の割り当て候補
+	struct Candidate {
+
+		CPUParticleGroup* group;
+		int priority;
+		float distance;
+		uint32_t particleCount;
+		CPUParticle::LODState lod;
+	};
+
+	// 視錐台の平面、内側が正
+	struct Plane {
+
+		Vector3 normal;
+		float distance;
+	};
+
+	// 直近のフレームの統計
+	struct Stats {
+
+		uint32_t systemCount = 0;
+		uint32_t groupCount = 0;
+		uint32_t particleCount = 0;
+		uint32_t culledGroupCount = 0;  // 画面外
+		uint32_t starvedGroupCount = 0; // 粒数の予算を超えて発生を止めた
+		uint32_t skippedUpdateCount = 0; // 更新を間引いた
+		std::array<uint32_t, kTierCount> tierGroupCount{};
+		float updateMilliseconds = 0.0f;
+	};
+
+	//--------- variables ----------------------------------------------------
+
+	bool isEnabled_ = true;
+
+	// 予算
+	int maxParticleCount_;       // 全体の粒数
+	float cpuBudgetMilliseconds_; // CPU更新にかける時間
+
+	std::array<TierSetting, kTierCount> tiers_;
+	TierSetting culledSetting_; // 画面外
+
+	// 時間の予算超過で下げている段階数
+	uint32_t pressure_ = 0;
+	// 段階を変えてから経過したフレーム数、変えた直後は時間が落ち着くまで待つ
+	uint32_t pressureFrames_ = 0;
+	static constexpr uint32_t kPressureSettleFrames = 30;
+	// 更新時間の移動平均
+	float smoothedMilliseconds_ = 0.0f;
+
+	std::array<Plane, 6> frustum_;
+	std::vector<Candidate> candidates_;
+	Stats stats_;
+
+	//--------- functions ----------------------------------------------------
+
+	void BuildFrustum(const Matrix4x4& viewProjection);
+	bool IsVisible(const CPUParticle::BoundingSphere& bounds) const;
+	uint32_t SelectTier(float distance) const;
+	void UpdatePressure();
+};
@@ -8,9 +8,14 @@
 #include <Engine/Core/Graphics/Descriptors/SRVDescriptor.h>
 #include <Engine/Core/Debug/Assert.h>
 #include <Engine/Core/Debug/SpdLogger.h>
+#include <Engine/Core/Thread/JobSystem.h>
 #include <Engine/Effect/Particle/ParticleConfig.h>
 #include <Engine/Scene/SceneView.h>
 #include <Engine/Utility/Timer/GameTimer.h>
+#include <Engine/Utility/Random/RandomGenerator.h>
+
+// c++
+#include <chrono>
 
 // modules
 // Spawner
@@ -69,25 +74,122 @@ void ParticleManager::Finalize() {
 
 ParticleSystem* ParticleManager::CreateParticleSystem(const std::string& filePath, bool useGame) {
 
+	// プールにあればそのまま使う、初期化はプールへ戻す時に済ませている
+	if (useGame) {
+		if (auto it = pool_.find(filePath); it != pool_.end() && !it->second.empty()) {
+
+			systems_.emplace_back(std::move(it->second.back()));
+			it->second.pop_back();
+			AssignSeed(systems_.back().get());
+			return systems_.back().get();
+		}
+	}
+
+	// 定義から作成
+	std::unique_ptr<ParticleSystem> system = CreateFromTemplate(filePath, useGame);
+	if (!system) {
+		return nullptr;
+	}
+	AssignSeed(system.get());
+	// 配列に追加
+	systems_.emplace_back(std::move(system));
+
+	// 生ptrを返す
+	return systems_.back().get();
+}
+
+void ParticleManager::ReleaseParticleSystem(ParticleSystem* system) {
+
+	if (!system) {
+		return;
+	}
+
+	// 発生を止める、プールへ戻すのは粒が消えてから
+	system->Release();
+}
+
+void ParticleManager::WarmParticleSystem(const std::string& filePath, uint32_t count) {
+
+	auto& pool = pool_[filePath];
+	while (pool.size() < count) {
+
+		std::unique_ptr<ParticleSystem> system = CreateFromTemplate(filePath, true);
+		if (!system) {
+			return;
+		}
+		pool.emplace_back(std::move(system));
+	}
+}
+
+std::shared_ptr<const Json> ParticleManager::FindTemplate(const std::string& filePath) {
+
+	// 読み込み済み
+	if (auto it = templates_.find(filePath); it != templates_.end()) {
+		return it->second;
+	}
+
 	// ファイル読み込みチェック
-	if (!JsonAdapter::LoadAssert(filePath)) {
+	Json data;
+	if (!JsonAdapter::LoadCheck(filePath, data)) {
 
 		LOG_WARN("particleFile not found → {}", filePath);
 		ASSERT(FALSE, "particleFile not found:" + filePath);
 		return nullptr;
 	}
 
+	// 以降は同じ定義を共有する
+	auto result = std::make_shared<const Json>(std::move(data));
+	templates_.emplace(filePath, result);
+	return result;
+}
+
+std::unique_ptr<ParticleSystem> ParticleManager::CreateFromTemplate(const std::string& filePath, bool useGame) {
+
+	std::shared_ptr<const Json> data = FindTemplate(filePath);
+	if (!data) {
+		return nullptr;
+	}
+
 	// システム作成
 	std::unique_ptr<ParticleSystem> system = std::make_unique<ParticleSystem>();
 	system->Init(device_, asset_, filePath);
 	system->SetSceneView(sceneView_);
-	// jsonファイルから作成
-	system->LoadJson(filePath, useGame);
-	// 配列に追加
-	systems_.emplace_back(std::move(system));
+	// 定義から作成
+	system->CreateFromTemplate(filePath, std::move(data), useGame);
+	return system;
+}
 
-	// 生ptrを返す
-	return systems_.back().get();
+void ParticleManager::RecycleSystems() {
+
+	// 並び順は更新、描画順に影響するので保ったまま詰める
+	size_t writeIndex = 0;
+	for (size_t readIndex = 0; readIndex < systems_.size(); ++readIndex) {
+
+		std::unique_ptr<ParticleSystem>& system = systems_[readIndex];
+		if (system->IsReleased() && system->IsFinished()) {
+
+			// 定義から作成したゲーム用のシステムのみ再利用する
+			if (system->HasTemplate() && system->IsUseGame()) {
+
+				system->ResetFromTemplate();
+				pool_[system->GetTemplatePath()].emplace_back(std::move(system));
+			}
+			continue;
+		}
+		if (writeIndex != readIndex) {
+
+			systems_[writeIndex] = std::move(system);
+		}
+		++writeIndex;
+	}
+
+	// 削除があった場合は選択を外す
+	if (writeIndex != systems_.size()) {
+
+		systems_.resize(writeIndex);
+		selectedSystem_ = -1;
+		renamingSystem_ = -1;
+	}
 }
 
 //============================================================================
@@ -155,22 +257,63 @@ void ParticleManager::Init(Asset* asset, ID3D12Device8* device,
 	renderer_ = std::make_unique<ParticleRenderer>();
 	renderer_->Init(device, asset, srvDescriptor, shaderCompiler);
 
+	budget_ = std::make_unique<ParticleBudget>();
+	budget_->Init();
+
 	// 発生、更新モジュールの登録
 	RegisterModules();
+
+	// seedが固定されるまでは起動ごとに変える
+	std::random_device randomDevice;
+	seed_ = (static_cast<uint64_t>(randomDevice()) << 32) | randomDevice();
 }
 
 void ParticleManager::Update(DxCommand* dxCommand) {
 
+	// 手放されて粒が消えたシステムをプールへ戻す
+	RecycleSystems();
+
 	if (systems_.empty()) {
 		return;
 	}
 
-	// すべてのシステムを更新
-	for (auto& system : systems_) {
+	// カメラからの距離と予算でCPUグループの間引きを決める
+	budget_->Evaluate(systems_, sceneView_->GetCamera());
+
+	// 全ての同時発生とGPUグループの発生処理
+	cpuGroupJobs_.clear();
+	for (const auto& system : systems_) {
 
-		// パーティクルを更新
 		system->Update();
 
+		// CPUグループを更新ジョブに積む
+		const uint32_t groupCount = static_cast<uint32_t>(system->GetCPUGroup().size());
+		for (uint32_t groupIndex = 0; groupIndex < groupCount; ++groupIndex) {
+
+			cpuGroupJobs_.push_back(CPUGroupJob{ system.get(), groupIndex });
+		}
+	}
+
+	// CPUグループの発生、更新を並列に行う
+	// 乱数列は各モジュールが持つので、処理したスレッドや順番によらず同じ結果になる
+	const auto updateBegin = std::chrono::steady_clock::now();
+	JobSystem::GetInstance()->ParallelFor(static_cast<uint32_t>(cpuGroupJobs_.size()), kGroupsPerJob,
+		[&](uint32_t begin, uint32_t end) {
+			for (uint32_t i = begin; i < end; ++i) {
+
+				const CPUGroupJob& job = cpuGroupJobs_[i];
+				job.system->UpdateCPUGroup(job.groupIndex);
+			}
+		});
+	const std::chrono::duration<float, std::milli> updateTime = std::chrono::steady_clock::now() - updateBegin;
+	budget_->EndFrame(systems_, updateTime.count());
+
+	// GPUへの転送とGPU更新はメインスレッドでまとめて行う
+	for (auto& system : systems_) {
+
+		// CPU転送
+		system->TransferCPUGroup();
+
 		// GPU
 		for (auto& group : system->GetGPUGroup()) {
 
@@ -180,6 +323,24 @@ void ParticleManager::Update(DxCommand* dxCommand) {
 	}
 }
 
+void ParticleManager::SetSeed(uint64_t seed) {
+
+	seed_ = seed;
+	systemSerial_ = 0;
+
+	// 生存中のシステムにも割り当て直す
+	for (const auto& system : systems_) {
+
+		AssignSeed(system.get());
+	}
+}
+
+void ParticleManager::AssignSeed(ParticleSystem* system) {
+
+	// 作成順の通し番号と混ぜる、同じ定義のシステム同士でも別の乱数列になる
+	system->SetRandomSeed(RandomGenerator::MixSeed(seed_, systemSerial_++));
+}
+
 void ParticleManager::Rendering(bool debugEnable,
 	SceneConstBuffer* sceneBuffer, DxCommand* dxCommand) {
 
@@ -196,6 +357,11 @@ void ParticleManager::Rendering(bool debugEnable,
 		}
 		for (const auto& group : system->GetCPUGroup()) {
 
+			// 画面外のグループは描画しない
+			if (group.group.GetLOD().isCulled) {
+				continue;
+			}
+
 			// 描画処理
 			if (group.group.IsDrawParticle()) {
 
@@ -219,6 +385,7 @@ void ParticleManager::AddSystem() {
 	std::unique_ptr<ParticleSystem> system = std::make_unique<ParticleSystem>();
 	system->Init(device_, asset_, name);
 	system->SetSceneView(sceneView_);
+	AssignSeed(system.get());
 	systems_.emplace_back(std::move(system));
 }
 
@@ -256,6 +423,13 @@ void ParticleManager::ImGui() {
 			ImGui::EndTabItem();
 		}
 
+		// Budget
+		if (ImGui::BeginTabItem("Budget")) {
+
+			budget_->ImGui();
+			ImGui::EndTabItem();
+		}
+
 		ImGui::EndTabBar();
 	}
 	ImGui::SetWindowFontScale(1.0f);
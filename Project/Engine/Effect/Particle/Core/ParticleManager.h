@@ -6,8 +6,12 @@
 #include <Engine/Editor/Base/IGameEditor.h>
 #include <Engine/Effect/Particle/Core/GPUParticleUpdater.h>
 #include <Engine/Effect/Particle/Core/ParticleRenderer.h>
+#include <Engine/Effect/Particle/Core/ParticleBudget.h>
 #include <Engine/Effect/Particle/System/ParticleSystem.h>
 
+// c++
+#include <unordered_map>
+
 //============================================================================
 //	ParticleManager class
 //	CPU/GPUパーティクルシステムの管理
@@ -25,6 +29,8 @@ public:
 		SceneView* sceneView);
 
 	// 所持しているパーティクルシステムの更新
+	// CPUグループの更新は並列に行い、GPUへの転送は最後にまとめて行う
+	// 更新前に予算管理でグループごとの間引きを決める
 	void Update(DxCommand* dxCommand);
 
 	// 全てのパーティクルの描画
@@ -41,16 +47,37 @@ public:
 
 	//---------- runtime -----------------------------------------------------
 
+	// 作成、プールに同じファイルのシステムがあればそれを使う
 	ParticleSystem* CreateParticleSystem(const std::string& filePath, bool useGame = true);
+	// 使い終わったシステムを返す、残りの粒が消えた後にプールへ戻す
+	void ReleaseParticleSystem(ParticleSystem* system);
+	// プールにcount個になるまで事前に作成しておく
+	void WarmParticleSystem(const std::string& filePath, uint32_t count);
+
+	// 乱数のseedを固定する、同じseedと同じ作成順、入力なら毎回同じ結果になる
+	// 生存中のシステムも配列順にseedを割り当て直す
+	void SetSeed(uint64_t seed);
 private:
 	//========================================================================
 	//	private Methods
 	//========================================================================
 
+	//--------- structure ----------------------------------------------------
+
+	// CPUグループ1つ分の更新ジョブ
+	struct CPUGroupJob {
+
+		ParticleSystem* system;
+		uint32_t groupIndex;
+	};
+
 	//--------- variables ----------------------------------------------------
 
 	static ParticleManager* instance_;
 
+	// 1ジョブで更新するCPUグループ数
+	static constexpr uint32_t kGroupsPerJob = 1;
+
 	Asset* asset_;
 	ID3D12Device8* device_;
 	SceneView* sceneView_;
@@ -58,9 +85,21 @@ private:
 	// GPU
 	std::unique_ptr<GPUParticleUpdater> gpuUpdater_;
 	std::unique_ptr<ParticleRenderer> renderer_;
+	// CPUパーティクルの予算管理
+	std::unique_ptr<ParticleBudget> budget_;
 
 	std::vector<std::unique_ptr<ParticleSystem>> systems_;
 
+	// 読み込み済みの定義、パスごとに1つ
+	std::unordered_map<std::string, std::shared_ptr<const Json>> templates_;
+	// 再利用を待つシステム、パスごと
+	std::unordered_map<std::string, std::vector<std::unique_ptr<ParticleSystem>>> pool_;
+
+	// 並列更新
+	std::vector<CPUGroupJob> cpuGroupJobs_;
+	uint64_t seed_ = 0;         // 全体のseed
+	uint64_t systemSerial_ = 0; // seedを固定してから割り当てたシステム数
+
 	// editor
 	int nextSystemId_ = 0;        // システム添え字インデックス
 	int selectedSystem_ = -1;     // 現在選択しているシステム
@@ -78,6 +117,14 @@ private:
 	// init
 	void RegisterModules();
 
+	// pool
+	std::shared_ptr<const Json> FindTemplate(const std::string& filePath);
+	std::unique_ptr<ParticleSystem> CreateFromTemplate(const std::string& filePath, bool useGame);
+	// 粒が消えた手放し済みのシステムをプールへ戻す
+	void RecycleSystems();
+	// 使い始めるシステムに乱数列のseedを割り当てる
+	void AssignSeed(ParticleSystem* system);
+
 	// editor
 	void AddSystem();
 	void RemoveSystem();
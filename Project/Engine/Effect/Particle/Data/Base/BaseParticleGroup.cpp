@@ -25,6 +25,37 @@ void BaseParticleGroup::SetParent(bool isSet, const BaseTransform& parent) {
 
 		parentTransform_ = nullptr;
 	}
+	detachedParentMatrix_.reset();
+}
+
+void BaseParticleGroup::ClearParent() {
+
+	parentTransform_ = nullptr;
+	detachedParentMatrix_.reset();
+}
+
+void BaseParticleGroup::DetachParent() {
+
+	// 親がいない場合は何もしない
+	if (!parentTransform_) {
+		return;
+	}
+
+	detachedParentMatrix_ = parentTransform_->matrix.world;
+	parentTransform_ = nullptr;
+}
+
+const Matrix4x4* BaseParticleGroup::GetParentMatrix() const {
+
+	if (parentTransform_) {
+
+		return &parentTransform_->matrix.world;
+	}
+	if (detachedParentMatrix_.has_value()) {
+
+		return &detachedParentMatrix_.value();
+	}
+	return nullptr;
 }
 
 D3D12_GPU_VIRTUAL_ADDRESS BaseParticleGroup::GetPrimitiveBufferAdress() const {
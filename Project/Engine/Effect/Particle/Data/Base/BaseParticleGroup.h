@@ -30,6 +30,10 @@ public:
 
 	// 親の設定
 	void SetParent(bool isSet, const BaseTransform& parent);
+	void ClearParent();
+	// 親を外すが、最後の行列を残して生存中の粒の位置を保つ
+	// 所有者が破棄された後も残りの粒が原点へ飛ばないようにする
+	void DetachParent();
 
 	D3D12_GPU_VIRTUAL_ADDRESS GetPrimitiveBufferAdress() const;
 protected:
@@ -70,6 +74,8 @@ protected:
 
 	// 親設定
 	const BaseTransform* parentTransform_ = nullptr;
+	// DetachParentで外した親の最後のワールド行列
+	std::optional<Matrix4x4> detachedParentMatrix_;
 
 	//--------- functions ----------------------------------------------------
 
@@ -79,6 +85,9 @@ protected:
 	void CreateTrailBuffer(ID3D12Device* device,
 		ParticlePrimitiveType primitiveType, uint32_t maxParticle);
 
+	// 粒に適応する親の行列、親がいない場合はnullptr
+	const Matrix4x4* GetParentMatrix() const;
+
 	// emitter
 	void DrawEmitter();
 	void EditEmitter();
@@ -5,6 +5,7 @@
 //============================================================================
 #include <Engine/Effect/Particle/ParticleConfig.h>
 #include <Engine/Utility/Timer/GameTimer.h>
+#include <Engine/Utility/Random/RandomGenerator.h>
 #include <Engine/Effect/Particle/Module/Updater/Time/ParticleUpdateLifeTimeModule.h>
 #include <Engine/Effect/Particle/Module/Updater/Trail/ParticleUpdateTrailModule.h>
 
@@ -35,6 +36,11 @@ void CPUParticleGroup::Create(ID3D12Device* device,
 	transformBuffer_.CreateSRVBuffer(device, createParticleInstanceCount_);
 	materialBuffer_.CreateSRVBuffer(device, createParticleInstanceCount_);
 	textureInfoBuffer_.CreateSRVBuffer(device, createParticleInstanceCount_);
+
+	// パーティクルの配列を確保
+	particles_.Init(primitiveBuffer_.type, createParticleInstanceCount_);
+	particles_.EnableTrail(HasTrailModule());
+	spawnMarks_.clear();
 }
 
 bool CPUParticleGroup::HasTrailModule() const {
@@ -74,18 +80,92 @@ void CPUParticleGroup::CreateFromJson(ID3D12Device* device, Asset* asset, const
 	transformBuffer_.CreateSRVBuffer(device, createParticleInstanceCount_);
 	materialBuffer_.CreateSRVBuffer(device, createParticleInstanceCount_);
 	textureInfoBuffer_.CreateSRVBuffer(device, createParticleInstanceCount_);
+
+	// パーティクルの配列を確保
+	particles_.Init(primitiveBuffer_.type, createParticleInstanceCount_);
+	particles_.EnableTrail(HasTrailModule());
+	spawnMarks_.clear();
+}
+
+void CPUParticleGroup::ResetFromJson(const Json& data) {
+
+	// モジュールはコマンドで書き換えられている場合があるので作り直す
+	FromJson(data, asset_);
+
+	// 粒を破棄
+	ClearParent();
+	particles_.Clear();
+	numInstance_ = 0;
+	isDrawParticle_ = true;
+
+	// 間引きの状態は次に使う時の予算管理で決め直す
+	lod_ = CPUParticle::LODState{};
+	bounds_ = CPUParticle::BoundingSphere{};
+	skippedFrames_ = 0;
+	pendingDeltaTime_ = 0.0f;
+	isUpdateSkipped_ = false;
+	spawnMarks_.clear();
 }
 
 void CPUParticleGroup::Update() {
 
+	// 間引くフレームは経過時間のみ貯める
+	pendingDeltaTime_ += GameTimer::GetDeltaTime();
+	if (++skippedFrames_ < (std::max)(lod_.updateInterval, 1u)) {
+
+		isUpdateSkipped_ = true;
+		return;
+	}
+	const float deltaTime = pendingDeltaTime_;
+	skippedFrames_ = 0;
+	pendingDeltaTime_ = 0.0f;
+	isUpdateSkipped_ = false;
+
 	// フェーズの更新処理
-	UpdatePhase();
+	UpdatePhase(deltaTime);
+	UpdateBounds();
+}
+
+void CPUParticleGroup::UpdateBounds() {
+
+	const uint32_t particleCount = particles_.GetCount();
+	if (particleCount == 0) {
+
+		bounds_.isValid = false;
+		return;
+	}
+
+	// 軸ごとの範囲から囲む球を求める
+	const std::vector<Vector3>& translations = particles_.GetTranslations();
+	Vector3 min = translations.front();
+	Vector3 max = translations.front();
+	for (uint32_t index = 1; index < particleCount; ++index) {
+
+		const Vector3& translation = translations[index];
+		min.x = (std::min)(min.x, translation.x);
+		min.y = (std::min)(min.y, translation.y);
+		min.z = (std::min)(min.z, translation.z);
+		max.x = (std::max)(max.x, translation.x);
+		max.y = (std::max)(max.y, translation.y);
+		max.z = (std::max)(max.z, translation.z);
+	}
+	bounds_.center = (min + max) * 0.5f;
+	bounds_.radius = (max - min).Length() * 0.5f;
+	bounds_.isValid = true;
+
+	// 親がいる場合は親の空間の座標なのでワールドへ変換する
+	if (const Matrix4x4* parentMatrix = GetParentMatrix()) {
+
+		bounds_.center = Vector3::Transform(bounds_.center, *parentMatrix);
+	}
 }
 
 void CPUParticleGroup::FrequencyEmit() {
 
-	const float deltaTime = GameTimer::GetDeltaTime();
+	// 予算に応じて発生間隔の進みを遅くする
+	const float deltaTime = GameTimer::GetDeltaTime() * lod_.emitRateScale;
 
+	const uint32_t countBefore = BeginSpawnMark();
 	for (auto& phase : phases_) {
 
 		// 一定間隔で発生させる
@@ -94,10 +174,17 @@ void CPUParticleGroup::FrequencyEmit() {
 		// emitterの更新
 		phase->UpdateEmitter();
 	}
+	EndSpawnMark(countBefore);
 }
 
 void CPUParticleGroup::Emit() {
 
+	// 粒数の予算を使い切っている場合は発生させない
+	if (lod_.emitRateScale <= 0.0f) {
+		return;
+	}
+
+	const uint32_t countBefore = BeginSpawnMark();
 	for (auto& phase : phases_) {
 
 		// 強制的に発生させる
@@ -106,6 +193,15 @@ void CPUParticleGroup::Emit() {
 		// emitterの更新
 		phase->UpdateEmitter();
 	}
+	EndSpawnMark(countBefore);
+}
+
+void CPUParticleGroup::DrawPhaseEmitter() {
+
+	for (const auto& phase : phases_) {
+
+		phase->DrawEmitter();
+	}
 }
 
 void CPUParticleGroup::ApplyCommand(const ParticleCommand& command) {
@@ -121,38 +217,83 @@ void CPUParticleGroup::ApplyCommand(const ParticleCommand& command) {
 	}
 }
 
-void CPUParticleGroup::UpdatePhase() {
+void CPUParticleGroup::SetRandomSeed(uint64_t seed) {
+
+	randomSeed_ = seed;
+	for (uint32_t index = 0; index < phases_.size(); ++index) {
+
+		phases_[index]->SetRandomSeed(RandomGenerator::MixSeed(randomSeed_, index));
+	}
+}
+
+void CPUParticleGroup::UpdatePhase(float deltaTime) {
 
 	// フェーズがない場合は処理しない
 	if (phases_.empty()) {
+
+		spawnMarks_.clear();
 		return;
 	}
 
-	const float deltaTime = GameTimer::GetDeltaTime();
+	// エディターでモジュールが追加、削除された場合に備えてノード配列を合わせる
+	particles_.EnableTrail(HasTrailModule());
+
+	// フェーズインデックスの制限と親の設定
+	const uint32_t particleCount = particles_.GetCount();
+	const uint32_t lastPhaseIndex = static_cast<uint32_t>(phases_.size() - 1);
+	std::vector<uint32_t>& phaseIndices = particles_.GetPhaseIndices();
+	std::vector<ParticleCommon::TransformForGPU>& transforms = particles_.GetTransforms();
+	// 所有者から外された後は最後の親の行列を使い続ける
+	const Matrix4x4* parent = GetParentMatrix();
+	const Matrix4x4 parentMatrix = parent ? *parent : Matrix4x4::MakeIdentity4x4();
+	for (uint32_t particleIndex = 0; particleIndex < particleCount; ++particleIndex) {
+
+		// フェーズインデックスが範囲外にならないように制御
+		phaseIndices[particleIndex] = (std::min)(phaseIndices[particleIndex], lastPhaseIndex);
+
+		transforms[particleIndex].aliveParent = parent != nullptr;
+		transforms[particleIndex].parentMatrix = parentMatrix;
+	}
+
+	// 間引き中に発生した粒は、発生してから貯まった分の時間のみ進める
+	// 追加は末尾に行われ、前回の更新から削除はないので発生ごとに連続した範囲になる
+	uint32_t rangeBegin = 0;
+	float rangeDeltaTime = deltaTime;
+	for (const auto& mark : spawnMarks_) {
+
+		const uint32_t rangeEnd = (std::min)(mark.firstIndex, particleCount);
+		UpdatePhaseRange(rangeBegin, rangeEnd, rangeDeltaTime);
+		rangeBegin = rangeEnd;
+		rangeDeltaTime = (std::max)(deltaTime - mark.pendingTime, 0.0f);
+	}
+	UpdatePhaseRange(rangeBegin, particleCount, rangeDeltaTime);
+	spawnMarks_.clear();
 
 	// particleの数を最大数に制限する
-	if (createParticleInstanceCount_ < particles_.size()) {
+	// 範囲ごとの更新の後に行う、入れ替え削除で範囲が崩れるため
+	if (createParticleInstanceCount_ < particles_.GetCount()) {
 
-		// 古いの要素から削除する
-		// it = std::next particles_.size() - createInstanceCount分イテレータを進める
-		auto last = std::next(particles_.begin(), particles_.size() - createParticleInstanceCount_);
-		// beginからlastまでの要素を削除
-		particles_.erase(particles_.begin(), last);
+		// 古い要素から削除する
+		particles_.EraseOldest(particles_.GetCount() - createParticleInstanceCount_);
 	}
 
 	// 転送データのリサイズ
-	ResizeTransferData(static_cast<uint32_t>(particles_.size()));
+	ResizeTransferData(particles_.GetCount());
 
-	// 全てのparticleに対して更新処理を行う
-	uint32_t particleIndex = 0;
-	for (auto it = particles_.begin(); it != particles_.end();) {
+	// 寿命、削除判定を行う
+	// 削除すると末尾の要素が同じindexに移るので、indexを進めずに続けて処理する
+	// 末尾の要素もまとめ更新済みなので、再度更新するのはフェーズが進んだ粒のみ
+	bool isUpdated = true;
+	for (uint32_t particleIndex = 0; particleIndex < particles_.GetCount();) {
 
-		auto& particle = *it;
-		// フェーズインデックスが範囲外にならないように制御
-		particle.phaseIndex = (std::min)(particle.phaseIndex, static_cast<uint32_t>(phases_.size() - 1));
+		CPUParticle::ParticleView particle = particles_.GetView(particleIndex);
 
-		// 現在のフェーズで更新
-		phases_[particle.phaseIndex]->UpdateParticle(particle, deltaTime);
+		// フェーズが進んだ粒は同じフレームで次のフェーズの更新を行う
+		if (!isUpdated) {
+
+			phases_[particle.phaseIndex]->UpdateParticle(particle, deltaTime);
+			isUpdated = true;
+		}
 
 		// 削除、フェーズ判定処理
 		// 寿命終了後、モードに応じて処理
@@ -175,6 +316,7 @@ void CPUParticleGroup::UpdatePhase() {
 
 					// テクスチャの情報を次のフェーズのものに更新する
 					particle.textureInfo = phases_[particle.phaseIndex]->GetSpawner()->GetTextureInfo();
+					isUpdated = false;
 					continue;
 				} else {
 
@@ -187,17 +329,17 @@ void CPUParticleGroup::UpdatePhase() {
 
 							// 描画するかしないかでスケールを設定
 							// trueならそのまま、falseなら0.0f
-							it->transform.scale = trailModule->IsLifeEndDrawOrigin() ?
-								it->transform.scale : Vector3::AnyInit(0.0f);
+							particle.transform.scale = trailModule->IsLifeEndDrawOrigin() ?
+								particle.transform.scale : Vector3::AnyInit(0.0f);
 						} else {
 
-							it = particles_.erase(it);
+							particles_.SwapRemove(particleIndex);
 							continue;
 						}
 					} else {
 
 						// 削除
-						it = particles_.erase(it);
+						particles_.SwapRemove(particleIndex);
 						continue;
 					}
 				}
@@ -231,17 +373,17 @@ void CPUParticleGroup::UpdatePhase() {
 
 					// 描画するかしないかでスケールを設定
 					// trueならそのまま、falseなら0.0f
-					it->transform.scale = trailModule->IsLifeEndDrawOrigin() ?
-						it->transform.scale : Vector3::AnyInit(0.0f);
+					particle.transform.scale = trailModule->IsLifeEndDrawOrigin() ?
+						particle.transform.scale : Vector3::AnyInit(0.0f);
 				} else {
 
-					it = particles_.erase(it);
+					particles_.SwapRemove(particleIndex);
 					continue;
 				}
 			} else {
 
 				// 削除
-				it = particles_.erase(it);
+				particles_.SwapRemove(particleIndex);
 				continue;
 			}
 		}
@@ -249,88 +391,53 @@ void CPUParticleGroup::UpdatePhase() {
 		// bufferに渡すデータの更新処理
 		// デフォルトでtrue、トレイルで最終決定する
 		isDrawParticle_ = true;
-		UpdateTransferData(particleIndex, *it);
+		UpdateTransferData(particleIndex, particle);
 
 		// トレイル後処理更新中、ノードがすべてなくなったら
 		if (HasTrailModule()) {
-			if (&it->trailRuntime.isDetaching && it->trailRuntime.nodes.empty()) {
+			if (particle.trailRuntime.isDetaching && particle.trailRuntime.count == 0) {
 
-				it = particles_.erase(it);
+				particles_.SwapRemove(particleIndex);
 				continue;
 			}
 		}
 
 		// indexを進める
-		++it;
 		++particleIndex;
 	}
 
 	// instance数を更新
-	numInstance_ = static_cast<uint32_t>(particles_.size());
-	// buffer転送
-	TransferBuffer();
+	numInstance_ = particles_.GetCount();
 }
 
-void CPUParticleGroup::UpdateTransferData(uint32_t particleIndex,
-	const CPUParticle::ParticleData& particle) {
-
-	// transform
-	transferTransforms_[particleIndex] = particle.transform;
-	// 親の設定
-	if (parentTransform_) {
-
-		transferTransforms_[particleIndex].aliveParent = true;
-		transferTransforms_[particleIndex].parentMatrix = parentTransform_->matrix.world;
-	} else {
+void CPUParticleGroup::UpdatePhaseRange(uint32_t begin, uint32_t end, float deltaTime) {
 
-		transferTransforms_[particleIndex].aliveParent = false;
-		transferTransforms_[particleIndex].parentMatrix = Matrix4x4::MakeIdentity4x4();
-	}
+	// 同じフェーズが連続する区間ごとに、モジュール単位でまとめて更新する
+	const std::vector<uint32_t>& phaseIndices = particles_.GetPhaseIndices();
+	while (begin < end) {
 
-	// material
-	transferMaterials_[particleIndex] = particle.material;
-	// texture
-	transferTextureInfos_[particleIndex] = particle.textureInfo;
-	// primitive
-	switch (primitiveBuffer_.type) {
-	case ParticlePrimitiveType::Plane: {
-
-		transferPrimitives_.plane[particleIndex] = particle.primitive.plane;
-		break;
-	}
-	case ParticlePrimitiveType::Ring: {
-
-		transferPrimitives_.ring[particleIndex] = particle.primitive.ring;
-		break;
-	}
-	case ParticlePrimitiveType::Cylinder: {
-
-		transferPrimitives_.cylinder[particleIndex] = particle.primitive.cylinder;
-		break;
-	}
-	case ParticlePrimitiveType::Crescent: {
-
-		transferPrimitives_.crescent[particleIndex] = particle.primitive.crescent;
-		break;
+		uint32_t runEnd = begin + 1;
+		while (runEnd < end && phaseIndices[runEnd] == phaseIndices[begin]) {
+			++runEnd;
+		}
+		phases_[phaseIndices[begin]]->UpdateParticles(particles_, begin, runEnd, deltaTime);
+		begin = runEnd;
 	}
-	case ParticlePrimitiveType::Lightning: {
+}
 
-		transferPrimitives_.lightning[particleIndex] = particle.primitive.lightning;
-		break;
-	}
-	case ParticlePrimitiveType::TestMesh: {
+void CPUParticleGroup::UpdateTransferData(uint32_t particleIndex,
+	const CPUParticle::ParticleView& particle) {
 
-		transferPrimitives_.testMesh[particleIndex] = particle.primitive.testMesh;
-		break;
-	}
-	}
+	// transform、translationのみ別の配列で更新しているので書き戻す
+	// material、texture、形状はストアの配列をそのまま転送する
+	particles_.GetTransforms()[particleIndex].translation = particle.transform.translation;
 
 	// トレイルの処理を行っている場合のみ
 	if (ParticleUpdateTrailModule* trailModule = phases_[particle.phaseIndex]->GetTrailModule()) {
 
 		// バッファ転送用のデータを更新
 		trailModule->BuildTransferData(particleIndex, particle,
-			transferTrailHeaders_, transferTrailVertices_, sceneView_);
+			transferTrailHeaders_, transferTrailVertices_, trailVertexCount_, sceneView_);
 		// テクスチャをそのまま渡して更新
 		transferTrailTextureInfos_[particleIndex] = particle.trailTextureInfo;
 
@@ -341,42 +448,49 @@ void CPUParticleGroup::UpdateTransferData(uint32_t particleIndex,
 
 void CPUParticleGroup::TransferBuffer() {
 
+	// 更新処理を行っていない場合は転送しない
+	// 間引かれたフレームはバッファの内容が前回のままでよい
+	if (phases_.empty() || isUpdateSkipped_) {
+		return;
+	}
+
 	// transform
-	transformBuffer_.TransferData(transferTransforms_);
+	transformBuffer_.TransferData(particles_.GetTransforms());
 	// material
-	materialBuffer_.TransferData(transferMaterials_);
+	materialBuffer_.TransferData(particles_.GetMaterials());
 	// texture
-	textureInfoBuffer_.TransferData(transferTextureInfos_);
+	textureInfoBuffer_.TransferData(particles_.GetTextureInfos());
 	// primitive
+	const ParticleCommon::PrimitiveData<true>& primitives = particles_.GetPrimitives();
 	switch (primitiveBuffer_.type) {
 	case ParticlePrimitiveType::Plane: {
 
-		primitiveBuffer_.plane.TransferData(transferPrimitives_.plane);
+		primitiveBuffer_.plane.TransferData(primitives.plane);
 		break;
 	}
 	case ParticlePrimitiveType::Ring: {
 
-		primitiveBuffer_.ring.TransferData(transferPrimitives_.ring);
+		primitiveBuffer_.ring.TransferData(primitives.ring);
 		break;
 	}
 	case ParticlePrimitiveType::Cylinder: {
 
-		primitiveBuffer_.cylinder.TransferData(transferPrimitives_.cylinder);
+		primitiveBuffer_.cylinder.TransferData(primitives.cylinder);
 		break;
 	}
 	case ParticlePrimitiveType::Crescent: {
 
-		primitiveBuffer_.crescent.TransferData(transferPrimitives_.crescent);
+		primitiveBuffer_.crescent.TransferData(primitives.crescent);
 		break;
 	}
 	case ParticlePrimitiveType::Lightning: {
 
-		primitiveBuffer_.lightning.TransferData(transferPrimitives_.lightning);
+		primitiveBuffer_.lightning.TransferData(primitives.lightning);
 		break;
 	}
 	case ParticlePrimitiveType::TestMesh: {
 
-		primitiveBuffer_.testMesh.TransferData(transferPrimitives_.testMesh);
+		primitiveBuffer_.testMesh.TransferData(primitives.testMesh);
 		break;
 	}
 	}
@@ -384,83 +498,54 @@ void CPUParticleGroup::TransferBuffer() {
 	// トレイルの処理を行っている場合のみ
 	if (HasTrailModule()) {
 
-		trailHeaderBuffer_.TransferData(transferTrailHeaders_);
-		trailVertexBuffer_.TransferData(transferTrailVertices_);
-		trailTextureInfoBuffer_.TransferData(transferTrailTextureInfos_);
+		// 書き込んだ分のみ転送する
+		trailHeaderBuffer_.TransferData(transferTrailHeaders_, numInstance_);
+		trailVertexBuffer_.TransferData(transferTrailVertices_, trailVertexCount_);
+		trailTextureInfoBuffer_.TransferData(transferTrailTextureInfos_, numInstance_);
 	}
 }
 
 void CPUParticleGroup::ResizeTransferData(uint32_t size) {
 
-	// transform
-	transferTransforms_.resize(size);
-	// material
-	transferMaterials_.resize(size);
-	// textureInfo
-	transferTextureInfos_.resize(size);
-	// primitive
-	switch (primitiveBuffer_.type) {
-	case ParticlePrimitiveType::Plane: {
+	// 頂点の書き込み位置を戻す
+	trailVertexCount_ = 0;
 
-		transferPrimitives_.plane.resize(size);
-		break;
-	}
-	case ParticlePrimitiveType::Ring: {
+	// トレイルの処理を行っている場合のみ
+	if (HasTrailModule()) {
 
-		transferPrimitives_.ring.resize(size);
-		break;
-	}
-	case ParticlePrimitiveType::Cylinder: {
+		// 足りない場合のみ拡張する、同じ数が続く間は再確保しない
+		if (transferTrailHeaders_.size() < size) {
 
-		transferPrimitives_.cylinder.resize(size);
-		break;
-	}
-	case ParticlePrimitiveType::Crescent: {
-
-		transferPrimitives_.crescent.resize(size);
-		break;
-	}
-	case ParticlePrimitiveType::Lightning: {
+			transferTrailHeaders_.resize(size);
+			transferTrailTextureInfos_.resize(size);
+		}
 
-		transferPrimitives_.lightning.resize(size);
-		break;
-	}
-	case ParticlePrimitiveType::TestMesh: {
+		// 1ノード2頂点、バッファの最大数まで
+		const uint32_t vertexCount = (std::min)(size * 2u * static_cast<uint32_t>(kMaxTrailParticles),
+			createTrailInstanceCount_);
+		if (transferTrailVertices_.size() < vertexCount) {
 
-		transferPrimitives_.testMesh.resize(size);
-		break;
-	}
+			transferTrailVertices_.resize(vertexCount);
+		}
 	}
+}
 
-	// トレイルの処理を行っている場合のみ
-	if (HasTrailModule()) {
-
-		transferTrailHeaders_.resize(size * kMaxTrailParticles);
-		transferTrailTextureInfos_.resize(size * kMaxTrailParticles);
+uint32_t CPUParticleGroup::BeginSpawnMark() {
 
-		transferTrailVertices_.clear();
+	// 間引き中でなければ発生した粒も経過時間全てを進めればよい
+	if (0.0f < pendingDeltaTime_) {
 
-		// パラメータから安全側に見積る
-		uint32_t maxPoints = 0;
-		uint32_t subdivision = 0;
-		for (const auto& phase : phases_) {
-			if (auto* module = phase->GetTrailModule()) {
+		spawnMarks_.push_back({ particles_.GetCount(), pendingDeltaTime_ });
+	}
+	return particles_.GetCount();
+}
 
-				maxPoints = (std::max<uint32_t>)(maxPoints, module->GetMaxPoints());
-				subdivision = (std::max<uint32_t>)(subdivision, module->GetSubdivPerSegment());
-			}
-		}
+void CPUParticleGroup::EndSpawnMark(uint32_t countBefore) {
 
-		// 最大頂点数
-		const uint32_t kMaxVertexCount = 256;
-		uint32_t perTrail = 2u * maxPoints * (subdivision + 1u);
-		perTrail = (std::min)(perTrail, kMaxVertexCount);
-		if (perTrail == 0) {
+	// 何も発生しなかった場合は範囲を残さない
+	if (0.0f < pendingDeltaTime_ && particles_.GetCount() == countBefore) {
 
-			// 32をデフォルトにしておく
-			perTrail = 32;
-		}
-		transferTrailVertices_.reserve(size * perTrail);
+		spawnMarks_.pop_back();
 	}
 }
 
@@ -472,6 +557,7 @@ void CPUParticleGroup::AddPhase() {
 	// phase追加
 	phases_.emplace_back(std::make_unique<ParticlePhase>());
 	ParticlePhase* phase = phases_.back().get();
+	phase->SetRandomSeed(RandomGenerator::MixSeed(randomSeed_, phases_.size() - 1));
 	phase->Init(asset_, primitiveBuffer_.type);
 
 	// phaseが1つ以上ある時、同期して作成するか
@@ -516,6 +602,8 @@ void CPUParticleGroup::ImGui() {
 			if (ImGui::SmallButton("X")) {
 
 				phases_.erase(phases_.begin() + i);
+				// 並び順が変わったので乱数列を作り直す
+				SetRandomSeed(randomSeed_);
 				selectedPhase_ = std::clamp(selectedPhase_, 0, static_cast<int>(phases_.size()) - 1);
 				ImGui::PopID();
 				break;
@@ -590,6 +678,7 @@ void CPUParticleGroup::FromJson(const Json& data, Asset* asset) {
 	for (auto& phaseData : data["phases"]) {
 
 		auto phase = std::make_unique<ParticlePhase>();
+		phase->SetRandomSeed(RandomGenerator::MixSeed(randomSeed_, phases_.size()));
 		phase->Init(asset, primitiveBuffer_.type);
 		phase->FromJson(phaseData);
 		phases_.push_back(std::move(phase));
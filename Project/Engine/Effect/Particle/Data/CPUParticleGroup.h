@@ -5,6 +5,7 @@
 //============================================================================
 #include <Engine/Effect/Particle/Data/Base/BaseParticleGroup.h>
 #include <Engine/Effect/Particle/Phase/ParticlePhase.h>
+#include <Engine/Effect/Particle/Data/CPUParticleStore.h>
 
 //============================================================================
 //	CPUParticleGroup class
@@ -32,7 +33,13 @@ public:
 	void CreateFromJson(ID3D12Device* device, Asset* asset, const Json& data, bool useGame);
 
 	// 各パーティクルのフェーズを更新する
+	// 他のグループと並列に呼び出せる、GPUへの転送はTransferBufferで行う
+	// LODで間引かれたフレームは経過時間のみ貯めて、次の更新でまとめて進める
 	void Update();
+	// 更新結果をGPUへ転送する、メインスレッドで呼ぶ
+	void TransferBuffer();
+	// 更新されたemitterを描画する、メインスレッドで呼ぶ
+	void DrawPhaseEmitter();
 
 	// editor
 	void ImGui();
@@ -40,6 +47,8 @@ public:
 	// json
 	Json ToJson() const;
 	void FromJson(const Json& data, Asset* asset);
+	// 作成済みのバッファを使い回してjsonの状態に戻す、生存中の粒は破棄する
+	void ResetFromJson(const Json& data);
 
 	//--------- accessor -----------------------------------------------------
 
@@ -49,6 +58,14 @@ public:
 	bool HasTrailModule() const;
 	bool IsDrawParticle() const { return isDrawParticle_; }
 
+	// 予算管理から設定される間引き設定
+	void SetLOD(const CPUParticle::LODState& lod) { lod_ = lod; }
+	const CPUParticle::LODState& GetLOD() const { return lod_; }
+	// 前回更新した時の粒を囲む球
+	const CPUParticle::BoundingSphere& GetBounds() const { return bounds_; }
+	// このフレームの更新が間引かれたか
+	bool IsUpdateSkipped() const { return isUpdateSkipped_; }
+
 	const DxStructuredBuffer<ParticleCommon::TransformForGPU>& GetTransformBuffer() const { return transformBuffer_; }
 	const DxStructuredBuffer<ParticleCommon::TrailHeaderForGPU>& GetTrailHeaderBuffer() const { return trailHeaderBuffer_; }
 	const DxStructuredBuffer<ParticleCommon::TrailVertexForGPU>& GetTrailVertexBuffer() const { return trailVertexBuffer_; }
@@ -61,6 +78,8 @@ public:
 
 	// モジュールのコマンド適応
 	void ApplyCommand(const ParticleCommand& command);
+	// 各フェーズの乱数列をseedから作り直す
+	void SetRandomSeed(uint64_t seed);
 
 	//----------- emit -------------------------------------------------------
 
@@ -82,17 +101,15 @@ private:
 
 	// フェーズ
 	std::vector<std::unique_ptr<ParticlePhase>> phases_;
+	// フェーズの乱数列の元、フェーズの並び順と混ぜて使う
+	uint64_t randomSeed_ = 0;
 
-	// データ
-	std::list<CPUParticle::ParticleData> particles_;
-	// 転送データ
-	std::vector<CPUParticle::MaterialForGPU> transferMaterials_;
-	std::vector<CPUParticle::TextureInfoForGPU> transferTextureInfos_;
-	std::vector<ParticleCommon::TransformForGPU> transferTransforms_;
-	ParticleCommon::PrimitiveData<true> transferPrimitives_;
+	// データ、material/texture/形状はそのままGPUへ転送する
+	CPUParticleStore particles_;
 	// トレイル
 	std::vector<ParticleCommon::TrailHeaderForGPU> transferTrailHeaders_;
 	std::vector<ParticleCommon::TrailVertexForGPU> transferTrailVertices_;
+	uint32_t trailVertexCount_ = 0; // transferTrailVertices_に書き込んだ頂点数
 	std::vector<ParticleCommon::TrailTextureInfoForGPU> transferTrailTextureInfos_;
 
 	// buffers
@@ -103,6 +120,15 @@ private:
 	bool isDrawParticle_ = true;
 	BlendMode blendMode_;
 
+	// LOD
+	CPUParticle::LODState lod_;
+	CPUParticle::BoundingSphere bounds_;
+	uint32_t skippedFrames_ = 0; // 前回の更新から間引いたフレーム数
+	float pendingDeltaTime_ = 0.0f; // 間引いている間に貯めた経過時間
+	bool isUpdateSkipped_ = false;
+	// 間引き中に発生した粒は、次の更新で発生してからの時間のみ進める
+	std::vector<CPUParticle::SpawnMark> spawnMarks_;
+
 	// editor
 	int selectedPhase_ = -1;
 	bool isSynchPhase_ = true;
@@ -110,12 +136,15 @@ private:
 	//--------- functions ----------------------------------------------------
 
 	// update
-	void UpdatePhase();
+	void UpdatePhase(float deltaTime);
+	void UpdatePhaseRange(uint32_t begin, uint32_t end, float deltaTime);
+	void UpdateBounds();
 	void UpdateTransferData(uint32_t particleIndex,
-		const CPUParticle::ParticleData& particle);
-	void TransferBuffer();
+		const CPUParticle::ParticleView& particle);
 
 	// helper
 	void ResizeTransferData(uint32_t size);
+	uint32_t BeginSpawnMark();
+	void EndSpawnMark(uint32_t countBefore);
 	void AddPhase();
 };
\ No newline at end of file
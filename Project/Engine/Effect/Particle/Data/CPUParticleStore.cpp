@@ -0,0 +1,299 @@
+#include "CPUParticleStore.h"
+
+//============================================================================
+//	include
+//============================================================================
+
+// c++
+#include <algorithm>
+#include <functional>
+
+//============================================================================
+//	CPUParticleStore classMethods
+//============================================================================
+
+void CPUParticleStore::Init(ParticlePrimitiveType primitiveType, uint32_t capacity) {
+
+	// 形状が変わる場合に備えて全て破棄してから確保する
+	*this = CPUParticleStore{};
+	primitives_.type = primitiveType;
+	capacity_ = capacity;
+	ForEachArray([capacity](auto& array) { array.reserve(capacity); });
+}
+
+void CPUParticleStore::EnableTrail(bool enable) {
+
+	if (isTrailEnabled_ == enable) {
+		return;
+	}
+	isTrailEnabled_ = enable;
+
+	if (!enable) {
+
+		trailPoints_.clear();
+		trailPoints_.shrink_to_fit();
+		return;
+	}
+
+	// 最大数分を確保しておき、以降の追加、削除で再確保しないようにする
+	trailPoints_.reserve(static_cast<size_t>(capacity_) * kTrailStride);
+	trailPoints_.resize(static_cast<size_t>(GetCount()) * kTrailStride);
+	for (auto& trail : trailRuntimes_) {
+
+		trail.head = 0;
+		trail.count = 0;
+	}
+}
+
+void CPUParticleStore::Push(const CPUParticle::ParticleData& particle) {
+
+	// hot
+	translations_.push_back(particle.transform.translation);
+	velocities_.push_back(particle.velocity);
+	currentTimes_.push_back(particle.currentTime);
+	lifeTimes_.push_back(particle.lifeTime);
+	progresses_.push_back(particle.progress);
+	phaseIndices_.push_back(particle.phaseIndex);
+
+	// GPU転送データ
+	transforms_.push_back(particle.transform);
+	materials_.push_back(particle.material);
+	textureInfos_.push_back(particle.textureInfo);
+	trailTextureInfos_.push_back(particle.trailTextureInfo);
+
+	// 形状
+	switch (primitives_.type) {
+	case ParticlePrimitiveType::Plane:
+
+		primitives_.plane.push_back(particle.primitive.plane);
+		break;
+	case ParticlePrimitiveType::Ring:
+
+		primitives_.ring.push_back(particle.primitive.ring);
+		break;
+	case ParticlePrimitiveType::Cylinder:
+
+		primitives_.cylinder.push_back(particle.primitive.cylinder);
+		break;
+	case ParticlePrimitiveType::Crescent:
+
+		primitives_.crescent.push_back(particle.primitive.crescent);
+		break;
+	case ParticlePrimitiveType::Lightning:
+
+		primitives_.lightning.push_back(particle.primitive.lightning);
+		break;
+	case ParticlePrimitiveType::TestMesh:
+
+		primitives_.testMesh.push_back(particle.primitive.testMesh);
+		break;
+	}
+
+	// cold
+	CPUParticle::ParticleColdData& cold = colds_.emplace_back();
+	cold.keyPathStartT = particle.keyPathStartT;
+	cold.hasKeyPathStart = particle.hasKeyPathStart;
+	cold.keyPathSpawnAngle = particle.keyPathSpawnAngle;
+	cold.hasKeyPathSpawnAngle = particle.hasKeyPathSpawnAngle;
+	cold.spawnTranlation = particle.spawnTranlation;
+	cold.rotation = particle.rotation;
+	trailRuntimes_.push_back(particle.trailRuntime);
+	spawnOrders_.push_back(nextSpawnOrder_++);
+	if (isTrailEnabled_) {
+
+		trailPoints_.resize(trailPoints_.size() + kTrailStride);
+	}
+}
+
+uint32_t CPUParticleStore::PushRange(const CPUParticle::ParticleData& particle, uint32_t count) {
+
+	const uint32_t first = GetCount();
+	if (count == 0) {
+		return first;
+	}
+
+	// hot
+	translations_.insert(translations_.end(), count, particle.transform.translation);
+	velocities_.insert(velocities_.end(), count, particle.velocity);
+	currentTimes_.insert(currentTimes_.end(), count, particle.currentTime);
+	lifeTimes_.insert(lifeTimes_.end(), count, particle.lifeTime);
+	progresses_.insert(progresses_.end(), count, particle.progress);
+	phaseIndices_.insert(phaseIndices_.end(), count, particle.phaseIndex);
+
+	// GPU転送データ
+	transforms_.insert(transforms_.end(), count, particle.transform);
+	materials_.insert(materials_.end(), count, particle.material);
+	textureInfos_.insert(textureInfos_.end(), count, particle.textureInfo);
+	trailTextureInfos_.insert(trailTextureInfos_.end(), count, particle.trailTextureInfo);
+
+	// 形状
+	switch (primitives_.type) {
+	case ParticlePrimitiveType::Plane:
+
+		primitives_.plane.insert(primitives_.plane.end(), count, particle.primitive.plane);
+		break;
+	case ParticlePrimitiveType::Ring:
+
+		primitives_.ring.insert(primitives_.ring.end(), count, particle.primitive.ring);
+		break;
+	case ParticlePrimitiveType::Cylinder:
+
+		primitives_.cylinder.insert(primitives_.cylinder.end(), count, particle.primitive.cylinder);
+		break;
+	case ParticlePrimitiveType::Crescent:
+
+		primitives_.crescent.insert(primitives_.crescent.end(), count, particle.primitive.crescent);
+		break;
+	case ParticlePrimitiveType::Lightning:
+
+		primitives_.lightning.insert(primitives_.lightning.end(), count, particle.primitive.lightning);
+		break;
+	case ParticlePrimitiveType::TestMesh:
+
+		primitives_.testMesh.insert(primitives_.testMesh.end(), count, particle.primitive.testMesh);
+		break;
+	}
+
+	// cold
+	CPUParticle::ParticleColdData cold{};
+	cold.keyPathStartT = particle.keyPathStartT;
+	cold.hasKeyPathStart = particle.hasKeyPathStart;
+	cold.keyPathSpawnAngle = particle.keyPathSpawnAngle;
+	cold.hasKeyPathSpawnAngle = particle.hasKeyPathSpawnAngle;
+	cold.spawnTranlation = particle.spawnTranlation;
+	cold.rotation = particle.rotation;
+	colds_.insert(colds_.end(), count, cold);
+	trailRuntimes_.insert(trailRuntimes_.end(), count, particle.trailRuntime);
+	for (uint32_t index = 0; index < count; ++index) {
+
+		spawnOrders_.push_back(nextSpawnOrder_++);
+	}
+	if (isTrailEnabled_) {
+
+		trailPoints_.resize(trailPoints_.size() + static_cast<size_t>(count) * kTrailStride);
+	}
+	return first;
+}
+
+void CPUParticleStore::SwapRemove(uint32_t index) {
+
+	const size_t last = lifeTimes_.size() - 1;
+	ForEachArray([index, last](auto& array) {
+
+		// 末尾を削除位置に移してから末尾を詰める
+		if (index != last) {
+
+			array[index] = std::move(array[last]);
+		}
+		array.pop_back();
+		});
+
+	// トレイルのノードも1粒分まとめて移す
+	if (isTrailEnabled_) {
+		if (index != last) {
+
+			std::copy_n(trailPoints_.begin() + last * kTrailStride, kTrailStride,
+				trailPoints_.begin() + static_cast<size_t>(index) * kTrailStride);
+		}
+		trailPoints_.resize(last * kTrailStride);
+	}
+}
+
+void CPUParticleStore::EraseOldest(uint32_t count) {
+
+	if (count == 0) {
+		return;
+	}
+	if (GetCount() <= count) {
+
+		Clear();
+		return;
+	}
+
+	// 発生順の古いcount個のindexを求める
+	eraseIndices_.resize(GetCount());
+	for (uint32_t index = 0; index < GetCount(); ++index) {
+
+		eraseIndices_[index] = index;
+	}
+	std::nth_element(eraseIndices_.begin(), eraseIndices_.begin() + count, eraseIndices_.end(),
+		[this](uint32_t a, uint32_t b) { return spawnOrders_[a] < spawnOrders_[b]; });
+	eraseIndices_.resize(count);
+
+	// 後ろのindexから削除すれば、末尾から移ってくる粒は削除対象に含まれない
+	std::sort(eraseIndices_.begin(), eraseIndices_.end(), std::greater<uint32_t>());
+	for (uint32_t index : eraseIndices_) {
+
+		SwapRemove(index);
+	}
+}
+
+void CPUParticleStore::Clear() {
+
+	ForEachArray([](auto& array) { array.clear(); });
+	trailPoints_.clear();
+}
+
+CPUParticle::ParticleView CPUParticleStore::GetView(uint32_t index) {
+
+	ParticleCommon::TransformForGPU& transform = transforms_[index];
+	CPUParticle::ParticleColdData& cold = colds_[index];
+
+	// グループの形状のみ参照を持つ
+	CPUParticle::PrimitiveView primitive{};
+	primitive.type = primitives_.type;
+	switch (primitives_.type) {
+	case ParticlePrimitiveType::Plane:
+
+		primitive.plane = &primitives_.plane[index];
+		break;
+	case ParticlePrimitiveType::Ring:
+
+		primitive.ring = &primitives_.ring[index];
+		break;
+	case ParticlePrimitiveType::Cylinder:
+
+		primitive.cylinder = &primitives_.cylinder[index];
+		break;
+	case ParticlePrimitiveType::Crescent:
+
+		primitive.crescent = &primitives_.crescent[index];
+		break;
+	case ParticlePrimitiveType::Lightning:
+
+		primitive.lightning = &primitives_.lightning[index];
+		break;
+	case ParticlePrimitiveType::TestMesh:
+
+		primitive.testMesh = &primitives_.testMesh[index];
+		break;
+	}
+
+	return CPUParticle::ParticleView{
+		.lifeTime = lifeTimes_[index],
+		.currentTime = currentTimes_[index],
+		.progress = progresses_[index],
+		.phaseIndex = phaseIndices_[index],
+		.keyPathStartT = cold.keyPathStartT,
+		.hasKeyPathStart = cold.hasKeyPathStart,
+		.keyPathSpawnAngle = cold.keyPathSpawnAngle,
+		.hasKeyPathSpawnAngle = cold.hasKeyPathSpawnAngle,
+		.spawnTranlation = cold.spawnTranlation,
+		.rotation = cold.rotation,
+		.trailRuntime = trailRuntimes_[index],
+		.trailPoints = isTrailEnabled_ ? &trailPoints_[static_cast<size_t>(index) * kTrailStride] : nullptr,
+		.velocity = velocities_[index],
+		.material = materials_[index],
+		.textureInfo = textureInfos_[index],
+		.trailTextureInfo = trailTextureInfos_[index],
+		.transform = {
+			.translation = translations_[index],
+			.scale = transform.scale,
+			.rotationMatrix = transform.rotationMatrix,
+			.parentMatrix = transform.parentMatrix,
+			.billboardMode = transform.billboardMode,
+			.aliveParent = transform.aliveParent,
+		},
+		.primitive = primitive,
+	};
+}
@@ -0,0 +1,172 @@
+#pragma once
+
+//============================================================================
+//	include
+//============================================================================
+#include <Engine/Effect/Particle/Structures/ParticleStructures.h>
+#include <Engine/Effect/Particle/ParticleConfig.h>
+
+// c++
+#include <vector>
+#include <utility>
+
+//============================================================================
+//	CPUParticleStore class
+//	CPUパーティクルをフィールドごとの配列(SoA)で保持する。
+//	毎フレーム触る値は個別の連続した配列に、形状はグループの形状分の配列のみを持つ。
+//	削除は末尾と入れ替えて行うため、並び順は保証しない。発生順は粒ごとの通し番号で持つ
+//	トレイルのノードは1粒kMaxTrailParticles個ずつ、1つの配列にまとめて持つ
+//============================================================================
+class CPUParticleStore {
+public:
+	//========================================================================
+	//	public Methods
+	//========================================================================
+
+	CPUParticleStore() = default;
+	~CPUParticleStore() = default;
+
+	// 形状と確保数の設定、既存の粒は破棄する
+	void Init(ParticlePrimitiveType primitiveType, uint32_t capacity);
+
+	// 1粒追加する
+	void Push(const CPUParticle::ParticleData& particle);
+	// particleと同じ値の粒をcount個まとめて追加し、先頭のindexを返す
+	// 粒ごとに違う値は返したindexから配列を直接書き換える
+	uint32_t PushRange(const CPUParticle::ParticleData& particle, uint32_t count);
+
+	// トレイルのノード配列を持つか設定する、有効にした時点で全ての粒のノードを空にする
+	void EnableTrail(bool enable);
+
+	// indexの粒を末尾と入れ替えて削除する
+	void SwapRemove(uint32_t index);
+	// 発生順の古い粒からcount個を削除する
+	void EraseOldest(uint32_t count);
+	void Clear();
+
+	//--------- accessor -----------------------------------------------------
+
+	// indexの粒の参照を取得
+	CPUParticle::ParticleView GetView(uint32_t index);
+
+	uint32_t GetCount() const { return static_cast<uint32_t>(lifeTimes_.size()); }
+	bool IsEmpty() const { return lifeTimes_.empty(); }
+	ParticlePrimitiveType GetPrimitiveType() const { return primitives_.type; }
+	bool IsTrailEnabled() const { return isTrailEnabled_; }
+
+	// 毎フレーム更新する値
+	std::vector<Vector3>& GetTranslations() { return translations_; }
+	std::vector<Vector3>& GetVelocities() { return velocities_; }
+	std::vector<float>& GetCurrentTimes() { return currentTimes_; }
+	std::vector<float>& GetLifeTimes() { return lifeTimes_; }
+	std::vector<float>& GetProgresses() { return progresses_; }
+	std::vector<uint32_t>& GetPhaseIndices() { return phaseIndices_; }
+
+	// GPUへそのまま転送する値
+	std::vector<ParticleCommon::TransformForGPU>& GetTransforms() { return transforms_; }
+	std::vector<CPUParticle::MaterialForGPU>& GetMaterials() { return materials_; }
+	const std::vector<CPUParticle::MaterialForGPU>& GetMaterials() const { return materials_; }
+	const std::vector<CPUParticle::TextureInfoForGPU>& GetTextureInfos() const { return textureInfos_; }
+	const ParticleCommon::PrimitiveData<true>& GetPrimitives() const { return primitives_; }
+
+	// 発生時の情報
+	std::vector<CPUParticle::ParticleColdData>& GetColds() { return colds_; }
+private:
+	//========================================================================
+	//	private Methods
+	//========================================================================
+
+	//--------- variables ----------------------------------------------------
+
+	// hot
+	std::vector<Vector3> translations_;
+	std::vector<Vector3> velocities_;
+	std::vector<float> currentTimes_;
+	std::vector<float> lifeTimes_;
+	std::vector<float> progresses_;
+	std::vector<uint32_t> phaseIndices_;
+
+	// GPU転送データ
+	// transformのtranslationは転送前にtranslations_から書き込む
+	std::vector<ParticleCommon::TransformForGPU> transforms_;
+	std::vector<CPUParticle::MaterialForGPU> materials_;
+	std::vector<CPUParticle::TextureInfoForGPU> textureInfos_;
+	std::vector<ParticleCommon::TrailTextureInfoForGPU> trailTextureInfos_;
+	// 形状、typeの配列のみ使用する
+	ParticleCommon::PrimitiveData<true> primitives_;
+
+	// cold
+	std::vector<CPUParticle::ParticleColdData> colds_;
+	std::vector<ParticleCommon::TrailRuntime> trailRuntimes_;
+	// 発生順の通し番号、小さいほど古い
+	std::vector<uint64_t> spawnOrders_;
+	uint64_t nextSpawnOrder_ = 0;
+	// EraseOldestで使う作業用の配列
+	std::vector<uint32_t> eraseIndices_;
+
+	// トレイルのノード、index * kTrailStrideから1粒分
+	static constexpr uint32_t kTrailStride = static_cast<uint32_t>(kMaxTrailParticles);
+	std::vector<ParticleCommon::TrailPoint> trailPoints_;
+	bool isTrailEnabled_ = false;
+
+	// 確保数
+	uint32_t capacity_ = 0;
+
+	//--------- functions ----------------------------------------------------
+
+	// 全ての配列に同じ処理を行う
+	template <typename Func>
+	void ForEachArray(Func&& func);
+};
+
+//============================================================================
+//	CPUParticleStore templateMethods
+//============================================================================
+
+template <typename Func>
+inline void CPUParticleStore::ForEachArray(Func&& func) {
+
+	func(translations_);
+	func(velocities_);
+	func(currentTimes_);
+	func(lifeTimes_);
+	func(progresses_);
+	func(phaseIndices_);
+
+	func(transforms_);
+	func(materials_);
+	func(textureInfos_);
+	func(trailTextureInfos_);
+
+	func(colds_);
+	func(trailRuntimes_);
+	func(spawnOrders_);
+
+	// 形状はtypeの配列のみ
+	switch (primitives_.type) {
+	case ParticlePrimitiveType::Plane:
+
+		func(primitives_.plane);
+		break;
+	case ParticlePrimitiveType::Ring:
+
+		func(primitives_.ring);
+		break;
+	case ParticlePrimitiveType::Cylinder:
+
+		func(primitives_.cylinder);
+		break;
+	case ParticlePrimitiveType::Crescent:
+
+		func(primitives_.crescent);
+		break;
+	case ParticlePrimitiveType::Lightning:
+
+		func(primitives_.lightning);
+		break;
+	case ParticlePrimitiveType::TestMesh:
+
+		func(primitives_.testMesh);
+		break;
+	}
+}
@@ -100,6 +100,19 @@ void GPUParticleGroup::CreateFromJson(ID3D12Device* device, Asset* asset, const
 	freeListBuffer_.CreateUAVBuffer(device, kMaxGPUParticles);
 }
 
+void GPUParticleGroup::ResetFromJson(const Json& data) {
+
+	// jsonからデータ取得
+	FromJson(data);
+
+	// 発生状態を戻す
+	ClearParent();
+	SetIsForcedEmit(false);
+	frequencyTime_ = 0.0f;
+	// 残っている粒は初期化処理で破棄させる
+	isInitialized_ = false;
+}
+
 void GPUParticleGroup::Update() {
 
 	// 現在使用中のエミッタを更新
@@ -261,11 +274,12 @@ void GPUParticleGroup::UpdateEmitter() {
 void GPUParticleGroup::UpdateParent() {
 
 	// 親の設定
+	// 所有者から外された後は最後の親の行列を使い続ける
 	ParentForGPU paent{};
-	if (parentTransform_) {
+	if (const Matrix4x4* parentMatrix = GetParentMatrix()) {
 
 		paent.aliveParent = true;
-		paent.parentMatrix = parentTransform_->matrix.world;
+		paent.parentMatrix = *parentMatrix;
 	} else {
 
 		paent.aliveParent = false;
@@ -49,6 +49,8 @@ public:
 	// json
 	Json ToJson() const;
 	void FromJson(const Json& data);
+	// 作成済みのバッファを使い回してjsonの状態に戻す、粒は次の更新で初期化する
+	void ResetFromJson(const Json& data);
 
 	//--------- accessor -----------------------------------------------------
 
@@ -68,6 +70,8 @@ public:
 	const std::string& GetTextureName() const { return textureName_; }
 	const std::string& GetNoiseTextureName() const { return noiseTextureName_; }
 	uint32_t GetEmitCount() const { return emitter_.common.count; }
+	// 発生した粒の寿命、全ての粒で共通
+	float GetLifeTime() const { return emitter_.common.lifeTime; }
 
 	D3D12_GPU_VIRTUAL_ADDRESS GetEmitterShapeBufferAdress() const;
 	const DxConstBuffer<ParentForGPU>& GetParentBuffer() const { return parentBuffer_; }
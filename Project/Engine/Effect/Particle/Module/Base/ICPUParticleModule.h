@@ -5,6 +5,7 @@
 //============================================================================
 #include <Engine/Effect/Particle/Structures/ParticleStructures.h>
 #include <Engine/Effect/Particle/Command/ParticleCommand.h>
+#include <Engine/Utility/Random/RandomStream.h>
 
 // imgui
 #include <imgui.h>
@@ -33,6 +34,17 @@ public:
 	//--------- accessor -----------------------------------------------------
 
 	virtual void SetCommand([[maybe_unused]] const ParticleCommand& command) {}
+	// 乱数列を作り直す、同じseedなら同じ発生、更新結果になる
+	void SetRandomSeed(uint64_t seed) { random_.Seed(seed); }
 
 	virtual const char* GetName() const = 0;
+protected:
+	//========================================================================
+	//	protected Methods
+	//========================================================================
+
+	//--------- variables ----------------------------------------------------
+
+	// モジュールごとに持つ乱数列
+	RandomStream random_;
 };
\ No newline at end of file
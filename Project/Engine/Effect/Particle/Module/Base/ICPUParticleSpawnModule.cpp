@@ -44,7 +44,7 @@ void ICPUParticleSpawnModule::SetCommonData(CPUParticle::ParticleData& particle)
 	particle.rotation = Quaternion::Identity();
 
 	// 生存時間
-	particle.lifeTime = lifeTime_.GetValue();
+	particle.lifeTime = lifeTime_.GetValue(random_);
 
 	// テクスチャ情報
 #if defined(_DEBUG) || defined(_DEVELOPBUILD)
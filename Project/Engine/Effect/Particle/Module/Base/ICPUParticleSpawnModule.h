@@ -6,11 +6,10 @@
 #include <Engine/Object/Data/Transform.h>
 #include <Engine/Effect/Particle/Module/Base/ICPUParticleModule.h>
 #include <Engine/Effect/Particle/Structures/ParticleEmitterStructures.h>
+#include <Engine/Effect/Particle/Data/CPUParticleStore.h>
 
 // imgui
 #include <imgui.h>
-// c++
-#include <list>
 // front
 class Asset;
 
@@ -29,7 +28,7 @@ public:
 	virtual ~ICPUParticleSpawnModule() = default;
 
 	// 受け取ったパーティクルの発生処理を行う
-	virtual void Execute(std::list<CPUParticle::ParticleData>& particles) = 0;
+	virtual void Execute(CPUParticleStore& particles) = 0;
 
 	virtual void UpdateEmitter() {}
 	virtual void DrawEmitter() {}
@@ -49,7 +48,7 @@ public:
 	// データ共有
 	void ShareCommonParam(ICPUParticleSpawnModule* other);
 
-	float GetLifeTime() const { return lifeTime_.GetValue(); }
+	float GetLifeTime() { return lifeTime_.GetValue(random_); }
 	const CPUParticle::TextureInfoForGPU& GetTextureInfo() const { return textureInfo_; }
 protected:
 	//========================================================================
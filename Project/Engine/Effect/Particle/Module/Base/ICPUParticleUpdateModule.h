@@ -5,6 +5,7 @@
 //============================================================================
 #include <Engine/Effect/Particle/Module/Base/ICPUParticleModule.h>
 #include <Engine/Effect/Particle/Module/Base/ParticleLoopableModule.h>
+#include <Engine/Effect/Particle/Data/CPUParticleStore.h>
 
 //============================================================================
 //	ICPUParticleUpdateModule class
@@ -24,9 +25,27 @@ public:
 	void Init() override {}
 
 	// 受け取ったパーティクルの更新処理を行う
-	virtual void Execute(CPUParticle::ParticleData& particle, float deltaTime) = 0;
+	virtual void Execute(CPUParticle::ParticleView& particle, float deltaTime) = 0;
+
+	// [begin, end)のパーティクルをまとめて更新する
+	// 既定では1粒ずつExecuteを呼ぶので、まとめ処理が不要なモジュールはExecuteのみ実装すればよい
+	virtual void ExecuteBatch(CPUParticleStore& particles, uint32_t begin, uint32_t end, float deltaTime);
 
 	//--------- accessor -----------------------------------------------------
 
 	virtual ParticleUpdateModuleID GetID() const = 0;
-};
\ No newline at end of file
+};
+
+//============================================================================
+//	ICPUParticleUpdateModule inlineMethods
+//============================================================================
+
+inline void ICPUParticleUpdateModule::ExecuteBatch(CPUParticleStore& particles,
+	uint32_t begin, uint32_t end, float deltaTime) {
+
+	for (uint32_t index = begin; index < end; ++index) {
+
+		CPUParticle::ParticleView particle = particles.GetView(index);
+		Execute(particle, deltaTime);
+	}
+}
\ No newline at end of file
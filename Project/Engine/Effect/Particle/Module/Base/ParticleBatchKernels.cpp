@@ -0,0 +1,159 @@
+#include "ParticleBatchKernels.h"
+
+//============================================================================
+//	include
+//============================================================================
+
+// simd
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define PARTICLE_SIMD_SSE
+#include <xmmintrin.h>
+#elif defined(_M_ARM64) || defined(__aarch64__) || defined(__ARM_NEON)
+#define PARTICLE_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+// Vector3の配列をfloatの配列として扱う
+static_assert(sizeof(Vector3) == sizeof(float) * 3);
+
+//============================================================================
+//	ParticleBatch namespaceMethods
+//============================================================================
+
+void ParticleBatch::AddScaled(float* dst, const float* src, float scale, uint32_t count) {
+
+	uint32_t i = 0;
+#if defined(PARTICLE_SIMD_SSE)
+	const __m128 s = _mm_set1_ps(scale);
+	for (; i + 4 <= count; i += 4) {
+
+		__m128 d = _mm_loadu_ps(dst + i);
+		d = _mm_add_ps(d, _mm_mul_ps(_mm_loadu_ps(src + i), s));
+		_mm_storeu_ps(dst + i, d);
+	}
+#elif defined(PARTICLE_SIMD_NEON)
+	for (; i + 4 <= count; i += 4) {
+
+		float32x4_t d = vld1q_f32(dst + i);
+		d = vaddq_f32(d, vmulq_n_f32(vld1q_f32(src + i), scale));
+		vst1q_f32(dst + i, d);
+	}
+#endif
+	for (; i < count; ++i) {
+
+		dst[i] += src[i] * scale;
+	}
+}
+
+void ParticleBatch::AddUniform(Vector3* dst, const Vector3& value, uint32_t count) {
+
+	float* data = &dst->x;
+	const uint32_t floatCount = count * 3;
+
+	uint32_t i = 0;
+	// xyzの並びは12要素(4レジスタ分)で一巡する
+#if defined(PARTICLE_SIMD_SSE)
+	const __m128 v0 = _mm_setr_ps(value.x, value.y, value.z, value.x);
+	const __m128 v1 = _mm_setr_ps(value.y, value.z, value.x, value.y);
+	const __m128 v2 = _mm_setr_ps(value.z, value.x, value.y, value.z);
+	for (; i + 12 <= floatCount; i += 12) {
+
+		_mm_storeu_ps(data + i + 0, _mm_add_ps(_mm_loadu_ps(data + i + 0), v0));
+		_mm_storeu_ps(data + i + 4, _mm_add_ps(_mm_loadu_ps(data + i + 4), v1));
+		_mm_storeu_ps(data + i + 8, _mm_add_ps(_mm_loadu_ps(data + i + 8), v2));
+	}
+#elif defined(PARTICLE_SIMD_NEON)
+	const float pattern[12] = {
+		value.x, value.y, value.z, value.x,
+		value.y, value.z, value.x, value.y,
+		value.z, value.x, value.y, value.z };
+	const float32x4_t v0 = vld1q_f32(pattern + 0);
+	const float32x4_t v1 = vld1q_f32(pattern + 4);
+	const float32x4_t v2 = vld1q_f32(pattern + 8);
+	for (; i + 12 <= floatCount; i += 12) {
+
+		vst1q_f32(data + i + 0, vaddq_f32(vld1q_f32(data + i + 0), v0));
+		vst1q_f32(data + i + 4, vaddq_f32(vld1q_f32(data + i + 4), v1));
+		vst1q_f32(data + i + 8, vaddq_f32(vld1q_f32(data + i + 8), v2));
+	}
+#endif
+	for (uint32_t index = i / 3; index < count; ++index) {
+
+		dst[index] += value;
+	}
+}
+
+void ParticleBatch::AdvanceLifeTime(float* currentTimes, float* progresses,
+	const float* lifeTimes, float deltaTime, uint32_t count) {
+
+	uint32_t i = 0;
+#if defined(PARTICLE_SIMD_SSE)
+	const __m128 dt = _mm_set1_ps(deltaTime);
+	for (; i + 4 <= count; i += 4) {
+
+		__m128 current = _mm_add_ps(_mm_loadu_ps(currentTimes + i), dt);
+		_mm_storeu_ps(currentTimes + i, current);
+		_mm_storeu_ps(progresses + i, _mm_div_ps(current, _mm_loadu_ps(lifeTimes + i)));
+	}
+#elif defined(PARTICLE_SIMD_NEON)
+	const float32x4_t dt = vdupq_n_f32(deltaTime);
+	for (; i + 4 <= count; i += 4) {
+
+		float32x4_t current = vaddq_f32(vld1q_f32(currentTimes + i), dt);
+		vst1q_f32(currentTimes + i, current);
+		vst1q_f32(progresses + i, vdivq_f32(current, vld1q_f32(lifeTimes + i)));
+	}
+#endif
+	for (; i < count; ++i) {
+
+		currentTimes[i] += deltaTime;
+		progresses[i] = currentTimes[i] / lifeTimes[i];
+	}
+}
+
+void ParticleBatch::Lerp4(float* out, const float* start, const float* diff, float t) {
+
+#if defined(PARTICLE_SIMD_SSE)
+	_mm_storeu_ps(out, _mm_add_ps(_mm_loadu_ps(start), _mm_mul_ps(_mm_loadu_ps(diff), _mm_set1_ps(t))));
+#elif defined(PARTICLE_SIMD_NEON)
+	vst1q_f32(out, vaddq_f32(vld1q_f32(start), vmulq_n_f32(vld1q_f32(diff), t)));
+#else
+	for (int i = 0; i < 4; ++i) {
+
+		out[i] = start[i] + diff[i] * t;
+	}
+#endif
+}
+
+void ParticleBatch::LerpVector3x4(Vector3* const out[4], const float t[4],
+	const Vector3& start, const Vector3& diff) {
+
+	// 4粒分を成分ごとにまとめて計算してから書き戻す
+	float x[4];
+	float y[4];
+	float z[4];
+#if defined(PARTICLE_SIMD_SSE)
+	const __m128 t4 = _mm_loadu_ps(t);
+	_mm_storeu_ps(x, _mm_add_ps(_mm_set1_ps(start.x), _mm_mul_ps(_mm_set1_ps(diff.x), t4)));
+	_mm_storeu_ps(y, _mm_add_ps(_mm_set1_ps(start.y), _mm_mul_ps(_mm_set1_ps(diff.y), t4)));
+	_mm_storeu_ps(z, _mm_add_ps(_mm_set1_ps(start.z), _mm_mul_ps(_mm_set1_ps(diff.z), t4)));
+#elif defined(PARTICLE_SIMD_NEON)
+	const float32x4_t t4 = vld1q_f32(t);
+	vst1q_f32(x, vmlaq_n_f32(vdupq_n_f32(start.x), t4, diff.x));
+	vst1q_f32(y, vmlaq_n_f32(vdupq_n_f32(start.y), t4, diff.y));
+	vst1q_f32(z, vmlaq_n_f32(vdupq_n_f32(start.z), t4, diff.z));
+#else
+	for (int k = 0; k < 4; ++k) {
+
+		x[k] = start.x + diff.x * t[k];
+		y[k] = start.y + diff.y * t[k];
+		z[k] = start.z + diff.z * t[k];
+	}
+#endif
+	for (int k = 0; k < 4; ++k) {
+
+		out[k]->x = x[k];
+		out[k]->y = y[k];
+		out[k]->z = z[k];
+	}
+}
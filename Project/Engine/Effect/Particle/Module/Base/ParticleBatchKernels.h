@@ -0,0 +1,36 @@
+#pragma once
+
+//============================================================================
+//	include
+//============================================================================
+#include <Engine/MathLib/Vector3.h>
+
+// c++
+#include <cstdint>
+
+//============================================================================
+//	ParticleBatch namespace
+//	更新モジュールのまとめ処理で使う演算。SSE/NEONが使えればまとめて処理する
+//	補間は start + diff * t の形で行うため、std::lerpとは端で1ulp程度ずれることがある
+//============================================================================
+namespace ParticleBatch {
+
+	// 補間のtなどを一度にまとめて求める粒の数
+	constexpr uint32_t kChunkSize = 64;
+
+	// dst[i] += src[i] * scale (count要素)
+	void AddScaled(float* dst, const float* src, float scale, uint32_t count);
+
+	// 全てのdst[i]にvalueを加算する
+	void AddUniform(Vector3* dst, const Vector3& value, uint32_t count);
+
+	// currentTime += deltaTime、progress = currentTime / lifeTime
+	void AdvanceLifeTime(float* currentTimes, float* progresses,
+		const float* lifeTimes, float deltaTime, uint32_t count);
+
+	// 連続した4要素を補間する: out = start + diff * t
+	void Lerp4(float* out, const float* start, const float* diff, float t);
+
+	// 4粒分のVector3を補間する: out[k] = start + diff * t[k]
+	void LerpVector3x4(Vector3* const out[4], const float t[4], const Vector3& start, const Vector3& diff);
+}
@@ -0,0 +1,286 @@
+#include "ParticleNoiseKernels.h"
+
+//============================================================================
+//	include
+//============================================================================
+
+// c++
+#include <algorithm>
+#include <cmath>
+
+// simd
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define PARTICLE_SIMD_SSE
+#include <emmintrin.h>
+#elif defined(_M_ARM64) || defined(__aarch64__)
+#define PARTICLE_SIMD_NEON
+#include <arm_neon.h>
+#endif
+
+//============================================================================
+//	ParticleNoise common
+//============================================================================
+
+namespace {
+
+	// ハッシュの係数
+	constexpr uint32_t kHashX = 374761393u;
+	constexpr uint32_t kHashY = 668265263u;
+	constexpr uint32_t kHashZ = 362437u;
+	constexpr uint32_t kHashSeed = 521417u;
+	constexpr uint32_t kHashMix = 1274126177u;
+	// オクターブごとにseedをずらす量
+	constexpr uint32_t kOctaveSeedStep = 101u;
+	// ハッシュの下位24bitを[0,1)にする
+	constexpr float kRnd01Scale = 1.0f / 16777216.0f;
+
+	// Perlin補間
+	inline float Fade(float t) { return t * t * t * (t * (t * 6.0f - 15.0f) + 10.0f); }
+	// SIMD版と同じ式で補間する
+	inline float Lerp(float a, float b, float t) { return a + (b - a) * t; }
+
+	inline uint32_t Hash3d(uint32_t xTerm, uint32_t yTerm, uint32_t zTerm, uint32_t seedTerm) {
+
+		uint32_t h = xTerm + yTerm + zTerm + seedTerm;
+		h ^= h >> 13;
+		h *= kHashMix;
+		h ^= h >> 16;
+		return h;
+	}
+	inline float Rnd01(uint32_t h) { return static_cast<float>(h & 0x00FFFFFFu) * kRnd01Scale; }
+
+	// 格子を周期で折り返す
+	inline int Wrap(int value, int period) {
+
+		const int r = value % period;
+		return r < 0 ? r + period : r;
+	}
+
+	// 格子点の値を取得する関数を受け取り、8隅を補間する
+	template <typename Corner>
+	float Trilinear(const Vector3& p, Corner&& corner) {
+
+		const float floorX = std::floor(p.x);
+		const float floorY = std::floor(p.y);
+		const float floorZ = std::floor(p.z);
+		const int X = static_cast<int>(floorX);
+		const int Y = static_cast<int>(floorY);
+		const int Z = static_cast<int>(floorZ);
+		const float ux = Fade(p.x - floorX);
+		const float uy = Fade(p.y - floorY);
+		const float uz = Fade(p.z - floorZ);
+
+		const float x00 = Lerp(corner(X, Y, Z), corner(X + 1, Y, Z), ux);
+		const float x10 = Lerp(corner(X, Y + 1, Z), corner(X + 1, Y + 1, Z), ux);
+		const float x01 = Lerp(corner(X, Y, Z + 1), corner(X + 1, Y, Z + 1), ux);
+		const float x11 = Lerp(corner(X, Y + 1, Z + 1), corner(X + 1, Y + 1, Z + 1), ux);
+		const float y0 = Lerp(x00, x10, uy);
+		const float y1 = Lerp(x01, x11, uy);
+
+		// [-1,1]
+		return Lerp(y0, y1, uz) * 2.0f - 1.0f;
+	}
+
+	float Noise3Periodic(const Vector3& p, uint32_t seed, int period) {
+
+		const uint32_t seedTerm = seed * kHashSeed;
+		return Trilinear(p, [&](int x, int y, int z) {
+			return Rnd01(Hash3d(
+				static_cast<uint32_t>(Wrap(x, period)) * kHashX,
+				static_cast<uint32_t>(Wrap(y, period)) * kHashY,
+				static_cast<uint32_t>(Wrap(z, period)) * kHashZ, seedTerm));
+			});
+	}
+}
+
+//============================================================================
+//	ParticleNoise namespaceMethods
+//============================================================================
+
+float ParticleNoise::Noise3(const Vector3& p, uint32_t seed) {
+
+	const uint32_t seedTerm = seed * kHashSeed;
+	return Trilinear(p, [&](int x, int y, int z) {
+		return Rnd01(Hash3d(static_cast<uint32_t>(x) * kHashX,
+			static_cast<uint32_t>(y) * kHashY, static_cast<uint32_t>(z) * kHashZ, seedTerm));
+		});
+}
+
+float ParticleNoise::FBm(const Vector3& p, uint32_t seed, int octaves) {
+
+	float a = 1.0f, f = 1.0f, sum = 0.0f, norm = 0.0f;
+	for (int i = 0; i < octaves; ++i) {
+
+		sum += a * Noise3(p * f, seed + static_cast<uint32_t>(i) * kOctaveSeedStep);
+		norm += a; a *= 0.5f; f *= 2.0f;
+	}
+	return sum / (std::max)(1e-6f, norm);
+}
+
+float ParticleNoise::FBmPeriodic(const Vector3& p, uint32_t seed, int octaves, int period) {
+
+	// 周波数を2倍にすると格子の周期も2倍になる
+	float a = 1.0f, f = 1.0f, sum = 0.0f, norm = 0.0f;
+	for (int i = 0; i < octaves; ++i) {
+
+		sum += a * Noise3Periodic(p * f, seed + static_cast<uint32_t>(i) * kOctaveSeedStep, period << i);
+		norm += a; a *= 0.5f; f *= 2.0f;
+	}
+	return sum / (std::max)(1e-6f, norm);
+}
+
+#if defined(PARTICLE_SIMD_SSE) || defined(PARTICLE_SIMD_NEON)
+
+//============================================================================
+//	ParticleNoise simd
+//============================================================================
+
+namespace {
+
+#if defined(PARTICLE_SIMD_SSE)
+	using Float4 = __m128;
+	using Int4 = __m128i;
+
+	inline Float4 Set1(float v) { return _mm_set1_ps(v); }
+	inline Int4 Set1i(uint32_t v) { return _mm_set1_epi32(static_cast<int>(v)); }
+	inline Float4 Load(const float* p) { return _mm_loadu_ps(p); }
+	inline void Store(float* p, Float4 v) { _mm_storeu_ps(p, v); }
+	inline Float4 Add(Float4 a, Float4 b) { return _mm_add_ps(a, b); }
+	inline Float4 Sub(Float4 a, Float4 b) { return _mm_sub_ps(a, b); }
+	inline Float4 Mul(Float4 a, Float4 b) { return _mm_mul_ps(a, b); }
+	inline Int4 Addi(Int4 a, Int4 b) { return _mm_add_epi32(a, b); }
+	inline Int4 Xori(Int4 a, Int4 b) { return _mm_xor_si128(a, b); }
+	inline Int4 Andi(Int4 a, Int4 b) { return _mm_and_si128(a, b); }
+	template <int N>
+	inline Int4 Shr(Int4 a) { return _mm_srli_epi32(a, N); }
+	inline Float4 ToFloat(Int4 a) { return _mm_cvtepi32_ps(a); }
+	// SSE2には32bitの乗算がないので偶数、奇数要素に分けて掛ける
+	inline Int4 Muli(Int4 a, Int4 b) {
+
+		const __m128i even = _mm_mul_epu32(a, b);
+		const __m128i odd = _mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32));
+		return _mm_unpacklo_epi32(_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+			_mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0)));
+	}
+	// 切り捨てで整数化し、元より大きくなった要素を1引く
+	inline Int4 FloorToInt(Float4 v, Float4& floored) {
+
+		Int4 i = _mm_cvttps_epi32(v);
+		const Float4 truncated = _mm_cvtepi32_ps(i);
+		// 比較結果は真で-1になる
+		i = _mm_add_epi32(i, _mm_castps_si128(_mm_cmpgt_ps(truncated, v)));
+		floored = _mm_cvtepi32_ps(i);
+		return i;
+	}
+#elif defined(PARTICLE_SIMD_NEON)
+	using Float4 = float32x4_t;
+	using Int4 = uint32x4_t;
+
+	inline Float4 Set1(float v) { return vdupq_n_f32(v); }
+	inline Int4 Set1i(uint32_t v) { return vdupq_n_u32(v); }
+	inline Float4 Load(const float* p) { return vld1q_f32(p); }
+	inline void Store(float* p, Float4 v) { vst1q_f32(p, v); }
+	inline Float4 Add(Float4 a, Float4 b) { return vaddq_f32(a, b); }
+	inline Float4 Sub(Float4 a, Float4 b) { return vsubq_f32(a, b); }
+	inline Float4 Mul(Float4 a, Float4 b) { return vmulq_f32(a, b); }
+	inline Int4 Addi(Int4 a, Int4 b) { return vaddq_u32(a, b); }
+	inline Int4 Xori(Int4 a, Int4 b) { return veorq_u32(a, b); }
+	inline Int4 Andi(Int4 a, Int4 b) { return vandq_u32(a, b); }
+	template <int N>
+	inline Int4 Shr(Int4 a) { return vshrq_n_u32(a, N); }
+	inline Float4 ToFloat(Int4 a) { return vcvtq_f32_s32(vreinterpretq_s32_u32(a)); }
+	inline Int4 Muli(Int4 a, Int4 b) { return vmulq_u32(a, b); }
+	inline Int4 FloorToInt(Float4 v, Float4& floored) {
+
+		floored = vrndmq_f32(v);
+		return vreinterpretq_u32_s32(vcvtq_s32_f32(floored));
+	}
+#endif
+
+	inline Float4 Fade4(Float4 t) {
+
+		// t * t * t * (t * (t * 6 - 15) + 10)
+		const Float4 inner = Add(Mul(t, Sub(Mul(t, Set1(6.0f)), Set1(15.0f))), Set1(10.0f));
+		return Mul(Mul(Mul(t, t), t), inner);
+	}
+	inline Float4 Lerp4(Float4 a, Float4 b, Float4 t) { return Add(a, Mul(Sub(b, a), t)); }
+
+	inline Float4 Corner4(Int4 xTerm, Int4 yTerm, Int4 zTerm, Int4 seedTerm) {
+
+		Int4 h = Addi(Addi(xTerm, yTerm), Addi(zTerm, seedTerm));
+		h = Xori(h, Shr<13>(h));
+		h = Muli(h, Set1i(kHashMix));
+		h = Xori(h, Shr<16>(h));
+		// 24bitに収まるので符号付きで変換してよい
+		return Mul(ToFloat(Andi(h, Set1i(0x00FFFFFFu))), Set1(kRnd01Scale));
+	}
+
+	Float4 Noise4(Float4 px, Float4 py, Float4 pz, uint32_t seed) {
+
+		Float4 floorX, floorY, floorZ;
+		const Int4 X = FloorToInt(px, floorX);
+		const Int4 Y = FloorToInt(py, floorY);
+		const Int4 Z = FloorToInt(pz, floorZ);
+		const Float4 ux = Fade4(Sub(px, floorX));
+		const Float4 uy = Fade4(Sub(py, floorY));
+		const Float4 uz = Fade4(Sub(pz, floorZ));
+
+		// (X + 1) * k = X * k + k
+		const Int4 x0 = Muli(X, Set1i(kHashX));
+		const Int4 y0 = Muli(Y, Set1i(kHashY));
+		const Int4 z0 = Muli(Z, Set1i(kHashZ));
+		const Int4 x1 = Addi(x0, Set1i(kHashX));
+		const Int4 y1 = Addi(y0, Set1i(kHashY));
+		const Int4 z1 = Addi(z0, Set1i(kHashZ));
+		const Int4 s = Set1i(seed * kHashSeed);
+
+		const Float4 x00 = Lerp4(Corner4(x0, y0, z0, s), Corner4(x1, y0, z0, s), ux);
+		const Float4 x10 = Lerp4(Corner4(x0, y1, z0, s), Corner4(x1, y1, z0, s), ux);
+		const Float4 x01 = Lerp4(Corner4(x0, y0, z1, s), Corner4(x1, y0, z1, s), ux);
+		const Float4 x11 = Lerp4(Corner4(x0, y1, z1, s), Corner4(x1, y1, z1, s), ux);
+		const Float4 yy0 = Lerp4(x00, x10, uy);
+		const Float4 yy1 = Lerp4(x01, x11, uy);
+
+		// [-1,1]
+		return Sub(Mul(Lerp4(yy0, yy1, uz), Set1(2.0f)), Set1(1.0f));
+	}
+}
+
+void ParticleNoise::FBm4(const float* x, const float* y, const float* z,
+	uint32_t seed, int octaves, float* out) {
+
+	const Float4 px = Load(x);
+	const Float4 py = Load(y);
+	const Float4 pz = Load(z);
+
+	float a = 1.0f, f = 1.0f, norm = 0.0f;
+	Float4 sum = Set1(0.0f);
+	for (int i = 0; i < octaves; ++i) {
+
+		const Float4 frequency = Set1(f);
+		const Float4 n = Noise4(Mul(px, frequency), Mul(py, frequency), Mul(pz, frequency),
+			seed + static_cast<uint32_t>(i) * kOctaveSeedStep);
+		sum = Add(sum, Mul(Set1(a), n));
+		norm += a; a *= 0.5f; f *= 2.0f;
+	}
+	// 1点版と同じく除算で正規化する
+	Store(out, sum);
+	const float denominator = (std::max)(1e-6f, norm);
+	for (uint32_t lane = 0; lane < kLanes; ++lane) {
+
+		out[lane] /= denominator;
+	}
+}
+
+#else
+
+void ParticleNoise::FBm4(const float* x, const float* y, const float* z,
+	uint32_t seed, int octaves, float* out) {
+
+	for (uint32_t lane = 0; lane < kLanes; ++lane) {
+
+		out[lane] = FBm(Vector3(x[lane], y[lane], z[lane]), seed, octaves);
+	}
+}
+
+#endif
@@ -0,0 +1,32 @@
+#pragma once
+
+//============================================================================
+//	include
+//============================================================================
+#include <Engine/MathLib/Vector3.h>
+
+// c++
+#include <cstdint>
+
+//============================================================================
+//	ParticleNoise namespace
+//	ノイズ系モジュールで使うハッシュベースのバリューノイズ
+//	4点版はSSE/NEONが使えればまとめて処理し、1点版と同じ式で計算する
+//============================================================================
+namespace ParticleNoise {
+
+	// まとめて処理する点の数
+	constexpr uint32_t kLanes = 4;
+
+	// 格子点のハッシュを補間したノイズ、[-1,1]
+	float Noise3(const Vector3& p, uint32_t seed);
+	// オクターブ合成、octavesごとに周波数を2倍、振幅を半分にする
+	float FBm(const Vector3& p, uint32_t seed, int octaves);
+
+	// 4点分のFBm、x/y/z/outはkLanes要素
+	void FBm4(const float* x, const float* y, const float* z,
+		uint32_t seed, int octaves, float* out);
+
+	// 格子がperiodごとに繰り返すFBm、ボリュームの焼き込みに使う
+	float FBmPeriodic(const Vector3& p, uint32_t seed, int octaves, int period);
+}
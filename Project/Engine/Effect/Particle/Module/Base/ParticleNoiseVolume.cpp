@@ -0,0 +1,48 @@
+#include "ParticleNoiseVolume.h"
+
+//============================================================================
+//	include
+//============================================================================
+
+// c++
+#include <cmath>
+
+//============================================================================
+//	ParticleNoiseVolume classMethods
+//============================================================================
+
+void ParticleNoiseVolume::Clear() {
+
+	voxels_.clear();
+	voxels_.shrink_to_fit();
+}
+
+Vector3 ParticleNoiseVolume::Sample(const Vector3& p) const {
+
+	const float qx = p.x * kVoxelPerUnit;
+	const float qy = p.y * kVoxelPerUnit;
+	const float qz = p.z * kVoxelPerUnit;
+	const float floorX = std::floor(qx);
+	const float floorY = std::floor(qy);
+	const float floorZ = std::floor(qz);
+	const float fx = qx - floorX;
+	const float fy = qy - floorY;
+	const float fz = qz - floorZ;
+
+	// 2の補数なので負の座標もマスクで折り返せる
+	const uint32_t x0 = static_cast<uint32_t>(static_cast<int>(floorX)) & kMask;
+	const uint32_t y0 = static_cast<uint32_t>(static_cast<int>(floorY)) & kMask;
+	const uint32_t z0 = static_cast<uint32_t>(static_cast<int>(floorZ)) & kMask;
+	const uint32_t x1 = (x0 + 1) & kMask;
+	const uint32_t y1 = (y0 + 1) & kMask;
+	const uint32_t z1 = (z0 + 1) & kMask;
+
+	auto lerp = [](const Vector3& a, const Vector3& b, float t) {
+		return Vector3(a.x + (b.x - a.x) * t, a.y + (b.y - a.y) * t, a.z + (b.z - a.z) * t); };
+
+	const Vector3 c00 = lerp(voxels_[Index(x0, y0, z0)], voxels_[Index(x1, y0, z0)], fx);
+	const Vector3 c10 = lerp(voxels_[Index(x0, y1, z0)], voxels_[Index(x1, y1, z0)], fx);
+	const Vector3 c01 = lerp(voxels_[Index(x0, y0, z1)], voxels_[Index(x1, y0, z1)], fx);
+	const Vector3 c11 = lerp(voxels_[Index(x0, y1, z1)], voxels_[Index(x1, y1, z1)], fx);
+	return lerp(lerp(c00, c10, fy), lerp(c01, c11, fy), fz);
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+//============================================================================
+//	include
+//============================================================================
+#include <Engine/MathLib/Vector3.h>
+
+// c++
+#include <cstdint>
+#include <vector>
+
+//============================================================================
+//	ParticleNoiseVolume class
+//	ノイズの値を周期的な3Dボリュームに焼き込み、三線形補間で取得する
+//	焼き込み範囲は各軸[0, kPeriod)で、範囲外は折り返して繰り返す
+//============================================================================
+class ParticleNoiseVolume {
+public:
+	//========================================================================
+	//	public Methods
+	//========================================================================
+
+	ParticleNoiseVolume() = default;
+	~ParticleNoiseVolume() = default;
+
+	// field(位置)の値を各ボクセルに焼き込む、fieldはkPeriodで繰り返す値を返すこと
+	template <typename Func>
+	void Bake(Func&& field);
+	void Clear();
+
+	// 位置の値を周囲8ボクセルから補間して取得
+	Vector3 Sample(const Vector3& p) const;
+
+	//--------- accessor -----------------------------------------------------
+
+	bool IsBaked() const { return !voxels_.empty(); }
+
+	// 1軸のボクセル数、2の累乗
+	static constexpr uint32_t kResolution = 32;
+	// 焼き込む範囲
+	static constexpr int kPeriod = 8;
+private:
+	//========================================================================
+	//	private Methods
+	//========================================================================
+
+	//--------- variables ----------------------------------------------------
+
+	static constexpr uint32_t kMask = kResolution - 1;
+	static constexpr float kVoxelPerUnit = static_cast<float>(kResolution) / static_cast<float>(kPeriod);
+
+	// x、y、zの順に並べる
+	std::vector<Vector3> voxels_;
+
+	//--------- functions ----------------------------------------------------
+
+	static uint32_t Index(uint32_t x, uint32_t y, uint32_t z) {
+		return (z * kResolution + y) * kResolution + x;
+	}
+};
+
+//============================================================================
+//	ParticleNoiseVolume templateMethods
+//============================================================================
+
+template <typename Func>
+inline void ParticleNoiseVolume::Bake(Func&& field) {
+
+	voxels_.resize(static_cast<size_t>(kResolution) * kResolution * kResolution);
+	for (uint32_t z = 0; z < kResolution; ++z) {
+		for (uint32_t y = 0; y < kResolution; ++y) {
+			for (uint32_t x = 0; x < kResolution; ++x) {
+
+				const Vector3 p(static_cast<float>(x) / kVoxelPerUnit,
+					static_cast<float>(y) / kVoxelPerUnit, static_cast<float>(z) / kVoxelPerUnit);
+				voxels_[Index(x, y, z)] = field(p);
+			}
+		}
+	}
+}
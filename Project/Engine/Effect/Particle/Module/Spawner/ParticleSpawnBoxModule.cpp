@@ -4,7 +4,6 @@
 //	include
 //============================================================================
 #include <Engine/Core/Graphics/Renderer/LineRenderer.h>
-#include <Engine/Utility/Random/RandomGenerator.h>
 
 //============================================================================
 //	ParticleSpawnBoxModule classMethods
@@ -37,10 +36,11 @@ void ParticleSpawnBoxModule::Init() {
 	emitter_.Init();
 }
 
-Vector3 ParticleSpawnBoxModule::GetRandomPoint() const {
+void ParticleSpawnBoxModule::GenerateRandomPoints(uint32_t count) {
 
 	Vector3 halfSize = emitter_.size * 0.5f;
-	return RandomGenerator::Generate(Vector3(-halfSize.x, -halfSize.y, -halfSize.z), halfSize);
+	randomPoints_.resize(count);
+	random_.FillVector3(randomPoints_.data(), count, Vector3(-halfSize.x, -halfSize.y, -halfSize.z), halfSize);
 }
 
 void ParticleSpawnBoxModule::UpdateEmitter() {
@@ -49,9 +49,11 @@ void ParticleSpawnBoxModule::UpdateEmitter() {
 	emitter_.rotationMatrix = Matrix4x4::MakeRotateMatrix(emitterRotation_);
 }
 
-void ParticleSpawnBoxModule::Execute(std::list<CPUParticle::ParticleData>& particles) {
+void ParticleSpawnBoxModule::Execute(CPUParticleStore& particles) {
 
-	uint32_t emitCount = emitCount_.GetValue();
+	uint32_t emitCount = emitCount_.GetValue(random_);
+	// 発生位置を先にまとめて生成しておく
+	GenerateRandomPoints(emitCount);
 	// +Z方向に飛ばす
 	Vector3 forward = Vector3::Normalize(Vector3::TransferNormal(Vector3(0.0f, 0.0f, 1.0f), emitter_.rotationMatrix));
 	for (uint32_t index = 0; index < emitCount; ++index) {
@@ -62,14 +64,14 @@ void ParticleSpawnBoxModule::Execute(std::list<CPUParticle::ParticleData>& parti
 		ICPUParticleSpawnModule::SetCommonData(particle);
 
 		// 速度、発生位置
-		particle.velocity = forward * moveSpeed_.GetValue();
-		particle.transform.translation = emitter_.rotationMatrix.TransformPoint(GetRandomPoint()) + emitter_.translation;
+		particle.velocity = forward * moveSpeed_.GetValue(random_);
+		particle.transform.translation = emitter_.rotationMatrix.TransformPoint(randomPoints_[index]) + emitter_.translation;
 
 		// 発生した瞬間の座標を記録
 		particle.spawnTranlation = particle.transform.translation;
 
 		// 追加
-		particles.push_back(particle);
+		particles.Push(particle);
 	}
 }
 
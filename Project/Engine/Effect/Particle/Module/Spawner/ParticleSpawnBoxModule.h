@@ -21,7 +21,7 @@ public:
 
 	void Init() override;
 
-	void Execute(std::list<CPUParticle::ParticleData>& particles) override;
+	void Execute(CPUParticleStore& particles) override;
 
 	void UpdateEmitter() override;
 	void DrawEmitter() override;
@@ -51,8 +51,11 @@ private:
 	Vector3 emitterRotation_;
 	ParticleEmitterBox emitter_;
 
+	// 1回の発生分の発生位置、使い回して再確保を避ける
+	std::vector<Vector3> randomPoints_;
+
 	//--------- functions ----------------------------------------------------
 
-	// 箱の中のランダムな点を取得
-	Vector3 GetRandomPoint() const;
+	// 箱の中のランダムな点をcount個まとめて生成する
+	void GenerateRandomPoints(uint32_t count);
 };
\ No newline at end of file
@@ -5,7 +5,6 @@
 //============================================================================
 #include <Engine/Core/Graphics/Renderer/LineRenderer.h>
 #include <Engine/MathLib/MathUtils.h>
-#include <Engine/Utility/Random/RandomGenerator.h>
 #include <Engine/Utility/Enum/EnumAdapter.h>
 
 //============================================================================
@@ -56,10 +55,10 @@ void ParticleSpawnCircleModule::Init() {
 	circleDivision_ = 64;
 }
 
-void ParticleSpawnCircleModule::Execute(std::list<CPUParticle::ParticleData>& particles) {
+void ParticleSpawnCircleModule::Execute(CPUParticleStore& particles) {
 
 	// 発生数
-	uint32_t emitCount = emitCount_.GetValue();
+	uint32_t emitCount = emitCount_.GetValue(random_);
 	if (emitCount == 0) {
 		return;
 	}
@@ -78,7 +77,7 @@ void ParticleSpawnCircleModule::Execute(std::list<CPUParticle::ParticleData>& pa
 			//============================================================================
 
 			// 範囲内でランダムに角度を決定
-			float degree = (span <= 0.0f) ? 0.0f : RandomGenerator::Generate(0.0f, span);
+			float degree = (span <= 0.0f) ? 0.0f : random_.Generate(0.0f, span);
 			// 反転させた方向に進ませるかどうかで最終的な角度を決定する
 			float base = clockwise_ ? amax : amin;
 			return Math::WrapDegree(base + (clockwise_ ? -degree : degree));
@@ -156,7 +155,7 @@ void ParticleSpawnCircleModule::Execute(std::list<CPUParticle::ParticleData>& pa
 		particle.spawnTranlation = worldPos;
 
 		// 追加
-		particles.push_back(particle);
+		particles.Push(particle);
 	}
 
 	// Progressiveのときに発生間隔を進める
@@ -190,10 +189,10 @@ void ParticleSpawnCircleModule::UpdateAdvanceProgressive(uint32_t emitCount) {
 }
 
 Vector3 ParticleSpawnCircleModule::GetVelocity(
-	uint32_t index, uint32_t emitCount, const Vector3& direction) const {
+	uint32_t index, uint32_t emitCount, const Vector3& direction) {
 
 	// 速度を取得
-	const float speed = moveSpeed_.GetValue();
+	const float speed = moveSpeed_.GetValue(random_);
 	// Normalはそのまま法線方向を返す
 	if (velocityMode_ == VelocityMode::Normal) {
 
@@ -215,7 +214,7 @@ Vector3 ParticleSpawnCircleModule::GetVelocity(
 			//============================================================================
 
 			// 範囲内でランダムに角度を決定
-			float degree = (span <= 0.0f) ? 0.0f : RandomGenerator::Generate(0.0f, span);
+			float degree = (span <= 0.0f) ? 0.0f : random_.Generate(0.0f, span);
 			// 反転させた方向に進ませるかどうかで最終的な角度を決定する
 			float base = clockwise_ ? amax : amin;
 			return Math::WrapDegree(base + (clockwise_ ? -degree : degree));
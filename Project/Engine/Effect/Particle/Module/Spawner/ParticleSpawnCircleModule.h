@@ -21,7 +21,7 @@ public:
 
 	void Init() override;
 
-	void Execute(std::list<CPUParticle::ParticleData>& particles) override;
+	void Execute(CPUParticleStore& particles) override;
 
 	void DrawEmitter() override;
 
@@ -90,5 +90,5 @@ private:
 	// 角度を進める
 	void UpdateAdvanceProgressive(uint32_t emitCount);
 	// 速度取得
-	Vector3 GetVelocity(uint32_t index, uint32_t emitCount, const Vector3& direction) const;
+	Vector3 GetVelocity(uint32_t index, uint32_t emitCount, const Vector3& direction);
 };
\ No newline at end of file
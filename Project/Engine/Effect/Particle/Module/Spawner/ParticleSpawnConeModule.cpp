@@ -4,7 +4,6 @@
 //	include
 //============================================================================
 #include <Engine/Core/Graphics/Renderer/LineRenderer.h>
-#include <Engine/Utility/Random/RandomGenerator.h>
 
 //============================================================================
 //	ParticleSpawnConeModule classMethods
@@ -35,10 +34,10 @@ void ParticleSpawnConeModule::Init() {
 	emitter_.Init();
 }
 
-Vector3 ParticleSpawnConeModule::GetFacePoint(float radius, float height) const {
+Vector3 ParticleSpawnConeModule::GetFacePoint(float radius, float height) {
 
-	float angle = RandomGenerator::Generate(0.0f, 2.0f * pi);
-	float radiusRandom = RandomGenerator::Generate(0.0f, radius);
+	float angle = random_.Generate(0.0f, 2.0f * pi);
+	float radiusRandom = random_.Generate(0.0f, radius);
 	Vector3 point = Vector3(
 		radiusRandom * std::cos(angle),
 		height,
@@ -53,9 +52,9 @@ void ParticleSpawnConeModule::UpdateEmitter() {
 	emitter_.rotationMatrix = Matrix4x4::MakeRotateMatrix(emitterRotation_);
 }
 
-void ParticleSpawnConeModule::Execute(std::list<CPUParticle::ParticleData>& particles) {
+void ParticleSpawnConeModule::Execute(CPUParticleStore& particles) {
 
-	uint32_t emitCount = emitCount_.GetValue();
+	uint32_t emitCount = emitCount_.GetValue(random_);
 	emitter_.rotationMatrix = Matrix4x4::MakeRotateMatrix(emitterRotation_);
 
 	for (uint32_t index = 0; index < emitCount; ++index) {
@@ -73,14 +72,14 @@ void ParticleSpawnConeModule::Execute(std::list<CPUParticle::ParticleData>& part
 
 		// 速度、発生位置
 		Vector3 direction = (rotatedTopPoint - rotatedBasePoint).Normalize();
-		particle.velocity = direction * moveSpeed_.GetValue();
+		particle.velocity = direction * moveSpeed_.GetValue(random_);
 		particle.transform.translation = rotatedBasePoint;
 
 		// 発生した瞬間の座標を記録
 		particle.spawnTranlation = particle.transform.translation;
 
 		// 追加
-		particles.push_back(particle);
+		particles.Push(particle);
 	}
 }
 
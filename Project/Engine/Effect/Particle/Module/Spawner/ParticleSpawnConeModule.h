@@ -21,7 +21,7 @@ public:
 
 	void Init() override;
 
-	void Execute(std::list<CPUParticle::ParticleData>& particles) override;
+	void Execute(CPUParticleStore& particles) override;
 
 	void UpdateEmitter() override;
 	void DrawEmitter() override;
@@ -54,5 +54,5 @@ private:
 	//--------- functions ----------------------------------------------------
 
 	// コーンの面上の点を取得
-	Vector3 GetFacePoint(float radius, float height) const;
+	Vector3 GetFacePoint(float radius, float height);
 };
\ No newline at end of file
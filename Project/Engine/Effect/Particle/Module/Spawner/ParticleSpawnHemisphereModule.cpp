@@ -4,7 +4,6 @@
 //	include
 //============================================================================
 #include <Engine/Core/Graphics/Renderer/LineRenderer.h>
-#include <Engine/Utility/Random/RandomGenerator.h>
 
 //============================================================================
 //	ParticleSpawnHemisphereModule classMethods
@@ -35,10 +34,10 @@ void ParticleSpawnHemisphereModule::Init() {
 	emitter_.Init();
 }
 
-Vector3 ParticleSpawnHemisphereModule::GetRandomDirection() const {
+Vector3 ParticleSpawnHemisphereModule::GetRandomDirection() {
 
-	float phi = RandomGenerator::Generate(0.0f, pi * 2.0f);
-	float z = RandomGenerator::Generate(-1.0f, 1.0f);
+	float phi = random_.Generate(0.0f, pi * 2.0f);
+	float z = random_.Generate(-1.0f, 1.0f);
 	float sqrtOneMinusZ2 = sqrt(1.0f - z * z);
 	Vector3 direction = Vector3(sqrtOneMinusZ2 * cos(phi), sqrtOneMinusZ2 * sin(phi), z);
 
@@ -56,9 +55,9 @@ void ParticleSpawnHemisphereModule::UpdateEmitter() {
 	emitter_.rotationMatrix = Matrix4x4::MakeRotateMatrix(emitterRotation_);
 }
 
-void ParticleSpawnHemisphereModule::Execute(std::list<CPUParticle::ParticleData>& particles) {
+void ParticleSpawnHemisphereModule::Execute(CPUParticleStore& particles) {
 
-	uint32_t emitCount = emitCount_.GetValue();
+	uint32_t emitCount = emitCount_.GetValue(random_);
 	emitter_.rotationMatrix = Matrix4x4::MakeRotateMatrix(emitterRotation_);
 	for (uint32_t index = 0; index < emitCount; ++index) {
 
@@ -69,14 +68,14 @@ void ParticleSpawnHemisphereModule::Execute(std::list<CPUParticle::ParticleData>
 
 		// 速度、発生位置
 		Vector3 rotatedDirection = emitter_.rotationMatrix.TransformPoint(GetRandomDirection());
-		particle.velocity = rotatedDirection * moveSpeed_.GetValue();
+		particle.velocity = rotatedDirection * moveSpeed_.GetValue(random_);
 		particle.transform.translation = emitter_.translation + rotatedDirection * emitter_.radius;
 
 		// 発生した瞬間の座標を記録
 		particle.spawnTranlation = particle.transform.translation;
 
 		// 追加
-		particles.push_back(particle);
+		particles.Push(particle);
 	}
 }
 
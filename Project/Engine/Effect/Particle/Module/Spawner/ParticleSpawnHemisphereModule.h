@@ -21,7 +21,7 @@ public:
 
 	void Init() override;
 
-	void Execute(std::list<CPUParticle::ParticleData>& particles) override;
+	void Execute(CPUParticleStore& particles) override;
 
 	void UpdateEmitter() override;
 	void DrawEmitter() override;
@@ -54,5 +54,5 @@ private:
 	//--------- functions ----------------------------------------------------
 
 	// ランダムな方向ベクトルを取得
-	Vector3 GetRandomDirection() const;
+	Vector3 GetRandomDirection();
 };
\ No newline at end of file
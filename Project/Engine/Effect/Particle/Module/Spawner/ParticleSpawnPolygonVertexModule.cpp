@@ -5,10 +5,26 @@
 //============================================================================
 #include <Engine/Core/Graphics/Renderer/LineRenderer.h>
 
+// c++
+#include <algorithm>
+#include <cstring>
+
 //============================================================================
 //	ParticleSpawnPolygonVertexModule classMethods
 //============================================================================
 
+// FNV-1a
+static inline uint64_t HashBytes(uint64_t hash, const void* data, size_t size) {
+
+	const uint8_t* bytes = static_cast<const uint8_t*>(data);
+	for (size_t i = 0; i < size; ++i) {
+
+		hash ^= bytes[i];
+		hash *= 0x100000001B3ull;
+	}
+	return hash;
+}
+
 void ParticleSpawnPolygonVertexModule::SetCommand(const ParticleCommand& command) {
 
 	switch (command.id) {
@@ -45,7 +61,7 @@ void ParticleSpawnPolygonVertexModule::SetCommand(const ParticleCommand& command
 				spawnTimer_.Reset();
 				updater_.Reset();
 				spawned_ = 0;
-				instances_.clear();
+				ClearInstances();
 				multiEmit_ = true;
 				updateEnable_ = true;
 			} else {
@@ -78,15 +94,50 @@ void ParticleSpawnPolygonVertexModule::Init() {
 	prevVertices_ = CalcVertices();
 }
 
-std::vector<Vector3> ParticleSpawnPolygonVertexModule::CalcVertices() const {
+const ParticleSpawnPolygonVertexModule::VertexSet& ParticleSpawnPolygonVertexModule::CalcVertices() {
 
-	return CalcVertices(scale_, emitterRotation_);
+	CalcVertices(scale_, emitterRotation_, currentVertices_);
+	return currentVertices_;
 }
 
-std::vector<Vector3> ParticleSpawnPolygonVertexModule::CalcVertices(
-	float scale, const Vector3& rotation) const {
+uint64_t ParticleSpawnPolygonVertexModule::HashTransform(float scale, const Vector3& rotation) const {
 
-	std::vector<Vector3> vertices; vertices.reserve(vertexCount_);
+	// 頂点位置に影響する値のみ
+	uint64_t hash = 0xCBF29CE484222325ull;
+	hash = HashBytes(hash, &vertexCount_, sizeof(vertexCount_));
+	hash = HashBytes(hash, &scale, sizeof(scale));
+	hash = HashBytes(hash, &translation_, sizeof(translation_));
+	hash = HashBytes(hash, &useBillboardRotation_, sizeof(useBillboardRotation_));
+	if (useBillboardRotation_) {
+
+		hash = HashBytes(hash, &rotation.y, sizeof(rotation.y));
+		hash = HashBytes(hash, billboardRotation_.m, sizeof(billboardRotation_.m));
+	} else {
+
+		hash = HashBytes(hash, &rotation, sizeof(rotation));
+	}
+	return hash;
+}
+
+void ParticleSpawnPolygonVertexModule::CalcVertices(float scale,
+	const Vector3& rotation, VertexSet& out) {
+
+	// 姿勢が前回と同じなら計算済みの頂点を使う
+	const uint64_t hash = HashTransform(scale, rotation);
+	if (out.count != 0 && out.transformHash == hash) {
+		return;
+	}
+
+	// 単位多角形は頂点数が変わった時のみ作り直す
+	const uint32_t vertexCount = static_cast<uint32_t>(std::clamp(vertexCount_, 0, static_cast<int>(kMaxVertexCount)));
+	if (unitVertexCount_ != vertexCount) {
+		for (uint32_t i = 0; i < vertexCount; ++i) {
+
+			float ang = 2.0f * pi * i / vertexCount;
+			unitVertices_[i] = Vector3(std::cos(ang), 0.0f, std::sin(ang));
+		}
+		unitVertexCount_ = vertexCount;
+	}
 
 	// ビルボード回転か既存の回転を使用するか分岐
 	Matrix4x4 rotateMatrix = Matrix4x4::MakeIdentity4x4();
@@ -98,25 +149,48 @@ std::vector<Vector3> ParticleSpawnPolygonVertexModule::CalcVertices(
 
 		rotateMatrix = Matrix4x4::MakeRotateMatrix(rotation);
 	}
-	for (int i = 0; i < vertexCount_; ++i) {
+	for (uint32_t i = 0; i < vertexCount; ++i) {
 
-		float ang = 2.0f * pi * i / vertexCount_;
-		Vector3 local(std::cos(ang) * scale, 0.0f, std::sin(ang) * scale);
+		Vector3 local(unitVertices_[i].x * scale, 0.0f, unitVertices_[i].z * scale);
 
 		// 回転適応後の頂点座標
-		vertices.push_back(rotateMatrix.TransformPoint(local) + translation_);
+		out.positions[i] = rotateMatrix.TransformPoint(local) + translation_;
+	}
+	out.count = vertexCount;
+	out.transformHash = hash;
+}
+
+bool ParticleSpawnPolygonVertexModule::IsMoved(const VertexSet& current, const VertexSet& prev) {
+
+	// 同じ姿勢から計算した頂点なら比較するまでもない
+	if (current.count == prev.count && current.transformHash == prev.transformHash) {
+		return false;
+	}
+
+	const uint32_t vertexCount = (std::min)(current.count, prev.count);
+	// 前フレームの頂点位置と比較する
+	for (uint32_t i = 0; i < vertexCount; ++i) {
+		if (std::numeric_limits<float>::epsilon() < (current.positions[i] - prev.positions[i]).Length()) {
+
+			return true;
+		}
 	}
-	return vertices;
+	return false;
 }
 
 void ParticleSpawnPolygonVertexModule::SpawnInstance() {
 
-	if (maxConcurrent_ && maxConcurrent_ <= instances_.size()) {
+	if (maxConcurrent_ && static_cast<uint32_t>(maxConcurrent_) <= activeInstanceCount_) {
 		return;
 	}
 
+	// 空いているスロットを使い回す
+	auto it = std::find_if(instances_.begin(), instances_.end(),
+		[](const PolygonInstance& instance) { return !instance.active; });
+	PolygonInstance& instance = it != instances_.end() ? *it : instances_.emplace_back();
+
 	// 新しいインスタンスの設定
-	PolygonInstance instance{};
+	instance.active = true;
 	instance.updater = updater_;
 	// オフセット回転をかける
 	if (offsetRotation_.Length() != 0.0f) {
@@ -129,115 +203,34 @@ void ParticleSpawnPolygonVertexModule::SpawnInstance() {
 	// 始姿勢で固めて prev を作る
 	instance.scale = instance.updater.GetStartScale();
 	instance.rotation = instance.updater.GetStartRotation();
-	instance.prevVertices = CalcVertices(instance.scale, instance.rotation);
-	instances_.push_back(std::move(instance));
+	instance.prevVertices.count = 0;
+	CalcVertices(instance.scale, instance.rotation, instance.prevVertices);
+	++activeInstanceCount_;
 }
 
-void ParticleSpawnPolygonVertexModule::EmitForInstance(PolygonInstance& instance,
-	std::list<CPUParticle::ParticleData>& particles) {
-
-	const auto current = CalcVertices(instance.scale, instance.rotation);
+void ParticleSpawnPolygonVertexModule::ClearInstances() {
 
-	// 動いていないときは発生させない
-	if (notMoveEmit_) {
-		bool moved = false;
-		for (size_t i = 0, n = (std::min)(current.size(), instance.prevVertices.size()); i < n; ++i) {
-			if (std::numeric_limits<float>::epsilon() < (current[i] - instance.prevVertices[i]).Length()) {
+	// スロットは残して次の発生で使い回す
+	for (auto& instance : instances_) {
 
-				moved = true;
-				break;
-			}
-		}
-		if (!moved) {
-			return;
-		}
+		instance.active = false;
 	}
+	activeInstanceCount_ = 0;
+}
 
-	if (isInterpolate_) {
-
-		const float spacing = interpolateSpacing_.GetValue();
-		const uint32_t emitPerVertex = emitPerVertex_.GetValue();
-		if (instance.prevVertices.size() != current.size()) {
-
-			instance.prevVertices = current;
-		}
-
-		for (uint32_t v = 0; v < current.size(); ++v) {
-
-			const Vector3 diff = current[v] - instance.prevVertices[v];
-			const float   len = diff.Length();
-			if (len < spacing || len < std::numeric_limits<float>::epsilon()) {
-
-				Vector3 velocity = Vector3::Normalize(diff) * moveSpeed_.GetValue();
-				for (uint32_t n = 0; n < emitPerVertex; ++n) {
-
-					CPUParticle::ParticleData particle{};
-					ICPUParticleSpawnModule::SetCommonData(particle);
-					particle.velocity = velocity;
-					particle.transform.translation = current[v];
-					// 発生した瞬間の座標を記録
-					particle.spawnTranlation = particle.transform.translation;
-					particles.push_back(particle);
-				}
-				continue;
-			}
-
-			const uint32_t interpCount = static_cast<uint32_t>(len / spacing);
-			const Vector3 direction = diff / len;
-			const float step = spacing;
-			const Vector3 velocity = direction * moveSpeed_.GetValue();
-
-			for (uint32_t i = 1; i <= interpCount; ++i) {
-
-				const Vector3 pos = instance.prevVertices[v] + direction * step * static_cast<float>(i);
-				for (uint32_t n = 0; n < emitPerVertex; ++n) {
-
-					CPUParticle::ParticleData particle{};
-					ICPUParticleSpawnModule::SetCommonData(particle);
-					particle.velocity = velocity;
-					particle.transform.translation = pos;
-					// 発生した瞬間の座標を記録
-					particle.spawnTranlation = particle.transform.translation;
-					particles.push_back(particle);
-				}
-			}
-			for (uint32_t n = 0; n < emitPerVertex; ++n) {
-
-				CPUParticle::ParticleData particle{};
-				ICPUParticleSpawnModule::SetCommonData(particle);
-				particle.velocity = velocity;
-				particle.transform.translation = current[v];
-				// 発生した瞬間の座標を記録
-				particle.spawnTranlation = particle.transform.translation;
-				particles.push_back(particle);
-			}
-		}
-	} else {
-
-		const uint32_t emitPerVertex = emitPerVertex_.GetValue();
-		if (instance.prevVertices.size() != current.size()) {
-			instance.prevVertices = current;
-		}
-
-		for (uint32_t i = 0; i < current.size(); ++i) {
-
-			Vector3 direction = Vector3::Normalize(current[i] - instance.prevVertices[i]);
-			bool moving = direction.Length() > std::numeric_limits<float>::epsilon();
-			Vector3 vellocity = moving ? direction * moveSpeed_.GetValue() : Vector3(0.0f, 0.0f, moveSpeed_.GetValue());
+void ParticleSpawnPolygonVertexModule::EmitForInstance(PolygonInstance& instance,
+	CPUParticleStore& particles) {
 
-			for (uint32_t n = 0; n < emitPerVertex; ++n) {
+	VertexSet current = instance.prevVertices;
+	CalcVertices(instance.scale, instance.rotation, current);
 
-				CPUParticle::ParticleData particle{};
-				ICPUParticleSpawnModule::SetCommonData(particle);
-				particle.velocity = vellocity;
-				particle.transform.translation = current[i];
-				// 発生した瞬間の座標を記録
-				particle.spawnTranlation = particle.transform.translation;
-				particles.push_back(particle);
-			}
-		}
+	// 動いていないときは発生させない
+	if (notMoveEmit_ && !IsMoved(current, instance.prevVertices)) {
+		return;
 	}
 
+	EmitVertices(current, instance.prevVertices, particles);
+
 	// 次フレーム用の値を保持
 	instance.prevVertices = current;
 }
@@ -248,12 +241,16 @@ void ParticleSpawnPolygonVertexModule::UpdateEmitter() {
 	prevVertices_ = CalcVertices();
 }
 
-void ParticleSpawnPolygonVertexModule::Execute(std::list<CPUParticle::ParticleData>& particles) {
+void ParticleSpawnPolygonVertexModule::Execute(CPUParticleStore& particles) {
 
 	if (!updateEnable_) {
 		return;
 	}
 
+	// 発生する粒の共通設定
+	emitBase_ = CPUParticle::ParticleData{};
+	ICPUParticleSpawnModule::SetCommonData(emitBase_);
+
 	if (useMulti_) {
 		if (!multiEmit_) {
 			return;
@@ -276,25 +273,24 @@ void ParticleSpawnPolygonVertexModule::Execute(std::list<CPUParticle::ParticleDa
 		}
 
 		// 各インスタンスを更新、発生
-		for (size_t i = 0; i < instances_.size();) {
+		for (auto& inst : instances_) {
+			if (!inst.active) {
+				continue;
+			}
 
-			auto& inst = instances_[i];
 			inst.updater.Update(inst.scale, inst.rotation);
 			if (!inst.updater.CanEmit()) {
-				++i;
 				continue;
 			}
 
 			// 各インスタンスを発生させる
 			EmitForInstance(inst, particles);
 
-			// アニメ終了で破棄
+			// アニメ終了でスロットを空ける
 			if (inst.updater.IsFinished()) {
 
-				instances_.erase(instances_.begin() + i);
-			} else {
-
-				++i;
+				inst.active = false;
+				--activeInstanceCount_;
 			}
 		}
 		return;
@@ -305,13 +301,7 @@ void ParticleSpawnPolygonVertexModule::Execute(std::list<CPUParticle::ParticleDa
 		const bool startThisFrame = !updater_.CanEmit();
 		if (startThisFrame) {
 
-			const float savedScale = scale_;
-			const Vector3 savedRot = emitterRotation_;
-			scale_ = updater_.GetStartScale();
-			emitterRotation_ = updater_.GetStartRotation();
-			prevVertices_ = CalcVertices();
-			scale_ = savedScale;
-			emitterRotation_ = savedRot;
+			CalcVertices(updater_.GetStartScale(), updater_.GetStartRotation(), prevVertices_);
 		}
 		updater_.Update(scale_, emitterRotation_);
 	}
@@ -320,13 +310,7 @@ void ParticleSpawnPolygonVertexModule::Execute(std::list<CPUParticle::ParticleDa
 
 		return;
 	}
-	if (isInterpolate_) {
-
-		InterpolateEmit(particles);
-	} else {
-
-		NoneEmit(particles);
-	}
+	EmitVertices(CalcVertices(), prevVertices_, particles);
 }
 
 bool ParticleSpawnPolygonVertexModule::EnableEmit() {
@@ -334,144 +318,81 @@ bool ParticleSpawnPolygonVertexModule::EnableEmit() {
 	if (!notMoveEmit_) {
 		return true;
 	}
+	return IsMoved(CalcVertices(), prevVertices_);
+}
 
-	bool moved = false;
-	const std::vector<Vector3> currentVertices = CalcVertices();
-	const size_t vertexCount = (std::min)(currentVertices.size(), prevVertices_.size());
-	// 前フレームの頂点位置と比較する
-	for (size_t i = 0; i < vertexCount; ++i) {
-		if (std::numeric_limits<float>::epsilon() < (currentVertices[i] - prevVertices_[i]).Length()) {
+void ParticleSpawnPolygonVertexModule::EmitAt(CPUParticleStore& particles,
+	const Vector3& translation, const Vector3& velocity, uint32_t count) {
 
-			moved = true;
-			break;
-		}
+	// 速度、発生位置
+	emitBase_.velocity = velocity;
+	emitBase_.transform.translation = translation;
+	// 発生した瞬間の座標を記録
+	emitBase_.spawnTranlation = translation;
+
+	// まとめて追加し、生存時間のみ1粒ずつ決める
+	const uint32_t first = particles.PushRange(emitBase_, count);
+	std::vector<float>& lifeTimes = particles.GetLifeTimes();
+	for (uint32_t i = 0; i < count; ++i) {
+
+		lifeTimes[first + i] = lifeTime_.GetValue(random_);
 	}
-	return moved;
 }
 
-void ParticleSpawnPolygonVertexModule::InterpolateEmit(std::list<CPUParticle::ParticleData>& particles) {
+void ParticleSpawnPolygonVertexModule::EmitVertices(const VertexSet& current,
+	VertexSet& prev, CPUParticleStore& particles) {
 
-	const std::vector<Vector3> currentVertices = CalcVertices();
 	// 頂点数が変わった時は速度を0.0fにする
-	if (prevVertices_.size() != currentVertices.size()) {
-		prevVertices_ = currentVertices;
+	if (prev.count != current.count) {
+		prev = current;
 	}
 
-	const float spacing = interpolateSpacing_.GetValue();
-	const uint32_t emitPerVertex = emitPerVertex_.GetValue();
-	for (uint32_t v = 0; v < static_cast<uint32_t>(currentVertices.size()); ++v) {
+	if (!isInterpolate_) {
 
-		const Vector3 diff = currentVertices[v] - prevVertices_[v];
-		const float length = diff.Length();
+		const uint32_t emitPerVertex = emitPerVertex_.GetValue(random_);
+		for (uint32_t v = 0; v < current.count; ++v) {
 
-		// 頂点が静止している場合は通常発生のみ
-		if (length < spacing || length < std::numeric_limits<float>::epsilon()) {
+			// 進行方向ベクトル
+			Vector3 direction = Vector3::Normalize(current.positions[v] - prev.positions[v]);
+			bool isMoving = direction.Length() > std::numeric_limits<float>::epsilon();
+			// 速度の設定
+			Vector3 velocity = isMoving ? direction * moveSpeed_.GetValue(random_) :
+				Vector3(0.0f, 0.0f, moveSpeed_.GetValue(random_));
 
-			// 速度設定
-			Vector3 velocity = Vector3::Normalize(diff) * moveSpeed_.GetValue();
-			for (uint32_t n = 0; n < emitPerVertex; ++n) {
+			EmitAt(particles, current.positions[v], velocity, emitPerVertex);
+		}
+		return;
+	}
 
-				CPUParticle::ParticleData particle{};
+	const float spacing = interpolateSpacing_.GetValue(random_);
+	const uint32_t emitPerVertex = emitPerVertex_.GetValue(random_);
+	for (uint32_t v = 0; v < current.count; ++v) {
 
-				// 共通設定
-				ICPUParticleSpawnModule::SetCommonData(particle);
+		const Vector3 diff = current.positions[v] - prev.positions[v];
+		const float length = diff.Length();
 
-				// 速度、発生位置
-				particle.velocity = velocity;
-				particle.transform.translation = currentVertices[v];
-				// 発生した瞬間の座標を記録
-				particle.spawnTranlation = particle.transform.translation;
+		// 頂点が静止している場合は通常発生のみ
+		if (length < spacing || length < std::numeric_limits<float>::epsilon()) {
 
-				// 追加
-				particles.push_back(particle);
-			}
+			Vector3 velocity = Vector3::Normalize(diff) * moveSpeed_.GetValue(random_);
+			EmitAt(particles, current.positions[v], velocity, emitPerVertex);
 			continue;
 		}
 
 		// 補間個数と方向
 		const uint32_t interpCount = static_cast<uint32_t>(length / spacing);
 		const Vector3 direction = diff / length; // 正規化
-		const float stepLen = spacing;           // 等間隔
-		const Vector3 velocity = direction * moveSpeed_.GetValue();
+		const Vector3 velocity = direction * moveSpeed_.GetValue(random_);
 
-		// パーティクル間の補間
+		// パーティクル間の補間、等間隔
 		for (uint32_t i = 1; i <= interpCount; ++i) {
 
-			const Vector3 pos = prevVertices_[v] + direction * stepLen * static_cast<float>(i);
-			for (uint32_t n = 0; n < emitPerVertex; ++n) {
-
-				CPUParticle::ParticleData particle{};
-
-				// 共通設定
-				ICPUParticleSpawnModule::SetCommonData(particle);
-
-				// 速度、発生位置
-				particle.velocity = velocity;
-				particle.transform.translation = pos;
-				// 発生した瞬間の座標を記録
-				particle.spawnTranlation = particle.transform.translation;
-
-				// 追加
-				particles.push_back(particle);
-			}
-
+			const Vector3 pos = prev.positions[v] + direction * spacing * static_cast<float>(i);
+			EmitAt(particles, pos, velocity, emitPerVertex);
 		}
 
 		// 現在のフレームの頂点位置に発生
-		for (uint32_t n = 0; n < emitPerVertex; ++n) {
-
-			CPUParticle::ParticleData particle{};
-
-			// 共通設定
-			ICPUParticleSpawnModule::SetCommonData(particle);
-
-			// 速度、発生位置
-			particle.velocity = velocity;
-			particle.transform.translation = currentVertices[v];
-			// 発生した瞬間の座標を記録
-			particle.spawnTranlation = particle.transform.translation;
-
-			// 追加
-			particles.push_back(particle);
-		}
-
-	}
-}
-
-void ParticleSpawnPolygonVertexModule::NoneEmit(std::list<CPUParticle::ParticleData>& particles) {
-
-	const std::vector<Vector3> currentVertices = CalcVertices();
-	// 頂点数が変わった時は速度を0.0fにする
-	if (prevVertices_.size() != currentVertices.size()) {
-		prevVertices_ = currentVertices;
-	}
-
-	const uint32_t emitPerVertex = emitPerVertex_.GetValue();
-	for (uint32_t cIndex = 0; cIndex < static_cast<uint32_t>(currentVertices.size()); ++cIndex) {
-
-		// 進行方向ベクトル
-		Vector3 direction = Vector3::Normalize(currentVertices[cIndex] - prevVertices_[cIndex]);
-		bool isMoving = direction.Length() > std::numeric_limits<float>::epsilon();
-		// 速度の設定
-		Vector3 velocity = isMoving ? direction * moveSpeed_.GetValue() :
-			Vector3(0.0f, 0.0f, moveSpeed_.GetValue());
-
-		for (uint32_t pIndex = 0; pIndex < emitPerVertex; ++pIndex) {
-
-			CPUParticle::ParticleData particle{};
-
-			// 共通設定
-			ICPUParticleSpawnModule::SetCommonData(particle);
-
-			// 速度、発生位置
-			particle.velocity = velocity;
-			particle.transform.translation = currentVertices[cIndex];
-			// 発生した瞬間の座標を記録
-			particle.spawnTranlation = particle.transform.translation;
-
-			// 追加
-			particles.push_back(particle);
-		}
+		EmitAt(particles, current.positions[v], velocity, emitPerVertex);
 	}
 }
 
@@ -512,7 +433,7 @@ void ParticleSpawnPolygonVertexModule::ImGui() {
 
 		spawnTimer_.Reset();
 		spawned_ = 0;
-		instances_.clear();
+		ClearInstances();
 	}
 
 	ImGui::Text("spawned: %d", spawned_);
@@ -541,16 +462,16 @@ void ParticleSpawnPolygonVertexModule::DrawEmitter() {
 	} else if (vertexCount_ == 2) {
 
 		// 2頂点の場合
-		const auto vertices = CalcVertices();
+		const VertexSet& vertices = CalcVertices();
 		lineRenderer->DrawLine3D(
-			parentTranslation + vertices[0],
-			parentTranslation + vertices[1], emitterLineColor_);
+			parentTranslation + vertices.positions[0],
+			parentTranslation + vertices.positions[1], emitterLineColor_);
 	} else {
 
 		// 1頂点の場合
-		const auto vertices = CalcVertices();
+		const VertexSet& vertices = CalcVertices();
 		lineRenderer->DrawSphere(4, 0.08f * scale_,
-			parentTranslation + vertices[0], emitterLineColor_);
+			parentTranslation + vertices.positions[0], emitterLineColor_);
 	}
 }
 
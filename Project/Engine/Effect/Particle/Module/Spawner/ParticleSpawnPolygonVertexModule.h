@@ -6,6 +6,9 @@
 #include <Engine/Effect/Particle/Module/Base/ICPUParticleSpawnModule.h>
 #include <Engine/Effect/Particle/Module/Spawner/ParticleSpawnModuleUpdater.h>
 
+// c++
+#include <array>
+
 //============================================================================
 //	ParticleSpawnPolygonVertexModule class
 //	多角形頂点発生モジュール
@@ -22,7 +25,7 @@ public:
 
 	void Init() override;
 
-	void Execute(std::list<CPUParticle::ParticleData>& particles) override;
+	void Execute(CPUParticleStore& particles) override;
 
 	void UpdateEmitter() override;
 	void DrawEmitter() override;
@@ -49,14 +52,25 @@ private:
 
 	//--------- structure ----------------------------------------------------
 
-	// 多角形のインスタンス
+	// 頂点数の上限
+	static constexpr uint32_t kMaxVertexCount = 12;
+
+	// 多角形の頂点、計算した時の姿勢のハッシュを一緒に持つ
+	struct VertexSet {
+
+		std::array<Vector3, kMaxVertexCount> positions;
+		uint32_t count = 0;
+		uint64_t transformHash = 0;
+	};
+
+	// 多角形のインスタンス、スロットを使い回すためactiveで管理する
 	struct PolygonInstance {
 
 		float scale;
 		Vector3 rotation;
-		bool active = true;
+		bool active = false;
 
-		std::vector<Vector3> prevVertices;
+		VertexSet prevVertices;
 		ParticlePolygonVertexUpdater updater;
 	};
 
@@ -79,9 +93,14 @@ private:
 	float scale_;     // サイズ
 
 	ParticleValue<uint32_t> emitPerVertex_;   // 各頂点の発生数
-	std::vector<Vector3> prevVertices_;       // 前フレームの頂点位置
+	VertexSet prevVertices_;                  // 前フレームの頂点位置
+	VertexSet currentVertices_;               // 現在の頂点位置、姿勢が変わった時のみ計算し直す
 	ParticleValue<float> interpolateSpacing_; // パーティクル間の距離
 
+	// 原点中心の単位多角形、頂点数が変わった時のみ計算し直す
+	std::array<Vector3, kMaxVertexCount> unitVertices_;
+	uint32_t unitVertexCount_ = 0;
+
 	// マルチ発生の設定
 	bool useMulti_ = false; // インスタンスで複数発生させるかどうか
 	int spawnBurstCount_;   // 0=無限、>0=この回数だけ起動
@@ -93,21 +112,31 @@ private:
 	bool isSelfUpdate_;
 	ParticlePolygonVertexUpdater updater_;
 	std::vector<PolygonInstance> instances_;
+	uint32_t activeInstanceCount_ = 0;
+
+	// 発生する粒の共通部分、発生ごとに位置と速度のみ書き換える
+	CPUParticle::ParticleData emitBase_;
 
 	//--------- functions ----------------------------------------------------
 
 	// 発生可能かどうかのフラグ
 	bool EnableEmit();
-	// 間を補間して発生
-	void InterpolateEmit(std::list<CPUParticle::ParticleData>& particles);
-	// 通常発生
-	void NoneEmit(std::list<CPUParticle::ParticleData>& particles);
+	// 動いたかどうか
+	static bool IsMoved(const VertexSet& current, const VertexSet& prev);
+
+	// 前フレームの頂点からcurrentまでの移動に合わせて発生させる
+	void EmitVertices(const VertexSet& current, VertexSet& prev, CPUParticleStore& particles);
+	// 同じ位置、速度の粒をcount個発生させる
+	void EmitAt(CPUParticleStore& particles, const Vector3& translation,
+		const Vector3& velocity, uint32_t count);
 
-	// N頂点の多角形頂点を計算
-	std::vector<Vector3> CalcVertices() const;
-	std::vector<Vector3> CalcVertices(float scale, const Vector3& rotation) const;
+	// N頂点の多角形頂点を計算、姿勢が前回と同じならoutをそのまま使う
+	const VertexSet& CalcVertices();
+	void CalcVertices(float scale, const Vector3& rotation, VertexSet& out);
+	uint64_t HashTransform(float scale, const Vector3& rotation) const;
 
 	// 1インスタンスの発生処理
 	void SpawnInstance();
-	void EmitForInstance(PolygonInstance& instance, std::list<CPUParticle::ParticleData>& particles);
+	void EmitForInstance(PolygonInstance& instance, CPUParticleStore& particles);
+	void ClearInstances();
 };
\ No newline at end of file
@@ -4,7 +4,6 @@
 //	include
 //============================================================================
 #include <Engine/Core/Graphics/Renderer/LineRenderer.h>
-#include <Engine/Utility/Random/RandomGenerator.h>
 
 //============================================================================
 //	ParticleSpawnSphereModule classMethods
@@ -29,19 +28,19 @@ void ParticleSpawnSphereModule::Init() {
 	emitter_.Init();
 }
 
-Vector3 ParticleSpawnSphereModule::GetRandomDirection() const {
+Vector3 ParticleSpawnSphereModule::GetRandomDirection() {
 
-	float phi = RandomGenerator::Generate(0.0f, pi * 2.0f);
-	float z = RandomGenerator::Generate(-1.0f, 1.0f);
+	float phi = random_.Generate(0.0f, pi * 2.0f);
+	float z = random_.Generate(-1.0f, 1.0f);
 	float sqrtOneMinusZ2 = sqrt(1.0f - z * z);
 	Vector3 direction = Vector3(sqrtOneMinusZ2 * cos(phi), sqrtOneMinusZ2 * sin(phi), z);
 
 	return Vector3::Normalize(direction);
 }
 
-void ParticleSpawnSphereModule::Execute(std::list<CPUParticle::ParticleData>& particles) {
+void ParticleSpawnSphereModule::Execute(CPUParticleStore& particles) {
 
-	uint32_t emitCount = emitCount_.GetValue();
+	uint32_t emitCount = emitCount_.GetValue(random_);
 	for (uint32_t index = 0; index < emitCount; ++index) {
 
 		CPUParticle::ParticleData particle{};
@@ -51,14 +50,14 @@ void ParticleSpawnSphereModule::Execute(std::list<CPUParticle::ParticleData>& pa
 
 		// 速度、発生位置
 		Vector3 direction = GetRandomDirection();
-		particle.velocity = direction * moveSpeed_.GetValue();
+		particle.velocity = direction * moveSpeed_.GetValue(random_);
 		particle.transform.translation = emitter_.translation + direction * emitter_.radius;
 
 		// 発生した瞬間の座標を記録
 		particle.spawnTranlation = particle.transform.translation;
 
 		// 追加
-		particles.push_back(particle);
+		particles.Push(particle);
 	}
 }
 
@@ -21,7 +21,7 @@ void ParticleUpdateAlphaReferenceModule::Init() {
 }
 
 void ParticleUpdateAlphaReferenceModule::Execute(
-	CPUParticle::ParticleData& particle, [[maybe_unused]] float deltaTime) {
+	CPUParticle::ParticleView& particle, [[maybe_unused]] float deltaTime) {
 
 	// 色
 	particle.material.alphaReference = std::lerp(
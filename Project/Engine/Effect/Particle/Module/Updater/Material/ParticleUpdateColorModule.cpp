@@ -4,6 +4,7 @@
 //	include
 //============================================================================
 #include <Engine/Utility/Enum/EnumAdapter.h>
+#include <Engine/Effect/Particle/Module/Base/ParticleBatchKernels.h>
 
 //============================================================================
 //	ParticleUpdateColorModule classMethods
@@ -17,7 +18,7 @@ void ParticleUpdateColorModule::Init() {
 }
 
 void ParticleUpdateColorModule::Execute(
-	CPUParticle::ParticleData& particle, [[maybe_unused]] float deltaTime) {
+	CPUParticle::ParticleView& particle, [[maybe_unused]] float deltaTime) {
 
 	// t値取得
 	const float lerpT = LoopedT(particle.progress);
@@ -27,6 +28,34 @@ void ParticleUpdateColorModule::Execute(
 		EasedValue(easing, lerpT));
 }
 
+void ParticleUpdateColorModule::ExecuteBatch(CPUParticleStore& particles,
+	uint32_t begin, uint32_t end, [[maybe_unused]] float deltaTime) {
+
+	const float start[4] = { color_.start.r, color_.start.g, color_.start.b, color_.start.a };
+	const float diff[4] = {
+		color_.target.r - color_.start.r, color_.target.g - color_.start.g,
+		color_.target.b - color_.start.b, color_.target.a - color_.start.a };
+	std::vector<CPUParticle::MaterialForGPU>& materials = particles.GetMaterials();
+	const std::vector<float>& progresses = particles.GetProgresses();
+
+	// 補間のtは区間ごとにまとめて求める
+	float t[ParticleBatch::kChunkSize];
+	for (uint32_t chunk = begin; chunk < end; chunk += ParticleBatch::kChunkSize) {
+
+		const uint32_t count = (std::min)(ParticleBatch::kChunkSize, end - chunk);
+		for (uint32_t k = 0; k < count; ++k) {
+
+			t[k] = LoopedT(progresses[chunk + k]);
+		}
+		EasedValues(easing, t, t, count);
+		for (uint32_t k = 0; k < count; ++k) {
+
+			// Color::Lerpと同じくtを0~1に制限する
+			ParticleBatch::Lerp4(&materials[chunk + k].color.r, start, diff, std::clamp(t[k], 0.0f, 1.0f));
+		}
+	}
+}
+
 void ParticleUpdateColorModule::ImGui() {
 
 	ImGui::ColorEdit4("startColor", &color_.start.r);
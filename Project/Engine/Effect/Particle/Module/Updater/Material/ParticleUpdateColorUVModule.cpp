@@ -20,7 +20,7 @@ void ParticleUpdateColorUVModule::Init() {
 }
 
 void ParticleUpdateColorUVModule::Execute(
-	CPUParticle::ParticleData& particle, [[maybe_unused]] float deltaTime) {
+	CPUParticle::ParticleView& particle, [[maybe_unused]] float deltaTime) {
 
 	Vector3 translation{};
 	Vector3 scale{};
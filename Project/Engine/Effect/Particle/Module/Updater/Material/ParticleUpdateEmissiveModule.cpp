@@ -4,6 +4,14 @@
 //	include
 //============================================================================
 #include <Engine/Utility/Enum/EnumAdapter.h>
+#include <Engine/Effect/Particle/Module/Base/ParticleBatchKernels.h>
+
+// c++
+#include <cstddef>
+
+// 発光度と発光色を連続した4要素として扱う
+static_assert(offsetof(CPUParticle::MaterialForGPU, emissionColor) ==
+	offsetof(CPUParticle::MaterialForGPU, emissiveIntecity) + sizeof(float));
 
 //============================================================================
 //	ParticleUpdateEmissiveModule classMethods
@@ -20,7 +28,7 @@ void ParticleUpdateEmissiveModule::Init() {
 }
 
 void ParticleUpdateEmissiveModule::Execute(
-	CPUParticle::ParticleData& particle, [[maybe_unused]] float deltaTime) {
+	CPUParticle::ParticleView& particle, [[maybe_unused]] float deltaTime) {
 
 	// 発光度
 	particle.material.emissiveIntecity = std::lerp(
@@ -30,6 +38,30 @@ void ParticleUpdateEmissiveModule::Execute(
 		color_.start, color_.target, EasedValue(easingType_, particle.progress));
 }
 
+void ParticleUpdateEmissiveModule::ExecuteBatch(CPUParticleStore& particles,
+	uint32_t begin, uint32_t end, [[maybe_unused]] float deltaTime) {
+
+	// 発光度、発光色xyzの順
+	const float start[4] = { intencity_.start, color_.start.x, color_.start.y, color_.start.z };
+	const float diff[4] = {
+		intencity_.target - intencity_.start, color_.target.x - color_.start.x,
+		color_.target.y - color_.start.y, color_.target.z - color_.start.z };
+	std::vector<CPUParticle::MaterialForGPU>& materials = particles.GetMaterials();
+	const std::vector<float>& progresses = particles.GetProgresses();
+
+	// 補間のtは区間ごとにまとめて求める
+	float t[ParticleBatch::kChunkSize];
+	for (uint32_t chunk = begin; chunk < end; chunk += ParticleBatch::kChunkSize) {
+
+		const uint32_t count = (std::min)(ParticleBatch::kChunkSize, end - chunk);
+		EasedValues(easingType_, &progresses[chunk], t, count);
+		for (uint32_t k = 0; k < count; ++k) {
+
+			ParticleBatch::Lerp4(&materials[chunk + k].emissiveIntecity, start, diff, t[k]);
+		}
+	}
+}
+
 void ParticleUpdateEmissiveModule::ImGui() {
 
 	ImGui::DragFloat("startIntencity", &intencity_.start, 0.01f);
@@ -22,7 +22,8 @@ public:
 
 	void Init() override;
 
-	void Execute(CPUParticle::ParticleData& particle, float deltaTime) override;
+	void Execute(CPUParticle::ParticleView& particle, float deltaTime) override;
+	void ExecuteBatch(CPUParticleStore& particles, uint32_t begin, uint32_t end, float deltaTime) override;
 
 	void ImGui() override;
 
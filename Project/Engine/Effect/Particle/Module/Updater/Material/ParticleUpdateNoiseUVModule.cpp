@@ -20,7 +20,7 @@ void ParticleUpdateNoiseUVModule::Init() {
 }
 
 void ParticleUpdateNoiseUVModule::Execute(
-	CPUParticle::ParticleData& particle, [[maybe_unused]] float deltaTime) {
+	CPUParticle::ParticleView& particle, [[maybe_unused]] float deltaTime) {
 
 	Vector3 translation{};
 	Vector3 scale{};
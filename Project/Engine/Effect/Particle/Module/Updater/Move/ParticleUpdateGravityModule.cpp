@@ -1,5 +1,10 @@
 #include "ParticleUpdateGravityModule.h"
 
+//============================================================================
+//	include
+//============================================================================
+#include <Engine/Effect/Particle/Module/Base/ParticleBatchKernels.h>
+
 //============================================================================
 //	ParticleUpdateGravityModule classMethods
 //============================================================================
@@ -18,7 +23,7 @@ void ParticleUpdateGravityModule::Init() {
 }
 
 void ParticleUpdateGravityModule::Execute(
-	CPUParticle::ParticleData& particle, float deltaTime) {
+	CPUParticle::ParticleView& particle, float deltaTime) {
 
 	// 地面に反射する場合の処理
 	if (reflectGround_) {
@@ -43,6 +48,32 @@ void ParticleUpdateGravityModule::Execute(
 	particle.velocity += gravity;
 }
 
+void ParticleUpdateGravityModule::ExecuteBatch(CPUParticleStore& particles,
+	uint32_t begin, uint32_t end, float deltaTime) {
+
+	const uint32_t count = end - begin;
+	Vector3* translations = &particles.GetTranslations()[begin];
+	Vector3* velocities = &particles.GetVelocities()[begin];
+
+	// 地面に反射する場合の処理
+	if (reflectGround_) {
+
+		// 速度を加算後の座標
+		ParticleBatch::AddScaled(&translations->x, &velocities->x, deltaTime, count * 3);
+		// 地面を越えた粒のみ反射させる
+		for (uint32_t i = 0; i < count; ++i) {
+			if (translations[i].y <= reflectGroundY_ && velocities[i].y < 0.0f) {
+
+				velocities[i] = Vector3::Reflect(velocities[i], Vector3(0.0f, 1.0f, 0.0f)) * restitution_;
+				translations[i].y = reflectGroundY_;
+			}
+		}
+	}
+
+	// 重力の適応
+	ParticleBatch::AddUniform(velocities, direction_ * strength_ * deltaTime, count);
+}
+
 void ParticleUpdateGravityModule::ImGui() {
 
 	ImGui::Checkbox("reflectGround", &reflectGround_);
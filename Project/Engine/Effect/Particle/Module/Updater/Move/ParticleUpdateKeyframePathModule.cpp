@@ -5,7 +5,6 @@
 //============================================================================
 #include <Engine/Core/Graphics/Renderer/LineRenderer.h>
 #include <Engine/Utility/Enum/EnumAdapter.h>
-#include <Engine/Utility/Random/RandomGenerator.h>
 
 //============================================================================
 //	ParticleUpdateKeyframePathModule classMethods
@@ -64,7 +63,7 @@ void ParticleUpdateKeyframePathModule::Init() {
 }
 
 void ParticleUpdateKeyframePathModule::Execute(
-	CPUParticle::ParticleData& particle, [[maybe_unused]] float deltaTime) {
+	CPUParticle::ParticleView& particle, [[maybe_unused]] float deltaTime) {
 
 	// キーフレームがないときは処理しない
 	if (keys_.empty()) {
@@ -123,7 +122,7 @@ void ParticleUpdateKeyframePathModule::Execute(
 		if (0.0f < spawnAngleJitter_) {
 
 			// 乱数でアングルを設定
-			angle += RandomGenerator::Generate(-0.5f, 0.5f) * spawnAngleJitter_;
+			angle += random_.Generate(-0.5f, 0.5f) * spawnAngleJitter_;
 		}
 		if (spawnAngleWrap_) {
 
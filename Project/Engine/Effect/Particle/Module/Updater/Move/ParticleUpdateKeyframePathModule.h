@@ -22,7 +22,7 @@ public:
 
 	void Init() override;
 
-	void Execute(CPUParticle::ParticleData& particle, float deltaTime) override;
+	void Execute(CPUParticle::ParticleView& particle, float deltaTime) override;
 
 	void ImGui() override;
 
@@ -4,20 +4,12 @@
 //	include
 //============================================================================
 #include <Engine/Utility/Enum/EnumAdapter.h>
+#include <Engine/Effect/Particle/Module/Base/ParticleNoiseKernels.h>
 
 //============================================================================
 //	ParticleUpdateNoiseForceModule classMethods
 //============================================================================
 
-// Perlin補間
-static inline float Fade(float t) { return t * t * t * (t * (t * 6 - 15) + 10); }
-static inline uint32_t Hash3d(int x, int y, int z, uint32_t s) {
-
-	uint32_t h = (uint32_t)x * 374761393u + (uint32_t)y * 668265263u + (uint32_t)z * 362437u + s * 521417u;
-	h ^= h >> 13; h *= 1274126177u; h ^= h >> 16; return h;
-}
-static inline float Rnd01(uint32_t h) { return (h & 0x00FFFFFFu) / float(0x01000000); }
-
 void ParticleUpdateNoiseForceModule::Init() {
 
 	// 初期化値
@@ -29,39 +21,105 @@ void ParticleUpdateNoiseForceModule::Init() {
 	seed_ = 1337;
 	anchorToSpawn_ = true;
 	offsetAmp_ = Vector3::AnyInit(0.2f);
+	useVolume_ = false;
 }
 
 void ParticleUpdateNoiseForceModule::Execute(
-	CPUParticle::ParticleData& particle, float deltaTime) {
+	CPUParticle::ParticleView& particle, float deltaTime) {
 
 	// 基準の位置を取得
 	Vector3 pos = particle.transform.translation;
 	Vector3 sample = pos * frequency_ + Vector3(0.0f, timeScale_ * particle.currentTime, 0.0f);
 
+	ApplyField(EvaluateField(sample), particle.transform.translation,
+		particle.velocity, particle.spawnTranlation, deltaTime);
+}
+
+void ParticleUpdateNoiseForceModule::ExecuteBatch(CPUParticleStore& particles,
+	uint32_t begin, uint32_t end, float deltaTime) {
+
+	using ParticleNoise::kLanes;
+
+	std::vector<Vector3>& translations = particles.GetTranslations();
+	std::vector<Vector3>& velocities = particles.GetVelocities();
+	const std::vector<float>& currentTimes = particles.GetCurrentTimes();
+	const std::vector<CPUParticle::ParticleColdData>& colds = particles.GetColds();
+
+	const bool useVolume = useVolume_ && volume_.IsBaked();
+	auto fbm4 = [this](const float* x, const float* y, const float* z, uint32_t seed, float* out) {
+		ParticleNoise::FBm4(x, y, z, seed, octaves_, out);
+		};
+
+	uint32_t index = begin;
+	for (; index + kLanes <= end; index += kLanes) {
+
+		// サンプル位置を成分ごとに並べる
+		float x[kLanes];
+		float y[kLanes];
+		float z[kLanes];
+		for (uint32_t lane = 0; lane < kLanes; ++lane) {
+
+			const Vector3& pos = translations[index + lane];
+			x[lane] = pos.x * frequency_;
+			y[lane] = pos.y * frequency_ + timeScale_ * currentTimes[index + lane];
+			z[lane] = pos.z * frequency_;
+		}
+
+		Vector3 field[kLanes];
+		if (useVolume) {
+			for (uint32_t lane = 0; lane < kLanes; ++lane) {
+
+				field[lane] = volume_.Sample(Vector3(x[lane], y[lane], z[lane]));
+			}
+		} else {
+
+			EvaluateField<kLanes>(x, y, z, fbm4, field);
+		}
+
+		for (uint32_t lane = 0; lane < kLanes; ++lane) {
+
+			const uint32_t i = index + lane;
+			ApplyField(field[lane], translations[i], velocities[i], colds[i].spawnTranlation, deltaTime);
+		}
+	}
+	// 端数
+	for (; index < end; ++index) {
+
+		const Vector3 sample = translations[index] * frequency_ +
+			Vector3(0.0f, timeScale_ * currentTimes[index], 0.0f);
+		ApplyField(EvaluateField(sample), translations[index], velocities[index],
+			colds[index].spawnTranlation, deltaTime);
+	}
+}
+
+void ParticleUpdateNoiseForceModule::ApplyField(const Vector3& field, Vector3& translation,
+	Vector3& velocity, const Vector3& spawnTranslation, float deltaTime) const {
+
 	if (mode_ == NoiseMode::Offset) {
 
 		// 発生位置からのオフセット揺らぎ
-		Vector3 o(FBm(sample, seed_ + 11u), FBm(sample, seed_ + 23u), FBm(sample, seed_ + 31u));
-		particle.transform.translation = (anchorToSpawn_ ? particle.spawnTranlation : pos)
-			+ Vector3(o.x * offsetAmp_.x, o.y * offsetAmp_.y, o.z * offsetAmp_.z);
+		translation = (anchorToSpawn_ ? spawnTranslation : translation)
+			+ Vector3(field.x * offsetAmp_.x, field.y * offsetAmp_.y, field.z * offsetAmp_.z);
 		return;
 	}
 
 	// 勾配またはカールを力として速度に加算
-	Vector3 force = (mode_ == NoiseMode::Curl) ? CurlNoise(sample) : GradNoise(sample, seed_);
-	particle.velocity += force * strength_;
+	velocity += field * strength_;
 
 	// 簡易ダンピング
 	if (damping_ > 0.0f) {
 
-		particle.velocity *= (std::max)(0.0f, 1.0f - damping_ * deltaTime);
+		velocity *= (std::max)(0.0f, 1.0f - damping_ * deltaTime);
 	}
 }
 
 void ParticleUpdateNoiseForceModule::ImGui() {
 
-	EnumAdapter<NoiseMode>::Combo("mode", &mode_);
-	ImGui::DragInt("octaves", &octaves_, 1, 1, 8);
+	// ボリュームの値が変わる設定
+	bool isFieldChanged = false;
+
+	isFieldChanged |= EnumAdapter<NoiseMode>::Combo("mode", &mode_);
+	isFieldChanged |= ImGui::DragInt("octaves", &octaves_, 1, 1, 8);
 	ImGui::DragFloat("frequency", &frequency_, 0.01f, 0.01f, 10.0f);
 	ImGui::DragFloat("timeScale", &timeScale_, 0.01f, 0.0f, 5.0f);
 	if (mode_ != NoiseMode::Offset) {
@@ -73,7 +131,13 @@ void ParticleUpdateNoiseForceModule::ImGui() {
 		ImGui::DragFloat3("offsetAmp", &offsetAmp_.x, 0.01f);
 		ImGui::Checkbox("anchorToSpawn", &anchorToSpawn_);
 	}
-	ImGui::InputScalar("seed", ImGuiDataType_U32, &seed_);
+	isFieldChanged |= ImGui::InputScalar("seed", ImGuiDataType_U32, &seed_);
+	isFieldChanged |= ImGui::Checkbox("useVolume", &useVolume_);
+
+	if (isFieldChanged) {
+
+		BakeVolume();
+	}
 }
 
 Json ParticleUpdateNoiseForceModule::ToJson() {
@@ -88,6 +152,7 @@ Json ParticleUpdateNoiseForceModule::ToJson() {
 	data["seed_"] = seed_;
 	data["anchorToSpawn_"] = anchorToSpawn_;
 	data["offsetAmp_"] = offsetAmp_.ToJson();
+	data["useVolume_"] = useVolume_;
 
 	return data;
 }
@@ -102,58 +167,111 @@ void ParticleUpdateNoiseForceModule::FromJson(const Json& data) {
 	seed_ = data.value("seed_", 1337);
 	anchorToSpawn_ = data.value("anchorToSpawn_", true);
 	offsetAmp_ = Vector3::FromJson(data.value("offsetAmp_", Json()));
-}
+	useVolume_ = data.value("useVolume_", false);
 
-float ParticleUpdateNoiseForceModule::Noise3(const Vector3& p, uint32_t s) const {
-
-	const int X = (int)floorf(p.x), Y = (int)floorf(p.y), Z = (int)floorf(p.z);
-	const float fx = p.x - X, fy = p.y - Y, fz = p.z - Z;
-	const float ux = Fade(fx), uy = Fade(fy), uz = Fade(fz);
-	auto L = [&](int dx, int dy, int dz) { return Rnd01(Hash3d(X + dx, Y + dy, Z + dz, s)); };
-	// 8隅をtrilinear
-	float x00 = std::lerp(L(0, 0, 0), L(1, 0, 0), ux);
-	float x10 = std::lerp(L(0, 1, 0), L(1, 1, 0), ux);
-	float x01 = std::lerp(L(0, 0, 1), L(1, 0, 1), ux);
-	float x11 = std::lerp(L(0, 1, 1), L(1, 1, 1), ux);
-	float y0 = std::lerp(x00, x10, uy);
-	float y1 = std::lerp(x01, x11, uy);
-
-	// [-1,1]
-	return std::lerp(y0, y1, uz) * 2.0f - 1.0f;
+	BakeVolume();
 }
 
-float ParticleUpdateNoiseForceModule::FBm(const Vector3& p, uint32_t s) const {
+template <uint32_t N, typename FBmFunc>
+void ParticleUpdateNoiseForceModule::EvaluateField(const float* x, const float* y, const float* z,
+	FBmFunc&& fbm, Vector3* out) const {
+
+	if (mode_ == NoiseMode::Offset) {
+
+		float ox[N], oy[N], oz[N];
+		fbm(x, y, z, seed_ + 11u, ox);
+		fbm(x, y, z, seed_ + 23u, oy);
+		fbm(x, y, z, seed_ + 31u, oz);
+		for (uint32_t lane = 0; lane < N; ++lane) {
 
-	float a = 1.0f, f = 1.0f, sum = 0.0f, norm = 0.0f;
-	for (int i = 0; i < octaves_; i++) {
+			out[lane] = Vector3(ox[lane], oy[lane], oz[lane]);
+		}
+		return;
+	}
 
-		sum += a * Noise3(p * f, s + i * 101u);
-		norm += a; a *= 0.5f; f *= 2.0f;
+	// 中心差分でaxis方向の偏微分を求める
+	const float eps = 0.01f;
+	auto derivative = [&](uint32_t seed, int axis, float* result) {
+
+		float shifted[3][N];
+		const float* base[3] = { x, y, z };
+		float high[N], low[N];
+		for (int sign = 0; sign < 2; ++sign) {
+			for (int component = 0; component < 3; ++component) {
+				for (uint32_t lane = 0; lane < N; ++lane) {
+
+					shifted[component][lane] = base[component][lane] +
+						(component == axis ? (sign == 0 ? eps : -eps) : 0.0f);
+				}
+			}
+			fbm(shifted[0], shifted[1], shifted[2], seed, sign == 0 ? high : low);
+		}
+		for (uint32_t lane = 0; lane < N; ++lane) {
+
+			result[lane] = (high[lane] - low[lane]) / (2 * eps);
+		}
+		};
+
+	if (mode_ == NoiseMode::Curl) {
+
+		// curl(F) = (∂Fz/∂y-∂Fy/∂z, ∂Fx/∂z-∂Fz/∂x, ∂Fy/∂x-∂Fx/∂y)
+		const uint32_t s1 = seed_ + 17u, s2 = seed_ + 37u, s3 = seed_ + 59u;
+		float dFz_dy[N], dFy_dz[N], dFx_dz[N], dFz_dx[N], dFy_dx[N], dFx_dy[N];
+		derivative(s3, 1, dFz_dy);
+		derivative(s2, 2, dFy_dz);
+		derivative(s1, 2, dFx_dz);
+		derivative(s3, 0, dFz_dx);
+		derivative(s2, 0, dFy_dx);
+		derivative(s1, 1, dFx_dy);
+		for (uint32_t lane = 0; lane < N; ++lane) {
+
+			out[lane] = Vector3(dFz_dy[lane] - dFy_dz[lane],
+				dFx_dz[lane] - dFz_dx[lane], dFy_dx[lane] - dFx_dy[lane]);
+		}
+		return;
+	}
+
+	// ∇fBm
+	float dx[N], dy[N], dz[N];
+	derivative(seed_, 0, dx);
+	derivative(seed_, 1, dy);
+	derivative(seed_, 2, dz);
+	for (uint32_t lane = 0; lane < N; ++lane) {
+
+		out[lane] = Vector3(dx[lane], dy[lane], dz[lane]);
 	}
-	return sum / (std::max)(1e-6f, norm);
 }
 
-Vector3 ParticleUpdateNoiseForceModule::GradNoise(const Vector3& p, uint32_t s) const {
+Vector3 ParticleUpdateNoiseForceModule::EvaluateField(const Vector3& sample) const {
 
-	const float eps = 0.01f;
-	const float nx1 = FBm(Vector3(p.x + eps, p.y, p.z), s), nx0 = FBm(Vector3(p.x - eps, p.y, p.z), s);
-	const float ny1 = FBm(Vector3(p.x, p.y + eps, p.z), s), ny0 = FBm(Vector3(p.x, p.y - eps, p.z), s);
-	const float nz1 = FBm(Vector3(p.x, p.y, p.z + eps), s), nz0 = FBm(Vector3(p.x, p.y, p.z - eps), s);
-	return Vector3((nx1 - nx0) / (2 * eps), (ny1 - ny0) / (2 * eps), (nz1 - nz0) / (2 * eps));
+	if (useVolume_ && volume_.IsBaked()) {
+		return volume_.Sample(sample);
+	}
+
+	Vector3 field;
+	EvaluateField<1>(&sample.x, &sample.y, &sample.z,
+		[this](const float* x, const float* y, const float* z, uint32_t seed, float* out) {
+			*out = ParticleNoise::FBm(Vector3(*x, *y, *z), seed, octaves_);
+		}, &field);
+	return field;
 }
 
-Vector3 ParticleUpdateNoiseForceModule::CurlNoise(const Vector3& p) const {
+void ParticleUpdateNoiseForceModule::BakeVolume() {
 
-	const float eps = 0.01f;
-	auto n1 = [&](const Vector3& q) { return FBm(q, seed_ + 17u); };
-	auto n2 = [&](const Vector3& q) { return FBm(q, seed_ + 37u); };
-	auto n3 = [&](const Vector3& q) { return FBm(q, seed_ + 59u); };
-	// 中心差分で curl(F) = (∂Fz/∂y-∂Fy/∂z, ∂Fx/∂z-∂Fz/∂x, ∂Fy/∂x-∂Fx/∂y)
-	float dFz_dy = (n3(p + Vector3(0, eps, 0)) - n3(p - Vector3(0, eps, 0))) / (2 * eps);
-	float dFy_dz = (n2(p + Vector3(0, 0, eps)) - n2(p - Vector3(0, 0, eps))) / (2 * eps);
-	float dFx_dz = (n1(p + Vector3(0, 0, eps)) - n1(p - Vector3(0, 0, eps))) / (2 * eps);
-	float dFz_dx = (n3(p + Vector3(eps, 0, 0)) - n3(p - Vector3(eps, 0, 0))) / (2 * eps);
-	float dFy_dx = (n2(p + Vector3(eps, 0, 0)) - n2(p - Vector3(eps, 0, 0))) / (2 * eps);
-	float dFx_dy = (n1(p + Vector3(0, eps, 0)) - n1(p - Vector3(0, eps, 0))) / (2 * eps);
-	return Vector3(dFz_dy - dFy_dz, dFx_dz - dFz_dx, dFy_dx - dFx_dy);
+	if (!useVolume_) {
+
+		volume_.Clear();
+		return;
+	}
+
+	// 繰り返しの継ぎ目が出ないように周期的なノイズで焼き込む
+	volume_.Bake([this](const Vector3& p) {
+
+		Vector3 field;
+		EvaluateField<1>(&p.x, &p.y, &p.z,
+			[this](const float* x, const float* y, const float* z, uint32_t seed, float* out) {
+				*out = ParticleNoise::FBmPeriodic(Vector3(*x, *y, *z), seed, octaves_, ParticleNoiseVolume::kPeriod);
+			}, &field);
+		return field;
+		});
 }
\ No newline at end of file
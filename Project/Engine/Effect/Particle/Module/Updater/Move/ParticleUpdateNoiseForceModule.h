@@ -4,6 +4,7 @@
 //	include
 //============================================================================
 #include <Engine/Effect/Particle/Module/Base/ICPUParticleUpdateModule.h>
+#include <Engine/Effect/Particle/Module/Base/ParticleNoiseVolume.h>
 
 //============================================================================
 //	ParticleUpdateNoiseForceModule class
@@ -21,7 +22,9 @@ public:
 
 	void Init() override;
 
-	void Execute(CPUParticle::ParticleData& particle, float deltaTime) override;
+	void Execute(CPUParticle::ParticleView& particle, float deltaTime) override;
+	// 4粒ずつまとめてノイズを求める
+	void ExecuteBatch(CPUParticleStore& particles, uint32_t begin, uint32_t end, float deltaTime) override;
 
 	void ImGui() override;
 
@@ -66,11 +69,23 @@ private:
 	bool anchorToSpawn_ = true;
 	Vector3 offsetAmp_;
 
+	// 焼き込んだボリュームから取得する、繰り返しが見える代わりに軽い
+	bool useVolume_ = false;
+	ParticleNoiseVolume volume_;
+
 	//--------- functions ----------------------------------------------------
 
-	// ノイズ値の生成
-	float Noise3(const Vector3& p, uint32_t s) const;      // ノイズ生成
-	float FBm(const Vector3& p, uint32_t s) const;         // オクターブ合成
-	Vector3 GradNoise(const Vector3& p, uint32_t s) const; // ∇fBm
-	Vector3 CurlNoise(const Vector3& p) const;             // ∇×(fBm1,fBm2,fBm3)
+	// N点分のノイズの値を求める、モードに応じてオフセット、∇fBm、∇×(fBm1,fBm2,fBm3)
+	// fbm(x, y, z, seed, out)はN点分のfBmを返す
+	template <uint32_t N, typename FBmFunc>
+	void EvaluateField(const float* x, const float* y, const float* z, FBmFunc&& fbm, Vector3* out) const;
+	// 1点分
+	Vector3 EvaluateField(const Vector3& sample) const;
+
+	// 求めた値を粒に適応する
+	void ApplyField(const Vector3& field, Vector3& translation, Vector3& velocity,
+		const Vector3& spawnTranslation, float deltaTime) const;
+
+	// ボリュームを現在の設定で焼き直す
+	void BakeVolume();
 };
\ No newline at end of file
@@ -1,14 +1,27 @@
 #include "ParticleUpdateVelocityModule.h"
 
+//============================================================================
+//	include
+//============================================================================
+#include <Engine/Effect/Particle/Module/Base/ParticleBatchKernels.h>
+
 //============================================================================
 //	ParticleUpdateVelocityModule classMethods
 //============================================================================
 
 void ParticleUpdateVelocityModule::Execute(
-	CPUParticle::ParticleData& particle, float deltaTime) {
+	CPUParticle::ParticleView& particle, float deltaTime) {
 
 	particle.transform.translation += particle.velocity * deltaTime;
 }
 
+void ParticleUpdateVelocityModule::ExecuteBatch(CPUParticleStore& particles,
+	uint32_t begin, uint32_t end, float deltaTime) {
+
+	// 座標と速度は連続した配列なので、成分単位でまとめて加算する
+	ParticleBatch::AddScaled(&particles.GetTranslations()[begin].x,
+		&particles.GetVelocities()[begin].x, deltaTime, (end - begin) * 3);
+}
+
 void ParticleUpdateVelocityModule::ImGui() {
 }
\ No newline at end of file
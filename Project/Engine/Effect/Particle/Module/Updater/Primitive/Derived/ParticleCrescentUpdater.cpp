@@ -17,42 +17,42 @@ void ParticleCrescentUpdater::Init() {
 	target_.Init();
 }
 
-void ParticleCrescentUpdater::Update(CPUParticle::ParticleData& particle, EasingType easingType) {
+void ParticleCrescentUpdater::Update(CPUParticle::ParticleView& particle, EasingType easingType) {
 
-	particle.primitive.crescent.uvMode = start_.uvMode;
-	particle.primitive.crescent.uvMode = target_.uvMode;
+	particle.primitive.crescent->uvMode = start_.uvMode;
+	particle.primitive.crescent->uvMode = target_.uvMode;
 
-	particle.primitive.crescent.divide = Algorithm::LerpInt(start_.divide,
+	particle.primitive.crescent->divide = Algorithm::LerpInt(start_.divide,
 		target_.divide, EasedValue(easingType, particle.progress));
 
-	particle.primitive.crescent.outerRadius = std::lerp(start_.outerRadius,
+	particle.primitive.crescent->outerRadius = std::lerp(start_.outerRadius,
 		target_.outerRadius, EasedValue(easingType, particle.progress));
 
-	particle.primitive.crescent.innerRadius = std::lerp(start_.innerRadius,
+	particle.primitive.crescent->innerRadius = std::lerp(start_.innerRadius,
 		target_.innerRadius, EasedValue(easingType, particle.progress));
 
-	particle.primitive.crescent.startAngle = std::lerp(start_.startAngle,
+	particle.primitive.crescent->startAngle = std::lerp(start_.startAngle,
 		target_.startAngle, EasedValue(easingType, particle.progress));
 
-	particle.primitive.crescent.endAngle = std::lerp(start_.endAngle,
+	particle.primitive.crescent->endAngle = std::lerp(start_.endAngle,
 		target_.endAngle, EasedValue(easingType, particle.progress));
 
-	particle.primitive.crescent.thickness = std::lerp(start_.thickness,
+	particle.primitive.crescent->thickness = std::lerp(start_.thickness,
 		target_.thickness, EasedValue(easingType, particle.progress));
 
-	particle.primitive.crescent.pivot = Vector2::Lerp(start_.pivot,
+	particle.primitive.crescent->pivot = Vector2::Lerp(start_.pivot,
 		target_.pivot, EasedValue(easingType, particle.progress));
 
-	particle.primitive.crescent.tipSharpness = Vector2::Lerp(start_.tipSharpness,
+	particle.primitive.crescent->tipSharpness = Vector2::Lerp(start_.tipSharpness,
 		target_.tipSharpness, EasedValue(easingType, particle.progress));
 
-	particle.primitive.crescent.weight = Vector2::Lerp(start_.weight,
+	particle.primitive.crescent->weight = Vector2::Lerp(start_.weight,
 		target_.weight, EasedValue(easingType, particle.progress));
 
-	particle.primitive.crescent.outerColor = Color::Lerp(start_.outerColor,
+	particle.primitive.crescent->outerColor = Color::Lerp(start_.outerColor,
 		target_.outerColor, EasedValue(easingType, particle.progress));
 
-	particle.primitive.crescent.innerColor = Color::Lerp(start_.innerColor,
+	particle.primitive.crescent->innerColor = Color::Lerp(start_.innerColor,
 		target_.innerColor, EasedValue(easingType, particle.progress));
 }
 
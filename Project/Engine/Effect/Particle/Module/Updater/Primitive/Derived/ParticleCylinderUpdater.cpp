@@ -18,30 +18,30 @@ void ParticleCylinderUpdater::Init() {
 	uvMode_ = CylinderUVMode::None;
 }
 
-void ParticleCylinderUpdater::Update(CPUParticle::ParticleData& particle, EasingType easingType) {
+void ParticleCylinderUpdater::Update(CPUParticle::ParticleView& particle, EasingType easingType) {
 
 	// モードは渡すだけ
-	particle.primitive.cylinder.uvMode = static_cast<uint32_t>(uvMode_);
+	particle.primitive.cylinder->uvMode = static_cast<uint32_t>(uvMode_);
 
-	particle.primitive.cylinder.divide = Algorithm::LerpInt(start_.divide,
+	particle.primitive.cylinder->divide = Algorithm::LerpInt(start_.divide,
 		target_.divide, EasedValue(easingType, particle.progress));
 
-	particle.primitive.cylinder.topRadius = std::lerp(start_.topRadius,
+	particle.primitive.cylinder->topRadius = std::lerp(start_.topRadius,
 		target_.topRadius, EasedValue(easingType, particle.progress));
 
-	particle.primitive.cylinder.bottomRadius = std::lerp(start_.bottomRadius,
+	particle.primitive.cylinder->bottomRadius = std::lerp(start_.bottomRadius,
 		target_.bottomRadius, EasedValue(easingType, particle.progress));
 
-	particle.primitive.cylinder.maxAngle = std::lerp(start_.maxAngle,
+	particle.primitive.cylinder->maxAngle = std::lerp(start_.maxAngle,
 		target_.maxAngle, EasedValue(easingType, particle.progress));
 
-	particle.primitive.cylinder.height = std::lerp(start_.height,
+	particle.primitive.cylinder->height = std::lerp(start_.height,
 		target_.height, EasedValue(easingType, particle.progress));
 
-	particle.primitive.cylinder.topColor = Color::Lerp(start_.topColor,
+	particle.primitive.cylinder->topColor = Color::Lerp(start_.topColor,
 		target_.topColor, EasedValue(easingType, particle.progress));
 
-	particle.primitive.cylinder.bottomColor = Color::Lerp(start_.bottomColor,
+	particle.primitive.cylinder->bottomColor = Color::Lerp(start_.bottomColor,
 		target_.bottomColor, EasedValue(easingType, particle.progress));
 }
 
@@ -62,9 +62,9 @@ void ParticleLightningUpdater::Init() {
 	parentTranslation_ = Vector3::AnyInit(0.0f);
 }
 
-void ParticleLightningUpdater::Update(CPUParticle::ParticleData& particle, EasingType easingType) {
+void ParticleLightningUpdater::Update(CPUParticle::ParticleView& particle, EasingType easingType) {
 
-	LightningForGPU& lightning = particle.primitive.lightning;
+	LightningForGPU& lightning = *particle.primitive.lightning;
 	const float lifeProgress = particle.progress;
 
 	// 親、発生の位置
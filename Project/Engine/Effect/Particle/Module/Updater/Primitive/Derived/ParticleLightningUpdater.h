@@ -21,7 +21,7 @@ public:
 
 	void Init() override;
 
-	void Update(CPUParticle::ParticleData& particle, EasingType easingType) override;
+	void Update(CPUParticle::ParticleView& particle, EasingType easingType) override;
 
 	void ImGui() override;
 
@@ -17,32 +17,32 @@ void ParticlePlaneUpdater::Init() {
 	planeType_ = ParticlePlaneType::XY;
 }
 
-void ParticlePlaneUpdater::Update(CPUParticle::ParticleData& particle, EasingType easingType) {
+void ParticlePlaneUpdater::Update(CPUParticle::ParticleView& particle, EasingType easingType) {
 
 	// 形状モードを更新
-	particle.primitive.plane.mode = start_.mode;
-	particle.primitive.plane.mode = target_.mode;
+	particle.primitive.plane->mode = start_.mode;
+	particle.primitive.plane->mode = target_.mode;
 
-	particle.primitive.plane.size = Vector2::Lerp(start_.size,
+	particle.primitive.plane->size = Vector2::Lerp(start_.size,
 		target_.size, EasedValue(easingType, particle.progress));
 
-	particle.primitive.plane.pivot = Vector2::Lerp(start_.pivot,
+	particle.primitive.plane->pivot = Vector2::Lerp(start_.pivot,
 		target_.pivot, EasedValue(easingType, particle.progress));
 
 	// 頂点カラーを更新
-	particle.primitive.plane.leftTopVertexColor = Color::Lerp(
+	particle.primitive.plane->leftTopVertexColor = Color::Lerp(
 		start_.leftTopVertexColor,
 		target_.leftTopVertexColor,
 		EasedValue(easingType, particle.progress));
-	particle.primitive.plane.rightTopVertexColor = Color::Lerp(
+	particle.primitive.plane->rightTopVertexColor = Color::Lerp(
 		start_.rightTopVertexColor,
 		target_.rightTopVertexColor,
 		EasedValue(easingType, particle.progress));
-	particle.primitive.plane.leftBottomVertexColor = Color::Lerp(
+	particle.primitive.plane->leftBottomVertexColor = Color::Lerp(
 		start_.leftBottomVertexColor,
 		target_.leftBottomVertexColor,
 		EasedValue(easingType, particle.progress));
-	particle.primitive.plane.rightBottomVertexColor = Color::Lerp(
+	particle.primitive.plane->rightBottomVertexColor = Color::Lerp(
 		start_.rightBottomVertexColor,
 		target_.rightBottomVertexColor,
 		EasedValue(easingType, particle.progress));
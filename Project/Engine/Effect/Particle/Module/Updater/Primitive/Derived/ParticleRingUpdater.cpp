@@ -17,15 +17,15 @@ void ParticleRingUpdater::Init() {
 	target_.Init();
 }
 
-void ParticleRingUpdater::Update(CPUParticle::ParticleData& particle, EasingType easingType) {
+void ParticleRingUpdater::Update(CPUParticle::ParticleView& particle, EasingType easingType) {
 
-	particle.primitive.ring.divide = Algorithm::LerpInt(start_.divide,
+	particle.primitive.ring->divide = Algorithm::LerpInt(start_.divide,
 		target_.divide, EasedValue(easingType, particle.progress));
 
-	particle.primitive.ring.outerRadius = std::lerp(start_.outerRadius,
+	particle.primitive.ring->outerRadius = std::lerp(start_.outerRadius,
 		target_.outerRadius, EasedValue(easingType, particle.progress));
 
-	particle.primitive.ring.innerRadius = std::lerp(start_.innerRadius,
+	particle.primitive.ring->innerRadius = std::lerp(start_.innerRadius,
 		target_.innerRadius, EasedValue(easingType, particle.progress));
 }
 
@@ -17,16 +17,16 @@ void ParticleTestMeshUpdater::Init() {
 	planeType_ = ParticlePlaneType::XY;
 }
 
-void ParticleTestMeshUpdater::Update(CPUParticle::ParticleData& particle, EasingType easingType) {
+void ParticleTestMeshUpdater::Update(CPUParticle::ParticleView& particle, EasingType easingType) {
 
 	// 形状モードを更新
-	particle.primitive.testMesh.mode = start_.mode;
-	particle.primitive.testMesh.mode = target_.mode;
+	particle.primitive.testMesh->mode = start_.mode;
+	particle.primitive.testMesh->mode = target_.mode;
 
-	particle.primitive.testMesh.size = Vector2::Lerp(start_.size,
+	particle.primitive.testMesh->size = Vector2::Lerp(start_.size,
 		target_.size, EasedValue(easingType, particle.progress));
 
-	particle.primitive.testMesh.pivot = Vector2::Lerp(start_.pivot,
+	particle.primitive.testMesh->pivot = Vector2::Lerp(start_.pivot,
 		target_.pivot, EasedValue(easingType, particle.progress));
 }
 
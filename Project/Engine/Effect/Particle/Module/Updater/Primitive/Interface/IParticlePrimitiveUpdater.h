@@ -24,7 +24,7 @@ public:
 	virtual void Init() = 0;
 
 	// プリミティブ形状の更新
-	virtual void Update(CPUParticle::ParticleData& particle, EasingType easingType) = 0;
+	virtual void Update(CPUParticle::ParticleView& particle, EasingType easingType) = 0;
 
 	virtual void ImGui() = 0;
 
@@ -51,7 +51,7 @@ void ParticleUpdatePrimitiveModule::Init() {
 }
 
 void ParticleUpdatePrimitiveModule::Execute(
-	CPUParticle::ParticleData& particle, [[maybe_unused]] float deltaTime) {
+	CPUParticle::ParticleView& particle, [[maybe_unused]] float deltaTime) {
 
 	// 形状別で更新
 	type_ = particle.primitive.type;
@@ -4,6 +4,7 @@
 //	include
 //============================================================================
 #include <Engine/Utility/Enum/EnumAdapter.h>
+#include <Engine/Effect/Particle/Module/Base/ParticleBatchKernels.h>
 
 //============================================================================
 //	ParticleUpdateLifeTimeModule classMethods
@@ -26,7 +27,7 @@ void ParticleUpdateLifeTimeModule::Init() {
 }
 
 void ParticleUpdateLifeTimeModule::Execute(
-	CPUParticle::ParticleData& particle, float deltaTime) {
+	CPUParticle::ParticleView& particle, float deltaTime) {
 
 	// ライフタイムを進める
 	particle.currentTime += deltaTime;
@@ -34,6 +35,13 @@ void ParticleUpdateLifeTimeModule::Execute(
 	particle.progress = particle.currentTime / particle.lifeTime;
 }
 
+void ParticleUpdateLifeTimeModule::ExecuteBatch(CPUParticleStore& particles,
+	uint32_t begin, uint32_t end, float deltaTime) {
+
+	ParticleBatch::AdvanceLifeTime(&particles.GetCurrentTimes()[begin], &particles.GetProgresses()[begin],
+		&particles.GetLifeTimes()[begin], deltaTime, end - begin);
+}
+
 void ParticleUpdateLifeTimeModule::ImGui() {
 
 	EnumAdapter<ParticleLifeEndMode>::Combo("EndMode", &endMode_);
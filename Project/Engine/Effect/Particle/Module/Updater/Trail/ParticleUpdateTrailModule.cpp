@@ -3,9 +3,40 @@
 //============================================================================
 //	include
 //============================================================================
+#include <Engine/Effect/Particle/ParticleConfig.h>
 #include <Engine/Scene/SceneView.h>
 #include <Engine/Utility/Enum/EnumAdapter.h>
 
+//============================================================================
+//	TrailRing
+//============================================================================
+namespace {
+
+	// リングの位置はマスクで折り返す
+	static_assert((kMaxTrailParticles & (kMaxTrailParticles - 1)) == 0, "kMaxTrailParticles must be a power of two");
+	constexpr uint32_t kTrailRingMask = static_cast<uint32_t>(kMaxTrailParticles) - 1;
+
+	// 古い順でi番目のノード
+	ParticleCommon::TrailPoint& TrailNode(ParticleCommon::TrailPoint* points,
+		const ParticleCommon::TrailRuntime& trail, uint32_t i) {
+
+		return points[(trail.head + i) & kTrailRingMask];
+	}
+
+	// 末尾に追加する、maxPointsを超える分は古い順に捨てる
+	void PushTrailNode(ParticleCommon::TrailPoint* points, ParticleCommon::TrailRuntime& trail,
+		const ParticleCommon::TrailPoint& point, uint32_t maxPoints) {
+
+		while (maxPoints <= trail.count) {
+
+			trail.head = (trail.head + 1) & kTrailRingMask;
+			--trail.count;
+		}
+		points[(trail.head + trail.count) & kTrailRingMask] = point;
+		++trail.count;
+	}
+}
+
 //============================================================================
 //	ParticleUpdateTrailModule classMethods
 //============================================================================
@@ -38,9 +69,13 @@ void ParticleUpdateTrailModule::Init() {
 }
 
 void ParticleUpdateTrailModule::Execute(
-	CPUParticle::ParticleData& particle, float deltaTime) {
+	CPUParticle::ParticleView& particle, float deltaTime) {
 
 	ParticleCommon::TrailRuntime& trail = particle.trailRuntime;
+	ParticleCommon::TrailPoint* points = particle.trailPoints;
+	if (!points) {
+		return;
+	}
 
 	// トレイル対象の座標、親がいれば親の座標も加算する
 	const Vector3 parentTranslation = (particle.transform.aliveParent == 1) ?
@@ -49,16 +84,20 @@ void ParticleUpdateTrailModule::Execute(
 	const Vector3 particleTranslation = particle.transform.translation + parentTranslation;
 
 	// ノードの寿命を更新
-	for (auto& node : trail.nodes) {
+	// 古い順に並んでいるので、寿命が尽きたノードは先頭から連続している
+	uint32_t expiredCount = 0;
+	for (uint32_t i = 0; i < trail.count; ++i) {
 
+		ParticleCommon::TrailPoint& node = TrailNode(points, trail, i);
 		node.age += deltaTime;
-		// 寿命が尽きていたら削除
-		while (!trail.nodes.empty() &&
-			lifeTime_ < trail.nodes.front().age) {
+		if (expiredCount == i && lifeTime_ < node.age) {
 
-			trail.nodes.pop_front();
+			++expiredCount;
 		}
 	}
+	// 寿命が尽きていたら削除
+	trail.head = (trail.head + expiredCount) & kTrailRingMask;
+	trail.count -= expiredCount;
 
 	// 追従先のパーティクルが消えた後の処理を行うなら頂点を追加しない
 	if (trail.isDetaching) {
@@ -78,7 +117,9 @@ void ParticleUpdateTrailModule::Execute(
 		ParticleCommon::TrailPoint point{};
 		point.pos = particleTranslation;
 		point.age = 0.0f;
-		trail.nodes.emplace_back(point);
+		trail.head = 0;
+		trail.count = 0;
+		PushTrailNode(points, trail, point, 1);
 		return;
 	}
 
@@ -92,20 +133,19 @@ void ParticleUpdateTrailModule::Execute(
 
 		// 等間隔で分割して複数ノード押し込み
 		int steps = (std::max)(1, static_cast<int>(std::floor(distance / (std::max)(1e-6f, minDistance_))));
+		// リングに収まる最大数、超えたら古い順に削除
+		const uint32_t maxPoints = static_cast<uint32_t>(std::clamp(maxPoints_, 1, kMaxTrailParticles));
+		// 残らない分は計算しない
+		const int firstStep = (std::max)(1, steps - static_cast<int>(maxPoints) + 1);
 		Vector3 pointA = trail.prePos;
 		Vector3 pointB = currentPos;
-		for (int i = 1; i <= steps; i++) {
+		for (int i = firstStep; i <= steps; i++) {
 
 			float t = static_cast<float>(i) / steps;
 			ParticleCommon::TrailPoint point{};
 			point.age = 0.0f;
 			point.pos = pointA * (1.0f - t) + pointB * t;
-			// 最大数を超えたら削除
-			if (maxPoints_ <= static_cast<int>(trail.nodes.size())) {
-
-				trail.nodes.pop_front();
-			}
-			trail.nodes.emplace_back(point);
+			PushTrailNode(points, trail, point, maxPoints);
 		}
 		// 前座標を記録
 		trail.prePos = currentPos;
@@ -114,20 +154,23 @@ void ParticleUpdateTrailModule::Execute(
 }
 
 void ParticleUpdateTrailModule::BuildTransferData(uint32_t particleIndex,
-	const CPUParticle::ParticleData& particle,
+	const CPUParticle::ParticleView& particle,
 	std::vector<ParticleCommon::TrailHeaderForGPU>& transferTrailHeaders,
 	std::vector<ParticleCommon::TrailVertexForGPU>& transferTrailVertices,
-	const SceneView* sceneView) {
+	uint32_t& vertexCount, const SceneView* sceneView) {
 
 	// パーティクルのトレイルノード
-	const auto& nodes = particle.trailRuntime.nodes;
+	const ParticleCommon::TrailRuntime& trail = particle.trailRuntime;
+	ParticleCommon::TrailPoint* points = particle.trailPoints;
 
 	// デフォルトは空
-	uint32_t start = static_cast<uint32_t>(transferTrailVertices.size());
-	uint32_t vertexCount = 0;
+	const uint32_t start = vertexCount;
+	// 1ノード2頂点、転送配列に収まる分のみ書き込む
+	const uint32_t freeVertexCount = static_cast<uint32_t>(transferTrailVertices.size()) - start;
+	const uint32_t nodeCount = points ? (std::min)(trail.count, freeVertexCount / 2u) : 0u;
 
 	// トレイルしないなら頂点数は0にしてセット
-	if (!enable_ || nodes.size() < 2) {
+	if (!enable_ || nodeCount < 2) {
 		transferTrailHeaders[particleIndex] = { start, 0 };
 		return;
 	}
@@ -135,18 +178,22 @@ void ParticleUpdateTrailModule::BuildTransferData(uint32_t particleIndex,
 	// U(横)方向の距離累積
 	float uAccum = 0.0f;
 	Vector3 prevSide = Vector3(1.0f, 0.0f, 0.0f);
+	// 頂点は転送配列へ直接書き込む
+	ParticleCommon::TrailVertexForGPU* vertices = transferTrailVertices.data() + start;
+
+	for (uint32_t i = 0; i < nodeCount; ++i) {
 
-	for (size_t i = 0; i < nodes.size(); ++i) {
+		const ParticleCommon::TrailPoint& node = TrailNode(points, trail, i);
 
 		// 方向ベクトル
 		Vector3 direction;
 		// 現在の座標から前の座標を引いた方向
 		if (i == 0) {
-			direction = nodes[1].pos - nodes[0].pos;
-		} else if (i == nodes.size() - 1) {
-			direction = nodes[i].pos - nodes[i - 1].pos;
+			direction = TrailNode(points, trail, 1).pos - node.pos;
+		} else if (i == nodeCount - 1) {
+			direction = node.pos - TrailNode(points, trail, i - 1).pos;
 		} else {
-			direction = nodes[i + 1].pos - nodes[i - 1].pos;
+			direction = TrailNode(points, trail, i + 1).pos - TrailNode(points, trail, i - 1).pos;
 		}
 
 		float directionLength = direction.Length();
@@ -182,7 +229,7 @@ void ParticleUpdateTrailModule::BuildTransferData(uint32_t particleIndex,
 		prevSide = side = side.Normalize();
 
 		// 各ノードの進捗率
-		float progress = std::clamp(nodes[i].age / lifeTime_, 0.0f, 1.0f);
+		float progress = std::clamp(node.age / lifeTime_, 0.0f, 1.0f);
 		// 色を取得し、αは補間する
 		Color color = particle.material.color;
 		color.a = std::lerp(alpha_.start, alpha_.target, EasedValue(alphaEasing_, progress));
@@ -194,53 +241,35 @@ void ParticleUpdateTrailModule::BuildTransferData(uint32_t particleIndex,
 		float halfWidth = lerpedWidth * 0.5f;
 
 		// 左右頂点
-		const Vector3 center = nodes[i].pos;
-		const Vector3 leftWorldPos = center - side * halfWidth;
-		const Vector3 rightWorldPos = center + side * halfWidth;
+		const Vector3 center = node.pos;
 
 		// 距離ベースでタイリングする
 		float u = (1e-6f < uvTileLength_) ? (uAccum / uvTileLength_) : 0.0f;
 
-		// 左と右の頂点情報をセットして追加
-		ParticleCommon::TrailVertexForGPU leftVertex;
-		ParticleCommon::TrailVertexForGPU rightVertex;
+		// 左と右の頂点情報をセット
 		// 左
-		leftVertex.worldPos = leftWorldPos;
+		ParticleCommon::TrailVertexForGPU& leftVertex = vertices[i * 2 + 0];
+		leftVertex.worldPos = center - side * halfWidth;
 		leftVertex.uv = Vector2(u, 0.0f);
 		leftVertex.color = color;
 		// 右
-		rightVertex.worldPos = rightWorldPos;
+		ParticleCommon::TrailVertexForGPU& rightVertex = vertices[i * 2 + 1];
+		rightVertex.worldPos = center + side * halfWidth;
 		rightVertex.uv = Vector2(u, 1.0f);
 		rightVertex.color = color;
 
-		transferTrailVertices.push_back(leftVertex);
-		transferTrailVertices.push_back(rightVertex);
-
 		// 次のノードがあれば距離を加算する
-		if (i + 1 < nodes.size()) {
-			uAccum += (nodes[i + 1].pos - nodes[i].pos).Length();
+		if (i + 1 < nodeCount) {
+			uAccum += (TrailNode(points, trail, i + 1).pos - node.pos).Length();
 		}
 	}
 
-	// 偶数個に制限、奇数にすると頂点数とポリゴンの数が合わなくなるため
-	uint32_t end = static_cast<uint32_t>(transferTrailVertices.size());
-	vertexCount = end - start;
-	if (vertexCount & 1u) {
-		transferTrailVertices.pop_back();
-		--vertexCount;
-	}
-
-	// 4未満ならすべて削除
-	if (vertexCount < 4) {
-
-		// 使わないぶんは戻す
-		transferTrailVertices.resize(start);
-		vertexCount = 0;
-	}
-	transferTrailHeaders[particleIndex] = { start, vertexCount };
+	// 1ノード2頂点なので常に偶数、2ノード以上なので4頂点以上になる
+	vertexCount += nodeCount * 2u;
+	transferTrailHeaders[particleIndex] = { start, nodeCount * 2u };
 }
 
-bool ParticleUpdateTrailModule::OnOwnerLifeEnd(CPUParticle::ParticleData& particle) {
+bool ParticleUpdateTrailModule::OnOwnerLifeEnd(CPUParticle::ParticleView& particle) {
 
 	// 処理を行わないでそのまま消す
 	if (!enable_ || !isDetaching_) {
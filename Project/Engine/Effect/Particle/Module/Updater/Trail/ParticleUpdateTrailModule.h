@@ -25,14 +25,15 @@ public:
 	void Init() override;
 
 	// パーティクル、転送データの更新
-	void Execute(CPUParticle::ParticleData& particle, float deltaTime) override;
-	void BuildTransferData(uint32_t particleIndex, const CPUParticle::ParticleData& particle,
+	void Execute(CPUParticle::ParticleView& particle, float deltaTime) override;
+	// 確保済みのtransferTrailVerticesのvertexCount番目から頂点を書き込み、vertexCountを進める
+	void BuildTransferData(uint32_t particleIndex, const CPUParticle::ParticleView& particle,
 		std::vector<ParticleCommon::TrailHeaderForGPU>& transferTrailHeaders,
 		std::vector<ParticleCommon::TrailVertexForGPU>& transferTrailVertices,
-		const SceneView* sceneView);
+		uint32_t& vertexCount, const SceneView* sceneView);
 
 	// 追従先が無くなった後の処理を行うか
-	bool OnOwnerLifeEnd(CPUParticle::ParticleData& particle);
+	bool OnOwnerLifeEnd(CPUParticle::ParticleView& particle);
 
 	void ImGui() override;
 
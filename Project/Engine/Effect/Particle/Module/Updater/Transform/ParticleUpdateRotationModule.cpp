@@ -4,6 +4,7 @@
 //	include
 //============================================================================
 #include <Engine/Utility/Enum/EnumAdapter.h>
+#include <Engine/Effect/Particle/Module/Base/ParticleBatchKernels.h>
 
 //============================================================================
 //	ParticleUpdateRotationModule classMethods
@@ -65,8 +66,29 @@ void ParticleUpdateRotationModule::ToAxisAngle(const Quaternion& rotation, Vecto
 	}
 }
 
+void ParticleUpdateRotationModule::CalcSlerpAxisAngle(Quaternion& start, Vector3& axis, float& angle) const {
+
+	start = Quaternion::Normalize(lerpRotation_.start);
+	const Quaternion target = Quaternion::Normalize(lerpRotation_.target);
+
+	// 回転差分
+	const Quaternion delta = Quaternion::Multiply(Quaternion::Inverse(start), target);
+
+	// 軸角へ
+	ToAxisAngle(delta, axis, angle);
+
+	// 長い方の弧を処理するときは軸を反転する
+	if (slerpPreferLongArc_ && angle > std::numeric_limits<float>::epsilon() && angle < pi) {
+
+		angle = 2.0f * pi - angle;
+		axis = -axis;
+	}
+	// 追加回転数を角度にかける
+	angle += 2.0f * pi * static_cast<float>(slerpExtraTurns_);
+}
+
 Quaternion ParticleUpdateRotationModule::UpdateRotation(
-	CPUParticle::ParticleData& particle, float deltaTime) const {
+	CPUParticle::ParticleView& particle, float deltaTime) const {
 
 	switch (updateType_) {
 	case UpdateType::LockRotation: {
@@ -76,25 +98,10 @@ Quaternion ParticleUpdateRotationModule::UpdateRotation(
 	}
 	case UpdateType::Slerp: {
 
-		const Quaternion start = Quaternion::Normalize(lerpRotation_.start);
-		const Quaternion target = Quaternion::Normalize(lerpRotation_.target);
-
-		// 回転差分
-		const Quaternion delta = Quaternion::Multiply(Quaternion::Inverse(start), target);
-
-		// 軸角へ
+		Quaternion start;
 		Vector3 axis;
 		float angle = 0.0f;
-		ToAxisAngle(delta, axis, angle);
-
-		// 長い方の弧を処理するときは軸を反転する
-		if (slerpPreferLongArc_ && angle > std::numeric_limits<float>::epsilon() && angle < pi) {
-
-			angle = 2.0f * pi - angle;
-			axis = -axis;
-		}
-		// 追加回転数を角度にかける
-		angle += 2.0f * pi * static_cast<float>(slerpExtraTurns_);
+		CalcSlerpAxisAngle(start, axis, angle);
 
 		const float t = EasedValue(easing_, particle.progress);
 		Quaternion step = Quaternion::MakeAxisAngle(axis, angle * t);
@@ -142,27 +149,27 @@ Quaternion ParticleUpdateRotationModule::LockAxis(const Quaternion& rotation) co
 	return Quaternion::Normalize(Quaternion::Multiply(swing, fixedTwist));
 }
 
-void ParticleUpdateRotationModule::UpdateMatrix(
-	CPUParticle::ParticleData& particle, const Quaternion& rotation) {
+void ParticleUpdateRotationModule::UpdateMatrix(Quaternion& particleRotation,
+	Matrix4x4& rotationMatrix, const Quaternion& rotation) const {
 
 	// 親の回転を掛ける
-	particle.rotation = Quaternion::Normalize(
+	particleRotation = Quaternion::Normalize(
 		Quaternion::Multiply(parentRotation_, rotation));
 
 	// 全軸ビルボード処理
 	if (billboardType_ == ParticleBillboardType::All) {
 
-		particle.transform.rotationMatrix = Matrix4x4::MakeIdentity4x4();
+		rotationMatrix = Matrix4x4::MakeIdentity4x4();
 	}
 	// それ以外は回転を計算
 	else {
 
-		particle.transform.rotationMatrix = Quaternion::MakeRotateMatrix(particle.rotation);
+		rotationMatrix = Quaternion::MakeRotateMatrix(particleRotation);
 	}
 }
 
 void ParticleUpdateRotationModule::Execute(
-	CPUParticle::ParticleData& particle, float deltaTime) {
+	CPUParticle::ParticleView& particle, float deltaTime) {
 
 	particle.transform.billboardMode = static_cast<uint32_t>(billboardType_);
 
@@ -170,7 +177,7 @@ void ParticleUpdateRotationModule::Execute(
 	if (setRotation_.has_value() && billboardType_ == ParticleBillboardType::None) {
 
 		// 行列を計算
-		UpdateMatrix(particle, *setRotation_);
+		UpdateMatrix(particle.rotation, particle.transform.rotationMatrix, *setRotation_);
 		return;
 	}
 
@@ -179,7 +186,77 @@ void ParticleUpdateRotationModule::Execute(
 	// 軸固定処理
 	rotation = LockAxis(rotation);
 	// 行列を計算
-	UpdateMatrix(particle, rotation);
+	UpdateMatrix(particle.rotation, particle.transform.rotationMatrix, rotation);
+}
+
+void ParticleUpdateRotationModule::ExecuteBatch(CPUParticleStore& particles,
+	uint32_t begin, uint32_t end, float deltaTime) {
+
+	// 速度方向を向く場合は粒ごとに計算する
+	const bool isSetRotation = setRotation_.has_value() && billboardType_ == ParticleBillboardType::None;
+	if (!isSetRotation && updateType_ == UpdateType::LookToVelocity) {
+
+		ICPUParticleUpdateModule::ExecuteBatch(particles, begin, end, deltaTime);
+		return;
+	}
+
+	std::vector<ParticleCommon::TransformForGPU>& transforms = particles.GetTransforms();
+	std::vector<CPUParticle::ParticleColdData>& colds = particles.GetColds();
+	const uint32_t billboardMode = static_cast<uint32_t>(billboardType_);
+	for (uint32_t index = begin; index < end; ++index) {
+
+		transforms[index].billboardMode = billboardMode;
+	}
+
+	// 全ての粒で同じ回転になる場合は1度だけ計算して書き込む
+	if (isSetRotation || updateType_ == UpdateType::LockRotation) {
+
+		Quaternion rotation;
+		Matrix4x4 rotationMatrix;
+		UpdateMatrix(rotation, rotationMatrix, isSetRotation ? *setRotation_ : LockAxis(lockRotation_));
+		for (uint32_t index = begin; index < end; ++index) {
+
+			colds[index].rotation = rotation;
+			transforms[index].rotationMatrix = rotationMatrix;
+		}
+		return;
+	}
+
+	// 粒に依らない値を先に求めておく
+	if (updateType_ == UpdateType::Slerp) {
+
+		Quaternion start;
+		Vector3 axis;
+		float angle = 0.0f;
+		CalcSlerpAxisAngle(start, axis, angle);
+
+		const std::vector<float>& progresses = particles.GetProgresses();
+		// 補間のtは区間ごとにまとめて求める
+		float t[ParticleBatch::kChunkSize];
+		for (uint32_t chunk = begin; chunk < end; chunk += ParticleBatch::kChunkSize) {
+
+			const uint32_t count = (std::min)(ParticleBatch::kChunkSize, end - chunk);
+			EasedValues(easing_, &progresses[chunk], t, count);
+			for (uint32_t k = 0; k < count; ++k) {
+
+				const uint32_t index = chunk + k;
+				Quaternion step = Quaternion::MakeAxisAngle(axis, angle * t[k]);
+				Quaternion rotation = LockAxis(Quaternion::Normalize(Quaternion::Multiply(start, step)));
+				UpdateMatrix(colds[index].rotation, transforms[index].rotationMatrix, rotation);
+			}
+		}
+	} else if (updateType_ == UpdateType::AngularVelocity) {
+
+		Vector3 axis = angleAxis_.Normalize();
+		const Quaternion angleRotation = Quaternion::Normalize(
+			Quaternion::MakeAxisAngle(axis, angleSpeedRadian_ * deltaTime));
+		for (uint32_t index = begin; index < end; ++index) {
+
+			// 前フレームの姿勢に回転を掛ける
+			Quaternion rotation = LockAxis(Quaternion::Normalize(colds[index].rotation * angleRotation));
+			UpdateMatrix(colds[index].rotation, transforms[index].rotationMatrix, rotation);
+		}
+	}
 }
 
 void ParticleUpdateRotationModule::ImGui() {
@@ -21,7 +21,8 @@ public:
 
 	void Init() override;
 
-	void Execute(CPUParticle::ParticleData& particle, float deltaTime) override;
+	void Execute(CPUParticle::ParticleView& particle, float deltaTime) override;
+	void ExecuteBatch(CPUParticleStore& particles, uint32_t begin, uint32_t end, float deltaTime) override;
 
 	void ImGui() override;
 
@@ -96,7 +97,9 @@ private:
 	//--------- functions ----------------------------------------------------
 
 	static void ToAxisAngle(const Quaternion& rotation, Vector3& axis, float& angle);
-	Quaternion UpdateRotation(CPUParticle::ParticleData& particle, float deltaTime) const;
+	// 補間の開始姿勢と回転軸、角度を求める(粒に依らない)
+	void CalcSlerpAxisAngle(Quaternion& start, Vector3& axis, float& angle) const;
+	Quaternion UpdateRotation(CPUParticle::ParticleView& particle, float deltaTime) const;
 	Quaternion LockAxis(const Quaternion& rotation) const;
-	void UpdateMatrix(CPUParticle::ParticleData& particle, const Quaternion& rotation);
+	void UpdateMatrix(Quaternion& particleRotation, Matrix4x4& rotationMatrix, const Quaternion& rotation) const;
 };
\ No newline at end of file
@@ -4,6 +4,7 @@
 //	include
 //============================================================================
 #include <Engine/Utility/Enum/EnumAdapter.h>
+#include <Engine/Effect/Particle/Module/Base/ParticleBatchKernels.h>
 
 //============================================================================
 //	ParticleUpdateScaleModule classMethods
@@ -31,7 +32,7 @@ void ParticleUpdateScaleModule::Init() {
 }
 
 void ParticleUpdateScaleModule::Execute(
-	CPUParticle::ParticleData& particle, [[maybe_unused]] float deltaTime) {
+	CPUParticle::ParticleView& particle, [[maybe_unused]] float deltaTime) {
 
 	// t値取得
 	const float lerpT = LoopedT(particle.progress);
@@ -42,6 +43,44 @@ void ParticleUpdateScaleModule::Execute(
 		EasedValue(easing_, lerpT));
 }
 
+void ParticleUpdateScaleModule::ExecuteBatch(CPUParticleStore& particles,
+	uint32_t begin, uint32_t end, [[maybe_unused]] float deltaTime) {
+
+	const Vector3 start = scale_.start * scalingValue_;
+	const Vector3 diff = scale_.target * scalingValue_ - start;
+	std::vector<ParticleCommon::TransformForGPU>& transforms = particles.GetTransforms();
+	const std::vector<float>& progresses = particles.GetProgresses();
+
+	// 補間のtは区間ごとにまとめて求める
+	float t[ParticleBatch::kChunkSize];
+	for (uint32_t chunk = begin; chunk < end; chunk += ParticleBatch::kChunkSize) {
+
+		const uint32_t count = (std::min)(ParticleBatch::kChunkSize, end - chunk);
+		for (uint32_t k = 0; k < count; ++k) {
+
+			t[k] = LoopedT(progresses[chunk + k]);
+		}
+		EasedValues(easing_, t, t, count);
+
+		// 4粒ずつまとめて補間する
+		uint32_t k = 0;
+		for (; k + 4 <= count; k += 4) {
+
+			Vector3* scales[4];
+			for (uint32_t lane = 0; lane < 4; ++lane) {
+
+				scales[lane] = &transforms[chunk + k + lane].scale;
+			}
+			ParticleBatch::LerpVector3x4(scales, &t[k], start, diff);
+		}
+		// 端数
+		for (; k < count; ++k) {
+
+			transforms[chunk + k].scale = start + diff * t[k];
+		}
+	}
+}
+
 void ParticleUpdateScaleModule::ImGui() {
 
 	ImGui::DragFloat3("startScale", &scale_.start.x, 0.01f);
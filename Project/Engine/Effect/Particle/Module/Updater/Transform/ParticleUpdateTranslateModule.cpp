@@ -24,7 +24,7 @@ void ParticleUpdateTranslateModule::Init() {
 }
 
 void ParticleUpdateTranslateModule::Execute(
-	CPUParticle::ParticleData& particle, [[maybe_unused]] float deltaTime) {
+	CPUParticle::ParticleView& particle, [[maybe_unused]] float deltaTime) {
 
 	// 座標を渡す
 	particle.transform.translation = translation_;
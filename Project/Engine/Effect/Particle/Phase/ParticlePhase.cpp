@@ -5,6 +5,7 @@
 //============================================================================
 #include <Engine/Utility/Helper/ImGuiHelper.h>
 #include <Engine/Utility/Helper/Algorithm.h>
+#include <Engine/Utility/Random/RandomGenerator.h>
 #include <Engine/Effect/Particle/Module/Updater/Time/ParticleUpdateLifeTimeModule.h>
 #include <Engine/Effect/Particle/Module/Updater/Trail/ParticleUpdateTrailModule.h>
 
@@ -31,7 +32,7 @@ void ParticlePhase::Init(Asset* asset, ParticlePrimitiveType primitiveType) {
 	AddUpdater(ParticleUpdateModuleID::Color);
 }
 
-void ParticlePhase::FrequencyEmit(std::list<CPUParticle::ParticleData>& particles, float deltaTime) {
+void ParticlePhase::FrequencyEmit(CPUParticleStore& particles, float deltaTime) {
 
 	// emitterとして処理しない
 	if (notEmit_) {
@@ -50,13 +51,13 @@ void ParticlePhase::FrequencyEmit(std::list<CPUParticle::ParticleData>& particle
 	elapsed_ = 0.0f;
 }
 
-void ParticlePhase::Emit(std::list<CPUParticle::ParticleData>& particles) {
+void ParticlePhase::Emit(CPUParticleStore& particles) {
 
 	// 発生処理
 	spawner_->Execute(particles);
 }
 
-void ParticlePhase::UpdateParticle(CPUParticle::ParticleData& particle, float deltaTime) {
+void ParticlePhase::UpdateParticle(CPUParticle::ParticleView& particle, float deltaTime) {
 
 	// ポストプロセスのビットを設定
 	particle.material.postProcessMask = postProcessMask_;
@@ -68,6 +69,23 @@ void ParticlePhase::UpdateParticle(CPUParticle::ParticleData& particle, float de
 	}
 }
 
+void ParticlePhase::UpdateParticles(CPUParticleStore& particles,
+	uint32_t begin, uint32_t end, float deltaTime) {
+
+	// ポストプロセスのビットを設定
+	std::vector<CPUParticle::MaterialForGPU>& materials = particles.GetMaterials();
+	for (uint32_t index = begin; index < end; ++index) {
+
+		materials[index].postProcessMask = postProcessMask_;
+	}
+
+	// 更新処理、モジュールごとに範囲をまとめて処理する
+	for (const auto& updater : updaters_) {
+
+		updater->ExecuteBatch(particles, begin, end, deltaTime);
+	}
+}
+
 void ParticlePhase::UpdateEmitter() {
 
 	// emitterとして処理しない
@@ -80,6 +98,21 @@ void ParticlePhase::UpdateEmitter() {
 		return;
 	}
 	spawner_->UpdateEmitter();
+	// 描画はジョブの外でまとめて行う
+	isEmitterUpdated_ = true;
+}
+
+void ParticlePhase::DrawEmitter() {
+
+	if (!isEmitterUpdated_) {
+		return;
+	}
+	isEmitterUpdated_ = false;
+
+	// 更新後にspawnerが外されている場合は描画しない
+	if (!spawner_) {
+		return;
+	}
 	spawner_->DrawEmitter();
 }
 
@@ -103,6 +136,30 @@ void ParticlePhase::ApplyCommand(const ParticleCommand& command) {
 	}
 }
 
+void ParticlePhase::SetRandomSeed(uint64_t seed) {
+
+	randomSeed_ = seed;
+
+	// 発生モジュールは切り替えても同じ乱数列になるように全て同じseedにする
+	for (const auto& spawner : spawnerCache_) {
+		if (spawner) {
+
+			spawner->SetRandomSeed(RandomGenerator::MixSeed(randomSeed_, 0));
+		}
+	}
+	// 更新モジュールは並び順で分ける
+	ReseedUpdaters();
+}
+
+void ParticlePhase::ReseedUpdaters() {
+
+	// 0は発生モジュールが使うので1から
+	for (uint32_t index = 0; index < updaters_.size(); ++index) {
+
+		updaters_[index]->SetRandomSeed(RandomGenerator::MixSeed(randomSeed_, index + 1));
+	}
+}
+
 void ParticlePhase::SetSpawner(ParticleSpawnModuleID id) {
 
 	uint32_t index = static_cast<size_t>(id);
@@ -113,6 +170,7 @@ void ParticlePhase::SetSpawner(ParticleSpawnModuleID id) {
 		std::unique_ptr<ICPUParticleSpawnModule> module = SpawnRegistry::GetInstance().Create(id);
 		module->SetAsset(asset_);
 		module->SetPrimitiveType(primitiveType_);
+		module->SetRandomSeed(RandomGenerator::MixSeed(randomSeed_, 0));
 		module->Init();
 
 		// 現在有効な物があった場合、データを共有する
@@ -136,6 +194,7 @@ void ParticlePhase::AddUpdater(ParticleUpdateModuleID id) {
 
 	// 追加して初期化
 	updaters_.push_back(UpdateRegistry::GetInstance().Create(id));
+	updaters_.back()->SetRandomSeed(RandomGenerator::MixSeed(randomSeed_, updaters_.size()));
 	updaters_.back()->Init();
 }
 
@@ -147,6 +206,9 @@ void ParticlePhase::RemoveUpdater(uint32_t index) {
 		return;
 	}
 	updaters_.erase(updaters_.begin() + index);
+
+	// 並び順が変わったので、同じ構成なら同じ乱数列になるように作り直す
+	ReseedUpdaters();
 }
 
 void ParticlePhase::SwapUpdater(uint32_t from, uint32_t to) {
@@ -161,6 +223,9 @@ void ParticlePhase::SwapUpdater(uint32_t from, uint32_t to) {
 
 		std::rotate(updaters_.begin() + to, updaters_.begin() + from, updaters_.begin() + from + 1);
 	}
+
+	// 並び順が変わったので、同じ構成なら同じ乱数列になるように作り直す
+	ReseedUpdaters();
 }
 
 float ParticlePhase::GetLifeTime() const {
@@ -33,17 +33,25 @@ public:
 
 	// 発生処理
 	// 一定間隔
-	void FrequencyEmit(std::list<CPUParticle::ParticleData>& particles, float deltaTime);
+	void FrequencyEmit(CPUParticleStore& particles, float deltaTime);
 	// 強制発生
-	void Emit(std::list<CPUParticle::ParticleData>& particles);
+	void Emit(CPUParticleStore& particles);
 
 	// 更新処理
-	void UpdateParticle(CPUParticle::ParticleData& particle, float deltaTime);
+	void UpdateParticle(CPUParticle::ParticleView& particle, float deltaTime);
+	// [begin, end)をまとめて更新する、範囲内は全てこのフェーズの粒であること
+	void UpdateParticles(CPUParticleStore& particles, uint32_t begin, uint32_t end, float deltaTime);
 	void UpdateEmitter();
+	// UpdateEmitterが呼ばれていればemitterを描画する、LineRendererに積むのでメインスレッドで呼ぶ
+	void DrawEmitter();
 
 	// モジュールのコマンド適応
 	void ApplyCommand(const ParticleCommand& command);
 
+	// 発生、更新モジュールの乱数列をseedから作り直す
+	// 以降に追加されるモジュールもこのseedから作る
+	void SetRandomSeed(uint64_t seed);
+
 	// editor
 	void ImGui();
 
@@ -88,6 +96,10 @@ private:
 	uint32_t postProcessMask_;
 	// emitterとして処理しない
 	bool notEmit_ = false;
+	// DrawEmitterまでにemitterが更新されたか
+	bool isEmitterUpdated_ = false;
+	// モジュールの乱数列の元
+	uint64_t randomSeed_ = 0;
 
 	using SpawnRegistry = ParticleModuleRegistry<ICPUParticleSpawnModule, ParticleSpawnModuleID>;
 	using UpdateRegistry = ParticleModuleRegistry<ICPUParticleUpdateModule, ParticleUpdateModuleID>;
@@ -101,4 +113,9 @@ private:
 	// editor
 	ParticleSpawnModuleID selectSpawnModule_;
 	int selectedUpdater_ = -1;
+
+	//--------- functions ----------------------------------------------------
+
+	// 更新モジュールの乱数列を並び順からseedに合わせて作り直す
+	void ReseedUpdaters();
 };
\ No newline at end of file
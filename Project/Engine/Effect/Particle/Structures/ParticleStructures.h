@@ -11,9 +11,6 @@
 #include <Engine/Utility/Enum/Easing.h>
 #include <Engine/MathLib/MathUtils.h>
 
-// c++
-#include <deque>
-
 //============================================================================
 //	ParticleStructures
 //============================================================================
@@ -137,9 +134,12 @@ namespace ParticleCommon {
 		Vector3 pos; // 座標
 		float age;   // 寿命
 	};
+	// ノード本体はCPUParticleStoreが1粒kMaxTrailParticles個ずつ持ち、
+	// 固定長のリングバッファとして先頭位置と数のみをここで管理する
 	struct TrailRuntime {
 
-		std::deque<TrailPoint> nodes; // リングバッファ
+		uint32_t head = 0;            // 最も古いノードの位置
+		uint32_t count = 0;           // ノード数
 		Vector3 prePos;               // 前回のサンプル位置
 
 		bool isInitialized = false;   // 初期化済みか
@@ -265,6 +265,8 @@ namespace CPUParticle {
 		int32_t useNoiseTexture;
 	};
 
+	// 発生時に組み立てる1粒分のデータ
+	// CPUParticleStoreへ追加する際に各配列へ分配される
 	struct ParticleData {
 
 		// 生存時間
@@ -301,4 +303,97 @@ namespace CPUParticle {
 		ParticleCommon::TransformForGPU transform;
 		ParticleCommon::PrimitiveData<false> primitive;
 	};
+
+	// 更新頻度の低い発生時の情報
+	struct ParticleColdData {
+
+		// キー補間の開始したときの補間t
+		float keyPathStartT = -1.0f;
+		bool hasKeyPathStart = false;
+		float keyPathSpawnAngle = 0.0f;
+		bool hasKeyPathSpawnAngle = false;
+
+		// 発生したときの座標
+		Vector3 spawnTranlation;
+		// 回転の保持
+		Quaternion rotation;
+	};
+
+	// 1粒分のトランスフォームの参照
+	// translationのみ連続した配列に分けて持つ
+	struct TransformView {
+
+		Vector3& translation;
+		Vector3& scale;
+		Matrix4x4& rotationMatrix;
+		Matrix4x4& parentMatrix;
+		uint32_t& billboardMode;
+		uint32_t& aliveParent;
+	};
+
+	// 1粒分の形状の参照、グループの形状以外はnullptr
+	struct PrimitiveView {
+
+		ParticlePrimitiveType type;
+
+		PlaneForGPU* plane;
+		RingForGPU* ring;
+		CylinderForGPU* cylinder;
+		CrescentForGPU* crescent;
+		LightningForGPU* lightning;
+		TestMeshForGPU* testMesh;
+	};
+
+	// CPUParticleStore内の1粒分を参照する。
+	// メンバ名はParticleDataと同じなので、モジュールからは1粒の構造体と同様に扱える
+	struct ParticleView {
+
+		float& lifeTime;
+		float& currentTime;
+		float& progress;
+		uint32_t& phaseIndex;
+
+		float& keyPathStartT;
+		bool& hasKeyPathStart;
+		float& keyPathSpawnAngle;
+		bool& hasKeyPathSpawnAngle;
+
+		Vector3& spawnTranlation;
+		Quaternion& rotation;
+
+		ParticleCommon::TrailRuntime& trailRuntime;
+		// トレイルのノード、グループがトレイルを持たない場合はnullptr
+		ParticleCommon::TrailPoint* trailPoints;
+
+		Vector3& velocity;
+
+		MaterialForGPU& material;
+		TextureInfoForGPU& textureInfo;
+		ParticleCommon::TrailTextureInfoForGPU& trailTextureInfo;
+		TransformView transform;
+		PrimitiveView primitive;
+	};
+	// 距離と予算から決まるグループの処理の間引き設定
+	struct LODState {
+
+		uint32_t tier = 0;           // 0が最も詳細
+		uint32_t updateInterval = 1; // 何フレームに1回更新するか
+		float emitRateScale = 1.0f;  // 一定間隔発生の進む速さ、0で発生しない
+		bool isCulled = false;       // 画面外、描画しない
+	};
+
+	// 生存中の粒を囲む球、ワールド座標
+	struct BoundingSphere {
+
+		Vector3 center;
+		float radius = 0.0f;
+		bool isValid = false; // 粒がない場合はfalse
+	};
+
+	// 更新を間引いている間に発生した粒の範囲
+	struct SpawnMark {
+
+		uint32_t firstIndex = 0;  // この発生で追加された最初の粒
+		float pendingTime = 0.0f; // 発生した時点で既に貯まっていた経過時間
+	};
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 //	include
 //============================================================================
 #include <Engine/Utility/Random/RandomGenerator.h>
+#include <Engine/Utility/Random/RandomStream.h>
 #include <Engine/Utility/Json/JsonAdapter.h>
 #include <Engine/MathLib/MathUtils.h>
 
@@ -38,6 +39,10 @@ struct ParticleRandomRangeValue {
 	T GetRandomValue() const {
 		return RandomGenerator::Generate(min, max);
 	}
+	// 渡された乱数列から生成して取得
+	T GetRandomValue(RandomStream& stream) const {
+		return stream.Generate(min, max);
+	}
 };
 
 //============================================================================
@@ -59,6 +64,8 @@ public:
 	static ParticleValue<T> SetValue(T value);
 	// 定数かランダムの値を取得
 	T GetValue() const;
+	// ランダムの場合は渡された乱数列から取得する
+	T GetValue(RandomStream& stream) const;
 
 	// 分けて処理
 	void EditDragValue(const std::string& label);
@@ -117,6 +124,18 @@ inline T ParticleValue<T>::GetValue() const {
 	return constant.value;
 }
 
+template<typename T>
+inline T ParticleValue<T>::GetValue(RandomStream& stream) const {
+
+	if (valueType == ParticleValueType::Random) {
+
+		// ランダム値を返す
+		return random.GetRandomValue(stream);
+	}
+	// 定数値を返す
+	return constant.value;
+}
+
 template<typename T>
 inline void ParticleValue<T>::SelectType(const std::string& label) {
 
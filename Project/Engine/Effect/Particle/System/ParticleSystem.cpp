@@ -9,6 +9,7 @@
 #include <Engine/Utility/Enum/EnumAdapter.h>
 #include <Engine/Utility/Json/JsonAdapter.h>
 #include <Engine/Utility/Helper/Algorithm.h>
+#include <Engine/Utility/Random/RandomGenerator.h>
 
 // imgui
 #include <imgui.h>
@@ -47,6 +48,17 @@ void ParticleSystem::SetParent(const BaseTransform& parent) {
 
 void ParticleSystem::Update() {
 
+	// 手放された後は発生させず、残っている粒の更新のみ行う
+	if (isReleased_) {
+
+		releaseTimer_ += GameTimer::GetDeltaTime();
+		for (auto& group : gpuGroups_) {
+
+			group.group.Update();
+		}
+		return;
+	}
+
 	// 全ての同時発生
 	UpdateAllEmit();
 
@@ -62,17 +74,96 @@ void ParticleSystem::Update() {
 		}
 		group.group.Update();
 	}
-	// CPU
+	// CPUはUpdateCPUGroupで更新する
+}
+
+void ParticleSystem::UpdateCPUGroup(uint32_t index) {
+
+	CPUParticleGroup& group = cpuGroups_[index].group;
+
+	// ゲーム側で使用しない場合は常に
+	// 一定間隔で発生させる
+	if (!useGame_ && !allEmitEnable_ && !isReleased_) {
+
+		group.FrequencyEmit();
+	}
+	group.Update();
+}
+
+void ParticleSystem::TransferCPUGroup() {
+
 	for (auto& group : cpuGroups_) {
 
-		// ゲーム側で使用しない場合は常に
-		// 一定間隔で発生させる
-		if (!useGame_ && !allEmitEnable_) {
+		group.group.DrawPhaseEmitter();
+		group.group.TransferBuffer();
+	}
+}
 
-			group.group.FrequencyEmit();
+void ParticleSystem::Release() {
+
+	isReleased_ = true;
+	releaseTimer_ = 0.0f;
+	gpuDrainTime_ = 0.0f;
+
+	// 親は所有者側のものなので、この時点で外す
+	// 最後の行列は残して、生存中の粒を今の位置にとどめる
+	for (auto& group : gpuGroups_) {
+
+		group.group.DetachParent();
+		// 発生を止め、最後に発生した粒の寿命分は更新を続ける
+		group.group.SetIsForcedEmit(false);
+		gpuDrainTime_ = (std::max)(gpuDrainTime_, group.group.GetLifeTime());
+	}
+	for (auto& group : cpuGroups_) {
+
+		group.group.DetachParent();
+	}
+}
+
+const Json& ParticleSystem::GetGroups(const Json& data, const char* key) {
+
+	// 定義はconstで共有しているので、片方のグループしか無い場合は空の配列を返す
+	static const Json kEmpty = Json::array();
+	auto it = data.find(key);
+	return it == data.end() ? kEmpty : *it;
+}
+
+void ParticleSystem::ResetFromTemplate() {
+
+	// 定義からモジュールの値を戻す、コマンドで書き換えられている場合がある
+	// バッファは形状と最大数が定義から変わらないのでそのまま使う
+	const Json& data = *template_;
+	uint32_t index = 0;
+	for (const auto& groupData : GetGroups(data, "GPUGroups")) {
+
+		gpuGroups_[index++].group.ResetFromJson(groupData);
+	}
+	index = 0;
+	for (const auto& groupData : GetGroups(data, "CPUGroups")) {
+
+		cpuGroups_[index++].group.ResetFromJson(groupData);
+	}
+	ApplyRandomSeed();
+
+	allEmitTimer_ = 0.0f;
+	isReleased_ = false;
+	releaseTimer_ = 0.0f;
+	gpuDrainTime_ = 0.0f;
+}
+
+bool ParticleSystem::IsFinished() const {
+
+	// GPUの粒がまだ残っている
+	if (releaseTimer_ < gpuDrainTime_) {
+		return false;
+	}
+	for (const auto& group : cpuGroups_) {
+		if (0 < group.group.GetNumInstance()) {
+
+			return false;
 		}
-		group.group.Update();
 	}
+	return true;
 }
 
 void ParticleSystem::FrequencyEmit() {
@@ -150,6 +241,26 @@ void ParticleSystem::ApplyCommand(const ParticleCommand& command) {
 	}
 }
 
+void ParticleSystem::SetRandomSeed(uint64_t instanceSeed) {
+
+	instanceSeed_ = instanceSeed;
+	ApplyRandomSeed();
+}
+
+void ParticleSystem::ApplyRandomSeed() {
+
+	for (uint32_t index = 0; index < cpuGroups_.size(); ++index) {
+
+		cpuGroups_[index].group.SetRandomSeed(GetGroupSeed(index));
+	}
+}
+
+uint64_t ParticleSystem::GetGroupSeed(uint32_t index) const {
+
+	// グループの並び順で分ける
+	return RandomGenerator::MixSeed(RandomGenerator::MixSeed(seed_, instanceSeed_), index);
+}
+
 void ParticleSystem::AddGroup() {
 
 	// タイプに応じて作成
@@ -162,6 +273,7 @@ void ParticleSystem::AddGroup() {
 		group.name = "particle" + std::to_string(++nextGroupId_);
 		// 作成
 		group.group.Create(device_, asset_, primitiveType_);
+		group.group.SetRandomSeed(GetGroupSeed(static_cast<uint32_t>(cpuGroups_.size() - 1)));
 	} else if (particleType_ == ParticleType::GPU) {
 
 		// 追加
@@ -231,6 +343,7 @@ void ParticleSystem::HandleCopyPaste() {
 			group.group.SetSceneView(sceneView_);
 			group.name = "particle" + std::to_string(nextGroupId_);
 			group.group.Create(device_, asset_, copyGroup_.primitiveType);
+			group.group.SetRandomSeed(GetGroupSeed(static_cast<uint32_t>(cpuGroups_.size() - 1)));
 			group.group.FromJson(copyGroup_.data, asset_);
 		}
 		copyGroup_.hasData = false;
@@ -382,6 +495,14 @@ void ParticleSystem::ImGuiSystemParameter() {
 
 		ImGui::Text("%.3f / %.3f", allEmitTimer_, allEmitTime_);
 		ImGui::DragFloat("emit", &allEmitTime_, 0.01f);
+
+		// 同じseedなら同じ発生結果になる
+		if (ImGui::InputScalar("seed", ImGuiDataType_U64, &seed_)) {
+
+			ApplyRandomSeed();
+		}
+		// 予算を超えた時に優先して残す
+		ImGui::DragInt("priority", &priority_, 1.0f, -8, 8);
 	}
 
 	ImGui::SeparatorText("Config");
@@ -472,6 +593,8 @@ void ParticleSystem::SaveJson() {
 
 	data["primitiveType"] = EnumAdapter<ParticlePrimitiveType>::ToString(primitiveType_);
 	data["name"] = name_;
+	data["seed"] = seed_;
+	data["priority"] = priority_;
 
 	//============================================================================
 	//	GroupsParameters
@@ -510,6 +633,27 @@ void ParticleSystem::LoadJson(const std::optional<std::string>& filePath, bool u
 	// Particle/を削除
 	loadFileName_ = Algorithm::RemoveSubstring(loadFileName_, "Particle/");
 
+	// ファイルから直接読み込んだ場合は定義を持たない
+	template_.reset();
+	templatePath_.clear();
+
+	ApplyJson(data, useGame);
+}
+
+void ParticleSystem::CreateFromTemplate(const std::string& filePath,
+	std::shared_ptr<const Json> data, bool useGame) {
+
+	// Particle/を削除
+	loadFileName_ = Algorithm::RemoveSubstring(filePath, "Particle/");
+
+	template_ = std::move(data);
+	templatePath_ = filePath;
+
+	ApplyJson(*template_, useGame);
+}
+
+void ParticleSystem::ApplyJson(const Json& data, bool useGame) {
+
 	// 設定
 	useGame_ = useGame;
 
@@ -520,6 +664,8 @@ void ParticleSystem::LoadJson(const std::optional<std::string>& filePath, bool u
 	const auto& primitiveType = EnumAdapter<ParticlePrimitiveType>::FromString(data["primitiveType"]);
 	primitiveType_ = primitiveType.value();
 	name_ = data.value("name", "particleSystem");
+	seed_ = data.value("seed", uint64_t{ 0 });
+	priority_ = data.value("priority", 0);
 
 	//============================================================================
 	//	GroupsParameters
@@ -529,7 +675,7 @@ void ParticleSystem::LoadJson(const std::optional<std::string>& filePath, bool u
 	cpuGroups_.clear();
 
 	// GPU
-	for (auto& groupData : data["GPUGroups"]) {
+	for (auto& groupData : GetGroups(data, "GPUGroups")) {
 
 		auto& group = gpuGroups_.emplace_back();
 		group.group.SetSceneView(sceneView_);
@@ -537,11 +683,12 @@ void ParticleSystem::LoadJson(const std::optional<std::string>& filePath, bool u
 		group.group.CreateFromJson(device_, asset_, groupData);
 	}
 	// CPU
-	for (auto& groupData : data["CPUGroups"]) {
+	for (auto& groupData : GetGroups(data, "CPUGroups")) {
 
 		auto& group = cpuGroups_.emplace_back();
 		group.group.SetSceneView(sceneView_);
 		group.name = groupData.value("name", "");
 		group.group.CreateFromJson(device_, asset_, groupData, useGame_);
 	}
+	ApplyRandomSeed();
 }
\ No newline at end of file
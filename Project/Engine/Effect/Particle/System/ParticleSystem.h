@@ -13,6 +13,7 @@
 #include <imgui.h>
 // c++
 #include <filesystem>
+#include <memory>
 // front
 class Asset;
 
@@ -52,8 +53,13 @@ public:
 	// 初期化
 	void Init(ID3D12Device* device, Asset* asset, const std::string& name);
 
-	// 所持しているグループの更新
+	// 全ての同時発生とGPUグループの更新
 	void Update();
+	// index番目のCPUグループの発生、更新処理
+	// グループ同士は独立しているので並列に呼び出せる
+	void UpdateCPUGroup(uint32_t index);
+	// CPUグループの更新結果をGPUへ転送する、メインスレッドで呼ぶ
+	void TransferCPUGroup();
 
 	// editor
 	void ImGuiSelectedGroupEditor();
@@ -68,8 +74,11 @@ public:
 	void SelectGroup(int index) { selected_.index = index; }
 	void SetSceneView(SceneView* sceneView) { sceneView_ = sceneView; }
 	void SetParent(const BaseTransform& parent);
+	// 予算を超えた時に優先して残す順、大きいほど優先
+	void SetPriority(int priority) { priority_ = priority; }
 
 	const std::string& GetName() const { return name_; }
+	int GetPriority() const { return priority_; }
 	const std::string& GetGroupName(uint32_t i) const { return gpuGroups_[i].name; }
 
 	std::vector<NameGroup<GPUParticleGroup>>& GetGPUGroup() { return gpuGroups_; }
@@ -79,9 +88,28 @@ public:
 
 	// コマンド適用、各モジュールへ転送
 	void ApplyCommand(const ParticleCommand& command);
+	// 乱数列を作り直す、定義のseedとinstanceSeedからグループ、フェーズごとの乱数列を作る
+	void SetRandomSeed(uint64_t instanceSeed);
 
 	// .jsonファイルから読み込んで作成する
 	void LoadJson(const std::optional<std::string>& filePath = std::nullopt, bool useGame = false);
+	// 読み込み済みの定義から作成する、定義は再利用時の初期化にも使う
+	void CreateFromTemplate(const std::string& filePath, std::shared_ptr<const Json> data, bool useGame);
+
+	//---------- pool --------------------------------------------------------
+
+	// 所有者が手放した、発生を止めて残りの粒が消えるのを待つ
+	void Release();
+	// 定義の状態に戻す、プールへ戻す時に呼ぶ
+	void ResetFromTemplate();
+
+	// 全てのグループの粒が消えたか
+	// GPUの粒は数を読み戻さないので、手放してから寿命分経過したかで判断する
+	bool IsFinished() const;
+	bool IsReleased() const { return isReleased_; }
+	bool IsUseGame() const { return useGame_; }
+	bool HasTemplate() const { return template_ != nullptr; }
+	const std::string& GetTemplatePath() const { return templatePath_; }
 
 	// 一定間隔
 	void FrequencyEmit();
@@ -121,6 +149,20 @@ private:
 	// runtime
 	bool useGame_; // ゲーム側で使用する場合
 
+	// 予算管理の優先度
+	int priority_ = 0;
+
+	// random
+	uint64_t seed_ = 0;         // 定義のseed
+	uint64_t instanceSeed_ = 0; // 管理側から割り当てられたseed
+
+	// pool
+	std::shared_ptr<const Json> template_; // 作成元の定義
+	std::string templatePath_;             // 定義のパス
+	bool isReleased_ = false;              // 所有者が手放したか
+	float releaseTimer_ = 0.0f;            // 手放してからの経過時間
+	float gpuDrainTime_ = 0.0f;            // GPUの粒が全て消えるまでの時間
+
 	// allEmit
 	// 全て同時に発生させる
 	bool allEmitEnable_; // フラグ
@@ -148,10 +190,17 @@ private:
 
 	// json
 	void SaveJson();
+	void ApplyJson(const Json& data, bool useGame);
+	// グループ配列を取得する、無ければ空の配列
+	static const Json& GetGroups(const Json& data, const char* key);
 
 	// update
 	void UpdateAllEmit();
 
+	// random
+	void ApplyRandomSeed();
+	uint64_t GetGroupSeed(uint32_t index) const;
+
 	// editor
 	void AddGroup();
 	void RemoveGroup();
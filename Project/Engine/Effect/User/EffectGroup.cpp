@@ -15,6 +15,21 @@
 //	EffectGroup classMethods
 //============================================================================
 
+EffectGroup::~EffectGroup() {
+
+	ReleaseNodes();
+}
+
+void EffectGroup::ReleaseNodes() {
+
+	ParticleManager* particleManager = ParticleManager::GetInstance();
+	for (const auto& node : nodes_) {
+
+		particleManager->ReleaseParticleSystem(node.system);
+	}
+	nodes_.clear();
+}
+
 void EffectGroup::Init(const std::string& name, const std::string& groupName) {
 
 	// object作成
@@ -633,7 +648,7 @@ void EffectGroup::LoadJson(const std::string& fileName) {
 	}
 
 	// ノードをクリア
-	nodes_.clear();
+	ReleaseNodes();
 	parentAnchorId_ = data.value("parentAnchorId_", 0);
 	parentAnchorName_ = data.value("parentAnchorName_", "");
 
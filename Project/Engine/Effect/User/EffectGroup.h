@@ -19,7 +19,8 @@ public:
 	//========================================================================
 
 	EffectGroup() = default;
-	~EffectGroup() = default;
+	// 所持しているParticleSystemをManagerへ返す
+	~EffectGroup();
 
 	// オブジェクト作成
 	void Init(const std::string& name, const std::string& groupName);
@@ -102,6 +103,9 @@ private:
 	// 指定ノードの指定CPUグループの生存パーティクル数を取得する
 	uint32_t QueryAlive(const std::string& nodeKey, int groupIndex) const;
 
+	// 所持しているParticleSystemをManagerへ返す
+	void ReleaseNodes();
+
 	// json
 	void SaveJson(const std::string& filePath);
 
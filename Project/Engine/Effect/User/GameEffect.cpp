@@ -9,10 +9,20 @@
 //	GameEffect classMethods
 //============================================================================
 
+GameEffect::~GameEffect() {
+
+	// Managerへ返す
+	ParticleManager::GetInstance()->ReleaseParticleSystem(particleSystem_);
+}
+
 void GameEffect::CreateParticleSystem(const std::string& filePath) {
 
+	// 作り直す場合は前のシステムを返す
+	ParticleManager* particleManager = ParticleManager::GetInstance();
+	particleManager->ReleaseParticleSystem(particleSystem_);
+
 	// Managerに渡して作成
-	particleSystem_ = ParticleManager::GetInstance()->CreateParticleSystem(filePath);
+	particleSystem_ = particleManager->CreateParticleSystem(filePath);
 
 	// 初期化値
 	hasParent_ = false;
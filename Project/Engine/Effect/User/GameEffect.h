@@ -20,7 +20,12 @@ public:
 	//========================================================================
 
 	GameEffect() = default;
-	~GameEffect() = default;
+	// 作成したParticleSystemをManagerへ返す
+	~GameEffect();
+
+	// ParticleSystemを共有しないようにコピー禁止
+	GameEffect(const GameEffect&) = delete;
+	GameEffect& operator=(const GameEffect&) = delete;
 
 	// ParticleSystemの作成
 	void CreateParticleSystem(const std::string& filePath);
@@ -48,7 +53,7 @@ private:
 
 	//--------- variables ----------------------------------------------------
 
-	ParticleSystem* particleSystem_;
+	ParticleSystem* particleSystem_ = nullptr;
 
 	// 1回だけ発生させるか
 	bool emitOnce_;
@@ -14,6 +14,15 @@
 //	GameEffectGroup classMethods
 //============================================================================
 
+GameEffectGroup::~GameEffectGroup() {
+
+	ParticleManager* particleManager = ParticleManager::GetInstance();
+	for (const auto& group : groups_) {
+
+		particleManager->ReleaseParticleSystem(group.system);
+	}
+}
+
 void GameEffectGroup::Init(const std::string& name, const std::string& groupName) {
 
 	// object作成
@@ -20,7 +20,8 @@ public:
 	//========================================================================
 
 	GameEffectGroup() = default;
-	~GameEffectGroup() = default;
+	// 所持しているParticleSystemをManagerへ返す
+	~GameEffectGroup();
 
 	// オブジェクト作成
 	void Init(const std::string& name, const std::string& groupName);
@@ -0,0 +1,16 @@
+#pragma once
+
+//============================================================================
+//	include
+//============================================================================
+
+// simd
+// MathLibの.cppのみで使う、使用できる命令セットを判定してMATH_SIMD_SSE/MATH_SIMD_NEONを定義する
+// どちらも無ければスカラー版で処理する
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define MATH_SIMD_SSE
+#include <xmmintrin.h>
+#elif defined(_M_ARM64) || defined(__aarch64__) || defined(__ARM_NEON)
+#define MATH_SIMD_NEON
+#include <arm_neon.h>
+#endif
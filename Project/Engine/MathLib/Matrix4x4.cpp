@@ -4,6 +4,54 @@
 //	include
 //============================================================================*/
 #include <Engine/MathLib/Quaternion.h>
+#include <Engine/MathLib/MathSimd.h>
+
+//============================================================================*/
+//	simd helper
+//============================================================================*/
+
+namespace {
+
+	// 1行分(4要素)の乗算: result = row * matrix
+	// 加算順はスカラー版と同じ(k = 0..3)にして結果を一致させる
+	inline void MultiplyRow(const float* row, const Matrix4x4& matrix, float* result) {
+
+#if defined(MATH_SIMD_SSE)
+		__m128 r = _mm_mul_ps(_mm_set1_ps(row[0]), _mm_loadu_ps(matrix.m[0]));
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(row[1]), _mm_loadu_ps(matrix.m[1])));
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(row[2]), _mm_loadu_ps(matrix.m[2])));
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(row[3]), _mm_loadu_ps(matrix.m[3])));
+		_mm_storeu_ps(result, r);
+#elif defined(MATH_SIMD_NEON)
+		float32x4_t r = vmulq_n_f32(vld1q_f32(matrix.m[0]), row[0]);
+		r = vaddq_f32(r, vmulq_n_f32(vld1q_f32(matrix.m[1]), row[1]));
+		r = vaddq_f32(r, vmulq_n_f32(vld1q_f32(matrix.m[2]), row[2]));
+		r = vaddq_f32(r, vmulq_n_f32(vld1q_f32(matrix.m[3]), row[3]));
+		vst1q_f32(result, r);
+#else
+		for (int j = 0; j < 4; ++j) {
+			result[j] = row[0] * matrix.m[0][j] + row[1] * matrix.m[1][j] +
+				row[2] * matrix.m[2][j] + row[3] * matrix.m[3][j];
+		}
+#endif
+	}
+
+	// 行列同士の乗算、resultはlhs/rhsと重なっていてもよい
+	inline void MultiplyMatrix(const Matrix4x4& lhs, const Matrix4x4& rhs, Matrix4x4& result) {
+
+		float rows[4][4];
+		for (int i = 0; i < 4; ++i) {
+
+			MultiplyRow(lhs.m[i], rhs, rows[i]);
+		}
+		for (int i = 0; i < 4; ++i) {
+			for (int j = 0; j < 4; ++j) {
+
+				result.m[i][j] = rows[i][j];
+			}
+		}
+	}
+}
 
 //============================================================================*/
 //	Matrix4x4 classMethods
@@ -112,110 +160,141 @@ Matrix4x4 Matrix4x4::Zero() {
 
 Matrix4x4 Matrix4x4::Multiply(const Matrix4x4& m1, const Matrix4x4& m2) {
 
-	Matrix4x4 matrix{};
-	for (int i = 0; i < 4; i++) {
-		for (int j = 0; j < 4; j++) {
-			matrix.m[i][j] = 0;
-			for (int k = 0; k < 4; ++k) {
-				matrix.m[i][j] += m1.m[i][k] * m2.m[k][j];
-			}
-		}
-	}
+	Matrix4x4 matrix;
+	MultiplyMatrix(m1, m2, matrix);
 	return matrix;
 }
 
-Matrix4x4 Matrix4x4::Inverse(const Matrix4x4& m) {
+void Matrix4x4::MultiplyArray(const Matrix4x4* lhs, const Matrix4x4* rhs, Matrix4x4* out, size_t count) {
 
-	Matrix4x4 matrix = {};
+	for (size_t i = 0; i < count; ++i) {
 
-	float det =
-		m.m[0][0] * (m.m[1][1] * m.m[2][2] * m.m[3][3] + m.m[1][2] * m.m[2][3] * m.m[3][1] +
-			m.m[1][3] * m.m[2][1] * m.m[3][2] - m.m[1][1] * m.m[2][3] * m.m[3][2] -
-			m.m[1][2] * m.m[2][1] * m.m[3][3] - m.m[1][3] * m.m[2][2] * m.m[3][1]) -
-		m.m[0][1] * (m.m[1][0] * m.m[2][2] * m.m[3][3] + m.m[1][2] * m.m[2][3] * m.m[3][0] +
-			m.m[1][3] * m.m[2][0] * m.m[3][2] - m.m[1][0] * m.m[2][3] * m.m[3][2] -
-			m.m[1][2] * m.m[2][0] * m.m[3][3] - m.m[1][3] * m.m[2][2] * m.m[3][0]) +
-		m.m[0][2] * (m.m[1][0] * m.m[2][1] * m.m[3][3] + m.m[1][1] * m.m[2][3] * m.m[3][0] +
-			m.m[1][3] * m.m[2][0] * m.m[3][1] - m.m[1][0] * m.m[2][3] * m.m[3][1] -
-			m.m[1][1] * m.m[2][0] * m.m[3][3] - m.m[1][3] * m.m[2][1] * m.m[3][0]) -
-		m.m[0][3] * (m.m[1][0] * m.m[2][1] * m.m[3][2] + m.m[1][1] * m.m[2][2] * m.m[3][0] +
-			m.m[1][2] * m.m[2][0] * m.m[3][1] - m.m[1][0] * m.m[2][2] * m.m[3][1] -
-			m.m[1][1] * m.m[2][0] * m.m[3][2] - m.m[1][2] * m.m[2][1] * m.m[3][0]);
-
-	float invDet = 1.0f / det;
-
-	matrix.m[0][0] = (m.m[1][1] * m.m[2][2] * m.m[3][3] + m.m[1][2] * m.m[2][3] * m.m[3][1] +
-		m.m[1][3] * m.m[2][1] * m.m[3][2] - m.m[1][1] * m.m[2][3] * m.m[3][2] -
-		m.m[1][2] * m.m[2][1] * m.m[3][3] - m.m[1][3] * m.m[2][2] * m.m[3][1]) *
-		invDet;
-	matrix.m[0][1] = (m.m[0][1] * m.m[2][3] * m.m[3][2] + m.m[0][2] * m.m[2][1] * m.m[3][3] +
-		m.m[0][3] * m.m[2][2] * m.m[3][1] - m.m[0][1] * m.m[2][2] * m.m[3][3] -
-		m.m[0][2] * m.m[2][3] * m.m[3][1] - m.m[0][3] * m.m[2][1] * m.m[3][2]) *
-		invDet;
-	matrix.m[0][2] = (m.m[0][1] * m.m[1][2] * m.m[3][3] + m.m[0][2] * m.m[1][3] * m.m[3][1] +
-		m.m[0][3] * m.m[1][1] * m.m[3][2] - m.m[0][1] * m.m[1][3] * m.m[3][2] -
-		m.m[0][2] * m.m[1][1] * m.m[3][3] - m.m[0][3] * m.m[1][2] * m.m[3][1]) *
-		invDet;
-	matrix.m[0][3] = (m.m[0][1] * m.m[1][3] * m.m[2][2] + m.m[0][2] * m.m[1][1] * m.m[2][3] +
-		m.m[0][3] * m.m[1][2] * m.m[2][1] - m.m[0][1] * m.m[1][2] * m.m[2][3] -
-		m.m[0][2] * m.m[1][3] * m.m[2][1] - m.m[0][3] * m.m[1][1] * m.m[2][2]) *
-		invDet;
-
-	matrix.m[1][0] = (m.m[1][0] * m.m[2][3] * m.m[3][2] + m.m[1][2] * m.m[2][0] * m.m[3][3] +
-		m.m[1][3] * m.m[2][2] * m.m[3][0] - m.m[1][0] * m.m[2][2] * m.m[3][3] -
-		m.m[1][2] * m.m[2][3] * m.m[3][0] - m.m[1][3] * m.m[2][0] * m.m[3][2]) *
-		invDet;
-	matrix.m[1][1] = (m.m[0][0] * m.m[2][2] * m.m[3][3] + m.m[0][2] * m.m[2][3] * m.m[3][0] +
-		m.m[0][3] * m.m[2][0] * m.m[3][2] - m.m[0][0] * m.m[2][3] * m.m[3][2] -
-		m.m[0][2] * m.m[2][0] * m.m[3][3] - m.m[0][3] * m.m[2][2] * m.m[3][0]) *
-		invDet;
-	matrix.m[1][2] = (m.m[0][0] * m.m[1][3] * m.m[3][2] + m.m[0][2] * m.m[1][0] * m.m[3][3] +
-		m.m[0][3] * m.m[1][2] * m.m[3][0] - m.m[0][0] * m.m[1][2] * m.m[3][3] -
-		m.m[0][2] * m.m[1][3] * m.m[3][0] - m.m[0][3] * m.m[1][0] * m.m[3][2]) *
-		invDet;
-	matrix.m[1][3] = (m.m[0][0] * m.m[1][2] * m.m[2][3] + m.m[0][2] * m.m[1][3] * m.m[2][0] +
-		m.m[0][3] * m.m[1][0] * m.m[2][2] - m.m[0][0] * m.m[1][3] * m.m[2][2] -
-		m.m[0][2] * m.m[1][0] * m.m[2][3] - m.m[0][3] * m.m[1][2] * m.m[2][0]) *
-		invDet;
-
-	matrix.m[2][0] = (m.m[1][0] * m.m[2][1] * m.m[3][3] + m.m[1][1] * m.m[2][3] * m.m[3][0] +
-		m.m[1][3] * m.m[2][0] * m.m[3][1] - m.m[1][0] * m.m[2][3] * m.m[3][1] -
-		m.m[1][1] * m.m[2][0] * m.m[3][3] - m.m[1][3] * m.m[2][1] * m.m[3][0]) *
-		invDet;
-	matrix.m[2][1] = (m.m[0][0] * m.m[2][3] * m.m[3][1] + m.m[0][1] * m.m[2][0] * m.m[3][3] +
-		m.m[0][3] * m.m[2][1] * m.m[3][0] - m.m[0][0] * m.m[2][1] * m.m[3][3] -
-		m.m[0][1] * m.m[2][3] * m.m[3][0] - m.m[0][3] * m.m[2][0] * m.m[3][1]) *
-		invDet;
-	matrix.m[2][2] = (m.m[0][0] * m.m[1][1] * m.m[3][3] + m.m[0][1] * m.m[1][3] * m.m[3][0] +
-		m.m[0][3] * m.m[1][0] * m.m[3][1] - m.m[0][0] * m.m[1][3] * m.m[3][1] -
-		m.m[0][1] * m.m[1][0] * m.m[3][3] - m.m[0][3] * m.m[1][1] * m.m[3][0]) *
-		invDet;
-	matrix.m[2][3] = (m.m[0][0] * m.m[1][3] * m.m[2][1] + m.m[0][1] * m.m[1][0] * m.m[2][3] +
-		m.m[0][3] * m.m[1][1] * m.m[2][0] - m.m[0][0] * m.m[1][1] * m.m[2][3] -
-		m.m[0][1] * m.m[1][3] * m.m[2][0] - m.m[0][3] * m.m[1][0] * m.m[2][1]) *
-		invDet;
-
-	matrix.m[3][0] = (m.m[1][0] * m.m[2][2] * m.m[3][1] + m.m[1][1] * m.m[2][0] * m.m[3][2] +
-		m.m[1][2] * m.m[2][1] * m.m[3][0] - m.m[1][0] * m.m[2][1] * m.m[3][2] -
-		m.m[1][1] * m.m[2][2] * m.m[3][0] - m.m[1][2] * m.m[2][0] * m.m[3][1]) *
-		invDet;
-	matrix.m[3][1] = (m.m[0][0] * m.m[2][1] * m.m[3][2] + m.m[0][1] * m.m[2][2] * m.m[3][0] +
-		m.m[0][2] * m.m[2][0] * m.m[3][1] - m.m[0][0] * m.m[2][2] * m.m[3][1] -
-		m.m[0][1] * m.m[2][0] * m.m[3][2] - m.m[0][2] * m.m[2][1] * m.m[3][0]) *
-		invDet;
-	matrix.m[3][2] = (m.m[0][0] * m.m[1][2] * m.m[3][1] + m.m[0][1] * m.m[1][0] * m.m[3][2] +
-		m.m[0][2] * m.m[1][1] * m.m[3][0] - m.m[0][0] * m.m[1][1] * m.m[3][2] -
-		m.m[0][1] * m.m[1][2] * m.m[3][0] - m.m[0][2] * m.m[1][0] * m.m[3][1]) *
-		invDet;
-	matrix.m[3][3] = (m.m[0][0] * m.m[1][1] * m.m[2][2] + m.m[0][1] * m.m[1][2] * m.m[2][0] +
-		m.m[0][2] * m.m[1][0] * m.m[2][1] - m.m[0][0] * m.m[1][2] * m.m[2][1] -
-		m.m[0][1] * m.m[1][0] * m.m[2][2] - m.m[0][2] * m.m[1][1] * m.m[2][0]) *
-		invDet;
-
-	if (det == 0) {
-
-		return matrix;
+		MultiplyMatrix(lhs[i], rhs[i], out[i]);
 	}
+}
+
+void Matrix4x4::MultiplyArray(const Matrix4x4* lhs, const Matrix4x4& rhs, Matrix4x4* out, size_t count) {
+
+	// rhsがoutに含まれていても壊れないようにコピーしておく
+	const Matrix4x4 right = rhs;
+	for (size_t i = 0; i < count; ++i) {
+
+		MultiplyMatrix(lhs[i], right, out[i]);
+	}
+}
+
+Matrix4x4 Matrix4x4::Inverse(const Matrix4x4& m) {
+
+	// 2x2小行列式を共有して余因子を求める
+	const float s0 = m.m[0][0] * m.m[1][1] - m.m[1][0] * m.m[0][1];
+	const float s1 = m.m[0][0] * m.m[1][2] - m.m[1][0] * m.m[0][2];
+	const float s2 = m.m[0][0] * m.m[1][3] - m.m[1][0] * m.m[0][3];
+	const float s3 = m.m[0][1] * m.m[1][2] - m.m[1][1] * m.m[0][2];
+	const float s4 = m.m[0][1] * m.m[1][3] - m.m[1][1] * m.m[0][3];
+	const float s5 = m.m[0][2] * m.m[1][3] - m.m[1][2] * m.m[0][3];
+
+	const float c5 = m.m[2][2] * m.m[3][3] - m.m[3][2] * m.m[2][3];
+	const float c4 = m.m[2][1] * m.m[3][3] - m.m[3][1] * m.m[2][3];
+	const float c3 = m.m[2][1] * m.m[3][2] - m.m[3][1] * m.m[2][2];
+	const float c2 = m.m[2][0] * m.m[3][3] - m.m[3][0] * m.m[2][3];
+	const float c1 = m.m[2][0] * m.m[3][2] - m.m[3][0] * m.m[2][2];
+	const float c0 = m.m[2][0] * m.m[3][1] - m.m[3][0] * m.m[2][1];
+
+	const float det = s0 * c5 - s1 * c4 + s2 * c3 + s3 * c2 - s4 * c1 + s5 * c0;
+	const float invDet = 1.0f / det;
+
+	Matrix4x4 matrix;
+	matrix.m[0][0] = (m.m[1][1] * c5 - m.m[1][2] * c4 + m.m[1][3] * c3) * invDet;
+	matrix.m[0][1] = (-m.m[0][1] * c5 + m.m[0][2] * c4 - m.m[0][3] * c3) * invDet;
+	matrix.m[0][2] = (m.m[3][1] * s5 - m.m[3][2] * s4 + m.m[3][3] * s3) * invDet;
+	matrix.m[0][3] = (-m.m[2][1] * s5 + m.m[2][2] * s4 - m.m[2][3] * s3) * invDet;
+
+	matrix.m[1][0] = (-m.m[1][0] * c5 + m.m[1][2] * c2 - m.m[1][3] * c1) * invDet;
+	matrix.m[1][1] = (m.m[0][0] * c5 - m.m[0][2] * c2 + m.m[0][3] * c1) * invDet;
+	matrix.m[1][2] = (-m.m[3][0] * s5 + m.m[3][2] * s2 - m.m[3][3] * s1) * invDet;
+	matrix.m[1][3] = (m.m[2][0] * s5 - m.m[2][2] * s2 + m.m[2][3] * s1) * invDet;
+
+	matrix.m[2][0] = (m.m[1][0] * c4 - m.m[1][1] * c2 + m.m[1][3] * c0) * invDet;
+	matrix.m[2][1] = (-m.m[0][0] * c4 + m.m[0][1] * c2 - m.m[0][3] * c0) * invDet;
+	matrix.m[2][2] = (m.m[3][0] * s4 - m.m[3][1] * s2 + m.m[3][3] * s0) * invDet;
+	matrix.m[2][3] = (-m.m[2][0] * s4 + m.m[2][1] * s2 - m.m[2][3] * s0) * invDet;
+
+	matrix.m[3][0] = (-m.m[1][0] * c3 + m.m[1][1] * c1 - m.m[1][2] * c0) * invDet;
+	matrix.m[3][1] = (m.m[0][0] * c3 - m.m[0][1] * c1 + m.m[0][2] * c0) * invDet;
+	matrix.m[3][2] = (-m.m[3][0] * s3 + m.m[3][1] * s1 - m.m[3][2] * s0) * invDet;
+	matrix.m[3][3] = (m.m[2][0] * s3 - m.m[2][1] * s1 + m.m[2][2] * s0) * invDet;
+
+	return matrix;
+}
+
+Matrix4x4 Matrix4x4::InverseAffine(const Matrix4x4& m) {
+
+	// 左上3x3の余因子
+	const float c00 = m.m[1][1] * m.m[2][2] - m.m[1][2] * m.m[2][1];
+	const float c01 = m.m[1][2] * m.m[2][0] - m.m[1][0] * m.m[2][2];
+	const float c02 = m.m[1][0] * m.m[2][1] - m.m[1][1] * m.m[2][0];
+
+	const float det = m.m[0][0] * c00 + m.m[0][1] * c01 + m.m[0][2] * c02;
+	const float invDet = 1.0f / det;
+
+	Matrix4x4 matrix;
+	matrix.m[0][0] = c00 * invDet;
+	matrix.m[0][1] = (m.m[0][2] * m.m[2][1] - m.m[0][1] * m.m[2][2]) * invDet;
+	matrix.m[0][2] = (m.m[0][1] * m.m[1][2] - m.m[0][2] * m.m[1][1]) * invDet;
+	matrix.m[0][3] = 0.0f;
+
+	matrix.m[1][0] = c01 * invDet;
+	matrix.m[1][1] = (m.m[0][0] * m.m[2][2] - m.m[0][2] * m.m[2][0]) * invDet;
+	matrix.m[1][2] = (m.m[0][2] * m.m[1][0] - m.m[0][0] * m.m[1][2]) * invDet;
+	matrix.m[1][3] = 0.0f;
+
+	matrix.m[2][0] = c02 * invDet;
+	matrix.m[2][1] = (m.m[0][1] * m.m[2][0] - m.m[0][0] * m.m[2][1]) * invDet;
+	matrix.m[2][2] = (m.m[0][0] * m.m[1][1] - m.m[0][1] * m.m[1][0]) * invDet;
+	matrix.m[2][3] = 0.0f;
+
+	// 平行移動は -t * A^-1
+	const float tx = m.m[3][0];
+	const float ty = m.m[3][1];
+	const float tz = m.m[3][2];
+	matrix.m[3][0] = -(tx * matrix.m[0][0] + ty * matrix.m[1][0] + tz * matrix.m[2][0]);
+	matrix.m[3][1] = -(tx * matrix.m[0][1] + ty * matrix.m[1][1] + tz * matrix.m[2][1]);
+	matrix.m[3][2] = -(tx * matrix.m[0][2] + ty * matrix.m[1][2] + tz * matrix.m[2][2]);
+	matrix.m[3][3] = 1.0f;
+
+	return matrix;
+}
+
+Matrix4x4 Matrix4x4::InverseTranspose3x3(const Matrix4x4& m) {
+
+	// (A^-1)^T = 余因子行列 / det
+	const float c00 = m.m[1][1] * m.m[2][2] - m.m[1][2] * m.m[2][1];
+	const float c01 = m.m[1][2] * m.m[2][0] - m.m[1][0] * m.m[2][2];
+	const float c02 = m.m[1][0] * m.m[2][1] - m.m[1][1] * m.m[2][0];
+
+	const float det = m.m[0][0] * c00 + m.m[0][1] * c01 + m.m[0][2] * c02;
+	const float invDet = 1.0f / det;
+
+	Matrix4x4 matrix;
+	matrix.m[0][0] = c00 * invDet;
+	matrix.m[0][1] = c01 * invDet;
+	matrix.m[0][2] = c02 * invDet;
+	matrix.m[0][3] = 0.0f;
+
+	matrix.m[1][0] = (m.m[0][2] * m.m[2][1] - m.m[0][1] * m.m[2][2]) * invDet;
+	matrix.m[1][1] = (m.m[0][0] * m.m[2][2] - m.m[0][2] * m.m[2][0]) * invDet;
+	matrix.m[1][2] = (m.m[0][1] * m.m[2][0] - m.m[0][0] * m.m[2][1]) * invDet;
+	matrix.m[1][3] = 0.0f;
+
+	matrix.m[2][0] = (m.m[0][1] * m.m[1][2] - m.m[0][2] * m.m[1][1]) * invDet;
+	matrix.m[2][1] = (m.m[0][2] * m.m[1][0] - m.m[0][0] * m.m[1][2]) * invDet;
+	matrix.m[2][2] = (m.m[0][0] * m.m[1][1] - m.m[0][1] * m.m[1][0]) * invDet;
+	matrix.m[2][3] = 0.0f;
+
+	matrix.m[3][0] = 0.0f;
+	matrix.m[3][1] = 0.0f;
+	matrix.m[3][2] = 0.0f;
+	matrix.m[3][3] = 1.0f;
 
 	return matrix;
 }
@@ -325,14 +404,17 @@ Matrix4x4 Matrix4x4::MakeTranslateMatrix(const Vector3& translate) {
 
 Matrix4x4 Matrix4x4::MakeAffineMatrix(const Vector3& scale, const Vector3& rotate, const Vector3& translate) {
 
-	Matrix4x4 matrix = {};
-
-	Matrix4x4 scaleMatrix = MakeScaleMatrix(scale);
-	Matrix4x4 rotateMatrix = MakeRotateMatrix(rotate);
-	Matrix4x4 translateMatrix = MakeTranslateMatrix(translate);
+	// S * R * T は回転行列の各行をスケールし、4行目に平行移動を置いたものと等しい
+	Matrix4x4 matrix = MakeRotateMatrix(rotate);
+	for (int j = 0; j < 3; ++j) {
 
-	matrix = Multiply(scaleMatrix, rotateMatrix);
-	matrix = Multiply(matrix, translateMatrix);
+		matrix.m[0][j] *= scale.x;
+		matrix.m[1][j] *= scale.y;
+		matrix.m[2][j] *= scale.z;
+	}
+	matrix.m[3][0] = translate.x;
+	matrix.m[3][1] = translate.y;
+	matrix.m[3][2] = translate.z;
 
 	return matrix;
 }
@@ -428,14 +510,17 @@ Matrix4x4 Matrix4x4::MakeViewportMatrix(float left, float top, float width, floa
 // 任意軸アフィン変換
 Matrix4x4 Matrix4x4::MakeAxisAffineMatrix(const Vector3& scale, const Quaternion& rotate, const Vector3& translate) {
 
-	Matrix4x4 matrix = {};
-
-	Matrix4x4 scaleMatrix = MakeScaleMatrix(scale);
-	Matrix4x4 rotateMatrix = Quaternion::MakeRotateMatrix(rotate);
-	Matrix4x4 translateMatrix = MakeTranslateMatrix(translate);
+	// MakeAffineMatrixと同様に行列積を使わず直接組み立てる
+	Matrix4x4 matrix = Quaternion::MakeRotateMatrix(rotate);
+	for (int j = 0; j < 3; ++j) {
 
-	matrix = Multiply(scaleMatrix, rotateMatrix);
-	matrix = Multiply(matrix, translateMatrix);
+		matrix.m[0][j] *= scale.x;
+		matrix.m[1][j] *= scale.y;
+		matrix.m[2][j] *= scale.z;
+	}
+	matrix.m[3][0] = translate.x;
+	matrix.m[3][1] = translate.y;
+	matrix.m[3][2] = translate.z;
 
 	return matrix;
 }
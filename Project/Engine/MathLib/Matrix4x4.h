@@ -5,6 +5,9 @@
 //============================================================================
 #include <Engine/MathLib/Vector3.h>
 
+// c++
+#include <cstddef>
+
 // front
 class Quaternion;
 
@@ -39,6 +42,15 @@ public:
 	static Matrix4x4 Multiply(const Matrix4x4& m1, const Matrix4x4& m2);
 
 	static Matrix4x4 Inverse(const Matrix4x4& m);
+	// 4列目が(0,0,0,1)のアフィン行列専用の逆行列
+	static Matrix4x4 InverseAffine(const Matrix4x4& m);
+	// 左上3x3の逆転置行列(法線変換用、平行移動成分は0)
+	static Matrix4x4 InverseTranspose3x3(const Matrix4x4& m);
+
+	// 配列の一括乗算 out[i] = lhs[i] * rhs[i]
+	static void MultiplyArray(const Matrix4x4* lhs, const Matrix4x4* rhs, Matrix4x4* out, size_t count);
+	// 配列の一括乗算 out[i] = lhs[i] * rhs
+	static void MultiplyArray(const Matrix4x4* lhs, const Matrix4x4& rhs, Matrix4x4* out, size_t count);
 
 	static Matrix4x4 Transpose(const Matrix4x4& m);
 
@@ -5,6 +5,7 @@
 //============================================================================*/
 #include <Engine/Asset/AssetStructure.h>
 #include <Engine/Core/Debug/Assert.h>
+#include <Engine/MathLib/MathSimd.h>
 
 //============================================================================*/
 //	Quaternion classMethods
@@ -139,10 +140,37 @@ Quaternion Quaternion::Multiply(const Quaternion& lhs, const Quaternion& rhs) {
 
 	Quaternion result;
 
+#if defined(MATH_SIMD_SSE) || defined(MATH_SIMD_NEON)
+	// (x, y, z, w)の順に、lhsの各成分と符号付きで並べ替えたrhsの積を足していく
+	// 減算は符号を反転した積の加算と同じ値になるので、スカラー版と結果が一致する
+	float out[4];
+#if defined(MATH_SIMD_SSE)
+	__m128 r = _mm_mul_ps(_mm_set1_ps(lhs.w), _mm_setr_ps(rhs.x, rhs.y, rhs.z, rhs.w));
+	r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(lhs.x), _mm_setr_ps(rhs.w, -rhs.z, rhs.y, -rhs.x)));
+	r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(lhs.y), _mm_setr_ps(rhs.z, rhs.w, -rhs.x, -rhs.y)));
+	r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(lhs.z), _mm_setr_ps(-rhs.y, rhs.x, rhs.w, -rhs.z)));
+	_mm_storeu_ps(out, r);
+#else
+	const float c0[4] = { rhs.x, rhs.y, rhs.z, rhs.w };
+	const float c1[4] = { rhs.w, -rhs.z, rhs.y, -rhs.x };
+	const float c2[4] = { rhs.z, rhs.w, -rhs.x, -rhs.y };
+	const float c3[4] = { -rhs.y, rhs.x, rhs.w, -rhs.z };
+	float32x4_t r = vmulq_n_f32(vld1q_f32(c0), lhs.w);
+	r = vaddq_f32(r, vmulq_n_f32(vld1q_f32(c1), lhs.x));
+	r = vaddq_f32(r, vmulq_n_f32(vld1q_f32(c2), lhs.y));
+	r = vaddq_f32(r, vmulq_n_f32(vld1q_f32(c3), lhs.z));
+	vst1q_f32(out, r);
+#endif
+	result.x = out[0];
+	result.y = out[1];
+	result.z = out[2];
+	result.w = out[3];
+#else
 	result.w = lhs.w * rhs.w - lhs.x * rhs.x - lhs.y * rhs.y - lhs.z * rhs.z;
 	result.x = lhs.w * rhs.x + lhs.x * rhs.w + lhs.y * rhs.z - lhs.z * rhs.y;
 	result.y = lhs.w * rhs.y - lhs.x * rhs.z + lhs.y * rhs.w + lhs.z * rhs.x;
 	result.z = lhs.w * rhs.z + lhs.x * rhs.y - lhs.y * rhs.x + lhs.z * rhs.w;
+#endif
 
 	return result;
 }
@@ -271,33 +299,6 @@ float Quaternion::Dot(const Quaternion& q0, const Quaternion& q1) {
 	return q0.x * q1.x + q0.y * q1.y + q0.z * q1.z + q0.w * q1.w;
 }
 
-Quaternion Quaternion::CalculateValue(const std::vector<Keyframe<Quaternion>>& keyframes, float time) {
-
-	// キーが1つか、時刻がキーフレーム前なら最初の値とする
-	if (keyframes.size() == 1 || time <= keyframes[0].time) {
-
-		return keyframes[0].value;
-	}
-
-	for (size_t index = 0; index < keyframes.size(); ++index) {
-
-		size_t nextIndex = index + 1;
-
-		// indexとnextIndexの2つのkeyframeを取得して範囲内に時刻があるかを判定
-		if (keyframes[index].time <= time && time <= keyframes[nextIndex].time) {
-
-			// 範囲内を補完する
-			float t =
-				(time - keyframes[index].time) / (keyframes[nextIndex].time - keyframes[index].time);
-
-			return Slerp(keyframes[index].value, keyframes[nextIndex].value, t);
-		}
-	}
-
-	// ここまで来た場合は1番後の時刻よりも後ろなので最後の値を返す
-	return (*keyframes.rbegin()).value;
-}
-
 Quaternion Quaternion::LookRotation(const Vector3& forward, const Vector3& up) {
 
 	Vector3 f = forward.Normalize();
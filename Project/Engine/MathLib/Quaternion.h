@@ -17,8 +17,6 @@ using Json = nlohmann::json;
 // front
 class Vector3;
 class Matrix4x4;
-template <typename tValue>
-struct Keyframe;
 
 //============================================================================
 //	Quaternion class
@@ -79,8 +77,6 @@ public:
 
 	static float Dot(const Quaternion& q0, const Quaternion& q1);
 
-	static Quaternion CalculateValue(const std::vector<Keyframe<Quaternion>>& keyframes, float time);
-
 	static Quaternion LookRotation(const Vector3& forward, const Vector3& up);
 
 	static Quaternion LookAt(const Vector3& from, const Vector3& to, const Vector3& up);
@@ -5,6 +5,39 @@
 //============================================================================*/
 #include <Engine/Asset/AssetStructure.h>
 #include <Engine/Core/Debug/Assert.h>
+#include <Engine/MathLib/MathSimd.h>
+
+//============================================================================*/
+//	simd helper
+//============================================================================*/
+
+namespace {
+
+	// 点の変換の1行分: result = v.x * m[0] + v.y * m[1] + v.z * m[2] + m[3]
+	// 加算順はスカラー版と同じにして結果を一致させる
+	inline void TransformPoint(const Vector3& v, const Matrix4x4& matrix, float* result) {
+
+#if defined(MATH_SIMD_SSE)
+		__m128 r = _mm_mul_ps(_mm_set1_ps(v.x), _mm_loadu_ps(matrix.m[0]));
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(v.y), _mm_loadu_ps(matrix.m[1])));
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(v.z), _mm_loadu_ps(matrix.m[2])));
+		r = _mm_add_ps(r, _mm_loadu_ps(matrix.m[3]));
+		_mm_storeu_ps(result, r);
+#elif defined(MATH_SIMD_NEON)
+		float32x4_t r = vmulq_n_f32(vld1q_f32(matrix.m[0]), v.x);
+		r = vaddq_f32(r, vmulq_n_f32(vld1q_f32(matrix.m[1]), v.y));
+		r = vaddq_f32(r, vmulq_n_f32(vld1q_f32(matrix.m[2]), v.z));
+		r = vaddq_f32(r, vld1q_f32(matrix.m[3]));
+		vst1q_f32(result, r);
+#else
+		for (int j = 0; j < 4; ++j) {
+
+			result[j] = v.x * matrix.m[0][j] + v.y * matrix.m[1][j] + v.z * matrix.m[2][j] +
+				matrix.m[3][j];
+		}
+#endif
+	}
+}
 
 //============================================================================*/
 //	Vector3 classMethods
@@ -187,33 +220,6 @@ Vector3 Vector3::Normalize(const Vector3& v) {
 	return Vector3(v.x / length, v.y / length, v.z / length);
 }
 
-Vector3 Vector3::CalculateValue(const std::vector<Keyframe<Vector3>>& keyframes, float time) {
-
-	// キーが1つか、時刻がキーフレーム前なら最初の値とする
-	if (keyframes.size() == 1 || time <= keyframes[0].time) {
-
-		return keyframes[0].value;
-	}
-
-	for (size_t index = 0; index < keyframes.size(); index++) {
-
-		size_t nextIndex = index + 1;
-
-		// indexとnextIndexの2つのkeyframeを取得して範囲内に時刻があるかを判定
-		if (keyframes[index].time <= time && time <= keyframes[nextIndex].time) {
-
-			// 範囲内を補完する
-			float t =
-				(time - keyframes[index].time) / (keyframes[nextIndex].time - keyframes[index].time);
-
-			return Lerp(keyframes[index].value, keyframes[nextIndex].value, t);
-		}
-	}
-
-	// ここまで来た場合は1番後の時刻よりも後ろなので最後の値を返す
-	return (*keyframes.rbegin()).value;
-}
-
 Vector3 Vector3::Lerp(const Vector3& v0, const Vector3& v1, float t) {
 	return Vector3(std::lerp(v0.x, v1.x, t), std::lerp(v0.y, v1.y, t), std::lerp(v0.z, v1.z, t));
 }
@@ -225,16 +231,11 @@ Vector3 Vector3::Reflect(const Vector3& input, const Vector3& normal) {
 
 Vector3 Vector3::Transform(const Vector3& v, const Matrix4x4& matrix) {
 
-	Vector3 result;
+	float row[4];
+	TransformPoint(v, matrix, row);
 
-	result.x = v.x * matrix.m[0][0] + v.y * matrix.m[1][0] + v.z * matrix.m[2][0] +
-		matrix.m[3][0];
-	result.y = v.x * matrix.m[0][1] + v.y * matrix.m[1][1] + v.z * matrix.m[2][1] +
-		matrix.m[3][1];
-	result.z = v.x * matrix.m[0][2] + v.y * matrix.m[1][2] + v.z * matrix.m[2][2] +
-		matrix.m[3][2];
-	float w = v.x * matrix.m[0][3] + v.y * matrix.m[1][3] + v.z * matrix.m[2][3] +
-		matrix.m[3][3];
+	Vector3 result(row[0], row[1], row[2]);
+	float w = row[3];
 
 	if (w != 0.0f) {
 		result.x /= w;
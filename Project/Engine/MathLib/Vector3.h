@@ -16,8 +16,6 @@
 using Json = nlohmann::json;
 
 // front
-template <typename tValue>
-struct Keyframe;
 class Matrix4x4;
 
 //============================================================================
@@ -88,8 +86,6 @@ public:
 
 	static Vector3 Normalize(const Vector3& v);
 
-	static Vector3 CalculateValue(const std::vector<Keyframe<Vector3>>& keyframes, float time);
-
 	static Vector3 Lerp(const Vector3& v0, const Vector3& v1, float t);
 
 	static Vector3 Reflect(const Vector3& input, const Vector3& normal);
@@ -188,21 +188,14 @@ Vector3 GameObject3D::GetJointWorldPos(const std::string& jointName) const {
 		return Vector3();
 	}
 
-	// 骨の情報を取得
-	const Skeleton& skeleton = animation_->GetSkeleton();
-
-	// 指定されたjointNameの骨が存在するか確認
-	if (!Algorithm::Find(skeleton.jointMap, jointName)) {
+	// model空間の行列を取得、指定されたjointNameの骨が存在しなければ空
+	const Matrix4x4* jointToModel = animation_->FindJointSkeletonSpaceMatrix(jointName);
+	if (!jointToModel) {
 		return Vector3();
 	}
-	// jointNameに対応するindexを取得
-	uint32_t jointIndex = skeleton.jointMap.at(jointName);
-
-	// model空間の行列を取得
-	const Matrix4x4& jointToModel = skeleton.joints[jointIndex].skeletonSpaceMatrix;
 
 	// 行列を合成する
-	Matrix4x4 world = jointToModel * transform_->matrix.world;
+	Matrix4x4 world = *jointToModel * transform_->matrix.world;
 
 	// 平行移動成分でワールド座標を返す
 	return world.GetTranslationValue();
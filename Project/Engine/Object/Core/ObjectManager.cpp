@@ -60,13 +60,14 @@ void ObjectManager::Init(ID3D12Device* device, Asset* asset, DxCommand* dxComman
 	systemManager_->AddSystem<Transform3DSystem>();
 	systemManager_->AddSystem<Transform2DSystem>();
 	systemManager_->AddSystem<AnimationSystem>();
+	// jointを親に持つtransformはアニメーション後に更新する
+	systemManager_->AddSystem<Transform3DAttachmentSystem>(systemManager_->GetSystem<Transform3DSystem>());
 	systemManager_->AddSystem<MaterialSystem>();
 	systemManager_->AddSystem<SpriteMaterialSystem>();
 	systemManager_->AddSystem<TagSystem>();
 	systemManager_->AddSystem<SpriteBufferSystem>();
 	systemManager_->AddSystem<SkyboxRenderSystem>();
 	systemManager_->AddSystem<InstancedMeshSystem>(device, asset, dxCommand);
-	systemManager_->GetSystem<InstancedMeshSystem>()->StartBuildWorker();
 
 	ImGuiObjectEditor::GetInstance()->Init();
 }
@@ -202,8 +203,9 @@ void ObjectManager::DestroyAll() {
 
 	// すべて走査して破棄
 	Archetype mask{};
-	auto objects = objectPoolManager_->View(mask);
-	for (uint32_t id : objects) {
+	// 破棄による一覧の変化は走査後にまとめて反映する
+	ObjectPoolManager::IterationScope iterationScope(*objectPoolManager_);
+	for (uint32_t id : objectPoolManager_->View(mask)) {
 
 		// 破棄フラグがたっていなければ破棄しない
 		const auto& tag = objectPoolManager_->GetData<ObjectTag>(id);
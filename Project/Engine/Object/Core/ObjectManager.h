@@ -73,6 +73,8 @@ public:
 
 	// プールを取得
 	ObjectPoolManager* GetObjectPoolManager() const { return objectPoolManager_.get(); }
+	// システムを取得
+	SystemManager* GetSystemManager() const { return systemManager_.get(); }
 
 	// singleton
 	static ObjectManager* GetInstance();
@@ -11,7 +11,6 @@
 #include <memory>
 #include <vector>
 #include <bitset>
-#include <unordered_map>
 #include <typeindex>
 // imgui
 #include <imgui.h>
@@ -20,6 +19,31 @@
 constexpr const size_t kMaxDataTypes = 64;
 using Archetype = std::bitset<kMaxDataTypes>;
 
+//============================================================================
+//	ObjectHandle namespace
+//	32bitのオブジェクトIDを下位index/上位generationに分割して扱う。
+//============================================================================
+namespace ObjectHandle {
+
+	// ビット配分
+	constexpr uint32_t kIndexBits = 20;
+	constexpr uint32_t kGenerationBits = 32 - kIndexBits;
+	constexpr uint32_t kIndexMask = (1u << kIndexBits) - 1u;
+	constexpr uint32_t kGenerationMask = (1u << kGenerationBits) - 1u;
+
+	// 無効なID
+	constexpr uint32_t kInvalid = 0xffffffff;
+
+	// index/generationからIDを作成する
+	constexpr uint32_t Make(uint32_t index, uint32_t generation) {
+		return (index & kIndexMask) | ((generation & kGenerationMask) << kIndexBits);
+	}
+	// IDからindexを取り出す
+	constexpr uint32_t GetIndex(uint32_t object) { return object & kIndexMask; }
+	// IDからgenerationを取り出す
+	constexpr uint32_t GetGeneration(uint32_t object) { return (object >> kIndexBits) & kGenerationMask; }
+}
+
 //============================================================================
 //	IObjectPool class
 //	各プール共通のIFを定義し、削除/デバッグ操作を提供する。
@@ -58,15 +82,22 @@ public:
 	//--------- variables ----------------------------------------------------
 
 	// アクセス番地
-	// object -> index
-	std::unordered_map<uint32_t, size_t> objectToIndex_;
-	// index -> object
+	// objectIndex -> slot (sparse)
+	std::vector<uint32_t> sparse_;
+	// slot -> object (generation込み)
 	std::vector<uint32_t> indexToObject_;
-	std::vector<size_t> freeList_;
+	std::vector<uint32_t> freeList_;
+
+	// 生存しているobjectの詰めた配列(dense)
+	// 削除時はswap-and-popで末尾と入れ替える
+	std::vector<uint32_t> dense_;
+	// slot -> dense_の位置
+	std::vector<uint32_t> slotToDense_;
 
 	// data
 	// kMultiple = true: std::vector<T>
 	// kMultiple = false: T
+	// 外部から要素のポインタを保持されるため、slotは生存中に移動させない
 	using Storage = std::conditional_t<kMultiple, std::vector<T>, T>;
 	std::vector<Storage> data_;
 
@@ -82,15 +113,27 @@ public:
 	void Remove(uint32_t object) override;
 	// 指定オブジェクトのデータを取得する(無ければnullptr)
 	Storage* Get(uint32_t object);
+
+	// 生存しているobjectの一覧を返す
+	const std::vector<uint32_t>& GetObjects() const { return dense_; }
+	// 保持しているデータ数を返す
+	size_t GetSize() const { return dense_.size(); }
 private:
 	//========================================================================
 	//	private Methods
 	//========================================================================
 
+	//--------- variables ----------------------------------------------------
+
+	static constexpr uint32_t kInvalidSlot = 0xffffffff;
+
 	//--------- functions ----------------------------------------------------
 
 	// 内部処理: 実削除と空き番地管理を行う
 	void RemoveImpl(uint32_t object);
+
+	// objectに対応するslotを返す(無ければkInvalidSlot)
+	uint32_t FindSlot(uint32_t object) const;
 };
 
 //============================================================================
@@ -102,31 +145,41 @@ template<class ...Args>
 inline void ObjectPool<T, kMultiple>::Add(uint32_t object, Args && ...args) {
 
 	// すでに持っていれば上書き
-	auto it = objectToIndex_.find(object);
-	if (it != objectToIndex_.end()) {
+	if (uint32_t slot = FindSlot(object); slot != kInvalidSlot) {
 
-		data_[it->second] = Storage{ std::forward<Args>(args)... };
+		data_[slot] = Storage{ std::forward<Args>(args)... };
 		return;
 	}
 
-	size_t index;
+	uint32_t slot;
 	if (!freeList_.empty()) {
 
-		// 空いているindexを取得し再利用する
-		index = freeList_.back();
+		// 空いているslotを取得し再利用する
+		slot = freeList_.back();
 		freeList_.pop_back();
-		data_[index] = Storage{ std::forward<Args>(args)... };
-		indexToObject_[index] = object;
+		data_[slot] = Storage{ std::forward<Args>(args)... };
+		indexToObject_[slot] = object;
 	} else {
 
 		// capacityを超えたら
 		ASSERT(data_.size() < data_.capacity(), "ObjectPool capacity exceeded");
 
-		index = data_.size();
+		slot = static_cast<uint32_t>(data_.size());
 		data_.emplace_back(Storage{ std::forward<Args>(args)... });
 		indexToObject_.push_back(object);
+		slotToDense_.push_back(kInvalidSlot);
+	}
+
+	// sparse -> slot
+	const uint32_t index = ObjectHandle::GetIndex(object);
+	if (sparse_.size() <= index) {
+		sparse_.resize(index + 1, kInvalidSlot);
 	}
-	objectToIndex_[object] = index;
+	sparse_[index] = slot;
+
+	// denseの末尾に追加
+	slotToDense_[slot] = static_cast<uint32_t>(dense_.size());
+	dense_.push_back(object);
 }
 
 template<class T, bool kMultiple>
@@ -134,6 +187,9 @@ inline ObjectPool<T, kMultiple>::ObjectPool() {
 
 	// 最初に最大数を確保、これ以降は禁止
 	data_.reserve(Config::kMaxInstanceNum);
+	indexToObject_.reserve(Config::kMaxInstanceNum);
+	slotToDense_.reserve(Config::kMaxInstanceNum);
+	dense_.reserve(Config::kMaxInstanceNum);
 }
 
 template<class T, bool kMultiple>
@@ -146,6 +202,7 @@ inline void ObjectPool<T, kMultiple>::Debug(const char* label) {
 		return;
 	}
 
+	ImGui::Text("alive     = %zu", dense_.size());
 	ImGui::Text("size      = %zu", data_.size());
 	ImGui::Text("capacity  = %zu", data_.capacity());
 	ImGui::Text("element   = %zu bytes", sizeof(Storage));
@@ -205,11 +262,11 @@ inline void ObjectPool<T, kMultiple>::Remove(uint32_t object) {
 template<class T, bool kMultiple>
 inline ObjectPool<T, kMultiple>::Storage* ObjectPool<T, kMultiple>::Get(uint32_t object) {
 
-	auto it = objectToIndex_.find(object);
+	const uint32_t slot = FindSlot(object);
 	// objectが存在していれば値を返す
-	if (it != objectToIndex_.end()) {
+	if (slot != kInvalidSlot) {
 
-		return  &data_[it->second];
+		return &data_[slot];
 	}
 	// 存在していなければnullptrを返す
 	return nullptr;
@@ -219,16 +276,38 @@ template<class T, bool kMultiple>
 inline void ObjectPool<T, kMultiple>::RemoveImpl(uint32_t object) {
 
 	// 存在しないobjectの場合処理しない
-	auto it = objectToIndex_.find(object);
-	if (it == objectToIndex_.end()) {
+	const uint32_t slot = FindSlot(object);
+	if (slot == kInvalidSlot) {
 		return;
 	}
 
-	size_t index = it->second;
-	data_[index] = Storage{};
-	indexToObject_[index] = 0xffffffff;
+	// denseは末尾と入れ替えて詰める
+	const uint32_t denseIndex = slotToDense_[slot];
+	const uint32_t last = dense_.back();
+	dense_[denseIndex] = last;
+	slotToDense_[sparse_[ObjectHandle::GetIndex(last)]] = denseIndex;
+	dense_.pop_back();
+
+	data_[slot] = Storage{};
+	indexToObject_[slot] = ObjectHandle::kInvalid;
+	slotToDense_[slot] = kInvalidSlot;
+	sparse_[ObjectHandle::GetIndex(object)] = kInvalidSlot;
 
 	// 空き番地を記録
-	objectToIndex_.erase(it);
-	freeList_.push_back(index);
+	freeList_.push_back(slot);
+}
+
+template<class T, bool kMultiple>
+inline uint32_t ObjectPool<T, kMultiple>::FindSlot(uint32_t object) const {
+
+	const uint32_t index = ObjectHandle::GetIndex(object);
+	if (sparse_.size() <= index) {
+		return kInvalidSlot;
+	}
+	const uint32_t slot = sparse_[index];
+	// generationが異なる古いIDは無効扱い
+	if (slot == kInvalidSlot || indexToObject_[slot] != object) {
+		return kInvalidSlot;
+	}
+	return slot;
 }
\ No newline at end of file
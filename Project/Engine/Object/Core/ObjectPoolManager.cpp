@@ -12,6 +12,7 @@
 #include <Engine/Object/Data/ObjectTag.h>
 #include <Engine/Object/Data/Sprite.h>
 #include <Engine/Object/Data/MeshRender.h>
+#include <Engine/Object/Data/Skybox.h>
 
 //============================================================================
 //	ObjectPoolManager classMethods
@@ -19,12 +20,49 @@
 
 uint32_t ObjectPoolManager::Create() {
 
-	return alive_.empty() ? next_++ : PopAlive();
+	uint32_t index = alive_.empty() ? next_++ : PopAlive();
+	ASSERT(index < ObjectHandle::kIndexMask, "ObjectHandle index exceeded");
+
+	if (entries_.size() <= index) {
+		entries_.resize(index + 1);
+	}
+	ObjectEntry& entry = entries_[index];
+	entry.alive = true;
+	entry.archetype.reset();
+
+	uint32_t object = ObjectHandle::Make(index, entry.generation);
+	if (DeferQueryUpdate(object)) {
+		return object;
+	}
+	// 空のマスクを持つクエリへ登録
+	for (const auto& query : queries_) {
+		if (query->mask.none()) {
+
+			query->Add(object);
+		}
+	}
+	return object;
+}
+
+bool ObjectPoolManager::IsAlive(uint32_t object) const {
+
+	const uint32_t index = ObjectHandle::GetIndex(object);
+	if (index == 0 || entries_.size() <= index) {
+		return false;
+	}
+	const ObjectEntry& entry = entries_[index];
+	return entry.alive && ObjectHandle::GetGeneration(object) == entry.generation;
 }
 
 void ObjectPoolManager::Destroy(uint32_t object) {
 
-	Archetype arch = objectToArch_[object];
+	// 破棄済み、または古いIDの場合は処理しない
+	if (!IsAlive(object)) {
+		return;
+	}
+
+	ObjectEntry& entry = entries_[ObjectHandle::GetIndex(object)];
+	const Archetype arch = entry.archetype;
 
 	// bitが立っている全タイプのpoolからRemove
 	for (size_t typeId = 0; typeId < kMaxDataTypes; ++typeId) {
@@ -37,29 +75,158 @@ void ObjectPoolManager::Destroy(uint32_t object) {
 		}
 	}
 
-	// archetypeテーブルから除去
-	if (auto it = objectToArch_.find(object); it != objectToArch_.end()) {
+	// 条件を満たしていたクエリから除去
+	if (!DeferQueryUpdate(object)) {
+		for (const auto& query : queries_) {
+			if ((arch & query->mask) == query->mask) {
+
+				query->Remove(object);
+			}
+		}
+	}
+
+	// generationを進めて再利用キューへ
+	entry.alive = false;
+	entry.archetype.reset();
+	entry.generation = (entry.generation + 1) & ObjectHandle::kGenerationMask;
+	alive_.push_back(ObjectHandle::GetIndex(object));
+}
+
+const std::vector<uint32_t>& ObjectPoolManager::View(const Archetype& mask) {
+
+	// 登録済みならそのまま返す
+	if (auto it = maskToQuery_.find(mask); it != maskToQuery_.end()) {
+		return queries_[it->second]->objects;
+	}
+
+	// 新規登録、既存の生存オブジェクトから構築する
+	auto query = std::make_unique<Query>();
+	query->mask = mask;
+	for (uint32_t index = 1; index < entries_.size(); ++index) {
+
+		const ObjectEntry& entry = entries_[index];
+		if (entry.alive && (entry.archetype & mask) == mask) {
+
+			query->Add(ObjectHandle::Make(index, entry.generation));
+		}
+	}
+
+	maskToQuery_.emplace(mask, queries_.size());
+	queries_.emplace_back(std::move(query));
+	return queries_.back()->objects;
+}
+
+void ObjectPoolManager::UpdateQueries(uint32_t object,
+	const Archetype& before, const Archetype& after) {
+
+	if (DeferQueryUpdate(object)) {
+		return;
+	}
+	for (const auto& query : queries_) {
+
+		const bool matchBefore = (before & query->mask) == query->mask;
+		const bool matchAfter = (after & query->mask) == query->mask;
+		if (matchBefore == matchAfter) {
+			continue;
+		}
+		if (matchAfter) {
+
+			query->Add(object);
+		} else {
+
+			query->Remove(object);
+		}
+	}
+}
+
+bool ObjectPoolManager::DeferQueryUpdate(uint32_t object) {
+
+	if (iterationDepth_ == 0) {
+		return false;
+	}
+
+	ObjectEntry& entry = entries_[ObjectHandle::GetIndex(object)];
+	if (!entry.isQueryPending) {
 
-		archToEntities_[it->second].erase(
-			std::remove(archToEntities_[it->second].begin(),
-				archToEntities_[it->second].end(), object),
-			archToEntities_[it->second].end());
-		objectToArch_.erase(it);
+		entry.isQueryPending = true;
+		pendingIndices_.push_back(ObjectHandle::GetIndex(object));
 	}
-	// 再利用キューへ
-	alive_.push_back(object);
+	return true;
 }
 
-std::vector<uint32_t> ObjectPoolManager::View(const Archetype& mask) const {
+void ObjectPoolManager::FlushPendingQueries() {
+
+	for (uint32_t index : pendingIndices_) {
+
+		ObjectEntry& entry = entries_[index];
+		entry.isQueryPending = false;
+
+		// 走査中に破棄と再利用が起きている場合もあるので現在の状態のみを見る
+		const uint32_t object = ObjectHandle::Make(index, entry.generation);
+		for (const auto& query : queries_) {
+
+			const bool match = entry.alive && (entry.archetype & query->mask) == query->mask;
+			const uint32_t registered = query->Find(index);
+			if (registered != ObjectHandle::kInvalid && (!match || registered != object)) {
 
-	std::vector<uint32_t> result;
-	for (auto& [arch, list] : archToEntities_) {
-		if ((arch & mask) == mask) {
+				query->Remove(registered);
+			}
+			if (match && query->Find(index) == ObjectHandle::kInvalid) {
 
-			result.insert(result.end(), list.begin(), list.end());
+				query->Add(object);
+			}
 		}
 	}
-	return result;
+	pendingIndices_.clear();
+}
+
+ObjectPoolManager::IterationScope::IterationScope(ObjectPoolManager& manager) :
+	manager_(manager) {
+
+	++manager_.iterationDepth_;
+}
+
+ObjectPoolManager::IterationScope::~IterationScope() {
+
+	// 最も外側のスコープで反映する
+	if (--manager_.iterationDepth_ == 0) {
+
+		manager_.FlushPendingQueries();
+	}
+}
+
+void ObjectPoolManager::Query::Add(uint32_t object) {
+
+	const uint32_t index = ObjectHandle::GetIndex(object);
+	if (positions.size() <= index) {
+		positions.resize(index + 1, ObjectHandle::kInvalid);
+	}
+	positions[index] = static_cast<uint32_t>(objects.size());
+	objects.push_back(object);
+}
+
+uint32_t ObjectPoolManager::Query::Find(uint32_t index) const {
+
+	if (positions.size() <= index || positions[index] == ObjectHandle::kInvalid) {
+		return ObjectHandle::kInvalid;
+	}
+	return objects[positions[index]];
+}
+
+void ObjectPoolManager::Query::Remove(uint32_t object) {
+
+	const uint32_t index = ObjectHandle::GetIndex(object);
+	if (positions.size() <= index || positions[index] == ObjectHandle::kInvalid) {
+		return;
+	}
+
+	// 末尾と入れ替えて詰める
+	const uint32_t position = positions[index];
+	const uint32_t last = objects.back();
+	objects[position] = last;
+	positions[ObjectHandle::GetIndex(last)] = position;
+	objects.pop_back();
+	positions[index] = ObjectHandle::kInvalid;
 }
 
 void ObjectPoolManager::ImGui() {
@@ -82,17 +249,20 @@ void ObjectPoolManager::SetBit(uint32_t object, bool enable) {
 
 	size_t id = GetTypeID<T>();
 
-	Archetype& arch = objectToArch_[object];
-	Archetype  old = arch;
+	// 破棄済み、または古いIDの場合は処理しない
+	if (!IsAlive(object)) {
+		return;
+	}
 
+	Archetype& arch = entries_[ObjectHandle::GetIndex(object)].archetype;
+	const Archetype old = arch;
 	arch.set(id, enable);
 
-	// 旧リスト削除
-	auto& oldList = archToEntities_[old];
-	oldList.erase(std::remove(oldList.begin(), oldList.end(), object), oldList.end());
-
-	// 新リスト追加
-	archToEntities_[arch].push_back(object);
+	// 変化がなければクエリの更新は不要
+	if (arch == old) {
+		return;
+	}
+	UpdateQueries(object, old, arch);
 }
 
 // 各dataを明示的にインスタンス化
@@ -107,6 +277,21 @@ template void ObjectPoolManager::SetBit<class Skybox>(uint32_t, bool);
 template void ObjectPoolManager::SetBit<class MeshRender>(uint32_t, bool);
 template void ObjectPoolManager::SetBit<struct ObjectTag>(uint32_t, bool);
 
+void ObjectPoolManager::CreatePools() {
+
+	// データ型のプールを全て生成しておき、並列更新中にpools_が変化しないようにする
+	GetPool<Transform3D>();
+	GetPool<EffectTransform>();
+	GetPool<Transform2D>();
+	GetPool<Material, true>();
+	GetPool<SpriteMaterial>();
+	GetPool<SkinnedAnimation>();
+	GetPool<Sprite>();
+	GetPool<Skybox>();
+	GetPool<MeshRender>();
+	GetPool<ObjectTag>();
+}
+
 uint32_t ObjectPoolManager::PopAlive() {
 
 	uint32_t object = alive_.back(); alive_.pop_back(); return object;
@@ -6,6 +6,9 @@
 #include <Engine/Object/Core/ObjectPool.h>
 #include <Engine/Editor/Base/IGameEditor.h>
 
+// c++
+#include <unordered_map>
+
 //============================================================================
 //	ObjectPoolManager class
 //	各型のObjectPoolとアーキタイプを統括し、追加/削除/参照とデバッグを提供する。
@@ -17,15 +20,20 @@ public:
 	//	public Methods
 	//========================================================================
 
-	ObjectPoolManager() :IGameEditor("ObjectPoolManager") {};
+	ObjectPoolManager() :IGameEditor("ObjectPoolManager") { CreatePools(); };
 	~ObjectPoolManager() = default;
 
-	// 新規オブジェクトIDを発行する(再利用キュー優先)
+	// 新規オブジェクトIDを発行する(再利用キュー優先、generationを付与)
 	uint32_t Create();
 	// 指定オブジェクトを破棄し、関連データとアーキタイプを更新する
 	void Destroy(uint32_t object);
 
+	// IDが現在も生存しているか(古いgenerationならfalse)
+	bool IsAlive(uint32_t object) const;
+
 	// 型Tのプールを取得する(未生成なら生成して返す)
+	// システムは並列にGetDataを呼ぶので、IterationScope内での生成は禁止
+	// 使用するデータ型のプールはCreatePoolsで事前に生成しておく
 	template<class T, bool Flag = false>
 	ObjectPool<T, Flag>& GetPool();
 
@@ -36,8 +44,29 @@ public:
 	template<class T, bool Flag = false>
 	void RemoveData(uint32_t object);
 
-	// マスクを満たすアーキタイプのオブジェクト一覧を返す
-	std::vector<uint32_t> View(const Archetype& mask) const;
+	// マスクを満たすオブジェクト一覧を返す
+	// 初回呼び出しでクエリを登録し、以降は追加/削除時に差分更新される
+	// 返す参照は生きた一覧なので、走査中に構造を変更する場合はIterationScopeで囲むこと
+	const std::vector<uint32_t>& View(const Archetype& mask);
+
+	//--------- structure ----------------------------------------------------
+
+	// 生存中はView()の一覧を固定する、メインスレッドからのみ使用する
+	// スコープ内のCreate/Destroy/AddData/RemoveDataはプールへ即時反映されるが、
+	// 一覧への反映は最も外側のスコープを抜ける時にまとめて行う。
+	// そのため走査中に破棄したオブジェクトも一覧に残り、GetDataはnullptrを返す
+	class IterationScope {
+	public:
+
+		explicit IterationScope(ObjectPoolManager& manager);
+		~IterationScope();
+
+		IterationScope(const IterationScope&) = delete;
+		IterationScope& operator=(const IterationScope&) = delete;
+	private:
+
+		ObjectPoolManager& manager_;
+	};
 
 	// 登録済みプールをimguiでデバッグ表示する
 	void ImGui() override;
@@ -56,15 +85,53 @@ private:
 	//	private Methods
 	//========================================================================
 
-	//--------- variables ----------------------------------------------------
+	//--------- structure ----------------------------------------------------
 
-	std::unordered_map<uint32_t, Archetype> objectToArch_;
-	std::unordered_map<Archetype, std::vector<uint32_t>> archToEntities_;
+	// indexごとのオブジェクト情報
+	struct ObjectEntry {
+
+		uint32_t generation = 0; // 現在のgeneration
+		bool alive = false;      // 生存中か
+		bool isQueryPending = false; // クエリへの反映待ちか
+		Archetype archetype{};   // 所持しているデータのビット
+	};
+
+	// シグネチャごとのオブジェクト一覧
+	struct Query {
+
+		Archetype mask{};
+		// 条件を満たすオブジェクト(dense)
+		std::vector<uint32_t> objects;
+		// objectIndex -> objectsの位置
+		std::vector<uint32_t> positions;
+
+		// オブジェクトを末尾に追加する
+		void Add(uint32_t object);
+		// indexに登録されているオブジェクト、なければkInvalid
+		uint32_t Find(uint32_t index) const;
+		// swap-and-popでオブジェクトを取り除く
+		void Remove(uint32_t object);
+	};
+
+	//--------- variables ----------------------------------------------------
 
 	std::vector<std::shared_ptr<IObjectPool>> pools_;
 
+	// 0番は未使用
 	uint32_t next_ = 1;
+	// 破棄されたindexの再利用キュー
 	std::vector<uint32_t> alive_;
+	// index -> オブジェクト情報
+	std::vector<ObjectEntry> entries_;
+
+	// 登録済みクエリ
+	std::vector<std::unique_ptr<Query>> queries_;
+	std::unordered_map<Archetype, size_t> maskToQuery_;
+
+	// IterationScopeの入れ子数
+	uint32_t iterationDepth_ = 0;
+	// 走査中に変化があり、クエリへの反映を待っているindex
+	std::vector<uint32_t> pendingIndices_;
 
 	inline static std::atomic_size_t typeCounter_ = 0;
 
@@ -79,11 +146,20 @@ private:
 
 	//--------- functions ----------------------------------------------------
 
-	// 内部: アーキタイプのビット更新とエンティティリストの再構成を行う
+	// 内部: アーキタイプのビット更新と各クエリの差分更新を行う
 	template<class T>
 	void SetBit(uint32_t object, bool enable);
+	// 内部: アーキタイプの変化に応じて各クエリへ出入りさせる
+	void UpdateQueries(uint32_t object, const Archetype& before, const Archetype& after);
+	// 内部: 走査中なら反映待ちに積んでtrueを返す
+	bool DeferQueryUpdate(uint32_t object);
+	// 内部: 反映待ちのindexを現在の状態に合わせて各クエリへ反映する
+	void FlushPendingQueries();
 
-	// 内部: 再利用キューからIDを取り出す
+	// 内部: 全てのデータ型のプールを生成する
+	void CreatePools();
+
+	// 内部: 再利用キューからindexを取り出す
 	uint32_t PopAlive();
 };
 
@@ -95,6 +171,9 @@ inline ObjectPool<T, Flag>& ObjectPoolManager::GetPool() {
 		pools_.resize(id + 1);
 	}
 	if (!pools_[id]) {
+
+		// 走査中はワーカーからも参照されるので配列を変更できない
+		ASSERT(iterationDepth_ == 0, "ObjectPool created inside IterationScope, register it in CreatePools");
 		pools_[id] = std::make_shared<ObjectPool<T, Flag>>();
 	}
 	return *static_cast<ObjectPool<T, Flag>*>(pools_[id].get());
@@ -4,6 +4,7 @@
 //	include
 //============================================================================
 #include <Engine/Asset/Asset.h>
+#include <Engine/Asset/AnimationCompression.h>
 #include <Engine/Core/Graphics/Renderer/LineRenderer.h>
 #include <Engine/Utility/Timer/GameTimer.h>
 #include <Engine/Utility/Json/JsonAdapter.h>
@@ -29,29 +30,29 @@ void SkinnedAnimation::Init(const std::string& animationName, Asset* asset) {
 	transitionDuration_ = 0.4f;
 	currentAnimationName_ = animationName;
 
-	// 骨の情報とクラスターを渡す
+	// 骨の情報とクラスターは共有データを参照する
 	skeleton_ = asset_->GetSkeletonData(Algorithm::RemoveAfterUnderscore(currentAnimationName_));
 	skinCluster_ = asset_->GetSkinClusterData(Algorithm::RemoveAfterUnderscore(currentAnimationName_));
-	animationData_[currentAnimationName_] = asset_->GetAnimationData(currentAnimationName_);
+	RegisterClip(currentAnimationName_);
 
-	// 使用するjointを記録
-	std::vector<const NodeAnimation*>& tracks = jointAnimationTracks_[currentAnimationName_];
-	tracks.assign(skeleton_.joints.size(), nullptr);
-	for (const Joint& j : skeleton_.joints) {
-		// jointIndexで値を設定
-		auto it = animationData_[currentAnimationName_].nodeAnimations.find(j.name);
-		if (it != animationData_[currentAnimationName_].nodeAnimations.end()) {
+	// インスタンスごとの姿勢をバインドポーズで初期化
+	const size_t jointCount = skeleton_->joints.size();
+	jointTransforms_.resize(jointCount);
+	for (size_t i = 0; i < jointCount; ++i) {
 
-			tracks[j.index] = &it->second;
-		}
+		jointTransforms_[i] = skeleton_->joints[i].transform;
 	}
+	skeletonSpaceMatrices_.assign(jointCount, Matrix4x4::MakeIdentity4x4());
+	isParentJoints_.assign(jointCount, 0);
+	skinMatrices_.resize(jointCount);
+	palette_.resize(jointCount);
 
 	// 子の値を設定
-	children_.assign(skeleton_.joints.size(), {});
-	for (size_t i = 0; i < skeleton_.joints.size(); ++i) {
-		if (skeleton_.joints[i].parent) {
+	children_.assign(jointCount, {});
+	for (size_t i = 0; i < jointCount; ++i) {
+		if (skeleton_->joints[i].parent) {
 
-			children_[*skeleton_.joints[i].parent].push_back(static_cast<int>(i));
+			children_[*skeleton_->joints[i].parent].push_back(static_cast<int>(i));
 		}
 	}
 
@@ -62,7 +63,7 @@ void SkinnedAnimation::Init(const std::string& animationName, Asset* asset) {
 void SkinnedAnimation::Update(const Matrix4x4& worldMatrix) {
 
 	// animationがなにも設定されていなければ何もしない
-	if (animationData_.empty()) {
+	if (clips_.empty()) {
 		return;
 	}
 
@@ -85,7 +86,7 @@ void SkinnedAnimation::Update(const Matrix4x4& worldMatrix) {
 			// ループ再生かしないか
 			if (roopAnimation_) {
 
-				float duration = animationData_[currentAnimationName_].duration;
+				float duration = GetAnimationDuration(currentAnimationName_);
 				if (currentTimer + deltaTime >= duration) {
 
 					// 再生カウントをインクリメント
@@ -96,22 +97,23 @@ void SkinnedAnimation::Update(const Matrix4x4& worldMatrix) {
 				currentTimer = std::fmod(currentTimer + deltaTime, duration);
 
 				// 進行度を計算
-				animationProgress_ = currentTimer / animationData_[currentAnimationName_].duration;
+				animationProgress_ = currentTimer / duration;
 			} else {
 				// 経過時間が最大にいくまで時間を進める
-				if (animationData_[currentAnimationName_].duration > currentTimer) {
+				float duration = GetAnimationDuration(currentAnimationName_);
+				if (duration > currentTimer) {
 
 					currentTimer += deltaTime;
 				}
 
 				// 経過時間に達したら終了させる
-				if (currentTimer >= animationData_[currentAnimationName_].duration) {
+				if (currentTimer >= duration) {
 
-					currentTimer = animationData_[currentAnimationName_].duration;
+					currentTimer = duration;
 					animationFinish_ = true;
 				}
 
-				animationProgress_ = currentTimer / animationData_[currentAnimationName_].duration;
+				animationProgress_ = currentTimer / duration;
 			}
 		}
 
@@ -136,9 +138,9 @@ void SkinnedAnimation::Update(const Matrix4x4& worldMatrix) {
 		}
 
 		// animationをblendしてjointの値を更新する
-		BlendAnimation(skeleton_,
-			animationData_[oldAnimationName_], oldAnimationTimer_,
-			animationData_[nextAnimationName_], nextAnimationTimer_, alpha);
+		BlendAnimation(
+			oldAnimationName_, oldAnimationTimer_,
+			nextAnimationName_, nextAnimationTimer_, alpha);
 		UpdateSkeleton(worldMatrix);
 
 		// bufferに渡す値を更新する
@@ -152,12 +154,6 @@ void SkinnedAnimation::Update(const Matrix4x4& worldMatrix) {
 			currentTimer = nextAnimationTimer_;
 		}
 	}
-
-#if defined(_DEBUG) || defined(_DEVELOPBUILD)
-
-	// 骨の描画
-	DebugDrawBone(worldMatrix);
-#endif
 }
 
 void SkinnedAnimation::ImGui(float itemSize) {
@@ -181,7 +177,7 @@ void SkinnedAnimation::ImGui(float itemSize) {
 		}
 		ImGui::Text("RepeatCount: %d", repeatCount_);
 		ImGui::DragFloat("playbackSpeed", &playbackSpeed_, 0.01f);
-		ImGui::Text("duration: %.3f", animationData_[currentAnimationName_].duration);
+		ImGui::Text("duration: %.3f", GetAnimationDuration(currentAnimationName_));
 		EnumAdapter<ObjectUpdateMode>::Combo("UpdateMode", &updateMode_);
 	}
 	ImGui::Separator();
@@ -189,7 +185,7 @@ void SkinnedAnimation::ImGui(float itemSize) {
 	if (ImGui::CollapsingHeader("Status", ImGuiTreeNodeFlags_DefaultOpen)) {
 
 		const float timer = currentAnimationTimers_[updateModeIndex_];
-		const float duration = animationData_[currentAnimationName_].duration;
+		const float duration = GetAnimationDuration(currentAnimationName_);
 		const float prog = timer / duration;
 		const float transProg = transitionDuration_ > 0.0f ? transitionTimer_ / transitionDuration_ : 0.0f;
 
@@ -205,7 +201,7 @@ void SkinnedAnimation::ImGui(float itemSize) {
 
 		static std::vector<const char*> animNames;
 		animNames.clear();
-		for (const auto& [name, _] : animationData_) {
+		for (const auto& [name, _] : clips_) {
 
 			animNames.push_back(name.c_str());
 		}
@@ -242,7 +238,7 @@ void SkinnedAnimation::ImGui(float itemSize) {
 		}
 
 		int currentFrame = CurrentFrameIndex();
-		int totalFrames = static_cast<int>(animationData_[currentAnimationName_].duration * 30.0f);
+		int totalFrames = static_cast<int>(GetAnimationDuration(currentAnimationName_) * 30.0f);
 
 		ImGui::Text("Key Timeline");
 		DrawEventTimeline(*framesPtr, currentFrame, totalFrames, itemSize * 2.0f, 10.0f);
@@ -253,118 +249,94 @@ void SkinnedAnimation::ImGui(float itemSize) {
 
 void SkinnedAnimation::ApplyAnimation(float timer) {
 
-	// index配列を用意
-	std::vector<size_t> indices(skeleton_.joints.size());
-	// 0からsize分までの連続した値を作成する
-	std::iota(indices.begin(), indices.end(), 0);
-	const auto& tracks = jointAnimationTracks_[currentAnimationName_];
-
-	// par_unseqで並列処理
-	std::for_each(std::execution::par_unseq, indices.begin(), indices.end(), [&](size_t i) {
+	const AnimationClip* clip = FindClip(currentAnimationName_);
+	if (!clip) {
+		return;
+	}
 
-		const NodeAnimation* track = tracks[i];
-		if (!track) {
-			return;
-		}
+	// jointは数十程度なので、インスタンス単位のジョブ内で順に処理する
+	std::vector<NodeAnimationCursor>& cursors = jointAnimationCursors_[currentAnimationName_];
+	for (size_t i = 0; i < jointTransforms_.size(); ++i) {
 
-		Joint& joint = skeleton_.joints[i];
-		joint.transform.translation = Vector3::CalculateValue(track->translate.keyframes, timer);
-		joint.transform.rotation = Quaternion::CalculateValue(track->rotate.keyframes, timer);
-		joint.transform.scale = Vector3::CalculateValue(track->scale.keyframes, timer);
-		});
+		Transform3D& transform = jointTransforms_[i];
+		SampleJoint(*clip, i, timer, cursors[i], transform.translation, transform.rotation, transform.scale);
+	}
 }
 
 void SkinnedAnimation::UpdateSkeleton(const Matrix4x4& worldMatrix) {
 
 	// 全てのJointを更新、親が若いので通常ループで処理可能
-	for (auto& joint : skeleton_.joints) {
+	const std::vector<Joint>& joints = skeleton_->joints;
+	for (size_t i = 0; i < joints.size(); ++i) {
 
-		joint.localMatrix =
-			Matrix4x4::MakeAxisAffineMatrix(joint.transform.scale, joint.transform.rotation, joint.transform.translation);
+		Transform3D& transform = jointTransforms_[i];
+		const Matrix4x4 localMatrix =
+			Matrix4x4::MakeAxisAffineMatrix(transform.scale, transform.rotation, transform.translation);
 		// 親がいれば親の行列を掛ける
-		if (joint.parent) {
+		if (joints[i].parent) {
 
-			joint.skeletonSpaceMatrix = joint.localMatrix * skeleton_.joints[*joint.parent].skeletonSpaceMatrix;
+			skeletonSpaceMatrices_[i] = localMatrix * skeletonSpaceMatrices_[*joints[i].parent];
 		}
 		// 親がいないのでlocalMatrixとSkeletonSpaceMatrixは一致する
 		else {
 
-			joint.skeletonSpaceMatrix = joint.localMatrix;
+			skeletonSpaceMatrices_[i] = localMatrix;
 		}
 
 		// 親なら行列を更新する
-		if (joint.isParentTransform) {
+		if (isParentJoints_[i]) {
 
-			joint.transform.SetIsDirty(true);
-			joint.transform.matrix.world = joint.skeletonSpaceMatrix * worldMatrix;
+			transform.SetIsDirty(true);
+			transform.matrix.world = skeletonSpaceMatrices_[i] * worldMatrix;
 		}
 	}
 }
 
 void SkinnedAnimation::UpdateSkinCluster() {
 
-	for (size_t jointIndex = 0; jointIndex < skeleton_.joints.size(); ++jointIndex) {
+	assert(palette_.size() <= skinCluster_->inverseBindPoseMatrices.size());
 
-		assert(jointIndex < skinCluster_.inverseBindPoseMatrices.size());
+	// 連続した配列同士でまとめて掛けてから、GPUへ送る並びに移す
+	Matrix4x4::MultiplyArray(skinCluster_->inverseBindPoseMatrices.data(),
+		skeletonSpaceMatrices_.data(), skinMatrices_.data(), palette_.size());
+	for (size_t jointIndex = 0; jointIndex < palette_.size(); ++jointIndex) {
 
-		skinCluster_.mappedPalette[jointIndex].skeletonSpaceMatrix =
-			skinCluster_.inverseBindPoseMatrices[jointIndex] *
-			skeleton_.joints[jointIndex].skeletonSpaceMatrix;
-		skinCluster_.mappedPalette[jointIndex].skeletonSpaceInverseTransposeMatrix =
-			Matrix4x4::Transpose(Matrix4x4::Inverse(skinCluster_.mappedPalette[jointIndex].skeletonSpaceMatrix));
+		palette_[jointIndex].skeletonSpaceMatrix = skinMatrices_[jointIndex];
+		palette_[jointIndex].skeletonSpaceInverseTransposeMatrix =
+			Matrix4x4::InverseTranspose3x3(skinMatrices_[jointIndex]);
 	}
 }
 
-void SkinnedAnimation::BlendAnimation(Skeleton& skeleton, const AnimationData& oldAnimationData,
-	float oldAnimTime, const AnimationData& nextAnimationData, float nextAnimTime, float alpha) {
+void SkinnedAnimation::BlendAnimation(const std::string& oldAnimationName,
+	float oldAnimTime, const std::string& nextAnimationName, float nextAnimTime, float alpha) {
 
-	// すべてのJointを対象
-	for (size_t jointIndex = 0; jointIndex < skeleton.joints.size(); ++jointIndex) {
+	// クリップとカーソルはjointのループ外で1度だけ引く
+	const AnimationClip* oldClip = FindClip(oldAnimationName);
+	const AnimationClip* nextClip = FindClip(nextAnimationName);
+	std::vector<NodeAnimationCursor>* oldCursors = oldClip ? &jointAnimationCursors_[oldAnimationName] : nullptr;
+	std::vector<NodeAnimationCursor>* nextCursors = nextClip ? &jointAnimationCursors_[nextAnimationName] : nullptr;
 
-		auto& jointOld = skeleton.joints[jointIndex];
+	// すべてのJointを対象
+	for (size_t jointIndex = 0; jointIndex < jointTransforms_.size(); ++jointIndex) {
 
-		const std::string& nodeName = jointOld.name;
+		Transform3D& transform = jointTransforms_[jointIndex];
 
 		// old の transform
 		Vector3 posOld = Vector3(0.0f, 0.0f, 0.0f);
 		Quaternion rotOld = Quaternion::Identity();
 		Vector3 sclOld = Vector3(1.0f, 1.0f, 1.0f);
-		if (auto itOld = oldAnimationData.nodeAnimations.find(nodeName); itOld != oldAnimationData.nodeAnimations.end()) {
-
-			const auto& rootNodeAnimation = itOld->second;
-			if (!rootNodeAnimation.translate.keyframes.empty()) {
-
-				posOld = Vector3::CalculateValue(rootNodeAnimation.translate.keyframes, oldAnimTime);
-			}
-			if (!rootNodeAnimation.rotate.keyframes.empty()) {
-
-				rotOld = Quaternion::CalculateValue(rootNodeAnimation.rotate.keyframes, oldAnimTime);
-			}
-			if (!rootNodeAnimation.scale.keyframes.empty()) {
+		if (oldClip) {
 
-				sclOld = Vector3::CalculateValue(rootNodeAnimation.scale.keyframes, oldAnimTime);
-			}
+			SampleJoint(*oldClip, jointIndex, oldAnimTime, (*oldCursors)[jointIndex], posOld, rotOld, sclOld);
 		}
 
 		// next の transform
 		Vector3 posNext = Vector3(0.0f, 0.0f, 0.0f);
 		Quaternion rotNext = Quaternion::Identity();
 		Vector3 sclNext = Vector3(1.0f, 1.0f, 1.0f);
-		if (auto itNext = nextAnimationData.nodeAnimations.find(nodeName); itNext != nextAnimationData.nodeAnimations.end()) {
-			const auto& rootNodeAnimation = itNext->second;
-
-			if (!rootNodeAnimation.translate.keyframes.empty()) {
-
-				posNext = Vector3::CalculateValue(rootNodeAnimation.translate.keyframes, nextAnimTime);
-			}
-			if (!rootNodeAnimation.rotate.keyframes.empty()) {
-
-				rotNext = Quaternion::CalculateValue(rootNodeAnimation.rotate.keyframes, nextAnimTime);
-			}
-			if (!rootNodeAnimation.scale.keyframes.empty()) {
+		if (nextClip) {
 
-				sclNext = Vector3::CalculateValue(rootNodeAnimation.scale.keyframes, nextAnimTime);
-			}
+			SampleJoint(*nextClip, jointIndex, nextAnimTime, (*nextCursors)[jointIndex], posNext, rotNext, sclNext);
 		}
 
 		// αブレンド
@@ -372,9 +344,38 @@ void SkinnedAnimation::BlendAnimation(Skeleton& skeleton, const AnimationData& o
 		Quaternion rotBlend = Quaternion::Slerp(rotOld, rotNext, alpha);
 		Vector3 sclBlend = Vector3::Lerp(sclOld, sclNext, alpha);
 
-		jointOld.transform.translation = posBlend;
-		jointOld.transform.rotation = rotBlend;
-		jointOld.transform.scale = sclBlend;
+		transform.translation = posBlend;
+		transform.rotation = rotBlend;
+		transform.scale = sclBlend;
+	}
+}
+
+void SkinnedAnimation::SampleJoint(const AnimationClip& clip, size_t jointIndex, float time,
+	NodeAnimationCursor& cursor, Vector3& outTranslation, Quaternion& outRotation, Vector3& outScale) const {
+
+	// 圧縮済みクリップ
+	if (const CompressedNodeAnimation* compressed = clip.FindCompressedChannel(jointIndex)) {
+
+		AnimationCompression::SampleNode(*compressed, clip.sampleRate, time, cursor,
+			outTranslation, outRotation, outScale);
+		return;
+	}
+
+	const NodeAnimation* track = clip.FindChannel(jointIndex);
+	if (!track) {
+		return;
+	}
+	if (!track->translate.Empty()) {
+
+		outTranslation = AnimationSampler::Sample(track->translate, time, cursor.translate);
+	}
+	if (!track->rotate.Empty()) {
+
+		outRotation = AnimationSampler::Sample(track->rotate, time, cursor.rotate);
+	}
+	if (!track->scale.Empty()) {
+
+		outScale = AnimationSampler::Sample(track->scale, time, cursor.scale);
 	}
 }
 
@@ -439,16 +440,16 @@ void SkinnedAnimation::DebugDrawBone(const Matrix4x4& worldMatrix) {
 	LineRenderer* lineRenderer = LineRenderer::GetInstance();
 
 	// jointの描画
-	std::vector<Vector3> worldPos(skeleton_.joints.size());
-	for (size_t i = 0; i < skeleton_.joints.size(); ++i) {
+	std::vector<Vector3> worldPos(skeletonSpaceMatrices_.size());
+	for (size_t i = 0; i < skeletonSpaceMatrices_.size(); ++i) {
 
 		worldPos[i] = Vector3::Transform(Vector3::AnyInit(0.0f),
-			skeleton_.joints[i].skeletonSpaceMatrix * worldMatrix);
+			skeletonSpaceMatrices_[i] * worldMatrix);
 		lineRenderer->DrawSphere(kDivision, 0.32f, worldPos[i], Color::Green(), LineType::DepthIgnore);
 	}
 
 	// 親から子に向けて描画
-	for (size_t parent = 0; parent < skeleton_.joints.size(); ++parent) {
+	for (size_t parent = 0; parent < children_.size(); ++parent) {
 		for (int children : children_[parent]) {
 
 			Vector3 base = worldPos[parent];  // 親
@@ -477,23 +478,24 @@ void SkinnedAnimation::DebugDrawBone(const Matrix4x4& worldMatrix) {
 void SkinnedAnimation::SetAnimationData(const std::string& animationName) {
 
 	// 登録済みの場合は処理しない
-	if (Algorithm::Find(animationData_, animationName)) {
+	if (Algorithm::Find(clips_, animationName)) {
 		return;
 	}
 
-	animationData_[animationName] = asset_->GetAnimationData(animationName);
+	RegisterClip(animationName);
+}
 
-	// 使用するjointを記録
-	std::vector<const NodeAnimation*>& tracks = jointAnimationTracks_[animationName];
-	tracks.assign(skeleton_.joints.size(), nullptr);
-	for (const Joint& j : skeleton_.joints) {
-		// jointIndexで値を設定
-		auto it = animationData_[animationName].nodeAnimations.find(j.name);
-		if (it != animationData_[animationName].nodeAnimations.end()) {
+void SkinnedAnimation::RegisterClip(const std::string& animationName) {
 
-			tracks[j.index] = &it->second;
-		}
-	}
+	// クリップは共有し、カーソルのみインスタンスごとに持つ
+	clips_[animationName] = asset_->GetAnimationClip(animationName);
+	jointAnimationCursors_[animationName].assign(skeleton_->joints.size(), NodeAnimationCursor{});
+}
+
+const AnimationClip* SkinnedAnimation::FindClip(const std::string& animationName) const {
+
+	auto it = clips_.find(animationName);
+	return it == clips_.end() ? nullptr : it->second.get();
 }
 
 void SkinnedAnimation::SetKeyframeEvent(const std::string& fileName) {
@@ -579,13 +581,11 @@ void SkinnedAnimation::SwitchAnimation(const std::string& nextAnimName,
 
 void SkinnedAnimation::SetParentJoint(const std::string& jointName) {
 
-	for (auto& joint : skeleton_.joints) {
-		if (joint.name == jointName) {
+	auto it = skeleton_->jointMap.find(jointName);
+	if (it != skeleton_->jointMap.end()) {
 
-			// 親として更新させる
-			joint.isParentTransform = true;
-			return;
-		}
+		// 親として更新させる
+		isParentJoints_[it->second] = 1;
 	}
 }
 
@@ -627,8 +627,8 @@ bool SkinnedAnimation::IsEventKey(const std::string& keyEvent, uint32_t frameInd
 float SkinnedAnimation::GetAnimationDuration(const std::string& animationName) const {
 
 	// animationの再生時間を取得
-	float duration = animationData_.at(animationName).duration;
-	return duration;
+	const AnimationClip* clip = FindClip(animationName);
+	return clip ? clip->duration : 0.0f;
 }
 
 float SkinnedAnimation::GetEventTime(const std::string& animName,
@@ -661,14 +661,14 @@ void SkinnedAnimation::SetCurrentAnimTime(float time) {
 
 	// 進行度を計算
 	animationProgress_ = currentAnimationTimers_[updateModeIndex_] /
-		animationData_[currentAnimationName_].duration;
+		GetAnimationDuration(currentAnimationName_);
 }
 
 std::vector<std::string> SkinnedAnimation::GetAnimationNames() const {
 
 	std::vector<std::string> names;
-	names.reserve(animationData_.size());
-	for (const auto& data : animationData_) {
+	names.reserve(clips_.size());
+	for (const auto& data : clips_) {
 
 		names.push_back(data.first);
 	}
@@ -678,6 +678,12 @@ std::vector<std::string> SkinnedAnimation::GetAnimationNames() const {
 
 const Transform3D* SkinnedAnimation::FindJointTransform(const std::string& name) const {
 
-	auto it = skeleton_.jointMap.find(name);
-	return (it == skeleton_.jointMap.end()) ? nullptr : &skeleton_.joints[it->second].transform;
+	auto it = skeleton_->jointMap.find(name);
+	return (it == skeleton_->jointMap.end()) ? nullptr : &jointTransforms_[it->second];
+}
+
+const Matrix4x4* SkinnedAnimation::FindJointSkeletonSpaceMatrix(const std::string& name) const {
+
+	auto it = skeleton_->jointMap.find(name);
+	return (it == skeleton_->jointMap.end()) ? nullptr : &skeletonSpaceMatrices_[it->second];
 }
\ No newline at end of file
@@ -4,10 +4,11 @@
 //	include
 //============================================================================
 #include <Engine/Asset/AssetStructure.h>
+#include <Engine/Asset/AnimationSampler.h>
 #include <Engine/Utility/Enum/ObjectUpdateMode.h>
 
 // c++
-#include <execution>
+#include <memory>
 #include <ranges> 
 
 // front 
@@ -28,6 +29,7 @@ public:
 
 	void Init(const std::string& animationName, Asset* asset);
 
+	// 姿勢とパレットの更新。インスタンス間で共有する書き込みは無いので並列に呼べる
 	void Update(const Matrix4x4& worldMatrix);
 
 	void ImGui(float itemSize);
@@ -93,6 +95,8 @@ public:
 
 	// 親となるトランスフォームを取得
 	const Transform3D* FindJointTransform(const std::string& name) const;
+	// jointのskeletonSpaceでの変換行列を取得
+	const Matrix4x4* FindJointSkeletonSpaceMatrix(const std::string& name) const;
 
 	//========================================================================
 	//	デバッグ
@@ -100,13 +104,16 @@ public:
 
 	// 骨のデバッグ表示
 	void SetDebugViewBone(bool enable) { isDisplayBone_ = enable; }
+	// 骨の線描画、LineRendererはスレッドセーフでないので並列更新の外から呼ぶ
+	void DebugDrawBone(const Matrix4x4& worldMatrix);
 
 	//========================================================================
 	//	バッファデータ
 	//========================================================================
 	
-	const std::vector<WellForGPU>& GetWellForGPU() const { return skinCluster_.mappedPalette; }
-	const Skeleton& GetSkeleton() const { return skeleton_; }
+	const std::vector<WellForGPU>& GetWellForGPU() const { return palette_; }
+	// 共有されている骨構造(姿勢はインスタンスごとに持つ)
+	const Skeleton& GetSkeleton() const { return *skeleton_; }
 private:
 	//========================================================================
 	//	private Methods
@@ -120,12 +127,19 @@ private:
 	ObjectUpdateMode updateMode_ = ObjectUpdateMode::None;
 	uint32_t updateModeIndex_ = static_cast<uint32_t>(updateMode_);
 
-	// アニメーションはstringで名前ごとに保存して使うようにする
-	std::unordered_map<std::string, AnimationData> animationData_;
-	// 使用するジョイントをstd::stringで名前ごとに記録
-	std::unordered_map<std::string, std::vector<const NodeAnimation*>> jointAnimationTracks_;
-	Skeleton skeleton_;
-	SkinCluster skinCluster_;
+	// 全インスタンスで共有する不変データ、アニメーションは名前ごとに参照する
+	std::unordered_map<std::string, std::shared_ptr<const AnimationClip>> clips_;
+	std::shared_ptr<const Skeleton> skeleton_;
+	std::shared_ptr<const SkinCluster> skinCluster_;
+
+	// インスタンスごとの再生状態と姿勢
+	// jointごとのキーフレーム探索カーソル、アニメーションの名前ごとに記録
+	std::unordered_map<std::string, std::vector<NodeAnimationCursor>> jointAnimationCursors_;
+	std::vector<Transform3D> jointTransforms_;     // jointごとのSRT
+	std::vector<Matrix4x4> skeletonSpaceMatrices_; // skeletonSpaceでの変換行列
+	std::vector<uint8_t> isParentJoints_;          // 親として更新するjoint
+	std::vector<Matrix4x4> skinMatrices_;          // MultiplyArrayの出力先、paletteへ移す
+	std::vector<WellForGPU> palette_;              // インスタンシングに送るデータ
 
 	// キーフレームイベント
 	std::unordered_map<std::string, std::unordered_map<std::string, std::vector<int>>> eventKeyTables_;
@@ -166,13 +180,19 @@ private:
 	void UpdateSkinCluster();
 
 	// blend処理
-	void BlendAnimation(Skeleton& skeleton,
-		const AnimationData& oldAnimationData, float oldAnimTime,
-		const AnimationData& nextAnimationData, float nextAnimTime, float alpha);
+	void BlendAnimation(
+		const std::string& oldAnimationName, float oldAnimTime,
+		const std::string& nextAnimationName, float nextAnimTime, float alpha);
+	// クリップのjointのSRTを求める。トラックが無ければ出力を変更しない
+	void SampleJoint(const AnimationClip& clip, size_t jointIndex, float time,
+		NodeAnimationCursor& cursor, Vector3& outTranslation, Quaternion& outRotation, Vector3& outScale) const;
+
+	// 共有クリップを参照し、カーソルを用意する
+	void RegisterClip(const std::string& animationName);
+	const AnimationClip* FindClip(const std::string& animationName) const;
 
 	// helper
 	int CurrentFrameIndex() const;
 	void DrawEventTimeline(const std::vector<int>& frames, int currentFrame,
 		int totalFrames, float barWidth, float barHeight);
-	void DebugDrawBone(const Matrix4x4& worldMatrix);
 };
\ No newline at end of file
@@ -23,6 +23,14 @@ public:
 
 	// タイプシグネチャ取得
 	virtual Archetype Signature() const = 0;
+
+	// 読み込むデータ型(スケジューラの依存関係構築に使用、デフォルトはSignature)
+	virtual Archetype ReadAccess() const { return Signature(); }
+	// 書き込むデータ型(スケジューラの依存関係構築に使用、デフォルトはSignature)
+	virtual Archetype WriteAccess() const { return Signature(); }
 	// タイプシグネチャでフィルタリングされたオブジェクトの更新
 	virtual void Update(ObjectPoolManager& ObjectPoolManager) = 0;
+	// 全段階の更新後に呼び出し側のスレッドで登録順に呼ばれる
+	// スレッドセーフでない処理(デバッグ描画など)はここで行う
+	virtual void PostUpdate([[maybe_unused]] ObjectPoolManager& ObjectPoolManager) {}
 };
\ No newline at end of file
@@ -3,27 +3,135 @@
 //============================================================================
 //	include
 //============================================================================
+#include <Engine/Core/Thread/JobSystem.h>
+#include <Engine/Object/Core/ObjectPoolManager.h>
 #include <Engine/Object/System/Systems/InstancedMeshSystem.h>
+#include <Engine/Utility/Helper/Algorithm.h>
+
+// c++
+#include <chrono>
 
 //============================================================================
 //	SystemManager classMethods
 //============================================================================
 
-void SystemManager::UpdateData(ObjectPoolManager& ObjectPoolManager) {
+void SystemManager::BuildSchedule() {
+
+	stages_.clear();
 
-	// 各systemを更新
-	for (const auto& [type, system] : systems_) {
+	// 登録順に、競合する先行システムより後の段階へ配置する
+	std::vector<std::pair<ISystem*, size_t>> placed;
+	for (const auto& type : order_) {
 
 		// bufferの転送処理は別で行う
 		if (type == std::type_index(typeid(InstancedMeshSystem))) {
 			continue;
 		}
-		system->Update(ObjectPoolManager);
+
+		ISystem* system = systems_.at(type).get();
+		const Archetype read = system->ReadAccess();
+		const Archetype write = system->WriteAccess();
+
+		size_t stage = 0;
+		for (const auto& [other, otherStage] : placed) {
+
+			const Archetype otherRead = other->ReadAccess();
+			const Archetype otherWrite = other->WriteAccess();
+			// 書き込みが相手の読み書きと重なれば依存
+			const bool conflict = (write & (otherRead | otherWrite)).any() ||
+				(otherWrite & read).any();
+			if (conflict) {
+
+				stage = (std::max)(stage, otherStage + 1);
+			}
+		}
+		if (stages_.size() <= stage) {
+			stages_.resize(stage + 1);
+		}
+
+		std::string name = typeid(*system).name();
+		name = Algorithm::RemoveSubstring(name, "class ");
+		stages_[stage].push_back(ScheduledSystem{ system, name, 0.0f });
+		placed.emplace_back(system, stage);
+	}
+	isScheduleDirty_ = false;
+}
+
+void SystemManager::UpdateData(ObjectPoolManager& ObjectPoolManager) {
+
+	if (isScheduleDirty_) {
+
+		BuildSchedule();
+	}
+
+	// クエリの登録はプールの構造を変更するので並列実行前に済ませておく
+	for (auto& stage : stages_) {
+		for (auto& scheduled : stage) {
+
+			ObjectPoolManager.View(scheduled.system->Signature());
+		}
+	}
+
+	// 全段階の実行中はクエリの一覧を固定する
+	ObjectPoolManager::IterationScope iterationScope(ObjectPoolManager);
+
+	JobSystem* jobSystem = JobSystem::GetInstance();
+	for (auto& stage : stages_) {
+		if (stage.empty()) {
+			continue;
+		}
+
+		// 同じ段階のシステムは並列実行、最後の1つは呼び出し側で処理する
+		JobCounter counter{};
+		for (size_t i = 0; i + 1 < stage.size(); ++i) {
+
+			ScheduledSystem* scheduled = &stage[i];
+			jobSystem->Submit([this, scheduled, &ObjectPoolManager]() {
+				RunSystem(*scheduled, ObjectPoolManager); }, &counter);
+		}
+		RunSystem(stage.back(), ObjectPoolManager);
+
+		// 次の段階へ進む前に完了を待つ
+		jobSystem->Wait(counter);
+	}
+
+	// 並列に行えない後処理を登録順に行う
+	for (const auto& type : order_) {
+
+		systems_.at(type)->PostUpdate(ObjectPoolManager);
 	}
 }
 
 void SystemManager::UpdateBuffer(ObjectPoolManager& ObjectPoolManager) {
 
 	// buffer転送処理
+	ObjectPoolManager::IterationScope iterationScope(ObjectPoolManager);
 	this->GetSystem<InstancedMeshSystem>()->Update(ObjectPoolManager);
-}
\ No newline at end of file
+}
+
+void SystemManager::RunSystem(ScheduledSystem& scheduled, ObjectPoolManager& ObjectPoolManager) {
+
+	auto start = std::chrono::high_resolution_clock::now();
+
+	scheduled.system->Update(ObjectPoolManager);
+
+	std::chrono::duration<float, std::milli> elapsed = std::chrono::high_resolution_clock::now() - start;
+	// 値が跳ねないように平滑化する
+	constexpr float kSmoothing = 0.1f;
+	scheduled.smoothedMs += (elapsed.count() - scheduled.smoothedMs) * kSmoothing;
+}
+
+void SystemManager::ImGui() {
+
+	ImGui::SeparatorText("Systems");
+	ImGui::Text("workers: %u", JobSystem::GetInstance()->GetWorkerCount());
+
+	for (size_t stage = 0; stage < stages_.size(); ++stage) {
+
+		ImGui::Text("stage %zu", stage);
+		for (const auto& scheduled : stages_[stage]) {
+
+			ImGui::Text("  %-24s %.3f ms", scheduled.name.c_str(), scheduled.smoothedMs);
+		}
+	}
+}
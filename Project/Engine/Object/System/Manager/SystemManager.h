@@ -9,10 +9,12 @@
 #include <unordered_map>
 #include <algorithm>
 #include <ranges>
+#include <string>
 
 //============================================================================
 //	SystemManager class
 //	オブジェクトデータのシステムを管理するマネージャ
+//	宣言された読み書きデータ型から依存関係を構築し、独立したシステムを並列実行する
 //============================================================================
 class SystemManager {
 public:
@@ -33,6 +35,9 @@ public:
 	// 全てのシステムのバッファ更新
 	void UpdateBuffer(ObjectPoolManager& ObjectPoolManager);
 
+	// 実行段階とシステムごとの処理時間を表示する
+	void ImGui();
+
 	//--------- accessor -----------------------------------------------------
 
 	// システム取得
@@ -43,9 +48,32 @@ private:
 	//	private Methods
 	//========================================================================
 
+	//--------- structure ----------------------------------------------------
+
+	// スケジュールされたシステム
+	struct ScheduledSystem {
+
+		ISystem* system = nullptr;
+		std::string name;
+		float smoothedMs = 0.0f; // 処理時間(平滑化)
+	};
+
 	//--------- variables ----------------------------------------------------
 
 	std::unordered_map<std::type_index, std::unique_ptr<ISystem>> systems_;
+	// 登録順
+	std::vector<std::type_index> order_;
+
+	// 実行段階、同じ段階のシステムは互いに競合しない
+	std::vector<std::vector<ScheduledSystem>> stages_;
+	bool isScheduleDirty_ = true;
+
+	//--------- functions ----------------------------------------------------
+
+	// 登録順と読み書き宣言から実行段階を構築する
+	void BuildSchedule();
+	// 計測しながらシステムを更新する
+	void RunSystem(ScheduledSystem& scheduled, ObjectPoolManager& ObjectPoolManager);
 };
 
 template<class T, class ...Args>
@@ -54,7 +82,11 @@ inline void SystemManager::AddSystem(Args&& ...args) {
 	// system登録
 	const std::type_index key = typeid(T);
 	auto system = std::make_unique<T>(std::forward<Args>(args)...);
-	systems_.emplace(key, std::move(system));
+	if (systems_.emplace(key, std::move(system)).second) {
+
+		order_.emplace_back(key);
+		isScheduleDirty_ = true;
+	}
 }
 
 template<typename T>
@@ -65,4 +97,4 @@ inline T* SystemManager::GetSystem() const {
 		return static_cast<T*>(it->second.get());
 	}
 	return nullptr;
-}
\ No newline at end of file
+}
@@ -5,6 +5,7 @@
 //============================================================================
 #include <Engine/Object/Core/ObjectPoolManager.h>
 #include <Engine/Object/Data/SkinnedAnimation.h>
+#include <Engine/Core/Thread/JobSystem.h>
 
 //============================================================================
 //	AnimationSystem classMethods
@@ -17,12 +18,45 @@ Archetype AnimationSystem::Signature() const {
 	return arch;
 }
 
+Archetype AnimationSystem::ReadAccess() const {
+
+	// ワールド行列を参照する
+	Archetype arch = Signature();
+	arch.set(ObjectPoolManager::GetTypeID<Transform3D>());
+	return arch;
+}
+
+Archetype AnimationSystem::WriteAccess() const {
+
+	return Signature();
+}
+
 void AnimationSystem::Update(ObjectPoolManager& ObjectPoolManager) {
 
+	const std::vector<uint32_t>& objects = ObjectPoolManager.View(Signature());
+
+	// インスタンスをまとめて1ジョブとし、姿勢評価とパレット更新を並列に行う
+	JobSystem::GetInstance()->ParallelFor(static_cast<uint32_t>(objects.size()), kInstancesPerJob,
+		[&](uint32_t begin, uint32_t end) {
+			for (uint32_t i = begin; i < end; ++i) {
+
+				auto* animation = ObjectPoolManager.GetData<SkinnedAnimation>(objects[i]);
+				auto* transform = ObjectPoolManager.GetData<Transform3D>(objects[i]);
+				animation->Update(transform->matrix.world);
+			}
+		});
+}
+
+void AnimationSystem::PostUpdate([[maybe_unused]] ObjectPoolManager& ObjectPoolManager) {
+
+#if defined(_DEBUG) || defined(_DEVELOPBUILD)
+
+	// 骨の描画はLineRendererに積むので、並列更新の後に呼び出し側のスレッドで行う
 	for (uint32_t object : ObjectPoolManager.View(Signature())) {
 
 		auto* animation = ObjectPoolManager.GetData<SkinnedAnimation>(object);
 		auto* transform = ObjectPoolManager.GetData<Transform3D>(object);
-		animation->Update(transform->matrix.world);
+		animation->DebugDrawBone(transform->matrix.world);
 	}
+#endif
 }
\ No newline at end of file
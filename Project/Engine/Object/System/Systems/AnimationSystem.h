@@ -20,6 +20,19 @@ public:
 	~AnimationSystem() = default;
 
 	Archetype Signature() const override;
+	Archetype ReadAccess() const override;
+	Archetype WriteAccess() const override;
 
 	void Update(ObjectPoolManager& ObjectPoolManager) override;
+	// 骨のデバッグ描画
+	void PostUpdate(ObjectPoolManager& ObjectPoolManager) override;
+private:
+	//========================================================================
+	//	private Methods
+	//========================================================================
+
+	//--------- variables ----------------------------------------------------
+
+	// 1ジョブで処理するインスタンス数
+	static constexpr uint32_t kInstancesPerJob = 4;
 };
\ No newline at end of file
@@ -31,39 +31,9 @@ InstancedMeshSystem::~InstancedMeshSystem() {
 	StopBuildWorker();
 }
 
-void InstancedMeshSystem::StartBuildWorker() {
-
-	buildWorker_.Start([this](MeshBuildJob&& job) {
-
-		LOG_SCOPE_MS_LABEL(job.name);
-
-		// ジョブ開始
-		runningJobs_.fetch_add(1, std::memory_order_relaxed);
-		// キュー分を減算
-		pendingJobs_.fetch_sub(1, std::memory_order_relaxed);
-		if (job.skinned) {
-
-			// 骨ありメッシュ
-			meshRegistry_->RegisterMesh(job.name, true, job.maxInstance);
-			std::scoped_lock lock(instancedMutex_);
-			instancedBuffer_->Create(meshRegistry_->GetMeshes().at(job.name).get(),
-				job.name, job.maxInstance);
-		} else {
-
-			// 静的メッシュ
-			meshRegistry_->RegisterMesh(job.name, false, job.maxInstance);
-			std::scoped_lock lock(instancedMutex_);
-			instancedBuffer_->Create(meshRegistry_->GetMeshes().at(job.name).get(),
-				job.name, job.maxInstance);
-		}
-		// ジョブ終了
-		runningJobs_.fetch_sub(1, std::memory_order_relaxed);
-		});
-}
-
 void InstancedMeshSystem::StopBuildWorker() {
 
-	buildWorker_.Stop();
+	asset_->GetLoadScheduler()->CancelPending(AssetJobType::Mesh);
 }
 
 void InstancedMeshSystem::RequestBuild(const std::string& modelName,
@@ -74,20 +44,67 @@ void InstancedMeshSystem::RequestBuild(const std::string& modelName,
 		return;
 	}
 
-	// 骨があるか判定
-	const bool skinned = !asset_->GetModelData(modelName).skinClusterData.empty();
-	const uint32_t maxInstatnce = skinned ? maxInstSkinned : maxInstStatic;
+	// 依存先のモデルは投入済みでないと待てないので、先に読み込みを要求しておく
+	const AssetLoadHandle model = asset_->RequestModelAsync(modelName, AssetLoadPriority::Current);
 
-	auto& queue = buildWorker_.RefAsyncQueue();
-	if (queue.IsClearCondition([&](const MeshBuildJob& j) { return j.name == modelName; })) {
+	// 骨の有無はモデルの読み込み後に判定する
+	const bool isSubmitted = asset_->GetLoadScheduler()->Submit({ AssetJobType::Mesh, modelName },
+		AssetLoadPriority::Current, { model.GetKey() },
+		[this, modelName, maxInstStatic, maxInstSkinned]() {
+			this->BuildMesh(modelName, maxInstStatic, maxInstSkinned); });
+	if (!isSubmitted) {
 		return;
 	}
-	// 処理キューの追加
-	queue.AddQueue(MeshBuildJob{ modelName, skinned, maxInstatnce });
 	requested_.insert(modelName);
 	pendingJobs_.fetch_add(1, std::memory_order_relaxed);
 }
 
+void InstancedMeshSystem::BuildMesh(const std::string& modelName,
+	uint32_t maxInstStatic, uint32_t maxInstSkinned) {
+
+	LOG_SCOPE_MS_LABEL(modelName);
+
+	// ジョブ開始
+	runningJobs_.fetch_add(1, std::memory_order_relaxed);
+	// キュー分を減算
+	pendingJobs_.fetch_sub(1, std::memory_order_relaxed);
+
+	// モデルが見つからなかった場合は作成しない
+	if (!asset_->SearchModel(modelName)) {
+
+		SpdLogger::Log("[Mesh][MissingModel] " + modelName);
+		runningJobs_.fetch_sub(1, std::memory_order_relaxed);
+		return;
+	}
+
+	// 骨の有無で最大数を変える
+	const bool skinned = !asset_->GetModelData(modelName).skinClusterData.empty();
+	const uint32_t maxInstance = skinned ? maxInstSkinned : maxInstStatic;
+
+	// 描画中のマップは変更せず、作成したものはメインスレッドで登録する
+	// 登録されるまでは実行中として数える
+	std::unique_ptr<IMesh> mesh = meshRegistry_->CreateMesh(modelName, skinned, maxInstance);
+	std::scoped_lock lock(builtMutex_);
+	builtMeshes_.push_back({ modelName, std::move(mesh), maxInstance });
+}
+
+void InstancedMeshSystem::PublishBuiltMeshes() {
+
+	std::vector<BuiltMesh> builtMeshes;
+	{
+		std::scoped_lock lock(builtMutex_);
+		builtMeshes.swap(builtMeshes_);
+	}
+	for (auto& built : builtMeshes) {
+
+		meshRegistry_->AddMesh(built.modelName, std::move(built.mesh));
+		instancedBuffer_->Create(meshRegistry_->GetMesh(built.modelName), built.modelName, built.maxInstance);
+
+		// ジョブ終了
+		runningJobs_.fetch_sub(1, std::memory_order_relaxed);
+	}
+}
+
 void InstancedMeshSystem::BuildForSceneSynch(Scene scene) {
 
 	// 読み込み済みのモデルを取得
@@ -123,8 +140,7 @@ void InstancedMeshSystem::RequestBuildForScene(Scene scene) {
 bool InstancedMeshSystem::IsReady(const std::string& name) const {
 
 	// メッシュ作成済みかどうか
-	const auto& meshes = meshRegistry_->GetMeshes();
-	if (!meshes.contains(name)) {
+	if (!meshRegistry_->Contains(name)) {
 		return false;
 	}
 	// バッファ作成済みかどうか
@@ -139,7 +155,10 @@ bool InstancedMeshSystem::IsBuilding() const {
 		runningJobs_.load(std::memory_order_relaxed));
 }
 
-float InstancedMeshSystem::GetBuildProgressForScene(Scene scene) const {
+float InstancedMeshSystem::GetBuildProgressForScene(Scene scene) {
+
+	// メッシュを描画しない遷移中はUpdateが呼ばれないので、ここでも登録する
+	PublishBuiltMeshes();
 
 	const auto& modelNames = asset_->GetPreloadModels(scene);
 	if (modelNames.empty()) {
@@ -190,6 +209,9 @@ Archetype InstancedMeshSystem::Signature() const {
 
 void InstancedMeshSystem::Update(ObjectPoolManager& ObjectPoolManager) {
 
+	// 作成し終えたメッシュを登録する
+	PublishBuiltMeshes();
+
 	// bufferクリア
 	instancedBuffer_->Reset();
 	objectIDsPerModel_.clear();
@@ -3,7 +3,6 @@
 //============================================================================
 //	include
 //============================================================================
-#include <Engine/Asset/Async/AssetLoadWorker.h>
 #include <Engine/Object/System/Base/ISystem.h>
 #include <Engine/Object/Data/MeshRender.h>
 #include <Engine/Core/Graphics/Mesh/MeshRegistry.h>
@@ -37,11 +36,10 @@ public:
 		Asset* asset, DxCommand* dxCommand);
 	~InstancedMeshSystem();
 
-	// 非同期処理
-	void StartBuildWorker();
+	// 非同期処理、未実行のビルド要求を破棄し実行中のものを待つ
 	void StopBuildWorker();
 
-	// メッシュのビルド要求
+	// メッシュのビルド要求、モデルの読み込みが終わってから共有の読み込みスケジューラで実行される
 	void RequestBuild(const std::string& modelName,
 		uint32_t maxInstStatic = Config::kMaxInstanceNum,
 		uint32_t maxInstSkinned = 16);
@@ -63,25 +61,20 @@ public:
 	const std::unordered_map<std::string, MeshRender>& GetRenderData() const { return renderData_; }
 	std::vector<RayTracingInstance> CollectRTInstances(const RaytracingScene* scene) const;
 
+	// ワーカーで作成し終えたメッシュを登録する、メインスレッドから呼び出す
+	void PublishBuiltMeshes();
+
 	// ビルド状況の取得
+	// 登録はPublishBuiltMeshesでのみ行うので、メインスレッドから参照する限りロックは不要
 	bool IsReady(const std::string& name) const;
 	bool IsBuilding() const;
-	// シーンのビルド進捗取得
-	float GetBuildProgressForScene(Scene scene) const;
+	// シーンのビルド進捗取得、取得前に作成済みのメッシュを登録する
+	float GetBuildProgressForScene(Scene scene);
 private:
 	//========================================================================
 	//	private Methods
 	//========================================================================
 
-	//--------- structure ----------------------------------------------------
-
-	struct MeshBuildJob {
-
-		std::string name;     // 名前
-		bool skinned;         // 骨の有無
-		uint32_t maxInstance; // 最大数
-	};
-
 	//--------- variables ----------------------------------------------------
 
 	ID3D12Device* device_;
@@ -95,12 +88,29 @@ private:
 	std::unordered_map<std::string, std::vector<uint32_t>> objectIDsPerModel_;
 	std::unordered_map<std::string, MeshRender> renderData_;
 
-	AssetLoadWorker<MeshBuildJob> buildWorker_;
+	//--------- structure ----------------------------------------------------
+
+	// ワーカーで作成し、登録待ちのメッシュ
+	struct BuiltMesh {
+
+		std::string modelName;
+		std::unique_ptr<IMesh> mesh;
+		uint32_t maxInstance;
+	};
+
 	// 重複処理回避用
-	std::mutex instancedMutex_;
 	std::unordered_set<std::string> requested_;
 
+	// 登録待ちのメッシュ、ワーカーから積まれる
+	std::mutex builtMutex_;
+	std::vector<BuiltMesh> builtMeshes_;
+
 	// 進捗カウンタ
 	std::atomic<uint32_t> pendingJobs_{};
 	std::atomic<uint32_t> runningJobs_{};
+
+	//--------- functions ----------------------------------------------------
+
+	// ビルドジョブ本体、骨の有無に応じた最大数でメッシュとバッファを作成する
+	void BuildMesh(const std::string& modelName, uint32_t maxInstStatic, uint32_t maxInstSkinned);
 };
\ No newline at end of file
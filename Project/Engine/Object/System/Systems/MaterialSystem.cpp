@@ -5,6 +5,13 @@
 //============================================================================
 #include <Engine/Asset/Asset.h>
 #include <Engine/Object/Core/ObjectPoolManager.h>
+#include <Engine/Core/Thread/JobSystem.h>
+
+namespace {
+
+	// 1ジョブで処理するオブジェクト数
+	constexpr uint32_t kUpdateChunkSize = 128;
+}
 
 //============================================================================
 //	MaterialSystem classMethods
@@ -50,14 +57,19 @@ Archetype MaterialSystem::Signature() const {
 
 void MaterialSystem::Update(ObjectPoolManager& ObjectPoolManager) {
 
-	for (uint32_t object : ObjectPoolManager.View(Signature())) {
+	// オブジェクト単位で独立しているので分割して並列処理する
+	const auto& view = ObjectPoolManager.View(Signature());
+	JobSystem::GetInstance()->ParallelFor(static_cast<uint32_t>(view.size()), kUpdateChunkSize,
+		[&](uint32_t begin, uint32_t end) {
+			for (uint32_t i = begin; i < end; ++i) {
 
-		auto* materials = ObjectPoolManager.GetData<Material, true>(object);
-		for (auto& material : *materials) {
+				auto* materials = ObjectPoolManager.GetData<Material, true>(view[i]);
+				for (auto& material : *materials) {
 
-			material.UpdateUVTransform();
-		}
-	}
+					material.UpdateUVTransform();
+				}
+			}
+		});
 }
 
 //============================================================================
@@ -73,9 +85,13 @@ Archetype SpriteMaterialSystem::Signature() const {
 
 void SpriteMaterialSystem::Update(ObjectPoolManager& ObjectPoolManager) {
 
-	for (uint32_t object : ObjectPoolManager.View(Signature())) {
+	const auto& view = ObjectPoolManager.View(Signature());
+	JobSystem::GetInstance()->ParallelFor(static_cast<uint32_t>(view.size()), kUpdateChunkSize,
+		[&](uint32_t begin, uint32_t end) {
+			for (uint32_t i = begin; i < end; ++i) {
 
-		auto* material = ObjectPoolManager.GetData<SpriteMaterial>(object);
-		material->UpdateUVTransform();
-	}
+				auto* material = ObjectPoolManager.GetData<SpriteMaterial>(view[i]);
+				material->UpdateUVTransform();
+			}
+		});
 }
\ No newline at end of file
@@ -20,6 +20,19 @@ Archetype SpriteBufferSystem::Signature() const {
 	return arch;
 }
 
+Archetype SpriteBufferSystem::ReadAccess() const {
+
+	return Signature();
+}
+
+Archetype SpriteBufferSystem::WriteAccess() const {
+
+	// 頂点を更新するのはspriteのみ
+	Archetype arch{};
+	arch.set(ObjectPoolManager::GetTypeID<Sprite>());
+	return arch;
+}
+
 void SpriteBufferSystem::Update(ObjectPoolManager& ObjectPoolManager) {
 
 	// データクリア
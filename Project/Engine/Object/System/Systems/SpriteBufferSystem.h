@@ -36,6 +36,8 @@ public:
 	~SpriteBufferSystem() = default;
 
 	Archetype Signature() const override;
+	Archetype ReadAccess() const override;
+	Archetype WriteAccess() const override;
 
 	void Update(ObjectPoolManager& ObjectPoolManager) override;
 
@@ -17,6 +17,17 @@ Archetype TagSystem::Signature() const {
 	return arch;
 }
 
+Archetype TagSystem::ReadAccess() const {
+
+	return Signature();
+}
+
+Archetype TagSystem::WriteAccess() const {
+
+	// タグは参照のみ
+	return Archetype{};
+}
+
 void TagSystem::Update(ObjectPoolManager& ObjectPoolManager) {
 
 	const auto& entities = ObjectPoolManager.View(Signature());
@@ -29,7 +40,7 @@ void TagSystem::Update(ObjectPoolManager& ObjectPoolManager) {
 	groups_.clear();
 	idToTag_.clear();
 
-	for (uint32_t object : ObjectPoolManager.View(Signature())) {
+	for (uint32_t object : entities) {
 
 		auto* tag = ObjectPoolManager.GetData<ObjectTag>(object);
 		idToTag_[object] = tag;
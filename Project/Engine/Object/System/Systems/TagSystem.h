@@ -25,6 +25,8 @@ public:
 	~TagSystem() = default;
 
 	Archetype Signature() const override;
+	Archetype ReadAccess() const override;
+	Archetype WriteAccess() const override;
 
 	void Update(ObjectPoolManager& ObjectPoolManager) override;
 
@@ -5,6 +5,19 @@
 //============================================================================
 #include <Engine/Object/Core/ObjectPoolManager.h>
 #include <Engine/Object/Data/Transform.h>
+#include <Engine/Object/Data/SkinnedAnimation.h>
+#include <Engine/Core/Thread/JobSystem.h>
+
+// c++
+#include <unordered_map>
+
+namespace {
+
+	// 親を持たない
+	constexpr uint32_t kNoParent = 0xffffffff;
+	// 1ジョブで処理する部分木の数
+	constexpr uint32_t kSubTreeChunkSize = 64;
+}
 
 //============================================================================
 //	TransformSystem3D classMethods
@@ -19,11 +32,175 @@ Archetype Transform3DSystem::Signature() const {
 
 void Transform3DSystem::Update(ObjectPoolManager& ObjectPoolManager) {
 
-	for (uint32_t object : ObjectPoolManager.View(Signature())) {
+	// 親子関係が変わったときのみ更新順を作り直す
+	const auto& view = ObjectPoolManager.View(Signature());
+	if (IsHierarchyChanged(ObjectPoolManager, view)) {
 
-		auto* transform = ObjectPoolManager.GetData<Transform3D>(object);
-		transform->UpdateMatrix();
+		BuildOrder();
+	}
+
+	UpdateSubTrees(subTrees_);
+}
+
+void Transform3DSystem::UpdateAttached() {
+
+	UpdateSubTrees(attachedSubTrees_);
+}
+
+void Transform3DSystem::UpdateSubTrees(const std::vector<SubTree>& subTrees) {
+
+	// 部分木の中は親→子の順なので、親のdirtyは必ず子より先に確定する
+	// 部分木同士は独立しているので並列に処理する
+	JobSystem::GetInstance()->ParallelFor(static_cast<uint32_t>(subTrees.size()), kSubTreeChunkSize,
+		[&](uint32_t begin, uint32_t end) {
+			for (uint32_t tree = begin; tree < end; ++tree) {
+				for (uint32_t i = subTrees[tree].begin; i < subTrees[tree].end; ++i) {
+
+					transforms_[order_[i]]->UpdateMatrix();
+				}
+			}
+		});
+}
+
+bool Transform3DSystem::IsHierarchyChanged(ObjectPoolManager& ObjectPoolManager,
+	const std::vector<uint32_t>& view) {
+
+	bool changed = transforms_.size() != view.size();
+	transforms_.resize(view.size(), nullptr);
+	cachedParents_.resize(view.size(), nullptr);
+
+	// 途中で抜けずにキャッシュを最新にする
+	for (size_t i = 0; i < view.size(); ++i) {
+
+		Transform3D* transform = ObjectPoolManager.GetData<Transform3D>(view[i]);
+		if (transforms_[i] != transform || cachedParents_[i] != transform->parent) {
+
+			transforms_[i] = transform;
+			cachedParents_[i] = transform->parent;
+			changed = true;
+		}
 	}
+	return changed;
+}
+
+void Transform3DSystem::BuildOrder() {
+
+	const uint32_t count = static_cast<uint32_t>(transforms_.size());
+
+	// transform -> index
+	std::unordered_map<const BaseTransform*, uint32_t> indexMap;
+	indexMap.reserve(count);
+	for (uint32_t i = 0; i < count; ++i) {
+
+		indexMap.emplace(transforms_[i], i);
+	}
+
+	// 親のindexと子の数を求める
+	// プール外の親(カメラなど)はルートとして扱う
+	parentIndices_.assign(count, kNoParent);
+	childOffsets_.assign(count + 1, 0);
+	for (uint32_t i = 0; i < count; ++i) {
+
+		if (!cachedParents_[i]) {
+			continue;
+		}
+		if (auto it = indexMap.find(cachedParents_[i]); it != indexMap.end() && it->second != i) {
+
+			parentIndices_[i] = it->second;
+			++childOffsets_[it->second + 1];
+		}
+	}
+	for (uint32_t i = 0; i < count; ++i) {
+
+		childOffsets_[i + 1] += childOffsets_[i];
+	}
+
+	// 子の一覧を詰める
+	children_.resize(childOffsets_[count]);
+	stack_.assign(childOffsets_.begin(), childOffsets_.end() - 1);
+	for (uint32_t i = 0; i < count; ++i) {
+		if (parentIndices_[i] != kNoParent) {
+
+			children_[stack_[parentIndices_[i]]++] = i;
+		}
+	}
+
+	// ルートごとに前順で並べる
+	order_.clear();
+	subTrees_.clear();
+	attachedSubTrees_.clear();
+	std::vector<bool> visited(count, false);
+	for (uint32_t root = 0; root < count; ++root) {
+		if (parentIndices_[root] != kNoParent) {
+			continue;
+		}
+
+		const uint32_t begin = static_cast<uint32_t>(order_.size());
+		stack_.clear();
+		stack_.push_back(root);
+		while (!stack_.empty()) {
+
+			uint32_t node = stack_.back();
+			stack_.pop_back();
+			visited[node] = true;
+			order_.push_back(node);
+			for (uint32_t c = childOffsets_[node + 1]; c > childOffsets_[node]; --c) {
+
+				stack_.push_back(children_[c - 1]);
+			}
+		}
+		// プール外の親を持つなら親の書き込み後に回す
+		std::vector<SubTree>& target = cachedParents_[root] ? attachedSubTrees_ : subTrees_;
+		target.push_back(SubTree{ begin, static_cast<uint32_t>(order_.size()) });
+	}
+
+	// 循環している親子関係はルートに辿り着かないので、最後にまとめて処理する
+	if (order_.size() < count) {
+
+		const uint32_t begin = static_cast<uint32_t>(order_.size());
+		for (uint32_t i = 0; i < count; ++i) {
+			if (!visited[i]) {
+
+				order_.push_back(i);
+			}
+		}
+		subTrees_.push_back(SubTree{ begin, static_cast<uint32_t>(order_.size()) });
+	}
+}
+
+//============================================================================
+//	Transform3DAttachmentSystem classMethods
+//============================================================================
+
+Transform3DAttachmentSystem::Transform3DAttachmentSystem(Transform3DSystem* transformSystem) {
+
+	transformSystem_ = nullptr;
+	transformSystem_ = transformSystem;
+}
+
+Archetype Transform3DAttachmentSystem::Signature() const {
+
+	Archetype arch{};
+	arch.set(ObjectPoolManager::GetTypeID<Transform3D>());
+	return arch;
+}
+
+Archetype Transform3DAttachmentSystem::ReadAccess() const {
+
+	// jointの行列を参照するので、AnimationSystemより後の段階に配置される
+	Archetype arch = Signature();
+	arch.set(ObjectPoolManager::GetTypeID<SkinnedAnimation>());
+	return arch;
+}
+
+Archetype Transform3DAttachmentSystem::WriteAccess() const {
+
+	return Signature();
+}
+
+void Transform3DAttachmentSystem::Update([[maybe_unused]] ObjectPoolManager& ObjectPoolManager) {
+
+	transformSystem_->UpdateAttached();
 }
 
 //============================================================================
@@ -5,9 +5,18 @@
 //============================================================================
 #include <Engine/Object/System/Base/ISystem.h>
 
+// c++
+#include <vector>
+#include <cstdint>
+// front
+class BaseTransform;
+class Transform3D;
+
 //============================================================================
 //	Transform3DSystem class
 //	3DTransformの更新システム
+//	親子関係を親→子の順(ルートごとの前順)に並べ、独立したルート単位で並列に更新する
+//	プール外の親(skeletonのjointなど)を持つ部分木はTransform3DAttachmentSystemで更新する
 //============================================================================
 class Transform3DSystem :
 	public ISystem {
@@ -22,6 +31,81 @@ public:
 	Archetype Signature() const override;
 
 	void Update(ObjectPoolManager& ObjectPoolManager) override;
+
+	// プール外の親を持つ部分木を更新する、更新順はUpdateで構築済みのものを使う
+	void UpdateAttached();
+private:
+	//========================================================================
+	//	private Methods
+	//========================================================================
+
+	//--------- structure ----------------------------------------------------
+
+	// ルート1つ分の部分木、order_内の範囲
+	struct SubTree {
+
+		uint32_t begin;
+		uint32_t end;
+	};
+
+	//--------- variables ----------------------------------------------------
+
+	// viewの並びでのtransformと、構築時の親
+	std::vector<Transform3D*> transforms_;
+	std::vector<const BaseTransform*> cachedParents_;
+
+	// 親→子の順に並べたtransformのindex
+	std::vector<uint32_t> order_;
+	std::vector<SubTree> subTrees_;
+	// プール外の親を持つ部分木
+	// 親は同じフレームに他のシステムが書き込むので、Updateでは処理しない
+	std::vector<SubTree> attachedSubTrees_;
+
+	// 構築用の作業領域
+	std::vector<uint32_t> parentIndices_;
+	std::vector<uint32_t> childOffsets_;
+	std::vector<uint32_t> children_;
+	std::vector<uint32_t> stack_;
+
+	//--------- functions ----------------------------------------------------
+
+	// transformと親の組が前回から変化しているか
+	bool IsHierarchyChanged(ObjectPoolManager& ObjectPoolManager, const std::vector<uint32_t>& view);
+	// 親子関係から更新順を構築する
+	void BuildOrder();
+	// 部分木を並列に更新する
+	void UpdateSubTrees(const std::vector<SubTree>& subTrees);
+};
+
+//============================================================================
+//	Transform3DAttachmentSystem class
+//	プール外のtransform(skeletonのjointなど)を親に持つ3DTransformの更新システム
+//	jointの行列はAnimationSystemが書き込むので、その後の段階で子を更新する
+//============================================================================
+class Transform3DAttachmentSystem :
+	public ISystem {
+public:
+	//========================================================================
+	//	public Methods
+	//========================================================================
+
+	Transform3DAttachmentSystem(Transform3DSystem* transformSystem);
+	~Transform3DAttachmentSystem() = default;
+
+	Archetype Signature() const override;
+	Archetype ReadAccess() const override;
+	Archetype WriteAccess() const override;
+
+	void Update(ObjectPoolManager& ObjectPoolManager) override;
+private:
+	//========================================================================
+	//	private Methods
+	//========================================================================
+
+	//--------- variables ----------------------------------------------------
+
+	// 更新順を共有する
+	Transform3DSystem* transformSystem_;
 };
 
 //============================================================================
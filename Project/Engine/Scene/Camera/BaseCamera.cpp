@@ -68,7 +68,7 @@ void BaseCamera::UpdateView(UpdateMode updateMode) {
 	// 行列更新
 	transform_.UpdateMatrix();
 
-	viewMatrix_ = Matrix4x4::Inverse(transform_.matrix.world);
+	viewMatrix_ = Matrix4x4::InverseAffine(transform_.matrix.world);
 	projectionMatrix_ =
 		Matrix4x4::MakePerspectiveFovMatrix(fovY_, aspectRatio_, nearClip_, farClip_);
 	viewProjectionMatrix_ = viewMatrix_ * projectionMatrix_;
@@ -155,7 +155,7 @@ void BaseCamera::RenderFrustum() {
 	fcBR *= frustumScale_;
 	fcBL *= frustumScale_;
 
-	Matrix4x4 cameraWorldMatrix = Matrix4x4::Inverse(viewMatrix_);
+	Matrix4x4 cameraWorldMatrix = Matrix4x4::InverseAffine(viewMatrix_);
 
 	// ワールド座標に変換
 	Vector3 wncTL = Vector3::Transform(ncTL, cameraWorldMatrix);
@@ -16,7 +16,7 @@ void Camera2D::Init() {
 
 	// 行列更新
 	transform_.UpdateMatrix();
-	viewMatrix_ = Matrix4x4::Inverse(transform_.matrix.world);
+	viewMatrix_ = Matrix4x4::InverseAffine(transform_.matrix.world);
 
 	projectionMatrix_ =
 		Matrix4x4::MakeOrthographicMatrix(0.0f, 0.0f, Config::kWindowWidthf,
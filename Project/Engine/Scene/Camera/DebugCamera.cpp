@@ -27,7 +27,7 @@ void DebugCamera::Init() {
 
 	// 行列更新
 	transform_.UpdateMatrix();
-	viewMatrix_ = Matrix4x4::Inverse(transform_.matrix.world);
+	viewMatrix_ = Matrix4x4::InverseAffine(transform_.matrix.world);
 
 	// アスペクト比
 	float aspectRatio = Config::kWindowWidthf / Config::kWindowHeightf;
@@ -54,7 +54,7 @@ void DebugCamera::Update() {
 	Matrix4x4 scaleMatrix = Matrix4x4::MakeScaleMatrix(Vector3::AnyInit(1.0f));
 	transform_.matrix.world = Matrix4x4::Multiply(scaleMatrix, rotateMatrix_);
 	transform_.matrix.world = Matrix4x4::Multiply(transform_.matrix.world, translateMatrix);
-	viewMatrix_ = Matrix4x4::Inverse(transform_.matrix.world);
+	viewMatrix_ = Matrix4x4::InverseAffine(transform_.matrix.world);
 
 	// アスペクト比
 	float aspectRatio = Config::kWindowWidthf / Config::kWindowHeightf;
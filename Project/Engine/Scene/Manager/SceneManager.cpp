@@ -6,6 +6,7 @@
 #include <Engine/Asset/Asset.h>
 #include <Engine/Editor/GameObject/ImGuiObjectEditor.h>
 #include <Engine/Editor/Camera/CameraEditor.h>
+#include <Engine/Effect/Particle/Core/ParticleManager.h>
 #include <Engine/Object/Core/ObjectManager.h>
 #include <Engine/Object/System/Systems/InstancedMeshSystem.h>
 #include <Engine/Utility/Enum/EnumAdapter.h>
@@ -32,6 +33,8 @@ SceneManager::SceneManager(Scene scene, Asset* asset, SceneView* sceneView) :IGa
 	// メッシュの構築
 	const auto& system = ObjectManager::GetInstance()->GetSystem<InstancedMeshSystem>();
 	system->BuildForSceneSynch(scene);
+	// シーンで使うパーティクルを作成しておく
+	WarmParticles(scene);
 	// 最初のシーン以外を非同期で読み込む
 	for (uint32_t index = 0; index < EnumAdapter<Scene>::GetEnumCount(); ++index) {
 
@@ -82,21 +85,23 @@ void SceneManager::SwitchScene() {
 	}
 
 	if (isSceneSwitching_) {
-		// アセットファイルの読み込みが終了したかどうか
-		if (asset_->IsScenePreloadFinished(nextSceneType_)) {
 
-			const auto& system = ObjectManager::GetInstance()->GetSystem<InstancedMeshSystem>();
-			// シーンに必要なメッシュ生成を依頼する
-			if (!queuedMeshBuild_) {
+		const auto& system = ObjectManager::GetInstance()->GetSystem<InstancedMeshSystem>();
+		if (!queuedMeshBuild_) {
 
-				system->RequestBuildForScene(nextSceneType_);
-				queuedMeshBuild_ = true;
-			}
-			// 終了したら遷移を終了させる
-			if (1.0f <= system->GetBuildProgressForScene(nextSceneType_)) {
+			// 先読み中の次のシーンの読み込みを優先させる
+			asset_->PrioritizeScene(nextSceneType_);
+			// シーンに必要なメッシュ生成を依頼する、各モデルの読み込みが終わり次第作成される
+			system->RequestBuildForScene(nextSceneType_);
+			// 次のシーンの初期化で使うパーティクルを遷移中に作成しておく
+			WarmParticles(nextSceneType_);
+			queuedMeshBuild_ = true;
+		}
+		// アセットファイルの読み込みとメッシュ生成が終了したら遷移を終了させる
+		if (asset_->IsScenePreloadFinished(nextSceneType_) &&
+			1.0f <= system->GetBuildProgressForScene(nextSceneType_)) {
 
-				sceneTransition_->NotifyAssetsFinished();
-			}
+			sceneTransition_->NotifyAssetsFinished();
 		}
 		// 遷移終了後
 		if (!needInitNextScene_ && sceneTransition_->ConsumeLoadEndFinished()) {
@@ -159,4 +164,14 @@ void SceneManager::LoadScene(Scene scene) {
 	ImGuiObjectEditor::GetInstance()->Reset();
 	// すべてのオブジェクトを破棄
 	ObjectManager::GetInstance()->DestroyAll();
+}
+
+void SceneManager::WarmParticles(Scene scene) {
+
+	// jsonの読み込み、モジュールとバッファの作成をシーンの初期化前に済ませる
+	ParticleManager* particleManager = ParticleManager::GetInstance();
+	for (const auto& [filePath, count] : asset_->GetPreloadParticles(scene)) {
+
+		particleManager->WarmParticleSystem(filePath, count);
+	}
 }
\ No newline at end of file
@@ -74,11 +74,13 @@ private:
 	bool needInitNextScene_;
 
 	// メッシュ制御
-	bool queuedMeshBuild_;
+	bool queuedMeshBuild_ = false;
 	bool allowMeshRendering_ = true;
 
 	//--------- functions ----------------------------------------------------
 
 	// シーン読み込み
 	void LoadScene(Scene scene);
+	// シーンで使うパーティクルシステムをプールに作成しておく
+	void WarmParticles(Scene scene);
 };
\ No newline at end of file
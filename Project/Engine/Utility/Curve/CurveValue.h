@@ -15,10 +15,13 @@
 #include <imgui_internal.h>
 // c++
 #include <vector>
+#include <algorithm>
+#include <cstdint>
 
 //============================================================================
 //	CurveValue class
 //	0.0f~1.0fの進捗に応じた値をカーブで補間して取得する
+//	カーブの値は制御点が変わった時に表へ焼き込み、取得時は表の隣り合う値を補間する
 //============================================================================
 template <typename T>
 class CurveValue {
@@ -32,6 +35,8 @@ public:
 
 	// 進捗(0.0f~1.0f)に応じた値の取得
 	T GetValue(float progress) const;
+	// count個の進捗をまとめて取得する
+	void GetValues(const float* progresses, T* out, uint32_t count) const;
 
 	// imgui
 	bool EditSelectCurve();
@@ -50,6 +55,10 @@ private:
 	// x1,y1,x2,y2
 	float bezier_[4]{};
 
+	// ベジェの媒介変数を等間隔に分けた時のyの値
+	static constexpr uint32_t kRemapSteps = 256;
+	float remapTable_[kRemapSteps + 1]{};
+
 	//--------- functions ----------------------------------------------------
 
 	// imgui
@@ -60,7 +69,10 @@ private:
 	// 値フィールドの編集
 	static bool EditValueField(const char* label, T& v);
 	static T EvalLinearChain(const std::vector<T>& keys, float t);
-	static float BezierValueScalar(float dt01, const float P[4]);
+	// 制御点から表を作り直す
+	void BakeRemapTable();
+	// 表から進捗に対応する値を補間して取得
+	float SampleRemap(float t) const;
 	template<int steps>
 	static void BezierTable(ImVec2 P[4], ImVec2 results[steps + 1]);
 	static bool ImGuiBezier(const char* label, float P[4]);
@@ -78,6 +90,7 @@ inline CurveValue<T>::CurveValue(const char* label) :label_(label) {
 	bezier_[1] = 0.575f;
 	bezier_[2] = 0.565f;
 	bezier_[3] = 1.000f;
+	BakeRemapTable();
 	// 2点初期化
 	keys_.resize(2);
 
@@ -97,11 +110,28 @@ inline T CurveValue<T>::GetValue(float progress) const {
 		return keys_.front();
 	}
 
-	float remapped = BezierValueScalar(t, bezier_);
+	float remapped = SampleRemap(t);
 	// N点対応
 	return EvalLinearChain(keys_, remapped);
 }
 
+template<typename T>
+inline void CurveValue<T>::GetValues(const float* progresses, T* out, uint32_t count) const {
+
+	if (keys_.size() <= 1) {
+
+		const T value = keys_.empty() ? T{} : keys_.front();
+		std::fill_n(out, count, value);
+		return;
+	}
+
+	for (uint32_t i = 0; i < count; ++i) {
+
+		const float remapped = SampleRemap(std::clamp(progresses[i], 0.0f, 1.0f));
+		out[i] = EvalLinearChain(keys_, remapped);
+	}
+}
+
 template<typename T>
 inline bool CurveValue<T>::EditSelectCurve() {
 
@@ -124,6 +154,10 @@ inline bool CurveValue<T>::ImGuiEditorUI() {
 	bool changed = false;
 	ImGui::SeparatorText(label_);
 	changed |= ImGuiBezier("##bezier", bezier_);
+	if (changed) {
+
+		BakeRemapTable();
+	}
 	return changed;
 }
 
@@ -203,14 +237,25 @@ inline T CurveValue<T>::EvalLinearChain(const std::vector<T>& keys, float t) {
 }
 
 template<typename T>
-inline float CurveValue<T>::BezierValueScalar(float dt01, const float P[4]) {
+inline void CurveValue<T>::BakeRemapTable() {
 
-	enum { STEPS = 256 };
-	ImVec2 Q[4] = { {0,0}, {P[0], P[1]}, {P[2], P[3]}, {1,1} };
-	ImVec2 results[STEPS + 1];
-	CurveValue::BezierTable<STEPS>(Q, results);
-	int idx = (int)((dt01 < 0 ? 0 : dt01 > 1 ? 1 : dt01) * STEPS);
-	return results[idx].y;
+	ImVec2 Q[4] = { {0,0}, {bezier_[0], bezier_[1]}, {bezier_[2], bezier_[3]}, {1,1} };
+	ImVec2 results[kRemapSteps + 1];
+	CurveValue::BezierTable<kRemapSteps>(Q, results);
+	for (uint32_t step = 0; step <= kRemapSteps; ++step) {
+
+		remapTable_[step] = results[step].y;
+	}
+}
+
+template<typename T>
+inline float CurveValue<T>::SampleRemap(float t) const {
+
+	// tは0.0f~1.0fに制限済み
+	const float position = t * static_cast<float>(kRemapSteps);
+	const uint32_t index = (std::min)(static_cast<uint32_t>(position), kRemapSteps - 1);
+	const float frac = position - static_cast<float>(index);
+	return remapTable_[index] + (remapTable_[index + 1] - remapTable_[index]) * frac;
 }
 
 template<typename T>
@@ -197,6 +197,61 @@ float EasedValue(EasingType easingType, float t) {
 	}
 }
 
+namespace {
+
+	// 関数をテンプレート引数で受け取り、ループ内で展開させる
+	template <float (*Func)(float)>
+	void EaseArray(const float* t, float* out, uint32_t count) {
+
+		for (uint32_t i = 0; i < count; ++i) {
+
+			out[i] = Func(t[i]);
+		}
+	}
+}
+
+void EasedValues(EasingType easingType, const float* t, float* out, uint32_t count) {
+
+	switch (easingType) {
+	case EasingType::EaseInSine: EaseArray<EaseInSine>(t, out, count); return;
+	case EasingType::EaseOutSine: EaseArray<EaseOutSine>(t, out, count); return;
+	case EasingType::EaseInOutSine: EaseArray<EaseInOutSine>(t, out, count); return;
+	case EasingType::EaseInQuad: EaseArray<EaseInQuad>(t, out, count); return;
+	case EasingType::EaseOutQuad: EaseArray<EaseOutQuad>(t, out, count); return;
+	case EasingType::EaseInOutQuad: EaseArray<EaseInOutQuad>(t, out, count); return;
+	case EasingType::EaseInCubic: EaseArray<EaseInCubic>(t, out, count); return;
+	case EasingType::EaseOutCubic: EaseArray<EaseOutCubic>(t, out, count); return;
+	case EasingType::EaseInOutCubic: EaseArray<EaseInOutCubic>(t, out, count); return;
+	case EasingType::EaseInQuart: EaseArray<EaseInQuart>(t, out, count); return;
+	case EasingType::EaseOutQuart: EaseArray<EaseOutQuart>(t, out, count); return;
+	case EasingType::EaseInOutQuart: EaseArray<EaseInOutQuart>(t, out, count); return;
+	case EasingType::EaseInQuint: EaseArray<EaseInQuint>(t, out, count); return;
+	case EasingType::EaseOutQuint: EaseArray<EaseOutQuint>(t, out, count); return;
+	case EasingType::EaseInOutQuint: EaseArray<EaseInOutQuint>(t, out, count); return;
+	case EasingType::EaseInExpo: EaseArray<EaseInExpo>(t, out, count); return;
+	case EasingType::EaseOutExpo: EaseArray<EaseOutExpo>(t, out, count); return;
+	case EasingType::EaseInOutExpo: EaseArray<EaseInOutExpo>(t, out, count); return;
+	case EasingType::EaseInCirc: EaseArray<EaseInCirc>(t, out, count); return;
+	case EasingType::EaseOutCirc: EaseArray<EaseOutCirc>(t, out, count); return;
+	case EasingType::EaseInOutCirc: EaseArray<EaseInOutCirc>(t, out, count); return;
+	case EasingType::EaseInBack: EaseArray<EaseInBack>(t, out, count); return;
+	case EasingType::EaseOutBack: EaseArray<EaseOutBack>(t, out, count); return;
+	case EasingType::EaseInBounce: EaseArray<EaseInBounce>(t, out, count); return;
+	case EasingType::EaseOutBounce: EaseArray<EaseOutBounce>(t, out, count); return;
+	case EasingType::EaseInOutBounce: EaseArray<EaseInOutBounce>(t, out, count); return;
+	default:
+
+		// Linear、未知の値はそのまま
+		if (out != t) {
+			for (uint32_t i = 0; i < count; ++i) {
+
+				out[i] = t[i];
+			}
+		}
+		return;
+	}
+}
+
 void Easing::SelectEasingType(EasingType& easingType, const std::string& lebel, float itemWidth) {
 
 	const char* easeInOptions[] = {
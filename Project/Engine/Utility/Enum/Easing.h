@@ -6,6 +6,7 @@
 
 // c++
 #include <cmath>
+#include <cstdint>
 #define _USE_MATH_DEFINES
 #include <math.h>
 #include <numbers>
@@ -81,6 +82,9 @@ enum class EasingType {
 };
 
 float EasedValue(EasingType easingType, float t);
+// count個のtをまとめて補間する。種類の分岐は呼び出しごとに1回だけ行う
+// outとtは同じ配列を渡してもよい
+void EasedValues(EasingType easingType, const float* t, float* out, uint32_t count);
 
 namespace Easing {
 
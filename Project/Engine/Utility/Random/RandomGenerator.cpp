@@ -20,3 +20,19 @@ Color RandomGenerator::Generate(const Color& min, const Color& max) {
 		Generate(min.b, max.b),
 		Generate(min.a, max.a) };
 }
+
+uint64_t RandomGenerator::MixSeed(uint64_t seed, uint64_t value) {
+
+	// splitmix64で混ぜる、近い値同士でも離れたseedになる
+	uint64_t z = seed ^ (value + 0x9E3779B97F4A7C15ull + (seed << 6) + (seed >> 2));
+	z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+	z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+	return z ^ (z >> 31);
+}
+
+std::mt19937& RandomGenerator::GetEngine() {
+
+	// スレッドごとに初回呼び出し時に作成する
+	thread_local std::mt19937 engine(std::random_device{}());
+	return engine;
+}
@@ -7,12 +7,14 @@
 #include <Engine/MathLib/Vector4.h>
 
 // c++
+#include <cstdint>
 #include <random>
 #include <type_traits>
 
 //============================================================================*/
 //	RandomGenerator class
 //	ランダム生成を行う、minがmaxより大きい場合は自動で入れ替える
+//	乱数列はスレッドごとに持つので、複数のスレッドから同時に呼び出せる
 //============================================================================*/
 class RandomGenerator {
 public:
@@ -27,6 +29,19 @@ public:
 	static Vector3 Generate(const Vector3& min, const Vector3& max);
 	// Color
 	static Color Generate(const Color& min, const Color& max);
+
+	// seedに値を混ぜて新しいseedを作る
+	static uint64_t MixSeed(uint64_t seed, uint64_t value);
+
+private:
+	//========================================================================*/
+	//	private Methods
+	//========================================================================*/
+
+	//--------- functions ----------------------------------------------------
+
+	// 呼び出したスレッドで使う乱数列
+	static std::mt19937& GetEngine();
 };
 
 template<typename T>
@@ -43,8 +58,7 @@ inline T RandomGenerator::Generate(T min, T max) {
 	}
 	static_assert(std::is_arithmetic<T>::value, "T must be an arithmetic type");
 
-	static std::random_device rd;
-	static std::mt19937 gen(rd());
+	std::mt19937& gen = GetEngine();
 
 	if constexpr (std::is_integral<T>::value) {
 
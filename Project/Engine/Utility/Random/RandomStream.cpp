@@ -0,0 +1,106 @@
+#include "RandomStream.h"
+
+//============================================================================*/
+//	include
+//============================================================================*/
+
+// c++
+#include <utility>
+
+//============================================================================*/
+//	RandomStream classMethods
+//============================================================================*/
+
+void RandomStream::Seed(uint64_t seed) {
+
+	seed_ = seed;
+
+	// splitmix64で状態を埋める、近いseed同士でも離れた状態になる
+	uint64_t x = seed;
+	for (uint32_t i = 0; i < 4; i += 2) {
+
+		x += 0x9E3779B97F4A7C15ull;
+		uint64_t z = x;
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+		z ^= (z >> 31);
+		state_[i] = static_cast<uint32_t>(z);
+		state_[i + 1] = static_cast<uint32_t>(z >> 32);
+	}
+
+	// 全て0だと同じ値しか出なくなる
+	if ((state_[0] | state_[1] | state_[2] | state_[3]) == 0) {
+		state_[0] = 1;
+	}
+}
+
+Vector3 RandomStream::Generate(const Vector3& min, const Vector3& max) {
+
+	// 評価順を固定するために1成分ずつ取り出す
+	const float x = Generate(min.x, max.x);
+	const float y = Generate(min.y, max.y);
+	const float z = Generate(min.z, max.z);
+	return Vector3(x, y, z);
+}
+
+Color RandomStream::Generate(const Color& min, const Color& max) {
+
+	const float r = Generate(min.r, max.r);
+	const float g = Generate(min.g, max.g);
+	const float b = Generate(min.b, max.b);
+	const float a = Generate(min.a, max.a);
+	return Color(r, g, b, a);
+}
+
+void RandomStream::FillFloat(float* out, uint32_t count, float min, float max) {
+
+	if (min > max) {
+		std::swap(min, max);
+	}
+
+	const float range = max - min;
+	for (uint32_t i = 0; i < count; ++i) {
+
+		out[i] = min + NextFloat01() * range;
+	}
+}
+
+void RandomStream::FillVector3(Vector3* out, uint32_t count, const Vector3& min, const Vector3& max) {
+
+	// 成分ごとの入れ替えと幅を先に求めておく
+	Vector3 low = min;
+	Vector3 high = max;
+	if (low.x > high.x) { std::swap(low.x, high.x); }
+	if (low.y > high.y) { std::swap(low.y, high.y); }
+	if (low.z > high.z) { std::swap(low.z, high.z); }
+	const Vector3 range = high - low;
+
+	for (uint32_t i = 0; i < count; ++i) {
+
+		out[i].x = low.x + NextFloat01() * range.x;
+		out[i].y = low.y + NextFloat01() * range.y;
+		out[i].z = low.z + NextFloat01() * range.z;
+	}
+}
+
+void RandomStream::FillColor(Color* out, uint32_t count, const Color& min, const Color& max) {
+
+	Color low = min;
+	Color high = max;
+	if (low.r > high.r) { std::swap(low.r, high.r); }
+	if (low.g > high.g) { std::swap(low.g, high.g); }
+	if (low.b > high.b) { std::swap(low.b, high.b); }
+	if (low.a > high.a) { std::swap(low.a, high.a); }
+	const float rangeR = high.r - low.r;
+	const float rangeG = high.g - low.g;
+	const float rangeB = high.b - low.b;
+	const float rangeA = high.a - low.a;
+
+	for (uint32_t i = 0; i < count; ++i) {
+
+		out[i].r = low.r + NextFloat01() * rangeR;
+		out[i].g = low.g + NextFloat01() * rangeG;
+		out[i].b = low.b + NextFloat01() * rangeB;
+		out[i].a = low.a + NextFloat01() * rangeA;
+	}
+}
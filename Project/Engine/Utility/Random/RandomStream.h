@@ -0,0 +1,112 @@
+#pragma once
+
+//============================================================================*/
+//	include
+//============================================================================*/
+#include <Engine/MathLib/Vector3.h>
+#include <Engine/MathLib/Vector4.h>
+
+// c++
+#include <cstdint>
+#include <type_traits>
+
+//============================================================================*/
+//	RandomStream class
+//	状態を自分で持つ軽量な乱数列(xoshiro128+)
+//	同じseedなら環境やスレッドに関係なく同じ値を返す。エミッターごとに持たせて使う
+//	minがmaxより大きい場合は自動で入れ替える
+//============================================================================*/
+class RandomStream {
+public:
+	//========================================================================*/
+	//	public Methods
+	//========================================================================*/
+
+	RandomStream() { Seed(0); }
+	explicit RandomStream(uint64_t seed) { Seed(seed); }
+	~RandomStream() = default;
+
+	// seedから状態を作り直す
+	void Seed(uint64_t seed);
+
+	// 32bitの乱数
+	uint32_t NextUInt();
+	// [0, 1)の乱数
+	float NextFloat01();
+
+	// [min, max)、整数は[min, max]
+	template <typename T>
+	T Generate(T min, T max);
+	// Vector3
+	Vector3 Generate(const Vector3& min, const Vector3& max);
+	// Color
+	Color Generate(const Color& min, const Color& max);
+
+	// まとめて生成する、1つずつ呼んだ場合と同じ順で値を取り出す
+	void FillFloat(float* out, uint32_t count, float min, float max);
+	void FillVector3(Vector3* out, uint32_t count, const Vector3& min, const Vector3& max);
+	void FillColor(Color* out, uint32_t count, const Color& min, const Color& max);
+
+	//--------- accessor -----------------------------------------------------
+
+	uint64_t GetSeed() const { return seed_; }
+private:
+	//========================================================================*/
+	//	private Methods
+	//========================================================================*/
+
+	//--------- variables ----------------------------------------------------
+
+	uint32_t state_[4];
+	uint64_t seed_ = 0;
+};
+
+//============================================================================*/
+//	RandomStream inlineMethods
+//============================================================================*/
+
+inline uint32_t RandomStream::NextUInt() {
+
+	const uint32_t result = state_[0] + state_[3];
+	const uint32_t t = state_[1] << 9;
+
+	state_[2] ^= state_[0];
+	state_[3] ^= state_[1];
+	state_[1] ^= state_[2];
+	state_[0] ^= state_[3];
+	state_[2] ^= t;
+	state_[3] = (state_[3] << 11) | (state_[3] >> 21);
+	return result;
+}
+
+inline float RandomStream::NextFloat01() {
+
+	// 下位bitは質が低いので上位24bitを仮数に使う
+	return static_cast<float>(NextUInt() >> 8) * (1.0f / 16777216.0f);
+}
+
+template <typename T>
+inline T RandomStream::Generate(T min, T max) {
+
+	static_assert(std::is_arithmetic<T>::value, "T must be an arithmetic type");
+
+	T minValue = min;
+	T maxValue = max;
+	// どちらが大きいか比較して、小さい方をminに入れる
+	if (minValue > maxValue) {
+
+		minValue = max;
+		maxValue = min;
+	}
+
+	if constexpr (std::is_integral<T>::value) {
+
+		// 乗算で範囲に写す、範囲が2^32を超える型は想定しない
+		const uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(maxValue) - static_cast<int64_t>(minValue)) + 1;
+		const uint64_t offset = (static_cast<uint64_t>(NextUInt()) * range) >> 32;
+		return static_cast<T>(static_cast<int64_t>(minValue) + static_cast<int64_t>(offset));
+	} else {
+
+		return minValue + static_cast<T>(NextFloat01()) * (maxValue - minValue);
+	}
+}
@@ -2,8 +2,18 @@
 //	include
 //============================================================================
 #include <Engine/Core/Framework.h>
+#include <Engine/Asset/TextureCooker.h>
 
-int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR, int) {
+// c++
+#include <string_view>
+
+int WINAPI WinMain(HINSTANCE, HINSTANCE, LPSTR lpCmdLine, int) {
+
+	// ウィンドウを作らずにテクスチャの変換のみ行う(ビルド後に実行される)
+	if (std::string_view(lpCmdLine).find("-cookTextures") != std::string_view::npos) {
+
+		return TextureCooker::RunHeadless();
+	}
 
 	std::unique_ptr<Framework> game = std::make_unique<Framework>();
 	game->Run();